@@ -168,6 +168,11 @@ if (NOT SERAC_THIRD_PARTY_LIBRARIES_FOUND)
         set(CALIPER_FOUND FALSE)
     endif()
 
+    #------------------------------------------------------------------------------
+    # Threads (used by the asynchronous output writer)
+    #------------------------------------------------------------------------------
+    find_package(Threads REQUIRED)
+
     #------------------------------------------------------------------------------
     # PETSC
     #------------------------------------------------------------------------------
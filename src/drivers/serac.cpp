@@ -15,7 +15,9 @@
 #include <fstream>
 #include <iostream>
 #include <memory>
+#include <optional>
 #include <string>
+#include <vector>
 
 #include "axom/core.hpp"
 #include "mfem.hpp"
@@ -24,8 +26,10 @@
 #include "serac/infrastructure/initialize.hpp"
 #include "serac/infrastructure/input.hpp"
 #include "serac/infrastructure/logger.hpp"
+#include "serac/infrastructure/profiling.hpp"
 #include "serac/infrastructure/terminator.hpp"
 #include "serac/numerics/mesh_utils.hpp"
+#include "serac/physics/mixed_nonlinear_solid.hpp"
 #include "serac/physics/thermal_solid.hpp"
 #include "serac/physics/utilities/equation_solver.hpp"
 #include "serac/serac_config.hpp"
@@ -44,6 +48,18 @@ void defineInputFileSchema(axom::inlet::Inlet& inlet, int rank)
   // The output type (visit, glvis, paraview, etc)
   serac::input::defineOutputTypeInputFileSchema(inlet.getGlobalTable());
 
+  // The output options (asynchronous writing, etc)
+  auto& output_table = inlet.addStruct("output", "Options controlling how output is written");
+  serac::input::defineOutputOptionsInputFileSchema(output_table);
+
+  // The dynamic load rebalancing options
+  auto& rebalance_table = inlet.addStruct("rebalance", "Options controlling dynamic load rebalancing");
+  serac::input::defineRebalanceOptionsInputFileSchema(rebalance_table);
+
+  // The parameter sweep options
+  auto& sweep_table = inlet.addStruct("sweep", "Options for running many cases on the same mesh");
+  serac::input::defineSweepOptionsInputFileSchema(sweep_table);
+
   // The mesh options
   auto& mesh_table = inlet.addStruct("main_mesh", "The main mesh for the problem");
   serac::mesh::InputOptions::defineInputFileSchema(mesh_table);
@@ -62,17 +78,307 @@ void defineInputFileSchema(axom::inlet::Inlet& inlet, int rank)
   }
 }
 
+/**
+ * @brief Builds the mesh described by the input file
+ *
+ * @param[in] mesh_options The mesh options
+ * @param[in] input_file_path The path of the input file, which relative mesh paths start from
+ * @param[in] comm The communicator to distribute the mesh over
+ * @param[in] rank The rank on MPI_COMM_WORLD
+ * @return The parallel mesh
+ */
+std::shared_ptr<mfem::ParMesh> buildMesh(mesh::InputOptions& mesh_options, const std::string& input_file_path,
+                                         MPI_Comm comm, int rank)
+{
+  std::shared_ptr<mfem::ParMesh> mesh;
+  if (const auto file_opts = std::get_if<mesh::FileInputOptions>(&mesh_options.extra_options)) {
+    auto full_mesh_path = input::findMeshFilePath(file_opts->relative_mesh_file_name, input_file_path);
+    if (file_opts->cache_directory) {
+      mesh = buildCachedMeshFromFile(full_mesh_path, *file_opts->cache_directory, mesh_options.ser_ref_levels,
+                                     mesh_options.par_ref_levels, comm, mesh_options.partition);
+    } else {
+      mesh = buildMeshFromFile(full_mesh_path, mesh_options.ser_ref_levels, mesh_options.par_ref_levels, comm,
+                               mesh_options.partition);
+    }
+  } else if (const auto part_opts = std::get_if<mesh::PartitionedInputOptions>(&mesh_options.extra_options)) {
+    // Each rank reads only its own partition
+    SLIC_WARNING_ROOT_IF(mesh_options.ser_ref_levels > 0, rank, "Serial refinement is ignored for partitioned meshes.");
+    auto full_mesh_path = input::findMeshFilePath(part_opts->relative_directory, input_file_path);
+    mesh                = buildMeshFromPartitionedFiles(full_mesh_path, mesh_options.par_ref_levels);
+  } else if (auto gen_opts = std::get_if<mesh::GenerateInputOptions>(&mesh_options.extra_options)) {
+    SLIC_WARNING_ROOT_IF(mesh_options.ser_ref_levels > 0, rank,
+                         "Serial refinement is ignored for generated meshes, increase the number of elements instead.");
+    if (gen_opts->elements.size() == 3) {
+      mesh = buildCuboidMesh(*gen_opts, comm, mesh_options.partition);
+    } else {
+      mesh = buildRectangleMesh(*gen_opts, comm, mesh_options.partition);
+    }
+    for (int lev = 0; lev < mesh_options.par_ref_levels; lev++) {
+      mesh->UniformRefinement();
+    }
+  }
+  return mesh;
+}
+
+/**
+ * @brief Constructs the physics module selected by the blocks present in the input file
+ *
+ * @param[in] mesh The mesh to construct the physics on
+ * @param[in] solid_solver_options The solid mechanics options, if present
+ * @param[in] thermal_solver_options The thermal conduction options, if present
+ * @param[in] rank The rank on MPI_COMM_WORLD
+ * @return The physics module, with its setup not yet completed
+ */
+std::unique_ptr<BasePhysics> buildPhysics(std::shared_ptr<mfem::ParMesh>                         mesh,
+                                          const std::optional<NonlinearSolid::InputOptions>&    solid_solver_options,
+                                          const std::optional<ThermalConduction::InputOptions>& thermal_solver_options,
+                                          int                                                    rank)
+{
+  std::unique_ptr<BasePhysics> physics;
+  if (solid_solver_options && thermal_solver_options) {
+    physics = std::make_unique<ThermalSolid>(mesh, *thermal_solver_options, *solid_solver_options);
+  } else if (solid_solver_options && solid_solver_options->mixed) {
+    physics = std::make_unique<MixedNonlinearSolid>(mesh, *solid_solver_options);
+  } else if (solid_solver_options) {
+    physics = std::make_unique<NonlinearSolid>(mesh, *solid_solver_options);
+  } else if (thermal_solver_options) {
+    physics = std::make_unique<ThermalConduction>(mesh, *thermal_solver_options);
+  } else {
+    SLIC_ERROR_ROOT(rank, "Neither nonlinear_solid nor thermal_conduction blocks specified in the input file.");
+  }
+  return physics;
+}
+
+/**
+ * @brief Runs the time loop of a physics module whose setup has been completed, writing output along the way
+ *
+ * @param[in] physics The physics module
+ * @param[in] inlet The input file, which gives the time and output parameters
+ * @param[in] output_name The name of the output files
+ * @param[in] rank The rank of this process on the physics module's communicator
+ */
+void runSimulation(BasePhysics& physics, axom::inlet::Inlet& inlet, const std::string& output_name, int rank)
+{
+  // Initialize/set the time information
+  double t       = 0;
+  double t_final = inlet["t_final"];
+  double dt      = inlet["dt"];
+
+  bool last_step = false;
+
+  // FIXME: This and the FromInlet specialization are hacked together,
+  // should be inlet["output_type"].get<OutputType>()
+  OutputOptions output_options;
+  if (inlet.contains("output")) {
+    output_options = inlet["output"].get<OutputOptions>();
+  }
+  physics.initializeOutput(inlet.getGlobalTable().get<OutputType>(), output_name, output_options);
+
+  // The next simulation time at which to write output when using a time-based cadence
+  double next_output_time = output_options.every_dt.value_or(0.0);
+
+  // Enter the time step loop.
+  for (int ti = 1; !last_step; ti++) {
+    // Compute the real timestep. This may be less than dt for the last timestep.
+    double dt_real = std::min(dt, t_final - t);
+
+    // Compute current time
+    t = t + dt_real;
+
+    // Print the timestep information
+    SLIC_INFO_ROOT(rank, "step " << ti << ", t = " << t);
+
+    // Solve the physics module appropriately
+    physics.advanceTimestep(dt_real);
+    SLIC_ERROR_ROOT_IF(dt_real <= 0.0, rank, "The timestep was rejected, try a smaller timestep.");
+
+    // Determine if this is the last timestep
+    last_step = (t >= t_final - 1e-8 * dt);
+
+    // Determine if output is due, the final state is always written
+    bool write_output = last_step;
+    if (output_options.every_dt) {
+      if (t >= next_output_time - 1e-8 * dt) {
+        write_output = true;
+        while (next_output_time <= t + 1e-8 * dt) {
+          next_output_time += *output_options.every_dt;
+        }
+      }
+    } else if (ti % output_options.every_n_steps == 0) {
+      write_output = true;
+    }
+
+    // Output a visualization file
+    if (write_output) {
+      physics.outputState();
+    }
+
+    // Repartition the mesh if the work has become imbalanced
+    if (!last_step) {
+      physics.rebalance();
+    }
+  }
+}
+
+/**
+ * @brief Shares a factor with the boundary conditions scaled by the sweep, so each case only has to change its value
+ *
+ * @param[in] scaled_bcs The names of the boundary conditions scaled by the cases
+ * @param[in] bc_scale The factor, which is set to each case's bc_scale
+ * @param[inout] solid_solver_options The solid mechanics options, if present
+ * @param[inout] thermal_solver_options The thermal conduction options, if present
+ * @param[in] rank The rank on MPI_COMM_WORLD
+ */
+void shareSweepScale(const std::vector<std::string>& scaled_bcs, std::shared_ptr<const double> bc_scale,
+                     std::optional<NonlinearSolid::InputOptions>&    solid_solver_options,
+                     std::optional<ThermalConduction::InputOptions>& thermal_solver_options, int rank)
+{
+  for (const auto& name : scaled_bcs) {
+    bool found = false;
+    if (solid_solver_options) {
+      auto bc = solid_solver_options->boundary_conditions.find(name);
+      if (bc != solid_solver_options->boundary_conditions.end()) {
+        bc->second.coef_opts.factor = bc_scale;
+        found                       = true;
+      }
+    }
+    if (thermal_solver_options) {
+      auto bc = thermal_solver_options->boundary_conditions.find(name);
+      if (bc != thermal_solver_options->boundary_conditions.end()) {
+        bc->second.coef_opts.factor = bc_scale;
+        found                       = true;
+      }
+    }
+    SLIC_ERROR_ROOT_IF(!found, rank, fmt::format("Cannot scale unknown boundary condition '{0}'", name));
+  }
+}
+
+/**
+ * @brief Applies the material parameters of one sweep case to a physics module whose setup has been completed
+ *
+ * @param[in] sweep_case The case
+ * @param[in] solid_solver_options The solid mechanics options, which give the parameters the case does not set
+ * @param[in] thermal_solver_options The thermal conduction options, which give the parameters the case does not set
+ * @param[inout] physics The physics module built from the options
+ * @param[in] rank The rank on MPI_COMM_WORLD
+ */
+void applySweepCase(const SweepCase&                                      sweep_case,
+                    const std::optional<NonlinearSolid::InputOptions>&    solid_solver_options,
+                    const std::optional<ThermalConduction::InputOptions>& thermal_solver_options, BasePhysics& physics,
+                    int rank)
+{
+  SLIC_ERROR_ROOT_IF((sweep_case.mu || sweep_case.K) && !solid_solver_options, rank,
+                     "A sweep case sets mu or K without a nonlinear_solid block.");
+  SLIC_ERROR_ROOT_IF(sweep_case.kappa && !thermal_solver_options, rank,
+                     "A sweep case sets kappa without a thermal_conduction block.");
+
+  // Parameters a case does not set return to the values of the input file
+  std::optional<std::pair<double, double>> moduli;
+  std::optional<double>                    kappa;
+  if (solid_solver_options) {
+    moduli = {sweep_case.mu.value_or(solid_solver_options->mu), sweep_case.K.value_or(solid_solver_options->K)};
+  }
+  if (thermal_solver_options) {
+    kappa = sweep_case.kappa.value_or(thermal_solver_options->kappa);
+  }
+
+  if (auto thermal_solid = dynamic_cast<ThermalSolid*>(&physics)) {
+    thermal_solid->SetHyperelasticMaterialParameters(moduli->first, moduli->second);
+    thermal_solid->UpdateConductivity(*kappa);
+  } else if (auto solid = dynamic_cast<NonlinearSolid*>(&physics)) {
+    solid->setHyperelasticMaterialParameters(moduli->first, moduli->second);
+  } else if (auto thermal = dynamic_cast<ThermalConduction*>(&physics)) {
+    thermal->updateConductivity(*kappa);
+  }
+}
+
+/**
+ * @brief Runs every case of a parameter sweep
+ *
+ * The ranks are split into contiguous groups that each build the mesh and the physics module
+ * once and run every concurrent_groups-th case on them. Between cases, only the material
+ * parameters and the factor of the scaled boundary conditions change, and the physics module
+ * restarts from its initial state. The forms keep their sparsity patterns and a direct linear
+ * solver keeps its symbolic factorization, so each case only redoes the value-dependent work.
+ *
+ * @param[in] inlet The input file
+ * @param[in] mesh_options The mesh options
+ * @param[in] input_file_path The path of the input file
+ * @param[in] solid_solver_options The solid mechanics options, if present
+ * @param[in] thermal_solver_options The thermal conduction options, if present
+ * @param[in] num_procs The number of ranks on MPI_COMM_WORLD
+ * @param[in] rank The rank on MPI_COMM_WORLD
+ */
+void runSweep(axom::inlet::Inlet& inlet, mesh::InputOptions& mesh_options, const std::string& input_file_path,
+              std::optional<NonlinearSolid::InputOptions>    solid_solver_options,
+              std::optional<ThermalConduction::InputOptions> thermal_solver_options, int num_procs, int rank)
+{
+  auto sweep_options = inlet["sweep"].get<SweepOptions>();
+  SLIC_ERROR_ROOT_IF(inlet.contains("rebalance"), rank, "Rebalancing is not supported in a parameter sweep.");
+  SLIC_ERROR_ROOT_IF(thermal_solver_options && thermal_solver_options->adaptivity, rank,
+                     "Adaptive mesh refinement is not supported in a parameter sweep.");
+
+  const int groups = sweep_options.concurrent_groups;
+  SLIC_ERROR_ROOT_IF(groups > num_procs, rank,
+                     fmt::format("Cannot split {0} ranks into {1} sweep groups", num_procs, groups));
+  SLIC_ERROR_ROOT_IF(groups > 1 && std::holds_alternative<mesh::PartitionedInputOptions>(mesh_options.extra_options),
+                     rank, "Partitioned meshes can only be read by a single sweep group.");
+
+  // Contiguous ranks share a group, which keeps each group's communication within as few nodes as possible
+  const int color = static_cast<int>(static_cast<long>(rank) * groups / num_procs);
+  MPI_Comm  comm;
+  MPI_Comm_split(MPI_COMM_WORLD, color, rank, &comm);
+  int group_rank = 0;
+  MPI_Comm_rank(comm, &group_rank);
+
+  auto bc_scale = std::make_shared<double>(1.0);
+  shareSweepScale(sweep_options.scaled_bcs, bc_scale, solid_solver_options, thermal_solver_options, rank);
+
+  auto mesh    = buildMesh(mesh_options, input_file_path, comm, rank);
+  auto physics = buildPhysics(mesh, solid_solver_options, thermal_solver_options, rank);
+  physics->completeSetup();
+
+  // Every case starts from the initial state of the input file
+  std::vector<mfem::Vector> initial_state;
+  for (const auto& state : physics->getState()) {
+    initial_state.emplace_back(state.get().gridFunc());
+  }
+
+  for (std::size_t i = static_cast<std::size_t>(color); i < sweep_options.cases.size();
+       i += static_cast<std::size_t>(groups)) {
+    SLIC_INFO_ROOT(group_rank, fmt::format("Running sweep case {0} of {1}", i + 1, sweep_options.cases.size()));
+
+    const auto& sweep_case = sweep_options.cases[i];
+    *bc_scale              = sweep_case.bc_scale;
+    applySweepCase(sweep_case, solid_solver_options, thermal_solver_options, *physics, rank);
+    physics->restart(initial_state);
+
+    runSimulation(*physics, inlet, fmt::format("serac_case_{0}", i), group_rank);
+    physics->flushOutput();
+  }
+
+  physics.reset();
+  mesh.reset();
+  MPI_Comm_free(&comm);
+}
+
 }  // namespace serac
 
 int main(int argc, char* argv[])
 {
-  auto [num_procs, rank] = serac::initialize(argc, argv);
+  // MPI only pays for full thread support when asynchronous output is requested
+  auto [num_procs, rank] = serac::initialize(argc, argv, MPI_COMM_WORLD, serac::cli::requestsAsyncOutput(argc, argv));
 
   // Handle Command line
   std::unordered_map<std::string, std::string> cli_opts =
       serac::cli::defineAndParse(argc, argv, rank, "Serac: a high order nonlinear thermomechanical simulation code");
   serac::cli::printGiven(cli_opts, rank);
 
+  // Only the runtime report of the solver regions is collected unless more is requested
+  auto caliper = cli_opts.find("caliper");
+  serac::profiling::initializeCaliper(caliper != cli_opts.end() ? caliper->second : "");
+  serac::terminator::registerCleanup([]() { serac::profiling::terminateCaliper(); });
+
   // Read input file
   std::string input_file_path = "";
   auto        search          = cli_opts.find("input_file");
@@ -101,17 +407,13 @@ int main(int argc, char* argv[])
   // Save input values to file
   datastore.getRoot()->save("serac_input.json", "json");
 
-  std::shared_ptr<mfem::ParMesh> mesh;
   // Build the mesh
   auto mesh_options = inlet["main_mesh"].get<serac::mesh::InputOptions>();
-  if (const auto file_opts = std::get_if<serac::mesh::FileInputOptions>(&mesh_options.extra_options)) {
-    auto full_mesh_path = serac::input::findMeshFilePath(file_opts->relative_mesh_file_name, input_file_path);
-    mesh = serac::buildMeshFromFile(full_mesh_path, mesh_options.ser_ref_levels, mesh_options.par_ref_levels);
+  if (inlet.contains("rebalance")) {
+    // Only nonconforming meshes can be repartitioned during the simulation
+    mesh_options.partition.nonconforming = true;
   }
 
-  // Create the physics object
-  std::unique_ptr<serac::BasePhysics> main_physics;
-
   // Create nullable contains for the solid and thermal input file options
   std::optional<serac::NonlinearSolid::InputOptions>    solid_solver_options;
   std::optional<serac::ThermalConduction::InputOptions> thermal_solver_options;
@@ -124,51 +426,26 @@ int main(int argc, char* argv[])
     thermal_solver_options = inlet["thermal_conduction"].get<serac::ThermalConduction::InputOptions>();
   }
 
-  // Construct the appropriate physics object using the input file options
-  if (solid_solver_options && thermal_solver_options) {
-    main_physics = std::make_unique<serac::ThermalSolid>(mesh, *thermal_solver_options, *solid_solver_options);
-  } else if (solid_solver_options) {
-    main_physics = std::make_unique<serac::NonlinearSolid>(mesh, *solid_solver_options);
-  } else if (thermal_solver_options) {
-    main_physics = std::make_unique<serac::ThermalConduction>(mesh, *thermal_solver_options);
-  } else {
-    SLIC_ERROR_ROOT(rank, "Neither nonlinear_solid nor thermal_conduction blocks specified in the input file.");
+  if (inlet.contains("sweep")) {
+    serac::runSweep(inlet, mesh_options, input_file_path, solid_solver_options, thermal_solver_options, num_procs,
+                    rank);
+    serac::exitGracefully();
   }
 
-  // Complete the solver setup
-  main_physics->completeSetup();
-
-  // Initialize/set the time information
-  double t       = 0;
-  double t_final = inlet["t_final"];
-  double dt      = inlet["dt"];
-
-  bool last_step = false;
-
-  // FIXME: This and the FromInlet specialization are hacked together,
-  // should be inlet["output_type"].get<OutputType>()
-  main_physics->initializeOutput(inlet.getGlobalTable().get<serac::OutputType>(), "serac");
-
-  // Enter the time step loop.
-  for (int ti = 1; !last_step; ti++) {
-    // Compute the real timestep. This may be less than dt for the last timestep.
-    double dt_real = std::min(dt, t_final - t);
-
-    // Compute current time
-    t = t + dt_real;
-
-    // Print the timestep information
-    SLIC_INFO_ROOT(rank, "step " << ti << ", t = " << t);
+  auto mesh = serac::buildMesh(mesh_options, input_file_path, MPI_COMM_WORLD, rank);
 
-    // Solve the physics module appropriately
-    main_physics->advanceTimestep(dt_real);
+  // Construct the appropriate physics object using the input file options
+  auto main_physics = serac::buildPhysics(mesh, solid_solver_options, thermal_solver_options, rank);
 
-    // Output a visualization file
-    main_physics->outputState();
+  // Complete the solver setup
+  main_physics->completeSetup();
 
-    // Determine if this is the last timestep
-    last_step = (t >= t_final - 1e-8 * dt);
+  if (inlet.contains("rebalance")) {
+    main_physics->enableRebalancing(inlet["rebalance"].get<serac::RebalanceOptions>());
   }
 
+  serac::runSimulation(*main_physics, inlet, "serac", rank);
+
+  // Any output still buffered by the I/O thread is flushed before exiting
   serac::exitGracefully();
 }
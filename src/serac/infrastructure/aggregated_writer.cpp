@@ -0,0 +1,146 @@
+// Copyright (c) 2019-2021, Lawrence Livermore National Security, LLC and
+// other Serac Project Developers. See the top-level LICENSE file for
+// details.
+//
+// SPDX-License-Identifier: (BSD-3-Clause)
+
+#include "serac/infrastructure/aggregated_writer.hpp"
+
+#include <algorithm>
+#include <climits>
+#include <cstdint>
+#include <fstream>
+#include <vector>
+
+#include "fmt/fmt.hpp"
+
+#include "serac/infrastructure/logger.hpp"
+
+namespace serac {
+
+AggregatedWriter::AggregatedWriter(MPI_Comm comm, const int aggregators_per_node)
+{
+  SLIC_ERROR_IF(aggregators_per_node < 1, "AggregatedWriter requires at least one aggregator per node.");
+
+  MPI_Comm_dup(comm, &comm_);
+  int rank = 0;
+  MPI_Comm_rank(comm_, &rank);
+
+  // Group the ranks on each node into contiguous blocks, one per aggregator
+  MPI_Comm node_comm;
+  MPI_Comm_split_type(comm_, MPI_COMM_TYPE_SHARED, rank, MPI_INFO_NULL, &node_comm);
+  int node_rank = 0;
+  int node_size = 0;
+  MPI_Comm_rank(node_comm, &node_rank);
+  MPI_Comm_size(node_comm, &node_size);
+
+  int num_groups = std::min(aggregators_per_node, node_size);
+  int group      = static_cast<int>((static_cast<long long>(node_rank) * num_groups) / node_size);
+  MPI_Comm_split(node_comm, group, node_rank, &group_comm_);
+  MPI_Comm_free(&node_comm);
+
+  int group_rank = 0;
+  MPI_Comm_rank(group_comm_, &group_rank);
+  MPI_Comm_split(comm_, group_rank == 0 ? 0 : MPI_UNDEFINED, rank, &aggregator_comm_);
+}
+
+AggregatedWriter::~AggregatedWriter()
+{
+  int mpi_finalized = 0;
+  MPI_Finalized(&mpi_finalized);
+  if (mpi_finalized) {
+    return;
+  }
+  if (aggregator_comm_ != MPI_COMM_NULL) {
+    MPI_Comm_free(&aggregator_comm_);
+  }
+  MPI_Comm_free(&group_comm_);
+  MPI_Comm_free(&comm_);
+}
+
+void AggregatedWriter::write(const std::string& file_name, const std::string& block) const
+{
+  int rank       = 0;
+  int group_rank = 0;
+  int group_size = 0;
+  MPI_Comm_rank(comm_, &rank);
+  MPI_Comm_rank(group_comm_, &group_rank);
+  MPI_Comm_size(group_comm_, &group_size);
+
+  // Gather the blocks of the group to its aggregator
+  SLIC_ERROR_IF(block.size() > static_cast<std::size_t>(INT_MAX),
+                fmt::format("Output block of {0} bytes is too large to aggregate", block.size()));
+  int              block_size = static_cast<int>(block.size());
+  std::vector<int> sizes(isAggregator() ? static_cast<std::size_t>(group_size) : 0);
+  MPI_Gather(&block_size, 1, MPI_INT, sizes.data(), 1, MPI_INT, 0, group_comm_);
+
+  std::vector<int> displs(sizes.size(), 0);
+  std::int64_t     group_bytes = 0;
+  for (std::size_t i = 0; i < sizes.size(); ++i) {
+    displs[i] = static_cast<int>(group_bytes);
+    group_bytes += sizes[i];
+  }
+  SLIC_ERROR_IF(group_bytes > INT_MAX,
+                fmt::format("Aggregated output of {0} bytes exceeds the gather limit, use more aggregators per node",
+                            group_bytes));
+
+  std::vector<char> buffer(static_cast<std::size_t>(group_bytes));
+  MPI_Gatherv(block.data(), block_size, MPI_CHAR, buffer.data(), sizes.data(), displs.data(), MPI_CHAR, 0,
+              group_comm_);
+
+  // The aggregators write their buffers back-to-back into the shared file
+  std::int64_t group_offset = 0;
+  if (isAggregator()) {
+    MPI_Exscan(&group_bytes, &group_offset, 1, MPI_INT64_T, MPI_SUM, aggregator_comm_);
+    int aggregator_rank = 0;
+    MPI_Comm_rank(aggregator_comm_, &aggregator_rank);
+    if (aggregator_rank == 0) {
+      // The result of MPI_Exscan is undefined on the first rank
+      group_offset = 0;
+    }
+
+    MPI_File file;
+    int      status = MPI_File_open(aggregator_comm_, file_name.c_str(), MPI_MODE_CREATE | MPI_MODE_WRONLY,
+                               MPI_INFO_NULL, &file);
+    SLIC_ERROR_IF(status != MPI_SUCCESS, fmt::format("Failed to open aggregated output file '{0}'", file_name));
+    MPI_File_set_size(file, 0);
+
+    // write_at_all is collective, so every aggregator must make the same number of calls
+    constexpr std::int64_t chunk_size = 1 << 30;
+    std::int64_t           num_chunks = (group_bytes + chunk_size - 1) / chunk_size;
+    MPI_Allreduce(MPI_IN_PLACE, &num_chunks, 1, MPI_INT64_T, MPI_MAX, aggregator_comm_);
+    for (std::int64_t chunk = 0; chunk < num_chunks; ++chunk) {
+      std::int64_t begin = std::min(chunk * chunk_size, group_bytes);
+      std::int64_t count = std::min(chunk_size, group_bytes - begin);
+      MPI_File_write_at_all(file, static_cast<MPI_Offset>(group_offset + begin), buffer.data() + begin,
+                            static_cast<int>(count), MPI_CHAR, MPI_STATUS_IGNORE);
+    }
+    MPI_File_close(&file);
+  }
+
+  // Record where each rank's block ended up
+  MPI_Bcast(&group_offset, 1, MPI_INT64_T, 0, group_comm_);
+  std::int64_t local_bytes  = block_size;
+  std::int64_t local_offset = 0;
+  MPI_Exscan(&local_bytes, &local_offset, 1, MPI_INT64_T, MPI_SUM, group_comm_);
+  if (group_rank == 0) {
+    local_offset = 0;
+  }
+
+  int num_ranks = 0;
+  MPI_Comm_size(comm_, &num_ranks);
+  std::int64_t              entry[2] = {group_offset + local_offset, local_bytes};
+  std::vector<std::int64_t> entries(rank == 0 ? 2 * static_cast<std::size_t>(num_ranks) : 0);
+  MPI_Gather(entry, 2, MPI_INT64_T, entries.data(), 2, MPI_INT64_T, 0, comm_);
+
+  if (rank == 0) {
+    std::ofstream index(file_name + ".index");
+    index << num_ranks << "\n";
+    for (int i = 0; i < num_ranks; ++i) {
+      auto idx = 2 * static_cast<std::size_t>(i);
+      index << i << " " << entries[idx] << " " << entries[idx + 1] << "\n";
+    }
+  }
+}
+
+}  // namespace serac
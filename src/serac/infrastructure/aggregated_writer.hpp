@@ -0,0 +1,82 @@
+// Copyright (c) 2019-2021, Lawrence Livermore National Security, LLC and
+// other Serac Project Developers. See the top-level LICENSE file for
+// details.
+//
+// SPDX-License-Identifier: (BSD-3-Clause)
+
+/**
+ * @file aggregated_writer.hpp
+ *
+ * @brief Writes per-rank data to a single shared file through a subset of aggregator ranks
+ */
+
+#pragma once
+
+#include <string>
+
+#include "mpi.h"
+
+namespace serac {
+
+/**
+ * @brief Collectively writes one block of bytes per rank into a single file
+ *
+ * Writing one file per rank overwhelms the metadata server of a parallel filesystem at
+ * scale. Instead, the ranks on each node are split into groups, each served by an
+ * aggregator rank. Each group gathers its blocks to its aggregator, and the aggregators
+ * write their concatenated blocks into one shared file with collective MPI-IO, so the
+ * filesystem sees a few large contiguous writes per node.
+ *
+ * The blocks are stored in aggregator order rather than rank order, so rank 0 also writes
+ * a plain-text index alongside each file (`<file_name>.index`) that lists the number of
+ * blocks followed by one `rank offset size` line per rank.
+ */
+class AggregatedWriter {
+public:
+  /**
+   * @brief Construct a new writer, establishing the aggregator groups
+   *
+   * @param[in] comm The communicator whose ranks contribute blocks, duplicated internally
+   * @param[in] aggregators_per_node The number of aggregator ranks on each shared-memory node
+   */
+  AggregatedWriter(MPI_Comm comm, const int aggregators_per_node);
+
+  AggregatedWriter(const AggregatedWriter&) = delete;
+  AggregatedWriter& operator=(const AggregatedWriter&) = delete;
+
+  /**
+   * @brief Frees the communicators
+   */
+  ~AggregatedWriter();
+
+  /**
+   * @brief Collectively write each rank's block to a shared file
+   *
+   * @param[in] file_name The file to create (or overwrite)
+   * @param[in] block This rank's data
+   */
+  void write(const std::string& file_name, const std::string& block) const;
+
+  /**
+   * @brief Whether this rank writes to the filesystem on behalf of its group
+   */
+  bool isAggregator() const { return aggregator_comm_ != MPI_COMM_NULL; }
+
+private:
+  /**
+   * @brief The duplicated communicator of all contributing ranks
+   */
+  MPI_Comm comm_;
+
+  /**
+   * @brief The ranks that share an aggregator, with the aggregator as rank 0
+   */
+  MPI_Comm group_comm_;
+
+  /**
+   * @brief The aggregator ranks, MPI_COMM_NULL on all other ranks
+   */
+  MPI_Comm aggregator_comm_;
+};
+
+}  // namespace serac
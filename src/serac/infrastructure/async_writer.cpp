@@ -0,0 +1,132 @@
+// Copyright (c) 2019-2021, Lawrence Livermore National Security, LLC and
+// other Serac Project Developers. See the top-level LICENSE file for
+// details.
+//
+// SPDX-License-Identifier: (BSD-3-Clause)
+
+#include "serac/infrastructure/async_writer.hpp"
+
+#include <algorithm>
+
+#include "serac/infrastructure/logger.hpp"
+#include "serac/infrastructure/terminator.hpp"
+
+namespace serac {
+
+AsyncWriter::AsyncWriter(const int num_slots) : slot_busy_(static_cast<std::size_t>(std::max(num_slots, 1)), false)
+{
+  SLIC_WARNING_IF(num_slots < 1, "AsyncWriter requires at least one buffer slot, using one.");
+  worker_     = std::thread(&AsyncWriter::run, this);
+  cleanup_id_ = terminator::registerCleanup([this]() { finalize(); });
+}
+
+AsyncWriter::~AsyncWriter()
+{
+  terminator::deregisterCleanup(cleanup_id_);
+  try {
+    finalize();
+  } catch (...) {
+    // Destructors must not throw, and the error was already recorded by the I/O thread
+  }
+}
+
+int AsyncWriter::acquireSlot()
+{
+  SLIC_ERROR_IF(!worker_.joinable(), "Cannot acquire an output slot after the AsyncWriter has been finalized.");
+  std::unique_lock<std::mutex> lock(mutex_);
+  task_done_.wait(lock, [this]() {
+    return error_ || std::find(slot_busy_.begin(), slot_busy_.end(), false) != slot_busy_.end();
+  });
+  rethrowPending();
+  auto slot = std::find(slot_busy_.begin(), slot_busy_.end(), false);
+  *slot     = true;
+  return static_cast<int>(slot - slot_busy_.begin());
+}
+
+void AsyncWriter::submit(const int slot, std::function<void()> task)
+{
+  bool reserved = false;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    reserved = (slot >= 0) && (slot < numSlots()) && slot_busy_[static_cast<std::size_t>(slot)];
+    if (reserved) {
+      tasks_.emplace_back(slot, std::move(task));
+    }
+  }
+  SLIC_ERROR_IF(!reserved, "Output tasks must be submitted with a slot returned by acquireSlot().");
+  task_ready_.notify_one();
+}
+
+void AsyncWriter::flush()
+{
+  // A task that aborts the program ends up here via exitGracefully, and waiting on
+  // ourselves would deadlock
+  if (std::this_thread::get_id() == worker_.get_id()) {
+    return;
+  }
+  std::unique_lock<std::mutex> lock(mutex_);
+  task_done_.wait(lock, [this]() { return tasks_.empty() && !running_task_; });
+  rethrowPending();
+}
+
+void AsyncWriter::finalize()
+{
+  if (!worker_.joinable() || std::this_thread::get_id() == worker_.get_id()) {
+    return;
+  }
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stop_ = true;
+  }
+  task_ready_.notify_one();
+  // The I/O thread drains the queue before exiting
+  worker_.join();
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  rethrowPending();
+}
+
+void AsyncWriter::run()
+{
+  while (true) {
+    std::pair<int, std::function<void()>> entry;
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      task_ready_.wait(lock, [this]() { return stop_ || !tasks_.empty(); });
+      if (tasks_.empty()) {
+        return;
+      }
+      entry = std::move(tasks_.front());
+      tasks_.pop_front();
+      running_task_ = true;
+    }
+
+    std::exception_ptr error;
+    try {
+      entry.second();
+    } catch (...) {
+      error = std::current_exception();
+    }
+
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      slot_busy_[static_cast<std::size_t>(entry.first)] = false;
+      running_task_                                     = false;
+      if (error && !error_) {
+        error_ = error;
+      }
+    }
+    task_done_.notify_all();
+  }
+}
+
+void AsyncWriter::rethrowPending()
+{
+  if (error_) {
+    auto error = error_;
+    error_     = nullptr;
+    std::rethrow_exception(error);
+  }
+}
+
+}  // namespace serac
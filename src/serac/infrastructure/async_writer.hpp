@@ -0,0 +1,154 @@
+// Copyright (c) 2019-2021, Lawrence Livermore National Security, LLC and
+// other Serac Project Developers. See the top-level LICENSE file for
+// details.
+//
+// SPDX-License-Identifier: (BSD-3-Clause)
+
+/**
+ * @file async_writer.hpp
+ *
+ * @brief A background worker thread for serializing output while the solver continues
+ */
+
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace serac {
+
+/**
+ * @brief Executes output tasks in order on a dedicated I/O thread
+ *
+ * The writer owns a fixed pool of buffer slots. The caller acquires a free slot,
+ * deep-copies the data to be written into storage indexed by that slot, and submits
+ * a task that serializes it. The slot is released once the task completes, so
+ * acquireSlot() blocks when every slot is still waiting to be written. The number
+ * of slots therefore bounds both the memory used for snapshots and how far the I/O
+ * thread can fall behind the solver.
+ *
+ * All pending output is flushed when exitGracefully() is called.
+ */
+class AsyncWriter {
+public:
+  /**
+   * @brief Construct a new writer and start its I/O thread
+   *
+   * @param[in] num_slots The number of snapshots that may be buffered at once
+   */
+  explicit AsyncWriter(const int num_slots = 2);
+
+  AsyncWriter(const AsyncWriter&) = delete;
+  AsyncWriter& operator=(const AsyncWriter&) = delete;
+
+  /**
+   * @brief Flushes all pending tasks and joins the I/O thread
+   */
+  ~AsyncWriter();
+
+  /**
+   * @brief Reserve a buffer slot, blocking until one is available
+   *
+   * @return The index of the reserved slot in [0, numSlots())
+   * @note If a previously submitted task threw, the exception is rethrown here
+   */
+  int acquireSlot();
+
+  /**
+   * @brief Queue a task that serializes the data held in a reserved slot
+   *
+   * @param[in] slot The slot returned by acquireSlot()
+   * @param[in] task The serialization work, executed on the I/O thread
+   */
+  void submit(const int slot, std::function<void()> task);
+
+  /**
+   * @brief Block until every submitted task has completed
+   *
+   * @note If a previously submitted task threw, the exception is rethrown here
+   */
+  void flush();
+
+  /**
+   * @brief Flush all pending tasks and stop the I/O thread
+   *
+   * No tasks may be submitted afterwards. Calling this more than once is a no-op.
+   */
+  void finalize();
+
+  /**
+   * @brief The number of buffer slots
+   */
+  int numSlots() const { return static_cast<int>(slot_busy_.size()); }
+
+private:
+  /**
+   * @brief The loop executed by the I/O thread
+   */
+  void run();
+
+  /**
+   * @brief Rethrow an exception captured on the I/O thread, if any
+   *
+   * @pre mutex_ is held by the caller
+   */
+  void rethrowPending();
+
+  /**
+   * @brief Guards all state shared with the I/O thread
+   */
+  std::mutex mutex_;
+
+  /**
+   * @brief Signals the I/O thread that a task was queued or a stop was requested
+   */
+  std::condition_variable task_ready_;
+
+  /**
+   * @brief Signals waiting callers that a task finished and its slot was released
+   */
+  std::condition_variable task_done_;
+
+  /**
+   * @brief The queue of (slot, task) pairs awaiting execution
+   */
+  std::deque<std::pair<int, std::function<void()>>> tasks_;
+
+  /**
+   * @brief Whether each slot is reserved or waiting to be written
+   */
+  std::vector<bool> slot_busy_;
+
+  /**
+   * @brief Whether the I/O thread is currently executing a task
+   */
+  bool running_task_ = false;
+
+  /**
+   * @brief Whether the I/O thread has been asked to stop
+   */
+  bool stop_ = false;
+
+  /**
+   * @brief The first exception thrown by a task, to be rethrown on the calling thread
+   */
+  std::exception_ptr error_;
+
+  /**
+   * @brief The handle of the flush callback registered with the terminator
+   */
+  int cleanup_id_;
+
+  /**
+   * @brief The I/O thread
+   */
+  std::thread worker_;
+};
+
+}  // namespace serac
@@ -6,6 +6,8 @@
 
 #include "serac/infrastructure/cli.hpp"
 
+#include <algorithm>
+
 #include "CLI11/CLI11.hpp"
 
 #include "serac/infrastructure/logger.hpp"
@@ -15,6 +17,11 @@ namespace serac::cli {
 
 //------- Command Line Interface -------
 
+bool requestsAsyncOutput(int argc, char* argv[])
+{
+  return std::any_of(argv + 1, argv + argc, [](const char* arg) { return std::string(arg) == ASYNC_OUTPUT_FLAG; });
+}
+
 std::unordered_map<std::string, std::string> defineAndParse(int argc, char* argv[], int rank,
                                                             std::string app_description)
 {
@@ -25,6 +32,12 @@ std::unordered_map<std::string, std::string> defineAndParse(int argc, char* argv
   bool create_input_file_docs{false};
   app.add_flag("-d, --create-input-file-docs", create_input_file_docs,
                "Writes Sphinx documentation for input file, then exits");
+  bool async_output{false};
+  app.add_flag(ASYNC_OUTPUT_FLAG, async_output,
+               "Initializes MPI with full thread support, which output.async requires to write on a background thread");
+  std::string caliper_options;
+  app.add_option("-c, --caliper", caliper_options,
+                 "Caliper ConfigManager configuration for profiling, in addition to the default runtime report");
 
   // Parse the arguments and check if they are good
   try {
@@ -47,6 +60,12 @@ std::unordered_map<std::string, std::string> defineAndParse(int argc, char* argv
   if (create_input_file_docs) {
     cli_opts.insert({"create_input_file_docs", {}});
   }
+  if (async_output) {
+    cli_opts.insert({"async_output", {}});
+  }
+  if (!caliper_options.empty()) {
+    cli_opts.insert({"caliper", caliper_options});
+  }
 
   return cli_opts;
 }
@@ -59,6 +78,10 @@ void printGiven(std::unordered_map<std::string, std::string>& cli_opts, int rank
   // Add options
   auto search = cli_opts.find("input_file");
   if (search != cli_opts.end()) optsMsg += fmt::format("Input File: {0}\n", search->second);
+  search = cli_opts.find("async_output");
+  if (search != cli_opts.end()) optsMsg += "Asynchronous Output: enabled\n";
+  search = cli_opts.find("caliper");
+  if (search != cli_opts.end()) optsMsg += fmt::format("Caliper: {0}\n", search->second);
 
   // Add footer
   optsMsg += fmt::format("{:*^80}\n", "*");
@@ -19,6 +19,21 @@
 // Command line functionality
 namespace serac::cli {
 
+/**
+ * @brief The command line flag that requests the MPI thread support needed by asynchronous output
+ */
+constexpr char ASYNC_OUTPUT_FLAG[] = "--async-output";
+
+/**
+ * @brief Returns whether the command line requests asynchronous output
+ *
+ * This only scans the arguments, so it can be called before MPI is initialized to select its thread support.
+ *
+ * @param[in] argc Argument count
+ * @param[in] argv Argument vector
+ */
+bool requestsAsyncOutput(int argc, char* argv[]);
+
 /**
  * @brief Defines command line options and parses the found values.
  *
@@ -27,10 +27,20 @@ std::pair<int, int> getMPIInfo(MPI_Comm comm)
   return {num_procs, rank};
 }
 
-std::pair<int, int> initialize(int argc, char* argv[], MPI_Comm comm)
+std::pair<int, int> initialize(int argc, char* argv[], MPI_Comm comm, const bool thread_multiple)
 {
-  // Initialize MPI.
-  if (MPI_Init(&argc, &argv) != MPI_SUCCESS) {
+  // Initialize MPI without thread support by default. Full thread support is only requested when
+  // asked for, so that output can be serialized on a background thread (see AsyncWriter).
+  // BasePhysics::initializeOutput checks the provided level with MPI_Query_thread and falls back
+  // to synchronous output if it is not available.
+  int result = MPI_SUCCESS;
+  if (thread_multiple) {
+    int provided = 0;
+    result       = MPI_Init_thread(&argc, &argv, MPI_THREAD_MULTIPLE, &provided);
+  } else {
+    result = MPI_Init(&argc, &argv);
+  }
+  if (result != MPI_SUCCESS) {
     std::cerr << "Failed to initialize MPI" << std::endl;
     serac::exitGracefully(true);
   }
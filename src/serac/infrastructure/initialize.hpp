@@ -30,8 +30,11 @@ std::pair<int, int> getMPIInfo(MPI_Comm comm = MPI_COMM_WORLD);
  * @param argc The number of command-line arguments
  * @param argv The command-line arguments, as C-strings
  * @param comm The MPI communicator to initialize with
+ * @param thread_multiple Whether to request MPI_THREAD_MULTIPLE, which asynchronous output
+ * requires but which makes every MPI call pay for locking
  * @return A pair containing the size and rank relative to the provided MPI communicator
  */
-std::pair<int, int> initialize(int argc, char* argv[], MPI_Comm comm = MPI_COMM_WORLD);
+std::pair<int, int> initialize(int argc, char* argv[], MPI_Comm comm = MPI_COMM_WORLD,
+                               const bool thread_multiple = false);
 
 }  // namespace serac
@@ -84,6 +84,50 @@ void defineOutputTypeInputFileSchema(axom::inlet::Table& table)
       .defaultValue("VisIt");
 }
 
+void defineOutputOptionsInputFileSchema(axom::inlet::Table& table)
+{
+  table.addBool("async", "Whether to write output on a background I/O thread, which requires serac --async-output")
+      .defaultValue(false);
+  table.addInt("max_pending", "Number of output snapshots that may be buffered before the solver waits")
+      .defaultValue(2);
+  table.addInt("every_n_steps", "Write output every this many timesteps").defaultValue(1);
+  table.addDouble("every_dt", "Write output every this much simulated time, overrides every_n_steps");
+  table.addStringArray("fields", "Names of the fields to write, all fields are written if omitted");
+  table.addInt("levels_of_detail",
+               "Refinement level for sampling high-order fields, defaults to the field order for ParaView and 1 for VisIt");
+  table.addBool("float32", "Write floating-point data in single precision (ParaView only)").defaultValue(false);
+  table.addInt("aggregators_per_node", "Number of ranks per node that write shared GLVis output files");
+}
+
+void defineRebalanceOptionsInputFileSchema(axom::inlet::Table& table)
+{
+  table.addInt("every_n_steps", "Check the load balance every this many timesteps").defaultValue(10);
+  table.addDouble("imbalance_threshold", "Repartition when the maximum per-rank work exceeds the average by this much")
+      .defaultValue(1.2);
+}
+
+void defineAdaptivityOptionsInputFileSchema(axom::inlet::Table& table)
+{
+  table.addInt("every_n_steps", "Adapt the mesh every this many timesteps").defaultValue(1);
+  table.addDouble("refine_fraction", "Refine elements with error above this fraction of the maximum").defaultValue(0.7);
+  table.addDouble("derefine_fraction", "Coarsen elements with error below this fraction of the refinement threshold")
+      .defaultValue(0.1);
+  table.addInt("max_elements", "Stop refining once the mesh has this many elements").defaultValue(1000000);
+  table.addInt("nc_limit", "Maximum level of hanging nodes on nonconforming meshes, 0 for unlimited").defaultValue(3);
+}
+
+void defineSweepOptionsInputFileSchema(axom::inlet::Table& table)
+{
+  table.addInt("concurrent_groups", "Number of groups of ranks that run cases at the same time").defaultValue(1);
+  table.addStringArray("scaled_bcs", "Names of the boundary conditions that each case's bc_scale multiplies");
+
+  auto& case_table = table.addStructArray("cases", "The parameters of each case");
+  case_table.addDouble("mu", "Shear modulus of the solid in this case");
+  case_table.addDouble("K", "Bulk modulus of the solid in this case");
+  case_table.addDouble("kappa", "Thermal conductivity in this case");
+  case_table.addDouble("bc_scale", "Factor applied to the boundary conditions named in scaled_bcs").defaultValue(1.0);
+}
+
 void BoundaryConditionInputOptions::defineInputFileSchema(axom::inlet::Table& table)
 {
   table.addIntArray("attrs", "Boundary attributes to which the BC should be applied");
@@ -95,10 +139,105 @@ bool CoefficientInputOptions::isVector() const
   return vector_function || vector_constant || (!vector_pw_const.empty());
 }
 
+namespace {
+
+/**
+ * @brief A coefficient multiplied by a factor that may change after it is constructed
+ */
+class ScaledCoefficient : public mfem::Coefficient {
+public:
+  /**
+   * @brief Constructs the scaled coefficient
+   *
+   * @param[in] coef The coefficient to scale
+   * @param[in] factor The factor, which is read at every evaluation
+   */
+  ScaledCoefficient(std::unique_ptr<mfem::Coefficient>&& coef, std::shared_ptr<const double> factor)
+      : coef_(std::move(coef)), factor_(std::move(factor))
+  {
+  }
+
+  /**
+   * @brief Evaluates the scaled coefficient
+   *
+   * @param[in] T The element transformation
+   * @param[in] ip The integration point
+   * @return The factor times the coefficient
+   */
+  double Eval(mfem::ElementTransformation& T, const mfem::IntegrationPoint& ip) override
+  {
+    coef_->SetTime(GetTime());
+    return *factor_ * coef_->Eval(T, ip);
+  }
+
+private:
+  /**
+   * @brief The coefficient being scaled
+   */
+  std::unique_ptr<mfem::Coefficient> coef_;
+
+  /**
+   * @brief The factor
+   */
+  std::shared_ptr<const double> factor_;
+};
+
+/**
+ * @brief A vector coefficient multiplied by a factor that may change after it is constructed
+ */
+class ScaledVectorCoefficient : public mfem::VectorCoefficient {
+public:
+  /**
+   * @brief Constructs the scaled vector coefficient
+   *
+   * @param[in] coef The vector coefficient to scale
+   * @param[in] factor The factor, which is read at every evaluation
+   */
+  ScaledVectorCoefficient(std::unique_ptr<mfem::VectorCoefficient>&& coef, std::shared_ptr<const double> factor)
+      : mfem::VectorCoefficient(coef->GetVDim()), coef_(std::move(coef)), factor_(std::move(factor))
+  {
+  }
+
+  using mfem::VectorCoefficient::Eval;
+
+  /**
+   * @brief Evaluates the scaled vector coefficient
+   *
+   * @param[out] V The factor times the vector coefficient
+   * @param[in] T The element transformation
+   * @param[in] ip The integration point
+   */
+  void Eval(mfem::Vector& V, mfem::ElementTransformation& T, const mfem::IntegrationPoint& ip) override
+  {
+    coef_->SetTime(GetTime());
+    coef_->Eval(V, T, ip);
+    V *= *factor_;
+  }
+
+private:
+  /**
+   * @brief The vector coefficient being scaled
+   */
+  std::unique_ptr<mfem::VectorCoefficient> coef_;
+
+  /**
+   * @brief The factor
+   */
+  std::shared_ptr<const double> factor_;
+};
+
+}  // namespace
+
 std::unique_ptr<mfem::VectorCoefficient> CoefficientInputOptions::constructVector(const int dim) const
 {
   SLIC_ERROR_IF(!isVector(), "Cannot construct a vector coefficient from scalar input");
 
+  if (factor) {
+    auto unscaled = *this;
+    unscaled.factor.reset();
+    return std::make_unique<ScaledVectorCoefficient>(unscaled.constructVector(dim), factor);
+  }
+
   if (vector_function) {
     return std::make_unique<mfem::VectorFunctionCoefficient>(dim, vector_function);
   } else if (vector_constant) {
@@ -139,6 +278,12 @@ std::unique_ptr<mfem::Coefficient> CoefficientInputOptions::constructScalar() co
 {
   SLIC_ERROR_IF(isVector(), "Cannot construct a scalar coefficient from vector input");
 
+  if (factor) {
+    auto unscaled = *this;
+    unscaled.factor.reset();
+    return std::make_unique<ScaledCoefficient>(unscaled.constructScalar(), factor);
+  }
+
   if (scalar_function) {
     return std::make_unique<mfem::FunctionCoefficient>(scalar_function);
   } else if (scalar_constant) {
@@ -228,6 +373,127 @@ serac::OutputType FromInlet<serac::OutputType>::operator()(const axom::inlet::Ta
   return output_names.at(output_type);
 }
 
+serac::OutputOptions FromInlet<serac::OutputOptions>::operator()(const axom::inlet::Table& base)
+{
+  serac::OutputOptions options;
+  options.async       = base["async"];
+  options.max_pending = base["max_pending"];
+
+  options.every_n_steps = base["every_n_steps"];
+  if (options.every_n_steps < 1) {
+    SLIC_ERROR(fmt::format("Output every_n_steps must be at least 1, got {0}", options.every_n_steps));
+  }
+  if (base.contains("every_dt")) {
+    options.every_dt = base["every_dt"];
+    if (*options.every_dt <= 0.0) {
+      SLIC_ERROR(fmt::format("Output every_dt must be positive, got {0}", *options.every_dt));
+    }
+  }
+  if (base.contains("fields")) {
+    // Inlet stores arrays as index-value maps, so sort by index to preserve the given order
+    auto                                     field_map = base["fields"].get<std::unordered_map<int, std::string>>();
+    std::vector<std::pair<int, std::string>> sorted_fields(field_map.begin(), field_map.end());
+    std::sort(sorted_fields.begin(), sorted_fields.end());
+    for (auto& [_, name] : sorted_fields) {
+      options.fields.push_back(name);
+    }
+  }
+  if (base.contains("levels_of_detail")) {
+    options.levels_of_detail = base["levels_of_detail"];
+  }
+  options.float32 = base["float32"];
+  if (base.contains("aggregators_per_node")) {
+    options.aggregators_per_node = base["aggregators_per_node"];
+    if (*options.aggregators_per_node < 1) {
+      SLIC_ERROR(
+          fmt::format("Output aggregators_per_node must be at least 1, got {0}", *options.aggregators_per_node));
+    }
+  }
+  return options;
+}
+
+serac::RebalanceOptions FromInlet<serac::RebalanceOptions>::operator()(const axom::inlet::Table& base)
+{
+  serac::RebalanceOptions options;
+  options.every_n_steps = base["every_n_steps"];
+  if (options.every_n_steps < 1) {
+    SLIC_ERROR(fmt::format("Rebalance every_n_steps must be at least 1, got {0}", options.every_n_steps));
+  }
+  options.imbalance_threshold = base["imbalance_threshold"];
+  if (options.imbalance_threshold < 1.0) {
+    SLIC_ERROR(fmt::format("Rebalance imbalance_threshold must be at least 1, got {0}", options.imbalance_threshold));
+  }
+  return options;
+}
+
+serac::AdaptivityOptions FromInlet<serac::AdaptivityOptions>::operator()(const axom::inlet::Table& base)
+{
+  serac::AdaptivityOptions options;
+  options.every_n_steps = base["every_n_steps"];
+  if (options.every_n_steps < 1) {
+    SLIC_ERROR(fmt::format("Adaptivity every_n_steps must be at least 1, got {0}", options.every_n_steps));
+  }
+  options.refine_fraction = base["refine_fraction"];
+  if ((options.refine_fraction <= 0.0) || (options.refine_fraction > 1.0)) {
+    SLIC_ERROR(fmt::format("Adaptivity refine_fraction must be in (0, 1], got {0}", options.refine_fraction));
+  }
+  options.derefine_fraction = base["derefine_fraction"];
+  if ((options.derefine_fraction < 0.0) || (options.derefine_fraction >= 1.0)) {
+    SLIC_ERROR(fmt::format("Adaptivity derefine_fraction must be in [0, 1), got {0}", options.derefine_fraction));
+  }
+  options.max_elements = base["max_elements"];
+  options.nc_limit     = base["nc_limit"];
+  if (options.nc_limit < 0) {
+    SLIC_ERROR(fmt::format("Adaptivity nc_limit must be non-negative, got {0}", options.nc_limit));
+  }
+  return options;
+}
+
+serac::SweepCase FromInlet<serac::SweepCase>::operator()(const axom::inlet::Table& base)
+{
+  serac::SweepCase sweep_case;
+  if (base.contains("mu")) {
+    sweep_case.mu = base["mu"];
+  }
+  if (base.contains("K")) {
+    sweep_case.K = base["K"];
+  }
+  if (base.contains("kappa")) {
+    sweep_case.kappa = base["kappa"];
+  }
+  sweep_case.bc_scale = base["bc_scale"];
+  return sweep_case;
+}
+
+serac::SweepOptions FromInlet<serac::SweepOptions>::operator()(const axom::inlet::Table& base)
+{
+  serac::SweepOptions options;
+  options.concurrent_groups = base["concurrent_groups"];
+  if (options.concurrent_groups < 1) {
+    SLIC_ERROR(fmt::format("Sweep concurrent_groups must be at least 1, got {0}", options.concurrent_groups));
+  }
+
+  // Inlet stores arrays as index-value maps, so sort by index to preserve the given order
+  if (base.contains("scaled_bcs")) {
+    auto                                     bc_map = base["scaled_bcs"].get<std::unordered_map<int, std::string>>();
+    std::vector<std::pair<int, std::string>> sorted_bcs(bc_map.begin(), bc_map.end());
+    std::sort(sorted_bcs.begin(), sorted_bcs.end());
+    for (auto& [_, name] : sorted_bcs) {
+      options.scaled_bcs.push_back(name);
+    }
+  }
+  if (base.contains("cases")) {
+    auto case_map = base["cases"].get<std::unordered_map<int, serac::SweepCase>>();
+    std::vector<std::pair<int, serac::SweepCase>> sorted_cases(case_map.begin(), case_map.end());
+    std::sort(sorted_cases.begin(), sorted_cases.end(),
+              [](const auto& a, const auto& b) { return a.first < b.first; });
+    for (auto& [_, sweep_case] : sorted_cases) {
+      options.cases.push_back(sweep_case);
+    }
+  }
+  return options;
+}
+
 serac::input::BoundaryConditionInputOptions FromInlet<serac::input::BoundaryConditionInputOptions>::operator()(
     const axom::inlet::Table& base)
 {
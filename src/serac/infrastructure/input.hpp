@@ -12,6 +12,7 @@
 
 #pragma once
 
+#include <memory>
 #include <string>
 #include <variant>
 
@@ -60,6 +61,30 @@ void defineVectorInputFileSchema(axom::inlet::Table& table);
  */
 void defineOutputTypeInputFileSchema(axom::inlet::Table& table);
 
+/**
+ * @brief Defines the schema for serac::OutputOptions
+ * @param[inout] table The base table on which to define the schema
+ */
+void defineOutputOptionsInputFileSchema(axom::inlet::Table& table);
+
+/**
+ * @brief Defines the schema for serac::RebalanceOptions
+ * @param[inout] table The base table on which to define the schema
+ */
+void defineRebalanceOptionsInputFileSchema(axom::inlet::Table& table);
+
+/**
+ * @brief Defines the schema for serac::AdaptivityOptions
+ * @param[inout] table The base table on which to define the schema
+ */
+void defineAdaptivityOptionsInputFileSchema(axom::inlet::Table& table);
+
+/**
+ * @brief Defines the schema for serac::SweepOptions
+ * @param[inout] table The base table on which to define the schema
+ */
+void defineSweepOptionsInputFileSchema(axom::inlet::Table& table);
+
 /**
  * @brief The information required from the input file for an mfem::(Vector)(Function)Coefficient
  */
@@ -88,6 +113,12 @@ struct CoefficientInputOptions {
    * @brief The component to which a scalar coefficient should be applied
    */
   std::optional<int> component;
+
+  /**
+   * @brief A factor that multiplies the constructed coefficients when they are evaluated, so they
+   * follow changes to its value, e.g., between the cases of a parameter sweep
+   */
+  std::shared_ptr<const double> factor;
   /**
    * @brief Returns whether the contained function corresponds to a vector coefficient
    */
@@ -137,6 +168,11 @@ struct FromInlet<mfem::Vector> {
 // Forward declaration
 namespace serac {
 enum class OutputType;
+struct OutputOptions;
+struct RebalanceOptions;
+struct AdaptivityOptions;
+struct SweepCase;
+struct SweepOptions;
 }  // namespace serac
 
 template <>
@@ -144,6 +180,31 @@ struct FromInlet<serac::OutputType> {
   serac::OutputType operator()(const axom::inlet::Table& base);
 };
 
+template <>
+struct FromInlet<serac::OutputOptions> {
+  serac::OutputOptions operator()(const axom::inlet::Table& base);
+};
+
+template <>
+struct FromInlet<serac::RebalanceOptions> {
+  serac::RebalanceOptions operator()(const axom::inlet::Table& base);
+};
+
+template <>
+struct FromInlet<serac::AdaptivityOptions> {
+  serac::AdaptivityOptions operator()(const axom::inlet::Table& base);
+};
+
+template <>
+struct FromInlet<serac::SweepCase> {
+  serac::SweepCase operator()(const axom::inlet::Table& base);
+};
+
+template <>
+struct FromInlet<serac::SweepOptions> {
+  serac::SweepOptions operator()(const axom::inlet::Table& base);
+};
+
 template <>
 struct FromInlet<serac::input::CoefficientInputOptions> {
   serac::input::CoefficientInputOptions operator()(const axom::inlet::Table& base);
@@ -23,15 +23,22 @@ std::optional<cali::ConfigManager> mgr;
 void initializeCaliper(const std::string& options)
 {
 #ifdef SERAC_USE_CALIPER
-  mgr               = cali::ConfigManager();
-  auto check_result = mgr->check(options.c_str());
-  if (check_result.empty()) {
-    mgr->add(options.c_str());
-  } else {
-    SLIC_WARNING("Caliper options invalid, ignoring: " << check_result);
+  // A program that configures Caliper itself, e.g., the serac driver, replaces the configuration started by
+  // serac::initialize, which must not keep collecting alongside it
+  if (mgr) {
+    mgr->stop();
+  }
+  mgr = cali::ConfigManager();
+  if (!options.empty()) {
+    auto check_result = mgr->check(options.c_str());
+    if (check_result.empty()) {
+      mgr->add(options.c_str());
+    } else {
+      SLIC_WARNING("Caliper options invalid, ignoring: " << check_result);
+    }
   }
-  // Defaults, should probably always be enabled
-  mgr->add("event-trace, runtime-report");
+  // The runtime report is cheap enough to always be enabled, tracing every event is opt-in
+  mgr->add("runtime-report");
   mgr->start();
 #else
   // Silence warning
@@ -12,6 +12,7 @@
 
 #pragma once
 
+#include <chrono>
 #include <string>
 
 #include "serac/serac_config.hpp"
@@ -26,6 +27,21 @@
  * Marks a function for Caliper profiling
  */
 
+/**
+ * @def SERAC_MARK_SCOPE(name)
+ * Marks the rest of the enclosing scope as a named region for Caliper profiling
+ */
+
+/**
+ * @def SERAC_MARK_BEGIN(name)
+ * Marks the beginning of a named region for Caliper profiling
+ */
+
+/**
+ * @def SERAC_MARK_END(name)
+ * Marks the end of a named region for Caliper profiling
+ */
+
 /**
  * @def SERAC_MARK_LOOP_START(id, name)
  * Marks the beginning of a loop block for Caliper profiling
@@ -44,6 +60,9 @@
 #ifdef SERAC_USE_CALIPER
 
 #define SERAC_MARK_FUNCTION CALI_CXX_MARK_FUNCTION
+#define SERAC_MARK_SCOPE(name) CALI_CXX_MARK_SCOPE(name)
+#define SERAC_MARK_BEGIN(name) CALI_MARK_BEGIN(name)
+#define SERAC_MARK_END(name) CALI_MARK_END(name)
 #define SERAC_MARK_LOOP_START(id, name) CALI_CXX_MARK_LOOP_BEGIN(id, name)
 #define SERAC_MARK_LOOP_ITER(id, i) CALI_CXX_MARK_LOOP_ITERATION(id, i)
 #define SERAC_MARK_LOOP_END(id) CALI_CXX_MARK_LOOP_END(id)
@@ -52,6 +71,9 @@
 
 // Define all these as nothing so annotated code will still compile
 #define SERAC_MARK_FUNCTION
+#define SERAC_MARK_SCOPE(name)
+#define SERAC_MARK_BEGIN(name)
+#define SERAC_MARK_END(name)
 #define SERAC_MARK_LOOP_START(id, name)
 #define SERAC_MARK_LOOP_ITER(id, i)
 #define SERAC_MARK_LOOP_END(id)
@@ -61,7 +83,9 @@
 namespace serac::profiling {
 /**
  * @brief Initializes performance monitoring using the Caliper library
- * @param options The Caliper ConfigManager config string, optional
+ *
+ * A runtime report is always collected. Calling this again replaces the previous configuration.
+ * @param options The Caliper ConfigManager config string of any additional data to collect, optional
  * @see https://software.llnl.gov/Caliper/ConfigManagerAPI.html#configmanager-configuration-string-syntax
  */
 void initializeCaliper(const std::string& options = "");
@@ -71,4 +95,40 @@ void initializeCaliper(const std::string& options = "");
  */
 void terminateCaliper();
 
+/**
+ * @brief Adds the wall time spent in its scope to a running total
+ */
+class ScopedTimer {
+public:
+  /**
+   * @brief Starts the timer
+   * @param[inout] total_seconds The total to add the elapsed time to
+   */
+  explicit ScopedTimer(double& total_seconds) : total_seconds_(total_seconds), start_(std::chrono::steady_clock::now())
+  {
+  }
+
+  ScopedTimer(const ScopedTimer&) = delete;
+  ScopedTimer& operator=(const ScopedTimer&) = delete;
+
+  /**
+   * @brief Adds the elapsed time to the total
+   */
+  ~ScopedTimer()
+  {
+    total_seconds_ += std::chrono::duration<double>(std::chrono::steady_clock::now() - start_).count();
+  }
+
+private:
+  /**
+   * @brief The running total, in seconds
+   */
+  double& total_seconds_;
+
+  /**
+   * @brief When the timer was started
+   */
+  std::chrono::steady_clock::time_point start_;
+};
+
 }  // namespace serac::profiling
@@ -8,7 +8,10 @@
 
 #include <csignal>
 #include <cstdlib>
+#include <exception>
 #include <iostream>
+#include <map>
+#include <mutex>
 
 #include "serac/infrastructure/accelerator.hpp"
 #include "serac/infrastructure/logger.hpp"
@@ -25,6 +28,22 @@ void signalHandler(int signal)
   serac::exitGracefully(true);
 }
 
+/**
+ * The callbacks registered with registerCleanup, keyed by their handle
+ * A map is used so that iterating in reverse runs them in the reverse order of registration
+ */
+std::map<int, std::function<void()>>& cleanupCallbacks()
+{
+  static std::map<int, std::function<void()>> callbacks;
+  return callbacks;
+}
+
+std::mutex& cleanupMutex()
+{
+  static std::mutex mutex;
+  return mutex;
+}
+
 }  // namespace
 
 namespace serac {
@@ -39,10 +58,42 @@ void registerSignals()
   std::signal(SIGTERM, signalHandler);
 }
 
+int registerCleanup(std::function<void()> callback)
+{
+  static int next_id = 0;
+
+  std::lock_guard<std::mutex> lock(cleanupMutex());
+  cleanupCallbacks().emplace(next_id, std::move(callback));
+  return next_id++;
+}
+
+void deregisterCleanup(const int id)
+{
+  std::lock_guard<std::mutex> lock(cleanupMutex());
+  cleanupCallbacks().erase(id);
+}
+
 }  // namespace terminator
 
 void exitGracefully(bool error)
 {
+  // Take ownership of the callbacks so that each one runs at most once, even if
+  // a callback itself ends up back here
+  std::map<int, std::function<void()>> callbacks;
+  {
+    std::lock_guard<std::mutex> lock(cleanupMutex());
+    callbacks.swap(cleanupCallbacks());
+  }
+  for (auto iter = callbacks.rbegin(); iter != callbacks.rend(); ++iter) {
+    try {
+      iter->second();
+    } catch (const std::exception& e) {
+      std::cerr << "[EXIT]: Cleanup failed: " << e.what() << std::endl;
+    } catch (...) {
+      std::cerr << "[EXIT]: Cleanup failed with an unknown exception" << std::endl;
+    }
+  }
+
   if (axom::slic::isInitialized()) {
     serac::logger::flush();
     serac::logger::finalize();
@@ -6,6 +6,8 @@
 
 #pragma once
 
+#include <functional>
+
 namespace serac {
 
 namespace terminator {
@@ -22,13 +24,31 @@ namespace terminator {
  */
 void registerSignals();
 
+/**
+ * @brief Registers a callback to be run by exitGracefully before logging and MPI are finalized
+ *
+ * This is used to flush work that is still in flight, e.g. buffered output, when the program
+ * exits without unwinding the stack. Callbacks are run in the reverse order of registration.
+ *
+ * @param[in] callback The function to call on exit
+ * @return A handle that can be passed to deregisterCleanup
+ */
+int registerCleanup(std::function<void()> callback);
+
+/**
+ * @brief Removes a callback registered with registerCleanup
+ *
+ * @param[in] id The handle returned by registerCleanup
+ */
+void deregisterCleanup(const int id);
+
 }  // namespace terminator
 
 /**
  * @brief Exits the program gracefully after cleaning up necessary tasks.
  *
- * This performs finalization work needed by the program such as finalizing MPI
- * and flushing and closing the SLIC logger.
+ * This performs finalization work needed by the program such as running registered
+ * cleanup callbacks, finalizing MPI, and flushing and closing the SLIC logger.
  *
  * @param[in] error True if the program should return an error code
  */
@@ -0,0 +1,149 @@
+// Copyright (c) 2019-2021, Lawrence Livermore National Security, LLC and
+// other Serac Project Developers. See the top-level LICENSE file for
+// details.
+//
+// SPDX-License-Identifier: (BSD-3-Clause)
+
+#include "serac/integrators/incompressibility_integrator.hpp"
+
+#include "serac/infrastructure/profiling.hpp"
+
+namespace serac::mfem_ext {
+
+double IncompressibilityIntegrator::evalKinematics(const mfem::FiniteElement& el, mfem::ElementTransformation& Tr,
+                                                   const mfem::IntegrationPoint& ip)
+{
+  Tr.SetIntPoint(&ip);
+  CalcInverse(Tr.Jacobian(), Jrt_);
+
+  el.CalcDShape(ip, DSh_);
+  Mult(DSh_, Jrt_, DS_);
+  MultAtB(PMatI_, DS_, F_);
+
+  for (int d = 0; d < F_.Height(); d++) {
+    F_(d, d) += 1.0;
+  }
+
+  CalcInverse(F_, Finv_);
+  Mult(DS_, Finv_, B_);
+  return F_.Det();
+}
+
+void IncompressibilityIntegrator::AssembleElementVector(const mfem::Array<const mfem::FiniteElement*>& el,
+                                                        mfem::ElementTransformation&                   Tr,
+                                                        const mfem::Array<const mfem::Vector*>&        elfun,
+                                                        const mfem::Array<mfem::Vector*>&              elvec)
+{
+  const auto& el_u  = *el[0];
+  const auto& el_p  = *el[1];
+  int         dof_u = el_u.GetDof(), dof_p = el_p.GetDof(), dim = el_u.GetDim();
+
+  DSh_.SetSize(dof_u, dim);
+  DS_.SetSize(dof_u, dim);
+  B_.SetSize(dof_u, dim);
+  Jrt_.SetSize(dim);
+  F_.SetSize(dim);
+  Finv_.SetSize(dim);
+  shape_p_.SetSize(dof_p);
+  PMatI_.UseExternalData(elfun[0]->GetData(), dof_u, dim);
+  elvec[0]->SetSize(dof_u * dim);
+  elvec[1]->SetSize(dof_p);
+  PMatO_.UseExternalData(elvec[0]->GetData(), dof_u, dim);
+
+  const mfem::IntegrationRule* ir = IntRule;
+  if (!ir) {
+    ir = &(mfem::IntRules.Get(el_u.GetGeomType(), 2 * el_u.GetOrder() + 3));
+  }
+
+  *elvec[0] = 0.0;
+  *elvec[1] = 0.0;
+  for (int i = 0; i < ir->GetNPoints(); i++) {
+    const mfem::IntegrationPoint& ip = ir->IntPoint(i);
+    const double                  J  = evalKinematics(el_u, Tr, ip);
+    el_p.CalcShape(ip, shape_p_);
+
+    const double p = shape_p_ * (*elfun[1]);
+    const double w = ip.weight * Tr.Weight();
+
+    // The pressure stress p J F^-T tested with the displacement gradients
+    PMatO_.Add(w * p * J, B_);
+
+    // The weak constraint J - 1 = p / K tested with the pressure
+    elvec[1]->Add(w * (J - 1.0 - p * inv_bulk_modulus_), shape_p_);
+  }
+}
+
+void IncompressibilityIntegrator::AssembleElementGrad(const mfem::Array<const mfem::FiniteElement*>& el,
+                                                      mfem::ElementTransformation&                   Tr,
+                                                      const mfem::Array<const mfem::Vector*>&        elfun,
+                                                      const mfem::Array2D<mfem::DenseMatrix*>&       elmats)
+{
+  SERAC_MARK_FUNCTION;
+
+  const auto& el_u  = *el[0];
+  const auto& el_p  = *el[1];
+  int         dof_u = el_u.GetDof(), dof_p = el_p.GetDof(), dim = el_u.GetDim();
+
+  DSh_.SetSize(dof_u, dim);
+  DS_.SetSize(dof_u, dim);
+  B_.SetSize(dof_u, dim);
+  Jrt_.SetSize(dim);
+  F_.SetSize(dim);
+  Finv_.SetSize(dim);
+  shape_p_.SetSize(dof_p);
+  PMatI_.UseExternalData(elfun[0]->GetData(), dof_u, dim);
+
+  auto& K_uu = *elmats(0, 0);
+  auto& K_up = *elmats(0, 1);
+  auto& K_pu = *elmats(1, 0);
+  auto& K_pp = *elmats(1, 1);
+  K_uu.SetSize(dof_u * dim);
+  K_up.SetSize(dof_u * dim, dof_p);
+  K_pu.SetSize(dof_p, dof_u * dim);
+  K_pp.SetSize(dof_p);
+  K_uu = 0.0;
+  K_up = 0.0;
+  K_pu = 0.0;
+  K_pp = 0.0;
+
+  const mfem::IntegrationRule* ir = IntRule;
+  if (!ir) {
+    ir = &(mfem::IntRules.Get(el_u.GetGeomType(), 2 * el_u.GetOrder() + 3));
+  }
+
+  for (int q = 0; q < ir->GetNPoints(); q++) {
+    const mfem::IntegrationPoint& ip = ir->IntPoint(q);
+    const double                  J  = evalKinematics(el_u, Tr, ip);
+    el_p.CalcShape(ip, shape_p_);
+
+    const double p = shape_p_ * (*elfun[1]);
+    const double w = ip.weight * Tr.Weight();
+
+    // The variation of p J F^-T in the direction of a displacement gradient
+    // is p J ((F^-T : dF) F^-T - F^-T dF^T F^-T)
+    for (int i = 0; i < dim; i++) {
+      for (int a = 0; a < dof_u; a++) {
+        for (int j = 0; j < dim; j++) {
+          for (int b = 0; b < dof_u; b++) {
+            K_uu(i * dof_u + a, j * dof_u + b) += w * p * J * (B_(a, i) * B_(b, j) - B_(a, j) * B_(b, i));
+          }
+        }
+      }
+    }
+
+    // The coupling blocks are transposes of each other
+    for (int j = 0; j < dim; j++) {
+      for (int b = 0; b < dof_u; b++) {
+        for (int c = 0; c < dof_p; c++) {
+          const double coupling = w * J * shape_p_(c) * B_(b, j);
+          K_pu(c, j * dof_u + b) += coupling;
+          K_up(j * dof_u + b, c) += coupling;
+        }
+      }
+    }
+
+    AddMult_a_VVt(-w * inv_bulk_modulus_, shape_p_, K_pp);
+  }
+}
+
+}  // namespace serac::mfem_ext
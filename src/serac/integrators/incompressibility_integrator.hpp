@@ -0,0 +1,94 @@
+// Copyright (c) 2019-2021, Lawrence Livermore National Security, LLC and
+// other Serac Project Developers. See the top-level LICENSE file for
+// details.
+//
+// SPDX-License-Identifier: (BSD-3-Clause)
+
+/**
+ * @file incompressibility_integrator.hpp
+ *
+ * @brief The MFEM integrator for the pressure terms of the mixed displacement-pressure formulation
+ */
+
+#pragma once
+
+#include "mfem.hpp"
+
+namespace serac::mfem_ext {
+
+/**
+ * @brief Incremental integrator of the volumetric terms of a perturbed Lagrangian u-p formulation
+ *
+ * Represents @f$ \int p (J - 1) - \frac{p^2}{2 K} dx @f$ over a zone, where J is the determinant of
+ * the deformation gradient of the displacement u and K is the bulk modulus. Its first variation adds
+ * the pressure stress @f$ p J F^{-T} @f$ to the displacement residual and enforces
+ * @f$ J - 1 = p / K @f$ weakly. Together with a purely deviatoric hyperelastic model for the
+ * displacement block, the Jacobian is a symmetric saddle point system that does not lock as K grows.
+ * The first block is the displacement, with the mesh in the reference configuration, and the second
+ * block is the pressure.
+ */
+class IncompressibilityIntegrator : public mfem::BlockNonlinearFormIntegrator {
+public:
+  /**
+   * @brief The constructor for the incompressibility integrator
+   *
+   * @param[in] bulk_modulus The bulk modulus K, which may be infinite for an incompressible material
+   */
+  explicit IncompressibilityIntegrator(const double bulk_modulus) : inv_bulk_modulus_(1.0 / bulk_modulus) {}
+
+  /**
+   * @brief The residual evaluation for the displacement and pressure blocks
+   *
+   * @param[in] el The finite elements of the displacement and the pressure
+   * @param[in] Tr The element transformation operators
+   * @param[in] elfun The displacement and pressure of the zone
+   * @param[out] elvec The output residuals
+   */
+  void AssembleElementVector(const mfem::Array<const mfem::FiniteElement*>& el, mfem::ElementTransformation& Tr,
+                             const mfem::Array<const mfem::Vector*>& elfun,
+                             const mfem::Array<mfem::Vector*>&       elvec) override;
+
+  /**
+   * @brief Assemble the local gradient blocks
+   *
+   * @param[in] el The finite elements of the displacement and the pressure
+   * @param[in] Tr The element transformation operators
+   * @param[in] elfun The displacement and pressure of the zone
+   * @param[out] elmats The output local gradient blocks
+   */
+  void AssembleElementGrad(const mfem::Array<const mfem::FiniteElement*>& el, mfem::ElementTransformation& Tr,
+                           const mfem::Array<const mfem::Vector*>&  elfun,
+                           const mfem::Array2D<mfem::DenseMatrix*>& elmats) override;
+
+private:
+  /**
+   * @brief Evaluates the kinematics of the displacement at an integration point
+   *
+   * @return The determinant of the deformation gradient
+   */
+  double evalKinematics(const mfem::FiniteElement& el, mfem::ElementTransformation& Tr,
+                        const mfem::IntegrationPoint& ip);
+
+  /**
+   * @brief The inverse of the bulk modulus
+   */
+  double inv_bulk_modulus_;
+
+  /**
+   * DSh: gradients of reference shape functions (dof x dim).
+   * DS: gradients of the shape functions in the reference configuration (dof x dim).
+   * Jrt: the inverse of the Jacobian of the reference-element transformation.
+   * F: the deformation gradient, and Finv its inverse.
+   * B: gradients of the shape functions in the deformed configuration, DS F^-1 (dof x dim).
+   * PMatI: the displacement of the zone (dof x dim).
+   * PMatO: reshaped view into the displacement residual (dof x dim).
+   */
+  mfem::DenseMatrix DSh_, DS_, Jrt_, F_, Finv_, B_, PMatI_, PMatO_;
+
+  /**
+   * @brief The pressure shape functions
+   */
+  mfem::Vector shape_p_;
+};
+
+}  // namespace serac::mfem_ext
@@ -6,18 +6,23 @@
 
 #include "serac/numerics/mesh_utils.hpp"
 
+#include <cstdint>
 #include <fstream>
+#include <limits>
+#include <unordered_map>
 
 #include "axom/core.hpp"
 #include "fmt/fmt.hpp"
 
 #include "serac/infrastructure/logger.hpp"
 #include "serac/infrastructure/terminator.hpp"
+#include "serac/numerics/structured_mesh.hpp"
 
 namespace serac {
 
 std::shared_ptr<mfem::ParMesh> buildMeshFromFile(const std::string& mesh_file, const int refine_serial,
-                                                 const int refine_parallel, const MPI_Comm comm)
+                                                 const int refine_parallel, const MPI_Comm comm,
+                                                 const mesh::PartitionOptions& partition)
 {
   // Get the MPI rank for logging purposes
   int rank = 0;
@@ -52,7 +57,172 @@ std::shared_ptr<mfem::ParMesh> buildMeshFromFile(const std::string& mesh_file, c
   }
 
   // create the parallel mesh
-  auto par_mesh = std::make_shared<mfem::ParMesh>(comm, *mesh);
+  auto par_mesh = distributeMesh(*mesh, partition, comm);
+  for (int lev = 0; lev < refine_parallel; lev++) {
+    par_mesh->UniformRefinement();
+  }
+
+  return par_mesh;
+}
+
+namespace {
+
+/**
+ * @brief Computes the 64-bit FNV-1a hash of a file's contents
+ *
+ * @param[in] file_name The file to hash
+ * @return The hash value
+ */
+std::uint64_t hashFile(const std::string& file_name)
+{
+  constexpr std::uint64_t fnv_offset_basis = 14695981039346656037ull;
+  constexpr std::uint64_t fnv_prime        = 1099511628211ull;
+
+  std::uint64_t     hash = fnv_offset_basis;
+  std::ifstream     file(file_name, std::ios::binary);
+  std::vector<char> buffer(1 << 20);
+  while (file) {
+    file.read(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+    for (std::streamsize i = 0; i < file.gcount(); ++i) {
+      hash ^= static_cast<unsigned char>(buffer[static_cast<std::size_t>(i)]);
+      hash *= fnv_prime;
+    }
+  }
+  return hash;
+}
+
+}  // namespace
+
+std::shared_ptr<mfem::ParMesh> buildCachedMeshFromFile(const std::string& mesh_file, const std::string& cache_directory,
+                                                       const int refine_serial, const int refine_parallel,
+                                                       const MPI_Comm comm, const mesh::PartitionOptions& partition)
+{
+  using namespace axom::utilities;
+
+  int rank      = 0;
+  int num_ranks = 0;
+  MPI_Comm_rank(comm, &rank);
+  MPI_Comm_size(comm, &num_ranks);
+
+  if (partition.nonconforming) {
+    // MFEM's parallel mesh format does not support nonconforming meshes
+    SLIC_WARNING_ROOT(rank, "Nonconforming meshes cannot be cached, building the mesh without the cache.");
+    return buildMeshFromFile(mesh_file, refine_serial, refine_parallel, comm, partition);
+  }
+
+  // Only the root reads the whole file to compute the cache key
+  std::uint64_t hash = 0;
+  if ((rank == 0) && filesystem::pathExists(mesh_file)) {
+    hash = hashFile(mesh_file);
+  }
+  MPI_Bcast(&hash, 1, MPI_UINT64_T, 0, comm);
+
+  auto        separator  = mesh_file.find_last_of('/');
+  std::string mesh_name  = (separator == std::string::npos) ? mesh_file : mesh_file.substr(separator + 1);
+  std::string cache_key  = fmt::format("{0}.{1:016x}.s{2}.p{3}.n{4}.m{5}", mesh_name, hash, refine_serial,
+                                      refine_parallel, num_ranks, static_cast<int>(partition.method));
+  if (partition.method == mesh::PartitionMethod::WeightedMETIS) {
+    // The element costs, and so the partitioning, depend on the orders and the loaded faces
+    cache_key += fmt::format(".c{0}", partition.cost_order);
+    for (const auto& [attribute, order] : partition.attribute_cost_orders) {
+      cache_key += fmt::format(".a{0}o{1}", attribute, order);
+    }
+    for (auto attribute : partition.loaded_boundary_attributes) {
+      cache_key += fmt::format(".l{0}", attribute);
+    }
+  }
+  std::string cache_path = filesystem::joinPath(cache_directory, cache_key);
+
+  // The root decides so that all ranks take the same path
+  int cached = 0;
+  if (rank == 0) {
+    cached = filesystem::pathExists(filesystem::joinPath(cache_path, "partitions")) ? 1 : 0;
+  }
+  MPI_Bcast(&cached, 1, MPI_INT, 0, comm);
+
+  if (cached) {
+    SLIC_INFO_ROOT(rank, fmt::format("Loading cached mesh partitions from: {0}", cache_path));
+    // The partitions were refined before they were cached
+    return buildMeshFromPartitionedFiles(cache_path, 0, comm);
+  }
+
+  auto par_mesh = buildMeshFromFile(mesh_file, refine_serial, refine_parallel, comm, partition);
+
+  SLIC_INFO_ROOT(rank, fmt::format("Caching mesh partitions in: {0}", cache_path));
+  writePartitionedMesh(*par_mesh, cache_path);
+
+  return par_mesh;
+}
+
+void writePartitionedMesh(const mfem::ParMesh& mesh, const std::string& directory)
+{
+  using namespace axom::utilities;
+
+  MPI_Comm comm      = mesh.GetComm();
+  int      rank      = 0;
+  int      num_ranks = 0;
+  MPI_Comm_rank(comm, &rank);
+  MPI_Comm_size(comm, &num_ranks);
+
+  if (rank == 0) {
+    filesystem::makeDirsForPath(directory);
+  }
+  MPI_Barrier(comm);
+
+  {
+    mfem::ofgzstream omesh(filesystem::joinPath(directory, fmt::format("mesh.{0:0>6}", rank)), true);
+    omesh.precision(std::numeric_limits<double>::max_digits10);
+    mesh.ParPrint(omesh);
+  }
+
+  // The partition count doubles as a marker that the set of partitions is complete
+  MPI_Barrier(comm);
+  if (rank == 0) {
+    std::ofstream partitions(filesystem::joinPath(directory, "partitions"));
+    partitions << num_ranks << std::endl;
+  }
+  MPI_Barrier(comm);
+}
+
+std::shared_ptr<mfem::ParMesh> buildMeshFromPartitionedFiles(const std::string& directory, const int refine_parallel,
+                                                             const MPI_Comm comm)
+{
+  using namespace axom::utilities;
+
+  int rank      = 0;
+  int num_ranks = 0;
+  MPI_Comm_rank(comm, &rank);
+  MPI_Comm_size(comm, &num_ranks);
+
+  SLIC_INFO_ROOT(rank, fmt::format("Opening partitioned mesh: {0}", directory));
+
+  int num_partitions = -1;
+  if (rank == 0) {
+    std::ifstream partitions(filesystem::joinPath(directory, "partitions"));
+    if (partitions) {
+      partitions >> num_partitions;
+    }
+  }
+  MPI_Bcast(&num_partitions, 1, MPI_INT, 0, comm);
+
+  if (num_partitions < 0) {
+    serac::logger::flush();
+    SLIC_ERROR_ROOT(rank, fmt::format("Not a complete partitioned mesh: {0}", directory));
+  }
+  if (num_partitions != num_ranks) {
+    serac::logger::flush();
+    SLIC_ERROR_ROOT(rank, fmt::format("Partitioned mesh {0} has {1} partitions but is being loaded on {2} ranks",
+                                      directory, num_partitions, num_ranks));
+  }
+
+  std::string      rank_file = filesystem::joinPath(directory, fmt::format("mesh.{0:0>6}", rank));
+  mfem::ifgzstream imesh(rank_file);
+  if (!imesh) {
+    serac::logger::flush();
+    SLIC_ERROR(fmt::format("Can not open mesh partition: {0}", rank_file));
+  }
+
+  auto par_mesh = std::make_shared<mfem::ParMesh>(comm, imesh);
   for (int lev = 0; lev < refine_parallel; lev++) {
     par_mesh->UniformRefinement();
   }
@@ -85,7 +255,8 @@ void squish(mfem::Mesh& mesh)
   mesh.SetVertices(vertices);
 }
 
-std::shared_ptr<mfem::ParMesh> buildDiskMesh(int approx_number_of_elements, const MPI_Comm comm)
+std::shared_ptr<mfem::ParMesh> buildDiskMesh(int approx_number_of_elements, const MPI_Comm comm,
+                                             const mesh::PartitionOptions& partition)
 {
   static constexpr int dim                   = 2;
   static constexpr int num_elems             = 4;
@@ -115,10 +286,11 @@ std::shared_ptr<mfem::ParMesh> buildDiskMesh(int approx_number_of_elements, cons
 
   squish(mesh);
 
-  return std::make_shared<mfem::ParMesh>(comm, mesh);
+  return distributeMesh(mesh, partition, comm);
 }
 
-std::shared_ptr<mfem::ParMesh> buildBallMesh(int approx_number_of_elements, const MPI_Comm comm)
+std::shared_ptr<mfem::ParMesh> buildBallMesh(int approx_number_of_elements, const MPI_Comm comm,
+                                             const mesh::PartitionOptions& partition)
 {
   static constexpr int dim                   = 3;
   static constexpr int num_elems             = 8;
@@ -151,37 +323,49 @@ std::shared_ptr<mfem::ParMesh> buildBallMesh(int approx_number_of_elements, cons
 
   squish(mesh);
 
-  return std::make_shared<mfem::ParMesh>(comm, mesh);
+  return distributeMesh(mesh, partition, comm);
 }
 
 std::shared_ptr<mfem::ParMesh> buildRectangleMesh(int elements_in_x, int elements_in_y, double size_x, double size_y,
-                                                  const MPI_Comm comm)
+                                                  const MPI_Comm comm, const mesh::PartitionOptions& partition)
 {
   mfem::Mesh mesh(elements_in_x, elements_in_y, mfem::Element::QUADRILATERAL, true, size_x, size_y);
-  return std::make_shared<mfem::ParMesh>(comm, mesh);
+  return distributeMesh(mesh, partition, comm);
 }
 
-std::shared_ptr<mfem::ParMesh> buildRectangleMesh(serac::mesh::GenerateInputOptions& options, const MPI_Comm comm)
+std::shared_ptr<mfem::ParMesh> buildRectangleMesh(serac::mesh::GenerateInputOptions& options, const MPI_Comm comm,
+                                                  const mesh::PartitionOptions& partition)
 {
+  if (options.parallel) {
+    SLIC_ERROR_IF(partition.nonconforming, "Nonconforming meshes cannot be generated in parallel.");
+    return buildStructuredMesh(options.elements, options.overall_size, comm);
+  }
   return buildRectangleMesh(options.elements[0], options.elements[1], options.overall_size[0], options.overall_size[1],
-                            comm);
+                            comm, partition);
 }
 
 std::shared_ptr<mfem::ParMesh> buildCuboidMesh(int elements_in_x, int elements_in_y, int elements_in_z, double size_x,
-                                               double size_y, double size_z, const MPI_Comm comm)
+                                               double size_y, double size_z, const MPI_Comm comm,
+                                               const mesh::PartitionOptions& partition)
 {
   mfem::Mesh mesh(elements_in_x, elements_in_y, elements_in_z, mfem::Element::HEXAHEDRON, true, size_x, size_y, size_z);
-  return std::make_shared<mfem::ParMesh>(comm, mesh);
+  return distributeMesh(mesh, partition, comm);
 }
 
-std::shared_ptr<mfem::ParMesh> buildCuboidMesh(serac::mesh::GenerateInputOptions& options, const MPI_Comm comm)
+std::shared_ptr<mfem::ParMesh> buildCuboidMesh(serac::mesh::GenerateInputOptions& options, const MPI_Comm comm,
+                                               const mesh::PartitionOptions& partition)
 {
+  if (options.parallel) {
+    SLIC_ERROR_IF(partition.nonconforming, "Nonconforming meshes cannot be generated in parallel.");
+    return buildStructuredMesh(options.elements, options.overall_size, comm);
+  }
   return buildCuboidMesh(options.elements[0], options.elements[1], options.elements[2], options.overall_size[0],
-                         options.overall_size[1], options.overall_size[2], comm);
+                         options.overall_size[1], options.overall_size[2], comm, partition);
 }
 
 std::shared_ptr<mfem::ParMesh> buildCylinderMesh(int radial_refinement, int elements_lengthwise, double radius,
-                                                 double height, const MPI_Comm comm)
+                                                 double height, const MPI_Comm comm,
+                                                 const mesh::PartitionOptions& partition)
 {
   static constexpr int dim                   = 2;
   static constexpr int num_vertices          = 17;
@@ -264,14 +448,14 @@ std::shared_ptr<mfem::ParMesh> buildCylinderMesh(int radial_refinement, int elem
 
   std::unique_ptr<mfem::Mesh> extruded_mesh(mfem::Extrude2D(&mesh, elements_lengthwise, height));
 
-  auto extruded_pmesh = std::make_shared<mfem::ParMesh>(comm, *extruded_mesh);
+  auto extruded_pmesh = distributeMesh(*extruded_mesh, partition, comm);
 
   return extruded_pmesh;
 }
 
 std::shared_ptr<mfem::ParMesh> buildHollowCylinderMesh(int radial_refinement, int elements_lengthwise,
                                                        double inner_radius, double outer_radius, double height,
-                                                       const MPI_Comm comm)
+                                                       const MPI_Comm comm, const mesh::PartitionOptions& partition)
 {
   static constexpr int dim                   = 2;
   static constexpr int num_vertices          = 16;
@@ -352,7 +536,7 @@ std::shared_ptr<mfem::ParMesh> buildHollowCylinderMesh(int radial_refinement, in
 
   std::unique_ptr<mfem::Mesh> extruded_mesh(mfem::Extrude2D(&mesh, elements_lengthwise, height));
 
-  auto extruded_pmesh = std::make_shared<mfem::ParMesh>(comm, *extruded_mesh);
+  auto extruded_pmesh = distributeMesh(*extruded_mesh, partition, comm);
 
   return extruded_pmesh;
 }
@@ -368,7 +552,20 @@ void InputOptions::defineInputFileSchema(axom::inlet::Table& table)
   table.addString("type", "Type of mesh").required();
 
   // mesh path
-  table.addString("mesh", "Path to Mesh file");
+  table.addString("mesh", "Path to Mesh file, or the directory of a partitioned mesh");
+  table.addString("cache_directory", "Directory in which to cache the partitioned and refined mesh");
+
+  // partitioning of the serial mesh across ranks
+  auto& partition = table.addStruct("partition", "How the serial mesh is partitioned across ranks");
+  partition.addString("method", "Partitioning method: metis, weighted_metis, hilbert, or morton")
+      .defaultValue("metis")
+      .validValues({"metis", "weighted_metis", "hilbert", "morton"});
+  partition.addInt("cost_order", "Polynomial order at which element costs are measured for weighted_metis")
+      .defaultValue(1);
+  partition.addIntArray("attribute_cost_orders", "Element orders for weighted_metis, indexed by element attribute");
+  partition.addIntArray("loaded_boundary_attributes", "Boundary attributes whose faces add to weighted_metis costs");
+  partition.addBool("nonconforming", "Convert to a nonconforming mesh, which is required for dynamic rebalancing")
+      .defaultValue(false);
 
   // mesh generation options
   auto& elements = table.addStruct("elements");
@@ -377,6 +574,9 @@ void InputOptions::defineInputFileSchema(axom::inlet::Table& table)
   elements.addInt("y", "y-dimension");
   elements.addInt("z", "z-dimension");
 
+  table.addBool("parallel", "Generate each rank's block directly instead of distributing a serial mesh")
+      .defaultValue(false);
+
   auto& size = table.addStruct("size");
   // JW: Can these be specified as requierd if elements is defined?
   size.addDouble("x", "Size in the x-dimension");
@@ -392,6 +592,36 @@ serac::mesh::InputOptions FromInlet<serac::mesh::InputOptions>::operator()(const
   int ser_ref = base["ser_ref_levels"];
   int par_ref = base["par_ref_levels"];
 
+  serac::mesh::PartitionOptions partition;
+  if (base.contains("partition")) {
+    auto        partition_input = base["partition"];
+    std::string method          = partition_input["method"];
+    if (method == "weighted_metis") {
+      partition.method = serac::mesh::PartitionMethod::WeightedMETIS;
+    } else if (method == "hilbert") {
+      partition.method = serac::mesh::PartitionMethod::Hilbert;
+    } else if (method == "morton") {
+      partition.method = serac::mesh::PartitionMethod::Morton;
+    }
+    partition.cost_order    = partition_input["cost_order"];
+    partition.nonconforming = partition_input["nonconforming"];
+    SLIC_ERROR_IF(partition.cost_order < 1, "Partition cost order must be at least 1.");
+    if (partition_input.contains("attribute_cost_orders")) {
+      auto orders = partition_input["attribute_cost_orders"].get<std::unordered_map<int, int>>();
+      for (const auto& [attribute, order] : orders) {
+        SLIC_ERROR_IF(order < 1, "Partition cost orders must be at least 1.");
+        partition.attribute_cost_orders[attribute] = order;
+      }
+    }
+    if (partition_input.contains("loaded_boundary_attributes")) {
+      // Build a set with just the values of the map
+      for (const auto& [_, attribute] :
+           partition_input["loaded_boundary_attributes"].get<std::unordered_map<int, int>>()) {
+        partition.loaded_boundary_attributes.insert(attribute);
+      }
+    }
+  }
+
   // This is for cuboid/rectangular meshes
   std::string mesh_type = base["type"];
   if (mesh_type == "generate") {
@@ -409,16 +639,24 @@ serac::mesh::InputOptions FromInlet<serac::mesh::InputOptions>::operator()(const
       overall_size    = {size_input["x"], size_input["y"]};
 
       if (size_input.contains("z")) {
-        overall_size[2] = size_input["z"];
+        overall_size.push_back(size_input["z"].get<double>());
       }
     } else {
       overall_size = std::vector<double>(overall_size.size(), 1.);
     }
 
-    return {serac::mesh::GenerateInputOptions{elements, overall_size}, ser_ref, par_ref};
-  } else if (mesh_type == "file") {  // This is for file-based meshes
+    bool parallel = base["parallel"];
+    return {serac::mesh::GenerateInputOptions{elements, overall_size, parallel}, ser_ref, par_ref, partition};
+  } else if (mesh_type == "partitioned") {  // This is for meshes already split into per-rank files
     std::string mesh_path = base["mesh"];
-    return {serac::mesh::FileInputOptions{mesh_path}, ser_ref, par_ref};
+    return {serac::mesh::PartitionedInputOptions{mesh_path}, ser_ref, par_ref, partition};
+  } else if (mesh_type == "file") {  // This is for file-based meshes
+    std::string                   mesh_path = base["mesh"];
+    serac::mesh::FileInputOptions file_options{mesh_path};
+    if (base.contains("cache_directory")) {
+      file_options.cache_directory = base["cache_directory"].get<std::string>();
+    }
+    return {file_options, ser_ref, par_ref, partition};
   }
 
   // If it reaches here, we haven't found a supported type
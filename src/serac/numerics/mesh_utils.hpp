@@ -14,10 +14,12 @@
 #pragma once
 
 #include <memory>
+#include <optional>
 #include <variant>
 #include "mfem.hpp"
 
 #include "serac/infrastructure/input.hpp"
+#include "serac/numerics/partitioning.hpp"
 
 /**
  * The Serac namespace
@@ -34,10 +36,63 @@ namespace serac {
  * @param[in] refine_serial The number of serial refinements
  * @param[in] refine_parallel The number of parallel refinements
  * @param[in] MPI_Comm The MPI communicator
+ * @param[in] partition How to partition the serial mesh across ranks
  * @return A shared_ptr containing the constructed and refined parallel mesh object
  */
 std::shared_ptr<mfem::ParMesh> buildMeshFromFile(const std::string& mesh_file, const int refine_serial = 0,
-                                                 const int refine_parallel = 0, const MPI_Comm comm = MPI_COMM_WORLD);
+                                                 const int refine_parallel = 0, const MPI_Comm comm = MPI_COMM_WORLD,
+                                                 const mesh::PartitionOptions& partition = {});
+
+/**
+ * @brief Constructs an MFEM parallel mesh from a file, reusing a previously partitioned and refined copy if possible
+ *
+ * The first run with a given mesh file, refinement levels, and number of ranks builds the mesh
+ * with buildMeshFromFile and stores each rank's partition in the cache directory using MFEM's
+ * parallel mesh format. Later runs with the same key load their partitions directly, skipping
+ * parsing of the full mesh, the serial refinements, the partitioning, and the parallel refinements.
+ * The key includes a hash of the mesh file's contents, so editing the mesh invalidates the cache.
+ *
+ * @param[in] mesh_file The mesh file to open
+ * @param[in] cache_directory The directory in which cached partitions are stored
+ * @param[in] refine_serial The number of serial refinements
+ * @param[in] refine_parallel The number of parallel refinements
+ * @param[in] MPI_Comm The MPI communicator
+ * @param[in] partition How to partition the serial mesh across ranks when the cache is empty
+ * @return A shared_ptr containing the constructed and refined parallel mesh object
+ */
+std::shared_ptr<mfem::ParMesh> buildCachedMeshFromFile(const std::string& mesh_file, const std::string& cache_directory,
+                                                       const int refine_serial = 0, const int refine_parallel = 0,
+                                                       const MPI_Comm                comm      = MPI_COMM_WORLD,
+                                                       const mesh::PartitionOptions& partition = {});
+
+/**
+ * @brief Writes each rank's partition of a parallel mesh into a directory
+ *
+ * Each rank writes its own file using MFEM's parallel mesh format, and the root
+ * records the number of partitions once all of them have been written.
+ * The result can be loaded with buildMeshFromPartitionedFiles.
+ *
+ * @param[in] mesh The parallel mesh to write
+ * @param[in] directory The directory in which to write the partitions, created if needed
+ */
+void writePartitionedMesh(const mfem::ParMesh& mesh, const std::string& directory);
+
+/**
+ * @brief Constructs an MFEM parallel mesh from pre-partitioned per-rank files
+ *
+ * Each rank reads only its own partition, so unlike buildMeshFromFile no rank ever holds
+ * the full serial mesh and peak memory is proportional to the local partition. The partitions
+ * can be produced by writePartitionedMesh, e.g. from a run that places fewer ranks per node,
+ * and must have been written with the same number of ranks as the communicator.
+ *
+ * @param[in] directory The directory containing the partitions
+ * @param[in] refine_parallel The number of parallel refinements
+ * @param[in] MPI_Comm The MPI communicator
+ * @return A shared_ptr containing the constructed and refined parallel mesh object
+ */
+std::shared_ptr<mfem::ParMesh> buildMeshFromPartitionedFiles(const std::string& directory,
+                                                             const int          refine_parallel = 0,
+                                                             const MPI_Comm     comm            = MPI_COMM_WORLD);
 
 /**
  * @brief Constructs a 2D MFEM mesh of a unit disk, centered at the origin
@@ -46,9 +101,11 @@ std::shared_ptr<mfem::ParMesh> buildMeshFromFile(const std::string& mesh_file, c
  * number of elements is as close as possible to the user-specified number of elements
  *
  * @param[in] approx_number_of_elements
+ * @param[in] partition How to partition the serial mesh across ranks
  * @return A shared_ptr containing the constructed mesh
  */
-std::shared_ptr<mfem::ParMesh> buildDiskMesh(int approx_number_of_elements, const MPI_Comm comm = MPI_COMM_WORLD);
+std::shared_ptr<mfem::ParMesh> buildDiskMesh(int approx_number_of_elements, const MPI_Comm comm = MPI_COMM_WORLD,
+                                             const mesh::PartitionOptions& partition = {});
 
 /**
  * @brief Constructs a 3D MFEM mesh of a unit ball, centered at the origin
@@ -57,9 +114,11 @@ std::shared_ptr<mfem::ParMesh> buildDiskMesh(int approx_number_of_elements, cons
  * number of elements is as close as possible to the user-specified number of elements
  *
  * @param[in] approx_number_of_elements
+ * @param[in] partition How to partition the serial mesh across ranks
  * @return A shared_ptr containing the constructed mesh
  */
-std::shared_ptr<mfem::ParMesh> buildBallMesh(int approx_number_of_elements, const MPI_Comm comm = MPI_COMM_WORLD);
+std::shared_ptr<mfem::ParMesh> buildBallMesh(int approx_number_of_elements, const MPI_Comm comm = MPI_COMM_WORLD,
+                                             const mesh::PartitionOptions& partition = {});
 
 /**
  * @brief Constructs a 2D MFEM mesh of a rectangle
@@ -68,10 +127,12 @@ std::shared_ptr<mfem::ParMesh> buildBallMesh(int approx_number_of_elements, cons
  * @param[in] elements_in_y the number of elements in the y-direction
  * @param[in] size_x Overall size in the x-direction
  * @param[in] size_y Overall size in the y-direction
+ * @param[in] partition How to partition the serial mesh across ranks
  * @return A shared_ptr containing the constructed mesh
  */
 std::shared_ptr<mfem::ParMesh> buildRectangleMesh(int elements_in_x, int elements_in_y, double size_x = 1.,
-                                                  double size_y = 1., const MPI_Comm comm = MPI_COMM_WORLD);
+                                                  double size_y = 1., const MPI_Comm comm = MPI_COMM_WORLD,
+                                                  const mesh::PartitionOptions& partition = {});
 
 /**
  * @brief Constructs a 3D MFEM mesh of a cuboid
@@ -83,11 +144,13 @@ std::shared_ptr<mfem::ParMesh> buildRectangleMesh(int elements_in_x, int element
  * @param[in] size_y Overall size in the y-direction
  * @param[in] size_z Overall size in the z-direction
  * @param[in] MPI_Comm MPI Communicator
+ * @param[in] partition How to partition the serial mesh across ranks
  * @return A shared_ptr containing the constructed mesh
  */
 std::shared_ptr<mfem::ParMesh> buildCuboidMesh(int elements_in_x, int elements_in_y, int elements_in_z,
                                                double size_x = 1., double size_y = 1., double size_z = 1.,
-                                               const MPI_Comm comm = MPI_COMM_WORLD);
+                                               const MPI_Comm                comm      = MPI_COMM_WORLD,
+                                               const mesh::PartitionOptions& partition = {});
 
 /**
  * @brief Constructs a 3D MFEM mesh of a cylinder
@@ -97,10 +160,12 @@ std::shared_ptr<mfem::ParMesh> buildCuboidMesh(int elements_in_x, int elements_i
  * @param[in] radius the radius of the cylinder
  * @param[in] height the number of elements in the z-direction
  *
+ * @param[in] partition How to partition the serial mesh across ranks
  * @return A shared_ptr containing the constructed mesh
  */
 std::shared_ptr<mfem::ParMesh> buildCylinderMesh(int radial_refinement, int elements_lengthwise, double radius,
-                                                 double height, const MPI_Comm comm = MPI_COMM_WORLD);
+                                                 double height, const MPI_Comm comm = MPI_COMM_WORLD,
+                                                 const mesh::PartitionOptions& partition = {});
 
 /**
  * @brief Constructs a 3D MFEM mesh of a hollow cylinder
@@ -111,11 +176,13 @@ std::shared_ptr<mfem::ParMesh> buildCylinderMesh(int radial_refinement, int elem
  * @param[in] outer ouer radius the radius of the cylindrical shell
  * @param[in] height the number of elements in the z-direction
  *
+ * @param[in] partition How to partition the serial mesh across ranks
  * @return A shared_ptr containing the constructed mesh
  */
 std::shared_ptr<mfem::ParMesh> buildHollowCylinderMesh(int radial_refinement, int elements_lengthwise,
                                                        double inner_radius, double outer_radius, double height,
-                                                       const MPI_Comm comm = MPI_COMM_WORLD);
+                                                       const MPI_Comm                comm      = MPI_COMM_WORLD,
+                                                       const mesh::PartitionOptions& partition = {});
 
 namespace mesh {
 
@@ -128,6 +195,14 @@ struct FileInputOptions {
   static void defineInputFileSchema(axom::inlet::Table& table);
 
   std::string relative_mesh_file_name;
+
+  /// Directory in which to cache the partitioned and refined mesh, caching is disabled if unset
+  std::optional<std::string> cache_directory;
+};
+
+struct PartitionedInputOptions {
+  /// Directory containing one partition per rank, as written by writePartitionedMesh
+  std::string relative_directory;
 };
 
 struct GenerateInputOptions {
@@ -141,6 +216,9 @@ struct GenerateInputOptions {
   /// For rectangular and cuboid meshes
   std::vector<int>    elements;
   std::vector<double> overall_size;
+
+  /// Build each rank's block directly with buildStructuredMesh instead of distributing a serial mesh
+  bool parallel = false;
 };
 
 struct InputOptions {
@@ -151,10 +229,13 @@ struct InputOptions {
    **/
   static void defineInputFileSchema(axom::inlet::Table& table);
 
-  std::variant<FileInputOptions, GenerateInputOptions> extra_options;
+  std::variant<FileInputOptions, GenerateInputOptions, PartitionedInputOptions> extra_options;
   // Serial/parallel refinement iterations
   int ser_ref_levels;
   int par_ref_levels;
+
+  /// How the serial mesh is partitioned across ranks
+  PartitionOptions partition;
 };
 
 }  // namespace mesh
@@ -162,22 +243,32 @@ struct InputOptions {
 /**
  * @brief Constructs a 3D MFEM mesh of a cuboid
  *
+ * If the options request parallel generation, each rank builds its own block with
+ * buildStructuredMesh and the partition options are ignored.
+ *
  * @param[in] extra_options Cuboid Mesh Options
  * @param[in] MPI_Comm MPI Communicator
+ * @param[in] partition How to partition the serial mesh across ranks
  * @return A shared_ptr containing the constructed mesh
  */
 std::shared_ptr<mfem::ParMesh> buildCuboidMesh(serac::mesh::GenerateInputOptions& options,
-                                               const MPI_Comm                     comm = MPI_COMM_WORLD);
+                                               const MPI_Comm                     comm      = MPI_COMM_WORLD,
+                                               const mesh::PartitionOptions&      partition = {});
 
 /**
  * @brief Constructs a 2D MFEM mesh of a rectangle
  *
+ * If the options request parallel generation, each rank builds its own block with
+ * buildStructuredMesh and the partition options are ignored.
+ *
  * @param[in] extra_options Rectangle Mesh Options
  * @param[in] MPI_Comm MPI Communicator
+ * @param[in] partition How to partition the serial mesh across ranks
  * @return A shared_ptr containing the constructed mesh
  */
 std::shared_ptr<mfem::ParMesh> buildRectangleMesh(serac::mesh::GenerateInputOptions& options,
-                                                  const MPI_Comm                     comm = MPI_COMM_WORLD);
+                                                  const MPI_Comm                     comm      = MPI_COMM_WORLD,
+                                                  const mesh::PartitionOptions&      partition = {});
 
 }  // namespace serac
 
@@ -0,0 +1,384 @@
+// Copyright (c) 2019-2021, Lawrence Livermore National Security, LLC and
+// other Serac Project Developers. See the top-level LICENSE file for
+// details.
+//
+// SPDX-License-Identifier: (BSD-3-Clause)
+
+#include "serac/numerics/partitioning.hpp"
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <map>
+#include <memory>
+#include <numeric>
+
+#include "fmt/fmt.hpp"
+
+#if defined(MFEM_USE_METIS) && defined(MFEM_USE_METIS_5)
+#include "metis.h"
+#endif
+
+#include "serac/infrastructure/logger.hpp"
+
+namespace serac {
+
+namespace {
+
+/**
+ * @brief Converts coordinates into the transposed form of their Hilbert index
+ *
+ * See J. Skilling, "Programming the Hilbert curve", AIP Conference Proceedings 707 (2004)
+ *
+ * @param[inout] x The integer coordinates, each using the low @a bits bits
+ * @param[in] bits The number of bits per coordinate
+ * @param[in] dim The number of coordinates
+ */
+void axesToTranspose(std::array<std::uint32_t, 3>& x, const int bits, const int dim)
+{
+  const std::uint32_t m = std::uint32_t{1} << (bits - 1);
+
+  // Inverse undo
+  for (std::uint32_t q = m; q > 1; q >>= 1) {
+    const std::uint32_t p = q - 1;
+    for (int i = 0; i < dim; i++) {
+      if (x[i] & q) {
+        x[0] ^= p;
+      } else {
+        const std::uint32_t t = (x[0] ^ x[i]) & p;
+        x[0] ^= t;
+        x[i] ^= t;
+      }
+    }
+  }
+
+  // Gray encode
+  for (int i = 1; i < dim; i++) {
+    x[i] ^= x[i - 1];
+  }
+  std::uint32_t t = 0;
+  for (std::uint32_t q = m; q > 1; q >>= 1) {
+    if (x[dim - 1] & q) {
+      t ^= q - 1;
+    }
+  }
+  for (int i = 0; i < dim; i++) {
+    x[i] ^= t;
+  }
+}
+
+/**
+ * @brief Interleaves the bits of the coordinates, most significant first
+ */
+std::uint64_t interleave(const std::array<std::uint32_t, 3>& x, const int bits, const int dim)
+{
+  std::uint64_t key = 0;
+  for (int bit = bits - 1; bit >= 0; bit--) {
+    for (int i = 0; i < dim; i++) {
+      key = (key << 1) | ((x[i] >> bit) & 1u);
+    }
+  }
+  return key;
+}
+
+/**
+ * @brief Times repeated evaluations of a function, returning the average time per call in seconds
+ */
+template <typename Func>
+double averageTime(Func&& func)
+{
+  using clock = std::chrono::steady_clock;
+
+  constexpr int                       min_reps = 5;
+  constexpr std::chrono::microseconds min_time(500);
+
+  int  reps  = 0;
+  auto start = clock::now();
+  auto stop  = start;
+  while ((reps < min_reps) || (stop - start < min_time)) {
+    func();
+    reps++;
+    stop = clock::now();
+  }
+  return std::chrono::duration<double>(stop - start).count() / reps;
+}
+
+}  // namespace
+
+std::vector<double> measureElementCosts(mfem::Mesh& mesh, const mesh::PartitionOptions& options, const MPI_Comm comm)
+{
+  auto element_order = [&mesh, &options](int e) {
+    auto order = options.attribute_cost_orders.find(mesh.GetAttribute(e));
+    return (order == options.attribute_cost_orders.end()) ? options.cost_order : order->second;
+  };
+
+  // Every rank holds the whole mesh, so they all find the same (geometry, order) classes in the same order
+  std::map<std::pair<int, int>, double> volume_costs;
+  std::map<std::pair<int, int>, int>    volume_samples;
+  for (int e = 0; e < mesh.GetNE(); e++) {
+    std::pair<int, int> key(mesh.GetElementBaseGeometry(e), element_order(e));
+    volume_costs.emplace(key, 0.0);
+    volume_samples.emplace(key, e);
+  }
+  std::map<std::pair<int, int>, double> face_costs;
+  std::map<std::pair<int, int>, int>    face_samples;
+  std::vector<int>                      loaded_faces;
+  for (int be = 0; be < mesh.GetNBE(); be++) {
+    if (options.loaded_boundary_attributes.count(mesh.GetBdrAttribute(be)) == 0) {
+      continue;
+    }
+    int element = 0;
+    int info    = 0;
+    mesh.GetBdrElementAdjacentElement(be, element, info);
+    std::pair<int, int> key(mesh.GetBdrElementBaseGeometry(be), element_order(element));
+    face_costs.emplace(key, 0.0);
+    face_samples.emplace(key, be);
+    loaded_faces.push_back(be);
+  }
+
+  int rank = 0;
+  MPI_Comm_rank(comm, &rank);
+  if (rank == 0) {
+    std::map<int, std::unique_ptr<mfem::H1_FECollection>> collections;
+    auto collection = [&collections, &mesh](int order) -> mfem::FiniteElementCollection& {
+      auto& fec = collections[order];
+      if (!fec) {
+        fec = std::make_unique<mfem::H1_FECollection>(order, mesh.Dimension());
+      }
+      return *fec;
+    };
+
+    mfem::DiffusionIntegrator stiffness;
+    mfem::MassIntegrator      boundary_mass;
+    mfem::DenseMatrix         elmat;
+    for (auto& [key, cost] : volume_costs) {
+      auto& fe    = *collection(key.second).FiniteElementForGeometry(static_cast<mfem::Geometry::Type>(key.first));
+      auto& trans = *mesh.GetElementTransformation(volume_samples[key]);
+      cost        = averageTime([&]() { stiffness.AssembleElementMatrix(fe, trans, elmat); });
+    }
+    for (auto& [key, cost] : face_costs) {
+      auto& fe    = *collection(key.second).FiniteElementForGeometry(static_cast<mfem::Geometry::Type>(key.first));
+      auto& trans = *mesh.GetBdrElementTransformation(face_samples[key]);
+      cost        = averageTime([&]() { boundary_mass.AssembleElementMatrix(fe, trans, elmat); });
+    }
+  }
+
+  // Timings differ between ranks, so everyone uses the root's to compute identical weights
+  std::vector<double> timings;
+  for (const auto& [key, cost] : volume_costs) {
+    timings.push_back(cost);
+  }
+  for (const auto& [key, cost] : face_costs) {
+    timings.push_back(cost);
+  }
+  MPI_Bcast(timings.data(), static_cast<int>(timings.size()), MPI_DOUBLE, 0, comm);
+  auto timing = timings.begin();
+  for (auto& [key, cost] : volume_costs) {
+    cost = *timing++;
+  }
+  for (auto& [key, cost] : face_costs) {
+    cost = *timing++;
+  }
+
+  std::vector<double> costs(static_cast<std::size_t>(mesh.GetNE()));
+  for (int e = 0; e < mesh.GetNE(); e++) {
+    costs[static_cast<std::size_t>(e)] = volume_costs[{mesh.GetElementBaseGeometry(e), element_order(e)}];
+  }
+  for (auto be : loaded_faces) {
+    int element = 0;
+    int info    = 0;
+    mesh.GetBdrElementAdjacentElement(be, element, info);
+    costs[static_cast<std::size_t>(element)] +=
+        face_costs[{mesh.GetBdrElementBaseGeometry(be), element_order(element)}];
+  }
+  return costs;
+}
+
+std::vector<int> partitionBySpaceFillingCurve(mfem::Mesh& mesh, const int num_parts, const mesh::PartitionMethod curve,
+                                              const std::vector<double>& element_weights)
+{
+  SLIC_ERROR_IF((curve != mesh::PartitionMethod::Hilbert) && (curve != mesh::PartitionMethod::Morton),
+                "Space-filling curve partitioning requires the Hilbert or Morton method.");
+
+  const int  num_elements = mesh.GetNE();
+  const int  dim          = mesh.SpaceDimension();
+  const auto ne           = static_cast<std::size_t>(num_elements);
+  SLIC_ERROR_IF(!element_weights.empty() && (element_weights.size() != ne),
+                fmt::format("Expected {0} element weights, got {1}", ne, element_weights.size()));
+
+  // Element centers and their bounding box
+  std::vector<mfem::Vector> centers(ne, mfem::Vector(dim));
+  std::array<double, 3>     lower;
+  std::array<double, 3>     upper;
+  lower.fill(std::numeric_limits<double>::max());
+  upper.fill(std::numeric_limits<double>::lowest());
+  for (int e = 0; e < num_elements; e++) {
+    auto& center = centers[static_cast<std::size_t>(e)];
+    mesh.GetElementCenter(e, center);
+    for (int d = 0; d < dim; d++) {
+      lower[d] = std::min(lower[d], center(d));
+      upper[d] = std::max(upper[d], center(d));
+    }
+  }
+
+  // Quantize the centers and compute their position along the curve
+  const int                  bits  = std::min(32, 63 / dim);
+  const double               cells = std::ldexp(1.0, bits) - 1.0;
+  std::vector<std::uint64_t> keys(ne);
+  for (std::size_t e = 0; e < ne; e++) {
+    std::array<std::uint32_t, 3> x{};
+    for (int d = 0; d < dim; d++) {
+      double extent = upper[d] - lower[d];
+      double scaled = (extent > 0.0) ? (centers[e](d) - lower[d]) / extent : 0.0;
+      x[d]          = static_cast<std::uint32_t>(std::llround(scaled * cells));
+    }
+    if (curve == mesh::PartitionMethod::Hilbert) {
+      axesToTranspose(x, bits, dim);
+    }
+    keys[e] = interleave(x, bits, dim);
+  }
+
+  // Break ties by element index so the result is deterministic
+  std::vector<int> order(ne);
+  std::iota(order.begin(), order.end(), 0);
+  std::sort(order.begin(), order.end(), [&keys](int a, int b) {
+    return std::make_pair(keys[static_cast<std::size_t>(a)], a) < std::make_pair(keys[static_cast<std::size_t>(b)], b);
+  });
+
+  auto weight = [&element_weights](int e) {
+    return element_weights.empty() ? 1.0 : element_weights[static_cast<std::size_t>(e)];
+  };
+  double total_weight = 0.0;
+  for (int e = 0; e < num_elements; e++) {
+    total_weight += weight(e);
+  }
+
+  // Split the curve into chunks of equal weight, assigning each element by its midpoint
+  std::vector<int> partitioning(ne);
+  double           prefix = 0.0;
+  for (auto e : order) {
+    double midpoint = prefix + 0.5 * weight(e);
+    int    part     = static_cast<int>(midpoint * num_parts / total_weight);
+    prefix += weight(e);
+
+    partitioning[static_cast<std::size_t>(e)] = std::clamp(part, 0, num_parts - 1);
+  }
+  return partitioning;
+}
+
+std::vector<int> partitionByWeightedMETIS(mfem::Mesh& mesh, const int num_parts,
+                                          const std::vector<double>& element_weights)
+{
+  const auto ne = static_cast<std::size_t>(mesh.GetNE());
+  SLIC_ERROR_IF(element_weights.size() != ne,
+                fmt::format("Expected {0} element weights, got {1}", ne, element_weights.size()));
+
+  std::vector<int> partitioning(ne, 0);
+  if (num_parts == 1) {
+    return partitioning;
+  }
+
+#if defined(MFEM_USE_METIS) && defined(MFEM_USE_METIS_5)
+  const mfem::Table& graph = mesh.ElementToElementTable();
+
+  std::vector<idx_t> xadj(graph.GetI(), graph.GetI() + ne + 1);
+  std::vector<idx_t> adjncy(graph.GetJ(), graph.GetJ() + graph.Size_of_connections());
+
+  // METIS balances integer weights, so scale the largest weight to a fixed resolution
+  constexpr double   resolution = 1000.0;
+  double             max_weight = *std::max_element(element_weights.begin(), element_weights.end());
+  std::vector<idx_t> vwgt(ne);
+  for (std::size_t e = 0; e < ne; e++) {
+    double scaled = (max_weight > 0.0) ? resolution * element_weights[e] / max_weight : 1.0;
+    vwgt[e]       = std::max<idx_t>(1, static_cast<idx_t>(std::lround(scaled)));
+  }
+
+  idx_t num_vertices    = static_cast<idx_t>(ne);
+  idx_t num_constraints = 1;
+  idx_t nparts          = num_parts;
+  idx_t edge_cut        = 0;
+  idx_t options[METIS_NOPTIONS];
+  METIS_SetDefaultOptions(options);
+  options[METIS_OPTION_CONTIG] = 1;
+
+  std::vector<idx_t> part(ne);
+  int status = METIS_PartGraphKway(&num_vertices, &num_constraints, xadj.data(), adjncy.data(), vwgt.data(), nullptr,
+                                   nullptr, &nparts, nullptr, nullptr, options, &edge_cut, part.data());
+  SLIC_ERROR_IF(status != METIS_OK, fmt::format("METIS_PartGraphKway failed with status {0}", status));
+
+  std::copy(part.begin(), part.end(), partitioning.begin());
+#else
+  static_cast<void>(mesh);
+  SLIC_ERROR("Weighted METIS partitioning requires MFEM to be built with METIS 5.");
+#endif
+  return partitioning;
+}
+
+mfem::Array<int> rebalancedPartition(const mfem::ParMesh& mesh, const std::vector<double>& element_weights)
+{
+  SLIC_ERROR_IF(!mesh.Nonconforming(), "Only nonconforming meshes can be rebalanced.");
+  const auto ne = static_cast<std::size_t>(mesh.GetNE());
+  SLIC_ERROR_IF(element_weights.size() != ne,
+                fmt::format("Expected {0} element weights, got {1}", ne, element_weights.size()));
+
+  // Locate this rank's piece of the curve
+  double local_weight = std::accumulate(element_weights.begin(), element_weights.end(), 0.0);
+  double prefix       = 0.0;
+  double total_weight = 0.0;
+  MPI_Exscan(&local_weight, &prefix, 1, MPI_DOUBLE, MPI_SUM, mesh.GetComm());
+  MPI_Allreduce(&local_weight, &total_weight, 1, MPI_DOUBLE, MPI_SUM, mesh.GetComm());
+  if (mesh.GetMyRank() == 0) {
+    // The result of MPI_Exscan is undefined on the first rank
+    prefix = 0.0;
+  }
+
+  // Split the curve into chunks of equal weight, assigning each element by its midpoint
+  const int        num_parts = mesh.GetNRanks();
+  mfem::Array<int> partition(static_cast<int>(ne));
+  for (std::size_t e = 0; e < ne; e++) {
+    double midpoint = prefix + 0.5 * element_weights[e];
+    int    part     = (total_weight > 0.0) ? static_cast<int>(midpoint * num_parts / total_weight) : mesh.GetMyRank();
+    prefix += element_weights[e];
+
+    partition[static_cast<int>(e)] = std::clamp(part, 0, num_parts - 1);
+  }
+  return partition;
+}
+
+std::shared_ptr<mfem::ParMesh> distributeMesh(mfem::Mesh& mesh, const mesh::PartitionOptions& options,
+                                              const MPI_Comm comm)
+{
+  int num_ranks = 0;
+  MPI_Comm_size(comm, &num_ranks);
+
+  if (options.nonconforming) {
+    // Simplices are converted too, as their refinement is otherwise conforming
+    mesh.EnsureNCMesh(true);
+  }
+
+  std::vector<int> partitioning;
+  switch (options.method) {
+    case mesh::PartitionMethod::METIS:
+      return std::make_shared<mfem::ParMesh>(comm, mesh);
+
+    case mesh::PartitionMethod::WeightedMETIS:
+      partitioning = partitionByWeightedMETIS(mesh, num_ranks, measureElementCosts(mesh, options, comm));
+      break;
+
+    case mesh::PartitionMethod::Hilbert:
+      [[fallthrough]];
+    case mesh::PartitionMethod::Morton:
+      partitioning = partitionBySpaceFillingCurve(mesh, num_ranks, options.method);
+      break;
+
+    default:
+      SLIC_ERROR("Partition method not recognized!");
+  }
+
+  return std::make_shared<mfem::ParMesh>(comm, mesh, partitioning.data());
+}
+
+}  // namespace serac
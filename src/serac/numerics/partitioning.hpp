@@ -0,0 +1,141 @@
+// Copyright (c) 2019-2021, Lawrence Livermore National Security, LLC and
+// other Serac Project Developers. See the top-level LICENSE file for
+// details.
+//
+// SPDX-License-Identifier: (BSD-3-Clause)
+
+/**
+ * @file partitioning.hpp
+ *
+ * @brief Functions for partitioning serial meshes across MPI ranks
+ */
+
+#pragma once
+
+#include <map>
+#include <memory>
+#include <set>
+#include <vector>
+
+#include "mfem.hpp"
+
+namespace serac {
+
+namespace mesh {
+
+/**
+ * @brief Method used to assign the elements of a serial mesh to ranks
+ */
+enum class PartitionMethod
+{
+  METIS,         /**< MFEM's default unweighted METIS partitioning */
+  WeightedMETIS, /**< METIS weighted by the measured per-element assembly cost */
+  Hilbert,       /**< Contiguous chunks of elements ordered along a Hilbert curve */
+  Morton         /**< Contiguous chunks of elements ordered along a Morton (Z-order) curve */
+};
+
+/**
+ * @brief Options for partitioning a serial mesh
+ */
+struct PartitionOptions {
+  /**
+   * @brief The partitioning method
+   */
+  PartitionMethod method = PartitionMethod::METIS;
+
+  /**
+   * @brief The polynomial order at which per-element assembly cost is measured for weighted partitioning
+   */
+  int cost_order = 1;
+
+  /**
+   * @brief Whether to convert the mesh to a nonconforming mesh before distributing it
+   *
+   * This is required to repartition the mesh during a simulation with rebalancedPartition
+   */
+  bool nonconforming = false;
+
+  /**
+   * @brief The polynomial orders of the elements with the given attributes, overriding cost_order
+   */
+  std::map<int, int> attribute_cost_orders;
+
+  /**
+   * @brief The boundary attributes carrying traction or flux loads, whose faces add to the cost of their elements
+   */
+  std::set<int> loaded_boundary_attributes;
+};
+
+}  // namespace mesh
+
+/**
+ * @brief Measures the relative assembly cost of each element of a mesh
+ *
+ * Each element is assigned an order from its attribute, falling back to the default cost
+ * order. The time to assemble a stiffness matrix is measured once for each combination of
+ * element geometry and order present, and the time to integrate a load is measured for each
+ * combination of face geometry and order on the loaded boundary attributes. An element's cost
+ * is its volume cost at its own order plus the cost of any loaded boundary faces it owns, so
+ * high-order regions and elements carrying boundary loads receive larger weights. Unloaded
+ * boundary faces add nothing. The timings are taken on the root rank and broadcast so that
+ * every rank computes identical weights.
+ *
+ * @param[in] mesh The serial mesh
+ * @param[in] options The element orders and loaded boundary attributes
+ * @param[in] comm The MPI communicator over which the costs are shared
+ * @return The cost of each element, in seconds
+ */
+std::vector<double> measureElementCosts(mfem::Mesh& mesh, const mesh::PartitionOptions& options,
+                                        const MPI_Comm comm = MPI_COMM_WORLD);
+
+/**
+ * @brief Partitions a mesh into contiguous pieces of a space-filling curve through the element centers
+ *
+ * This is fast, deterministic, and needs no graph partitioner, at the expense of a somewhat
+ * larger partition surface than METIS.
+ *
+ * @param[in] mesh The serial mesh
+ * @param[in] num_parts The number of parts
+ * @param[in] curve Either PartitionMethod::Hilbert or PartitionMethod::Morton
+ * @param[in] element_weights Optional per-element weights to balance, uniform if empty
+ * @return The part of each element
+ */
+std::vector<int> partitionBySpaceFillingCurve(mfem::Mesh& mesh, const int num_parts, const mesh::PartitionMethod curve,
+                                              const std::vector<double>& element_weights = {});
+
+/**
+ * @brief Partitions the element connectivity graph of a mesh with METIS, balancing per-element weights
+ *
+ * @param[in] mesh The serial mesh
+ * @param[in] num_parts The number of parts
+ * @param[in] element_weights The weight of each element
+ * @return The part of each element
+ */
+std::vector<int> partitionByWeightedMETIS(mfem::Mesh& mesh, const int num_parts,
+                                          const std::vector<double>& element_weights);
+
+/**
+ * @brief Computes a new partition of a nonconforming parallel mesh that balances per-element weights
+ *
+ * The elements of a nonconforming parallel mesh are ordered along a space-filling curve, with
+ * each rank owning a contiguous piece of it. The curve is re-split into pieces of equal weight,
+ * so elements only move between ranks that are neighbors along the curve.
+ *
+ * @param[in] mesh The nonconforming parallel mesh
+ * @param[in] element_weights The weight of each local element
+ * @return The new rank of each local element, as expected by mfem::ParMesh::Rebalance
+ */
+mfem::Array<int> rebalancedPartition(const mfem::ParMesh& mesh, const std::vector<double>& element_weights);
+
+/**
+ * @brief Distributes a serial mesh across the ranks of a communicator
+ *
+ * @param[in] mesh The serial mesh, which must be identical on all ranks
+ * @param[in] options The partitioning options
+ * @param[in] comm The MPI communicator
+ * @return The parallel mesh
+ */
+std::shared_ptr<mfem::ParMesh> distributeMesh(mfem::Mesh& mesh, const mesh::PartitionOptions& options,
+                                              const MPI_Comm comm = MPI_COMM_WORLD);
+
+}  // namespace serac
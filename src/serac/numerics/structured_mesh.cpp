@@ -0,0 +1,378 @@
+// Copyright (c) 2019-2021, Lawrence Livermore National Security, LLC and
+// other Serac Project Developers. See the top-level LICENSE file for
+// details.
+//
+// SPDX-License-Identifier: (BSD-3-Clause)
+
+#include "serac/numerics/structured_mesh.hpp"
+
+#include <algorithm>
+#include <limits>
+#include <map>
+#include <sstream>
+
+#include "fmt/fmt.hpp"
+
+#include "serac/infrastructure/logger.hpp"
+
+namespace serac {
+
+namespace {
+
+/**
+ * @brief The first element of a block when n elements are split as evenly as possible into p blocks
+ */
+int blockStart(const int block, const int n, const int p)
+{
+  return static_cast<int>(static_cast<long long>(block) * n / p);
+}
+
+/**
+ * @brief The local vertices of the entities shared with one group of ranks
+ */
+struct SharedEntities {
+  std::vector<int>                vertices;
+  std::vector<std::array<int, 2>> edges;
+  std::vector<std::array<int, 4>> faces;
+};
+
+}  // namespace
+
+namespace mesh {
+
+BoxDecomposition decomposeBox(const std::vector<int>& elements, const int num_ranks, const int rank)
+{
+  SLIC_ERROR_IF((elements.size() != 2) && (elements.size() != 3),
+                fmt::format("Structured meshes must have 2 or 3 directions, got {0}", elements.size()));
+
+  const std::array<int, 3> n = {elements[0], elements[1], (elements.size() == 3) ? elements[2] : 1};
+  SLIC_ERROR_IF(*std::min_element(n.begin(), n.end()) < 1,
+                "Structured meshes must have at least one element in each direction");
+
+  // Choose the number of blocks in each direction that minimizes the interface area
+  BoxDecomposition box{};
+  const long long  nx        = n[0];
+  const long long  ny        = n[1];
+  const long long  nz        = n[2];
+  long long        best_cost = std::numeric_limits<long long>::max();
+  for (int px = 1; (px <= num_ranks) && (px <= nx); px++) {
+    if (num_ranks % px != 0) {
+      continue;
+    }
+    for (int py = 1; (py <= num_ranks / px) && (py <= ny); py++) {
+      const int pz = num_ranks / px / py;
+      if (((num_ranks / px) % py != 0) || (pz > nz)) {
+        continue;
+      }
+      const long long cost = (px - 1) * ny * nz + (py - 1) * nx * nz + (pz - 1) * nx * ny;
+      if (cost < best_cost) {
+        best_cost  = cost;
+        box.blocks = {px, py, pz};
+      }
+    }
+  }
+  SLIC_ERROR_IF(best_cost == std::numeric_limits<long long>::max(),
+                fmt::format("Cannot split a {0}x{1}x{2} grid of elements into {3} blocks", nx, ny, nz, num_ranks));
+
+  box.block = {rank % box.blocks[0], (rank / box.blocks[0]) % box.blocks[1], rank / (box.blocks[0] * box.blocks[1])};
+  for (std::size_t d = 0; d < 3; d++) {
+    box.first[d] = blockStart(box.block[d], n[d], box.blocks[d]);
+    box.last[d]  = blockStart(box.block[d] + 1, n[d], box.blocks[d]);
+  }
+  return box;
+}
+
+}  // namespace mesh
+
+std::shared_ptr<mfem::ParMesh> buildStructuredMesh(const std::vector<int>&    elements,
+                                                   const std::vector<double>& overall_size, const MPI_Comm comm)
+{
+  int rank      = 0;
+  int num_ranks = 0;
+  MPI_Comm_rank(comm, &rank);
+  MPI_Comm_size(comm, &num_ranks);
+
+  SLIC_ERROR_IF(overall_size.size() != elements.size(),
+                fmt::format("Expected {0} overall sizes, got {1}", elements.size(), overall_size.size()));
+
+  const auto dim = elements.size();
+  const auto box = mesh::decomposeBox(elements, num_ranks, rank);
+  SLIC_INFO_ROOT(rank, fmt::format("Generating a structured mesh on {0}x{1}x{2} blocks", box.blocks[0],
+                                   box.blocks[1], box.blocks[2]));
+
+  // The number of local elements and vertices in each direction
+  std::array<int, 3> ne{};
+  std::array<int, 3> nv{};
+  for (std::size_t d = 0; d < 3; d++) {
+    ne[d] = box.last[d] - box.first[d];
+    nv[d] = (d < dim) ? ne[d] + 1 : 1;
+  }
+  auto vertex = [&nv](const int i, const int j, const int k) { return i + nv[0] * (j + nv[1] * k); };
+
+  // Whether a local vertex coordinate lies on the interface with a neighboring block
+  auto on_interface = [&](const std::size_t d, const int i) {
+    return (d < dim) && (((i == 0) && (box.block[d] > 0)) || ((i == ne[d]) && (box.block[d] + 1 < box.blocks[d])));
+  };
+
+  // Group 0 is this rank alone, the others are each distinct set of ranks sharing an entity
+  std::vector<std::vector<int>>           groups = {{rank}};
+  std::vector<SharedEntities>             shared(1);
+  std::map<std::vector<int>, std::size_t> group_ids;
+
+  // Finds the group of the entity at the given vertex that spans one element in the given
+  // directions, or zero if the entity is not shared
+  auto group_of = [&](const std::array<int, 3>& p, const std::array<bool, 3>& spans) -> std::size_t {
+    std::array<bool, 3> neighbors;
+    for (std::size_t d = 0; d < 3; d++) {
+      neighbors[d] = !spans[d] && on_interface(d, p[d]);
+    }
+    if (std::none_of(neighbors.begin(), neighbors.end(), [](bool n) { return n; })) {
+      return 0;
+    }
+
+    std::array<std::vector<int>, 3> blocks;
+    for (std::size_t d = 0; d < 3; d++) {
+      if (neighbors[d] && (p[d] == 0)) {
+        blocks[d].push_back(box.block[d] - 1);
+      }
+      blocks[d].push_back(box.block[d]);
+      if (neighbors[d] && (p[d] == ne[d])) {
+        blocks[d].push_back(box.block[d] + 1);
+      }
+    }
+
+    std::vector<int> ranks;
+    for (int bz : blocks[2]) {
+      for (int by : blocks[1]) {
+        for (int bx : blocks[0]) {
+          ranks.push_back(bx + box.blocks[0] * (by + box.blocks[1] * bz));
+        }
+      }
+    }
+    std::sort(ranks.begin(), ranks.end());
+
+    auto [entry, inserted] = group_ids.emplace(ranks, groups.size());
+    if (inserted) {
+      groups.push_back(ranks);
+      shared.emplace_back();
+    }
+    return entry->second;
+  };
+
+  // The entities are visited in increasing global order, so each group lists its entities in
+  // the same order on every rank that shares them
+  for (int k = 0; k < nv[2]; k++) {
+    for (int j = 0; j < nv[1]; j++) {
+      for (int i = 0; i < nv[0]; i++) {
+        if (auto g = group_of({i, j, k}, {false, false, false})) {
+          shared[g].vertices.push_back(vertex(i, j, k));
+        }
+      }
+    }
+  }
+
+  for (std::size_t d = 0; d < dim; d++) {
+    std::array<bool, 3> spans{};
+    spans[d] = true;
+    for (int k = 0; k < nv[2]; k++) {
+      for (int j = 0; j < nv[1]; j++) {
+        for (int i = 0; i < nv[0]; i++) {
+          std::array<int, 3> p = {i, j, k};
+          if (p[d] == ne[d]) {
+            continue;
+          }
+          if (auto g = group_of(p, spans)) {
+            std::array<int, 3> q = p;
+            q[d] += 1;
+            shared[g].edges.push_back({vertex(p[0], p[1], p[2]), vertex(q[0], q[1], q[2])});
+          }
+        }
+      }
+    }
+  }
+
+  if (dim == 3) {
+    for (std::size_t d = 0; d < 3; d++) {
+      // The tangent directions of faces normal to d
+      const std::size_t   t1    = (d == 0) ? 1 : 0;
+      const std::size_t   t2    = (d == 2) ? 1 : 2;
+      std::array<bool, 3> spans = {true, true, true};
+      spans[d]                  = false;
+      for (int k = 0; k < nv[2]; k++) {
+        for (int j = 0; j < nv[1]; j++) {
+          for (int i = 0; i < nv[0]; i++) {
+            std::array<int, 3> p = {i, j, k};
+            if ((p[t1] == ne[t1]) || (p[t2] == ne[t2])) {
+              continue;
+            }
+            if (auto g = group_of(p, spans)) {
+              std::array<int, 3> p1 = p;
+              std::array<int, 3> p2 = p;
+              p1[t1] += 1;
+              p2[t2] += 1;
+              std::array<int, 3> p12 = p1;
+              p12[t2] += 1;
+              shared[g].faces.push_back({vertex(p[0], p[1], p[2]), vertex(p1[0], p1[1], p1[2]),
+                                         vertex(p12[0], p12[1], p12[2]), vertex(p2[0], p2[1], p2[2])});
+            }
+          }
+        }
+      }
+    }
+  }
+
+  // Write the local block in MFEM's parallel mesh format, which ParMesh reads without any
+  // communication beyond matching up the shared entities
+  std::ostringstream out;
+  out.precision(std::numeric_limits<double>::max_digits10);
+  out << "MFEM mesh v1.2\n\ndimension\n" << dim << "\n\nelements\n" << ne[0] * ne[1] * ne[2] << '\n';
+  if (dim == 2) {
+    for (int j = 0; j < ne[1]; j++) {
+      for (int i = 0; i < ne[0]; i++) {
+        out << "1 " << mfem::Geometry::SQUARE << ' ' << vertex(i, j, 0) << ' ' << vertex(i + 1, j, 0) << ' '
+            << vertex(i + 1, j + 1, 0) << ' ' << vertex(i, j + 1, 0) << '\n';
+      }
+    }
+  } else {
+    for (int k = 0; k < ne[2]; k++) {
+      for (int j = 0; j < ne[1]; j++) {
+        for (int i = 0; i < ne[0]; i++) {
+          out << "1 " << mfem::Geometry::CUBE;
+          for (int dk = 0; dk < 2; dk++) {
+            out << ' ' << vertex(i, j, k + dk) << ' ' << vertex(i + 1, j, k + dk) << ' '
+                << vertex(i + 1, j + 1, k + dk) << ' ' << vertex(i, j + 1, k + dk);
+          }
+          out << '\n';
+        }
+      }
+    }
+  }
+
+  // Boundary attributes are numbered as in mfem::Mesh's Cartesian constructors, with outward normals
+  std::ostringstream boundary;
+  int                num_boundary = 0;
+
+  auto add_boundary = [&boundary, &num_boundary](const int attribute, std::initializer_list<int> vertices) {
+    boundary << attribute << ' ' << ((vertices.size() == 2) ? mfem::Geometry::SEGMENT : mfem::Geometry::SQUARE);
+    for (int v : vertices) {
+      boundary << ' ' << v;
+    }
+    boundary << '\n';
+    num_boundary++;
+  };
+  const std::array<bool, 3> at_min = {box.first[0] == 0, box.first[1] == 0, box.first[2] == 0};
+  const std::array<bool, 3> at_max = {box.last[0] == elements[0], box.last[1] == elements[1],
+                                      (dim == 3) && (box.last[2] == elements[2])};
+  const int                 xmax   = ne[0];
+  const int                 ymax   = ne[1];
+  const int                 zmax   = ne[2];
+  if (dim == 2) {
+    for (int i = 0; i < xmax; i++) {
+      if (at_min[1]) {
+        add_boundary(1, {vertex(i, 0, 0), vertex(i + 1, 0, 0)});
+      }
+      if (at_max[1]) {
+        add_boundary(3, {vertex(i + 1, ymax, 0), vertex(i, ymax, 0)});
+      }
+    }
+    for (int j = 0; j < ymax; j++) {
+      if (at_max[0]) {
+        add_boundary(2, {vertex(xmax, j, 0), vertex(xmax, j + 1, 0)});
+      }
+      if (at_min[0]) {
+        add_boundary(4, {vertex(0, j + 1, 0), vertex(0, j, 0)});
+      }
+    }
+  } else {
+    for (int j = 0; j < ymax; j++) {
+      for (int i = 0; i < xmax; i++) {
+        if (at_min[2]) {
+          add_boundary(1, {vertex(i, j, 0), vertex(i, j + 1, 0), vertex(i + 1, j + 1, 0), vertex(i + 1, j, 0)});
+        }
+        if (at_max[2]) {
+          add_boundary(6, {vertex(i, j, zmax), vertex(i + 1, j, zmax), vertex(i + 1, j + 1, zmax),
+                           vertex(i, j + 1, zmax)});
+        }
+      }
+    }
+    for (int k = 0; k < zmax; k++) {
+      for (int i = 0; i < xmax; i++) {
+        if (at_min[1]) {
+          add_boundary(2, {vertex(i, 0, k), vertex(i + 1, 0, k), vertex(i + 1, 0, k + 1), vertex(i, 0, k + 1)});
+        }
+        if (at_max[1]) {
+          add_boundary(4, {vertex(i, ymax, k), vertex(i, ymax, k + 1), vertex(i + 1, ymax, k + 1),
+                           vertex(i + 1, ymax, k)});
+        }
+      }
+      for (int j = 0; j < ymax; j++) {
+        if (at_max[0]) {
+          add_boundary(3, {vertex(xmax, j, k), vertex(xmax, j + 1, k), vertex(xmax, j + 1, k + 1),
+                           vertex(xmax, j, k + 1)});
+        }
+        if (at_min[0]) {
+          add_boundary(5, {vertex(0, j, k), vertex(0, j, k + 1), vertex(0, j + 1, k + 1), vertex(0, j + 1, k)});
+        }
+      }
+    }
+  }
+  out << "\nboundary\n" << num_boundary << '\n' << boundary.str();
+
+  out << "\nvertices\n" << nv[0] * nv[1] * nv[2] << '\n' << dim << '\n';
+  for (int k = 0; k < nv[2]; k++) {
+    for (int j = 0; j < nv[1]; j++) {
+      for (int i = 0; i < nv[0]; i++) {
+        const std::array<int, 3> index = {i, j, k};
+        for (std::size_t d = 0; d < dim; d++) {
+          out << ((d > 0) ? " " : "") << overall_size[d] * (box.first[d] + index[d]) / elements[d];
+        }
+        out << '\n';
+      }
+    }
+  }
+  out << "mfem_serial_mesh_end\n";
+
+  out << "\ncommunication_groups\nnumber_of_groups " << groups.size() << "\n\n";
+  for (const auto& group : groups) {
+    out << group.size();
+    for (int r : group) {
+      out << ' ' << r;
+    }
+    out << '\n';
+  }
+
+  std::size_t total_vertices = 0;
+  std::size_t total_edges    = 0;
+  std::size_t total_faces    = 0;
+  for (const auto& entities : shared) {
+    total_vertices += entities.vertices.size();
+    total_edges += entities.edges.size();
+    total_faces += entities.faces.size();
+  }
+  out << "\ntotal_shared_vertices " << total_vertices << "\ntotal_shared_edges " << total_edges << '\n';
+  if (dim == 3) {
+    out << "total_shared_faces " << total_faces << '\n';
+  }
+  for (std::size_t g = 1; g < groups.size(); g++) {
+    out << "\n#group " << g << "\nshared_vertices " << shared[g].vertices.size() << '\n';
+    for (int v : shared[g].vertices) {
+      out << v << '\n';
+    }
+    out << "\nshared_edges " << shared[g].edges.size() << '\n';
+    for (const auto& edge : shared[g].edges) {
+      out << edge[0] << ' ' << edge[1] << '\n';
+    }
+    if (dim == 3) {
+      out << "\nshared_faces " << shared[g].faces.size() << '\n';
+      for (const auto& face : shared[g].faces) {
+        out << mfem::Geometry::SQUARE << ' ' << face[0] << ' ' << face[1] << ' ' << face[2] << ' ' << face[3] << '\n';
+      }
+    }
+  }
+  out << "\nmfem_mesh_end\n";
+
+  std::istringstream input(out.str());
+  return std::make_shared<mfem::ParMesh>(comm, input);
+}
+
+}  // namespace serac
@@ -0,0 +1,86 @@
+// Copyright (c) 2019-2021, Lawrence Livermore National Security, LLC and
+// other Serac Project Developers. See the top-level LICENSE file for
+// details.
+//
+// SPDX-License-Identifier: (BSD-3-Clause)
+
+/**
+ * @file structured_mesh.hpp
+ *
+ * @brief Generators for structured meshes that build each rank's block directly in parallel
+ */
+
+#pragma once
+
+#include <array>
+#include <memory>
+#include <vector>
+
+#include "mfem.hpp"
+
+namespace serac {
+
+namespace mesh {
+
+/**
+ * @brief A decomposition of a structured grid of elements into one box-shaped block per rank
+ *
+ * Unused directions of a 2D grid have a single block spanning a single element.
+ */
+struct BoxDecomposition {
+  /**
+   * @brief The number of blocks in each direction
+   */
+  std::array<int, 3> blocks;
+
+  /**
+   * @brief The index of this rank's block in each direction
+   */
+  std::array<int, 3> block;
+
+  /**
+   * @brief The first element of this rank's block in each direction
+   */
+  std::array<int, 3> first;
+
+  /**
+   * @brief One past the last element of this rank's block in each direction
+   */
+  std::array<int, 3> last;
+};
+
+/**
+ * @brief Splits a structured grid of elements into one block per rank
+ *
+ * The number of blocks in each direction is chosen to minimize the number of element faces
+ * on the interfaces between blocks, and the elements in each direction are split as evenly
+ * as possible. Ranks are assigned to blocks with the x index varying fastest.
+ *
+ * @param[in] elements The number of elements in each direction, of size 2 or 3
+ * @param[in] num_ranks The number of blocks
+ * @param[in] rank The rank whose block is returned
+ * @return The decomposition, as seen from the given rank
+ */
+BoxDecomposition decomposeBox(const std::vector<int>& elements, const int num_ranks, const int rank);
+
+}  // namespace mesh
+
+/**
+ * @brief Constructs a rectangle or cuboid mesh without ever building the global mesh
+ *
+ * Each rank generates only the quadrilaterals or hexahedra of its own block of a box
+ * decomposition of the grid, along with the shared vertices, edges, and faces on the
+ * interfaces with its neighbors, so memory use and generation time per rank are independent
+ * of the total mesh size. The elements, vertices, and boundary attributes match those of
+ * buildRectangleMesh and buildCuboidMesh, only the partitioning differs.
+ *
+ * @param[in] elements The number of elements in each direction, of size 2 or 3
+ * @param[in] overall_size The size of the domain in each direction, of the same size as elements
+ * @param[in] comm The MPI communicator
+ * @return A shared_ptr containing the constructed mesh
+ */
+std::shared_ptr<mfem::ParMesh> buildStructuredMesh(const std::vector<int>&    elements,
+                                                   const std::vector<double>& overall_size,
+                                                   const MPI_Comm             comm = MPI_COMM_WORLD);
+
+}  // namespace serac
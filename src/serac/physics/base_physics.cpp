@@ -6,13 +6,54 @@
 
 #include "serac/physics/base_physics.hpp"
 
+#include <algorithm>
 #include <fstream>
+#include <sstream>
 
 #include "fmt/fmt.hpp"
 
 #include "serac/infrastructure/initialize.hpp"
 #include "serac/infrastructure/logger.hpp"
+#include "serac/infrastructure/profiling.hpp"
 #include "serac/infrastructure/terminator.hpp"
+#include "serac/numerics/partitioning.hpp"
+
+namespace {
+
+/**
+ * @brief A copy of a parallel mesh that communicates on its own duplicated communicator
+ *
+ * Output snapshots are written from a background thread, so collectives issued while
+ * saving (e.g., when creating output directories) must not interleave with the solver's
+ * communication on the original mesh's communicator.
+ */
+class SnapshotMesh : public mfem::ParMesh {
+public:
+  /**
+   * @brief Deep-copies a mesh, including its nodes
+   *
+   * @param[in] mesh The mesh to copy
+   */
+  explicit SnapshotMesh(const mfem::ParMesh& mesh) : mfem::ParMesh(mesh, true)
+  {
+    MPI_Comm_dup(mesh.GetComm(), &MyComm);
+    gtopo.SetComm(MyComm);
+  }
+
+  /**
+   * @brief Frees the duplicated communicator
+   */
+  ~SnapshotMesh()
+  {
+    int mpi_finalized = 0;
+    MPI_Finalized(&mpi_finalized);
+    if (!mpi_finalized) {
+      MPI_Comm_free(&MyComm);
+    }
+  }
+};
+
+}  // namespace
 
 namespace serac {
 
@@ -64,30 +105,125 @@ void BasePhysics::setTime(const double time)
 
 double BasePhysics::time() const { return time_; }
 
+void BasePhysics::restart(const std::vector<mfem::Vector>& initial_state)
+{
+  SLIC_ERROR_ROOT_IF(initial_state.size() != state_.size(), mpi_rank_,
+                     fmt::format("Cannot restart {0} state variables from {1} vectors", state_.size(),
+                                 initial_state.size()));
+  for (std::size_t i = 0; i < state_.size(); i++) {
+    auto& state = state_[i].get();
+    SLIC_ERROR_IF(initial_state[i].Size() != state.gridFunc().Size(),
+                  fmt::format("The initial values of '{0}' do not match its space", state.name()));
+    state.gridFunc() = initial_state[i];
+    state.initializeTrueVec();
+  }
+
+  // Multistep integrators start over without any previous time derivatives
+  for (auto& history : history_) {
+    *history.true_dofs = 0.0;
+  }
+
+  time_  = 0.0;
+  cycle_ = 0;
+  bcs_.setTime(time_);
+}
+
 int BasePhysics::cycle() const { return cycle_; }
 
-void BasePhysics::initializeOutput(const serac::OutputType output_type, const std::string& root_name)
+void BasePhysics::initializeOutput(const serac::OutputType output_type, const std::string& root_name,
+                                   const OutputOptions& options)
 {
   root_name_ = root_name;
 
   output_type_ = output_type;
 
+  output_options_ = options;
+
+  // Finish writing anything buffered under a previous configuration before tearing it down
+  output_writer_.reset();
+  aggregated_writer_.reset();
+  dc_.reset();
+  output_buffers_.clear();
+  output_fields_.clear();
+  output_indices_.clear();
+  snapshot_fields_.clear();
+  snapshot_spaces_.clear();
+  snapshot_mesh_.reset();
+
+  bool async = options.async;
+  if (async) {
+    int provided = MPI_THREAD_SINGLE;
+    MPI_Query_thread(&provided);
+    if (provided < MPI_THREAD_MULTIPLE) {
+      SLIC_WARNING_ROOT(mpi_rank_,
+                        "MPI was not initialized with MPI_THREAD_MULTIPLE (see serac::initialize), falling back to "
+                        "synchronous output.");
+      async = false;
+    } else if (mesh_->Nonconforming()) {
+      // The I/O thread's copy of the mesh cannot be made for nonconforming meshes
+      SLIC_WARNING_ROOT(mpi_rank_, "Nonconforming meshes do not support asynchronous output, writing synchronously.");
+      async = false;
+    }
+  }
+
+  // Select the fields to write
+  if (options.fields.empty()) {
+    for (std::size_t i = 0; i < state_.size(); ++i) {
+      output_indices_.push_back(i);
+    }
+  }
+  for (const auto& name : options.fields) {
+    auto match = std::find_if(state_.begin(), state_.end(),
+                              [&name](const FiniteElementState& state) { return state.name() == name; });
+    if (match == state_.end()) {
+      SLIC_ERROR_ROOT(mpi_rank_, fmt::format("Cannot output unknown field '{0}'", name));
+      continue;
+    }
+    output_indices_.push_back(static_cast<std::size_t>(match - state_.begin()));
+  }
+
+  if (async) {
+    // The I/O thread writes from its own copy of the mesh and fields so that the solver
+    // is free to modify the originals (including the mesh nodes) while output is in flight
+    snapshot_mesh_ = std::make_unique<SnapshotMesh>(state_.front().get().mesh());
+    for (auto i : output_indices_) {
+      const auto& space = state_[i].get().space();
+      snapshot_spaces_.push_back(std::make_unique<mfem::ParFiniteElementSpace>(
+          snapshot_mesh_.get(), space.FEColl(), space.GetVDim(), space.GetOrdering()));
+      snapshot_fields_.push_back(std::make_unique<mfem::ParGridFunction>(snapshot_spaces_.back().get()));
+      output_fields_.push_back(snapshot_fields_.back().get());
+    }
+    output_mesh_ = snapshot_mesh_.get();
+  } else {
+    for (auto i : output_indices_) {
+      output_fields_.push_back(&state_[i].get().gridFunc());
+    }
+    output_mesh_ = &state_.front().get().mesh();
+  }
+
+  // ParaView samples high-order fields at their native order unless told otherwise, VisIt keeps
+  // its default of a single level so its output does not grow unless requested
+  int max_order_in_fields = 1;
+  for (auto field : output_fields_) {
+    max_order_in_fields = std::max(max_order_in_fields, field->ParFESpace()->GetOrder(0));
+  }
+
   switch (output_type_) {
     case serac::OutputType::VisIt: {
-      dc_ = std::make_unique<mfem::VisItDataCollection>(root_name_, &state_.front().get().mesh());
+      auto visit_dc = std::make_unique<mfem::VisItDataCollection>(root_name_, output_mesh_);
+      visit_dc->SetLevelsOfDetail(options.levels_of_detail.value_or(1));
+      dc_ = std::move(visit_dc);
       break;
     }
 
     case serac::OutputType::ParaView: {
-      auto pv_dc = std::make_unique<mfem::ParaViewDataCollection>(root_name_, &state_.front().get().mesh());
-      int  max_order_in_fields = 0;
-      for (FiniteElementState& state : state_) {
-        pv_dc->RegisterField(state.name(), &state.gridFunc());
-        max_order_in_fields = std::max(max_order_in_fields, state.space().GetOrder(0));
+      auto pv_dc = std::make_unique<mfem::ParaViewDataCollection>(root_name_, output_mesh_);
+      for (std::size_t i = 0; i < output_fields_.size(); ++i) {
+        pv_dc->RegisterField(state_[output_indices_[i]].get().name(), output_fields_[i]);
       }
-      pv_dc->SetLevelsOfDetail(max_order_in_fields);
+      pv_dc->SetLevelsOfDetail(options.levels_of_detail.value_or(max_order_in_fields));
       pv_dc->SetHighOrderOutput(true);
-      pv_dc->SetDataFormat(mfem::VTKFormat::BINARY);
+      pv_dc->SetDataFormat(options.float32 ? mfem::VTKFormat::BINARY32 : mfem::VTKFormat::BINARY);
       pv_dc->SetCompression(true);
       dc_ = std::move(pv_dc);
       break;
@@ -98,7 +234,7 @@ void BasePhysics::initializeOutput(const serac::OutputType output_type, const st
     }
 
     case OutputType::SidreVisIt: {
-      dc_ = std::make_unique<axom::sidre::MFEMSidreDataCollection>(root_name_, &state_.front().get().mesh());
+      dc_ = std::make_unique<axom::sidre::MFEMSidreDataCollection>(root_name_, output_mesh_);
       break;
     }
 
@@ -107,38 +243,214 @@ void BasePhysics::initializeOutput(const serac::OutputType output_type, const st
   }
 
   if ((output_type_ == OutputType::VisIt) || (output_type_ == OutputType::SidreVisIt)) {
-    // Implicitly convert from ref_wrapper
-    for (FiniteElementState& state : state_) {
-      dc_->RegisterField(state.name(), &state.gridFunc());
+    for (std::size_t i = 0; i < output_fields_.size(); ++i) {
+      dc_->RegisterField(state_[output_indices_[i]].get().name(), output_fields_[i]);
+    }
+  }
+
+  if (options.float32 && (output_type_ != OutputType::ParaView)) {
+    SLIC_WARNING_ROOT(mpi_rank_, "Single precision output is only supported for ParaView, writing double precision.");
+  }
+  if (options.levels_of_detail && (output_type_ != OutputType::ParaView) && (output_type_ != OutputType::VisIt)) {
+    SLIC_WARNING_ROOT(mpi_rank_, "Levels of detail are only supported for ParaView and VisIt output, ignoring.");
+  }
+
+  if (options.aggregators_per_node) {
+    if (output_type_ == OutputType::GLVis) {
+      // Use the output mesh's communicator so that the I/O thread communicates on its own copy
+      aggregated_writer_ = std::make_unique<AggregatedWriter>(output_mesh_->GetComm(), *options.aggregators_per_node);
+    } else {
+      SLIC_WARNING_ROOT(mpi_rank_, "Aggregated output is only supported for GLVis output, ignoring.");
     }
   }
+
+  if (async) {
+    output_writer_ = std::make_unique<AsyncWriter>(options.max_pending);
+    output_buffers_.resize(static_cast<std::size_t>(output_writer_->numSlots()));
+  }
 }
 
 void BasePhysics::outputState() const
 {
+  SERAC_MARK_SCOPE("BasePhysics::outputState");
+  if (!output_writer_) {
+    writeOutput(cycle_, time_);
+    return;
+  }
+
+  // Deep-copy the current state into a free buffer, blocking if the I/O thread is too far behind
+  auto  slot     = output_writer_->acquireSlot();
+  auto& snapshot = output_buffers_[static_cast<std::size_t>(slot)];
+  snapshot.cycle = cycle_;
+  snapshot.time  = time_;
+
+  if (const auto nodes = state_.front().get().mesh().GetNodes()) {
+    snapshot.nodes = *nodes;
+  }
+
+  snapshot.fields.resize(output_indices_.size());
+  for (std::size_t i = 0; i < output_indices_.size(); ++i) {
+    snapshot.fields[i] = state_[output_indices_[i]].get().gridFunc();
+  }
+
+  output_writer_->submit(slot, [this, slot]() {
+    const auto& buffer = output_buffers_[static_cast<std::size_t>(slot)];
+    if (buffer.nodes.Size() > 0) {
+      *output_mesh_->GetNodes() = buffer.nodes;
+    }
+    for (std::size_t i = 0; i < output_fields_.size(); ++i) {
+      *output_fields_[i] = buffer.fields[i];
+    }
+    writeOutput(buffer.cycle, buffer.time);
+  });
+}
+
+void BasePhysics::flushOutput() const
+{
+  if (output_writer_) {
+    output_writer_->flush();
+  }
+}
+
+void BasePhysics::enableRebalancing(const RebalanceOptions& options)
+{
+  SLIC_ERROR_ROOT_IF(!mesh_->Nonconforming(), mpi_rank_,
+                     "Dynamic rebalancing requires a nonconforming mesh, see the nonconforming partition option.");
+  rebalance_options_ = options;
+  takeMeasuredWork();
+}
+
+bool BasePhysics::rebalance()
+{
+  SERAC_MARK_SCOPE("BasePhysics::rebalance");
+  if (!rebalance_options_ || (cycle_ % rebalance_options_->every_n_steps != 0)) {
+    return false;
+  }
+
+  double local_work = takeMeasuredWork();
+  double max_work   = 0.0;
+  double total_work = 0.0;
+  MPI_Allreduce(&local_work, &max_work, 1, MPI_DOUBLE, MPI_MAX, comm_);
+  MPI_Allreduce(&local_work, &total_work, 1, MPI_DOUBLE, MPI_SUM, comm_);
+  if (total_work <= 0.0) {
+    return false;
+  }
+
+  double imbalance = max_work * mpi_size_ / total_work;
+  if (imbalance <= rebalance_options_->imbalance_threshold) {
+    return false;
+  }
+  SLIC_INFO_ROOT(mpi_rank_, fmt::format("Work imbalance of {0:.3f} at cycle {1}, rebalancing", imbalance, cycle_));
+
+  // Spread each rank's work evenly over its elements, with a floor so that elements on
+  // ranks that measured no work still count towards the balance
+  const int           ne           = mesh_->GetNE();
+  double              min_cost     = 1.0e-2 * total_work / static_cast<double>(mesh_->GetGlobalNE());
+  double              element_cost = (ne > 0) ? local_work / ne : 0.0;
+  std::vector<double> weights(static_cast<std::size_t>(ne), std::max(element_cost, min_cost));
+
+  auto partition = rebalancedPartition(*mesh_, weights);
+
+  beginMeshChange();
+  mesh_->Rebalance(partition);
+  endMeshChange();
+  return true;
+}
+
+double BasePhysics::takeMeasuredWork()
+{
+  double work   = work_seconds_;
+  work_seconds_ = 0.0;
+  return work;
+}
+
+void BasePhysics::beginMeshChange()
+{
+  // Buffered output refers to the current partition
+  flushOutput();
+
+  for (auto& history : history_) {
+    history.migrating = std::make_unique<mfem::ParGridFunction>(&history.state->space());
+    history.migrating->SetFromTrueDofs(*history.true_dofs);
+  }
+}
+
+void BasePhysics::endMeshChange()
+{
+  for (auto& state : state_) {
+    state.get().update();
+  }
+
+  for (auto& history : history_) {
+    history.migrating->Update();
+    history.true_dofs->SetSize(history.state->space().GetTrueVSize());
+    history.migrating->GetTrueDofs(*history.true_dofs);
+    history.migrating.reset();
+  }
+
+  bcs_.updateEssentialDofs();
+
+  // The output mesh and data collections are tied to the previous partition
+  if (!root_name_.empty()) {
+    initializeOutput(output_type_, root_name_, output_options_);
+  }
+}
+
+void BasePhysics::registerHistory(mfem::Vector& true_dofs, FiniteElementState& state)
+{
+  history_.push_back({&true_dofs, &state, nullptr});
+}
+
+void BasePhysics::cancelMeshChange()
+{
+  for (auto& history : history_) {
+    history.migrating.reset();
+  }
+}
+
+void BasePhysics::writeOutput(const int cycle, const double time) const
+{
+  SERAC_MARK_SCOPE("BasePhysics::writeOutput");
   switch (output_type_) {
     case serac::OutputType::VisIt:
       [[fallthrough]];
     case serac::OutputType::ParaView:
       [[fallthrough]];
     case serac::OutputType::SidreVisIt: {
-      dc_->SetCycle(cycle_);
-      dc_->SetTime(time_);
+      dc_->SetCycle(cycle);
+      dc_->SetTime(time);
       dc_->Save();
       break;
     }
 
     case serac::OutputType::GLVis: {
-      std::string   mesh_name = fmt::format("{0}-mesh.{1:0>6}.{2:0>6}", root_name_, cycle_, mpi_rank_);
+      if (aggregated_writer_) {
+        std::ostringstream omesh;
+        omesh.precision(FLOAT_PRECISION_);
+        output_mesh_->Print(omesh);
+        aggregated_writer_->write(fmt::format("{0}-mesh.{1:0>6}", root_name_, cycle), omesh.str());
+
+        for (std::size_t i = 0; i < output_fields_.size(); ++i) {
+          std::ostringstream osol;
+          osol.precision(FLOAT_PRECISION_);
+          output_fields_[i]->Save(osol);
+          aggregated_writer_->write(
+              fmt::format("{0}-{1}.{2:0>6}", root_name_, state_[output_indices_[i]].get().name(), cycle), osol.str());
+        }
+        break;
+      }
+
+      std::string   mesh_name = fmt::format("{0}-mesh.{1:0>6}.{2:0>6}", root_name_, cycle, mpi_rank_);
       std::ofstream omesh(mesh_name);
       omesh.precision(FLOAT_PRECISION_);
-      state_.front().get().mesh().Print(omesh);
+      output_mesh_->Print(omesh);
 
-      for (FiniteElementState& state : state_) {
-        std::string   sol_name = fmt::format("{0}-{1}.{2:0>6}.{3:0>6}", root_name_, state.name(), cycle_, mpi_rank_);
+      for (std::size_t i = 0; i < output_fields_.size(); ++i) {
+        std::string sol_name = fmt::format("{0}-{1}.{2:0>6}.{3:0>6}", root_name_,
+                                           state_[output_indices_[i]].get().name(), cycle, mpi_rank_);
         std::ofstream osol(sol_name);
         osol.precision(FLOAT_PRECISION_);
-        state.gridFunc().Save(osol);
+        output_fields_[i]->Save(osol);
       }
       break;
     }
@@ -14,9 +14,12 @@
 
 #include <functional>
 #include <memory>
+#include <optional>
 
 #include "mfem.hpp"
 
+#include "serac/infrastructure/aggregated_writer.hpp"
+#include "serac/infrastructure/async_writer.hpp"
 #include "serac/physics/utilities/boundary_condition_manager.hpp"
 #include "serac/physics/utilities/equation_solver.hpp"
 #include "serac/physics/utilities/finite_element_state.hpp"
@@ -101,6 +104,19 @@ public:
    */
   virtual int cycle() const;
 
+  /**
+   * @brief Return to time zero from the given state to solve another case
+   *
+   * The forms, operators, and solvers that have been set up are kept, so the next solve only
+   * redoes the work that depends on values, e.g., after the material parameters have been
+   * changed between the cases of a parameter sweep. Derived classes extend it to reproject their
+   * essential boundary conditions and restart their time integrators.
+   *
+   * @param[in] initial_state The values of the grid function of each state variable, in the
+   * order of getState()
+   */
+  virtual void restart(const std::vector<mfem::Vector>& initial_state);
+
   /**
    * @brief Complete the setup and allocate the necessary data structures
    *
@@ -121,15 +137,70 @@ public:
    *
    * @param[in] output_type The type of output files to produce
    * @param[in] root_name The root name of the output files
+   * @param[in] options Controls which fields are written, their resolution, and whether
+   * output is written on a background thread
    */
-  virtual void initializeOutput(const serac::OutputType output_type, const std::string& root_name);
+  virtual void initializeOutput(const serac::OutputType output_type, const std::string& root_name,
+                                const OutputOptions& options = {});
 
   /**
    * @brief Output the current state of the PDE fields
    *
+   * With asynchronous output enabled this only copies the fields into a buffer
+   * and returns while the I/O thread writes them
    */
   virtual void outputState() const;
 
+  /**
+   * @brief Block until all buffered output has been written
+   */
+  virtual void flushOutput() const;
+
+  /**
+   * @brief Enable dynamic load rebalancing
+   *
+   * @param[in] options When to check the load balance and how much imbalance to tolerate
+   * @pre The mesh is nonconforming, see mesh::PartitionOptions::nonconforming
+   */
+  void enableRebalancing(const RebalanceOptions& options);
+
+  /**
+   * @brief Repartition the mesh if the work measured since the last check is imbalanced
+   *
+   * This should be called after each timestep. Every RebalanceOptions::every_n_steps cycles,
+   * the work measured by takeMeasuredWork is compared across ranks. If the most loaded rank
+   * exceeds the average by more than the threshold, the mesh is repartitioned so that each
+   * rank receives an equal share of the work, assuming it is spread evenly over each rank's
+   * elements, and the physics module's data is migrated to the new partition.
+   *
+   * @return Whether the mesh was repartitioned
+   */
+  bool rebalance();
+
+  /**
+   * @brief Returns the local work, in seconds, measured since the last call and resets the measurement
+   *
+   * Only rank-local work such as element assembly is measured, as time spent in collective
+   * operations (e.g., linear solves) is the same on every rank regardless of the load balance.
+   */
+  virtual double takeMeasuredWork();
+
+  /**
+   * @brief Prepare for the mesh to be repartitioned, refined, or derefined
+   *
+   * This writes any buffered output and saves the history vectors so they can follow their
+   * elements to their new ranks or be interpolated onto the adapted mesh
+   */
+  virtual void beginMeshChange();
+
+  /**
+   * @brief Migrate the data of the physics module after the mesh has been repartitioned or adapted
+   *
+   * This updates the state variables, history vectors, essential boundary condition DOFs, and
+   * output. Derived classes extend it to rebuild their forms and operators on the new mesh.
+   */
+  virtual void endMeshChange();
+
   /**
    * @brief Destroy the Base Solver object
    */
@@ -141,6 +212,28 @@ public:
   const mfem::ParMesh& mesh() const { return *mesh_; }
 
 protected:
+  /**
+   * @brief Write the output fields at the given cycle and time
+   *
+   * @param[in] cycle The cycle to label the output with
+   * @param[in] time The time to label the output with
+   */
+  void writeOutput(const int cycle, const double time) const;
+
+  /**
+   * @brief Register a vector that must follow its elements when the mesh is repartitioned
+   *
+   * @param[in] true_dofs A true DOF vector on the space of a state variable, e.g., the previous
+   * time derivative used by an ODE integrator
+   * @param[in] state The state variable whose space the vector is defined on
+   */
+  void registerHistory(mfem::Vector& true_dofs, FiniteElementState& state);
+
+  /**
+   * @brief Discard the history saved by beginMeshChange when the mesh was left unchanged
+   */
+  void cancelMeshChange();
+
   /**
    * @brief The MPI communicator
    */
@@ -211,6 +304,74 @@ protected:
    */
   std::unique_ptr<mfem::DataCollection> dc_;
 
+  /**
+   * @brief The mesh written by the output routines
+   *
+   * This is the primary mesh for synchronous output, or the I/O thread's private copy of it
+   * for asynchronous output
+   */
+  mfem::ParMesh* output_mesh_ = nullptr;
+
+  /**
+   * @brief The grid functions written by the output routines, one per selected state variable
+   */
+  std::vector<mfem::ParGridFunction*> output_fields_;
+
+  /**
+   * @brief The indices into state_ of the selected output fields
+   */
+  std::vector<std::size_t> output_indices_;
+
+  /**
+   * @brief A deep copy of the fields and mesh nodes taken by outputState
+   */
+  struct OutputSnapshot {
+    /**
+     * @brief The cycle at which the snapshot was taken
+     */
+    int cycle;
+
+    /**
+     * @brief The time at which the snapshot was taken
+     */
+    double time;
+
+    /**
+     * @brief The mesh nodes, empty if the mesh has no nodal grid function
+     */
+    mfem::Vector nodes;
+
+    /**
+     * @brief The field values, one per selected state variable
+     */
+    std::vector<mfem::Vector> fields;
+  };
+
+  /**
+   * @brief Writes GLVis output into shared files through aggregator ranks, if enabled
+   */
+  std::unique_ptr<AggregatedWriter> aggregated_writer_;
+
+  /**
+   * @brief The private copy of the mesh that the I/O thread writes from
+   */
+  std::unique_ptr<mfem::ParMesh> snapshot_mesh_;
+
+  /**
+   * @brief The finite element spaces of the output fields on snapshot_mesh_
+   */
+  std::vector<std::unique_ptr<mfem::ParFiniteElementSpace>> snapshot_spaces_;
+
+  /**
+   * @brief The output fields on snapshot_mesh_
+   */
+  std::vector<std::unique_ptr<mfem::ParGridFunction>> snapshot_fields_;
+
+  /**
+   * @brief Snapshot buffers, indexed by the slots of output_writer_
+   */
+  mutable std::vector<OutputSnapshot> output_buffers_;
+
   /**
    * @brief State variable initialization indicator
    */
@@ -220,6 +381,54 @@ protected:
    * @brief Boundary condition manager instance
    */
   BoundaryConditionManager bcs_;
+
+  /**
+   * @brief The options the output was last initialized with
+   */
+  OutputOptions output_options_;
+
+  /**
+   * @brief The rebalancing options, empty if rebalancing is disabled
+   */
+  std::optional<RebalanceOptions> rebalance_options_;
+
+  /**
+   * @brief The local work measured since the last load balance check, in seconds
+   */
+  double work_seconds_ = 0.0;
+
+  /**
+   * @brief A vector registered with registerHistory
+   */
+  struct HistoryVector {
+    /**
+     * @brief The true DOF values
+     */
+    mfem::Vector* true_dofs;
+
+    /**
+     * @brief The state variable whose space the vector is defined on
+     */
+    FiniteElementState* state;
+
+    /**
+     * @brief The values as a grid function while the mesh is being repartitioned
+     */
+    std::unique_ptr<mfem::ParGridFunction> migrating;
+  };
+
+  /**
+   * @brief The vectors that must follow their elements when the mesh is repartitioned
+   */
+  std::vector<HistoryVector> history_;
+
+  /**
+   * @brief The background writer used for asynchronous output
+   *
+   * @note This is declared last so that it is destroyed, flushing all pending output,
+   * before the snapshot data it reads from
+   */
+  std::unique_ptr<AsyncWriter> output_writer_;
 };
 
 }  // namespace serac
@@ -7,7 +7,9 @@
 #include "serac/physics/elasticity.hpp"
 
 #include "serac/infrastructure/logger.hpp"
+#include "serac/infrastructure/profiling.hpp"
 #include "serac/infrastructure/terminator.hpp"
+#include "serac/physics/utilities/krylov_solvers.hpp"
 
 namespace serac {
 
@@ -16,7 +18,8 @@ constexpr int NUM_FIELDS = 1;
 Elasticity::Elasticity(int order, std::shared_ptr<mfem::ParMesh> mesh, const LinearSolverOptions& options)
     : BasePhysics(mesh, NUM_FIELDS, order),
       displacement_(
-          *mesh, FiniteElementState::Options{.order = order, .vector_dim = mesh->Dimension(), .name = "displacement"})
+          *mesh, FiniteElementState::Options{.order = order, .vector_dim = mesh->Dimension(), .name = "displacement"}),
+      lin_options_(options)
 {
   mesh->EnsureNodes();
   state_.push_back(displacement_);
@@ -24,7 +27,15 @@ Elasticity::Elasticity(int order, std::shared_ptr<mfem::ParMesh> mesh, const Lin
   // If the user wants the AMG preconditioner with a linear solver, set the pfes to be the displacement
   const auto& augmented_options = mfem_ext::AugmentAMGForElasticity(options, displacement_.space());
 
-  K_inv_          = mfem_ext::EquationSolver(mesh->GetComm(), augmented_options);
+  // If the user wants the p-multigrid preconditioner, describe the stiffness on each level. The elasticity
+  // integrator does not support partial assembly, so every level is assembled.
+  const auto& pmg_options = mfem_ext::AugmentPMultigrid(
+      augmented_options, displacement_.space(),
+      [this](mfem::ParBilinearForm& form) { form.AddDomainIntegrator(new mfem::ElasticityIntegrator(*lambda_, *mu_)); },
+      [this](mfem::ParFiniteElementSpace& space, mfem::Array<int>& dofs) { dofs = bcs_.allEssentialDofs(space); },
+      false);
+
+  K_inv_          = mfem_ext::EquationSolver(mesh->GetComm(), pmg_options);
   is_quasistatic_ = true;
 }
 
@@ -49,8 +60,22 @@ void Elasticity::setLameParameters(mfem::Coefficient& lambda, mfem::Coefficient&
 
 void Elasticity::setBodyForce(mfem::VectorCoefficient& force) { body_force_ = &force; }
 
+void Elasticity::setStaticCondensation(const bool static_condensation)
+{
+  if (static_condensation) {
+    // The coarse levels of p-multigrid are built on the full space
+    const auto iter_options = std::get_if<IterativeSolverOptions>(&lin_options_);
+    if (iter_options && iter_options->prec) {
+      SLIC_ERROR_ROOT_IF(std::holds_alternative<PMultigridPrec>(*iter_options->prec), mpi_rank_,
+                         "Static condensation cannot be combined with the p-multigrid preconditioner.");
+    }
+  }
+  static_condensation_ = static_condensation;
+}
+
 void Elasticity::completeSetup()
 {
+  SERAC_MARK_SCOPE("Elasticity::completeSetup");
   SLIC_ASSERT_MSG(mu_ != nullptr, "Lame mu not set in ElasticitySolver!");
   SLIC_ASSERT_MSG(lambda_ != nullptr, "Lame lambda not set in ElasticitySolver!");
 
@@ -59,8 +84,14 @@ void Elasticity::completeSetup()
 
   // Add the elastic integrator
   K_form_->AddDomainIntegrator(new mfem::ElasticityIntegrator(*lambda_, *mu_));
-  K_form_->Assemble();
-  K_form_->Finalize();
+  if (static_condensation_) {
+    // The form is finalized when the condensed system is formed with the essential DOFs
+    K_form_->EnableStaticCondensation();
+    K_form_->Assemble();
+  } else {
+    K_form_->Assemble();
+    K_form_->Finalize();
+  }
 
   // Define the parallel linear form
 
@@ -75,16 +106,23 @@ void Elasticity::completeSetup()
     l_form_->Assemble();
     rhs_.reset(l_form_->ParallelAssemble());
   } else {
-    rhs_  = displacement_.createOnSpace<mfem::HypreParVector>();
-    *rhs_ = 0.0;
+    *l_form_ = 0.0;
+    rhs_     = displacement_.createOnSpace<mfem::HypreParVector>();
+    *rhs_    = 0.0;
   }
 
-  // Assemble the stiffness matrix
-  K_mat_ = std::unique_ptr<mfem::HypreParMatrix>(K_form_->ParallelAssemble());
+  if (static_condensation_) {
+    // The condensed system lives on the trace space, which AMG has to know about
+    K_inv_ = mfem_ext::EquationSolver(mesh_->GetComm(),
+                                      mfem_ext::AugmentAMGForElasticity(lin_options_, *K_form_->SCParFESpace()));
+  } else {
+    // Assemble the stiffness matrix
+    K_mat_ = std::unique_ptr<mfem::HypreParMatrix>(K_form_->ParallelAssemble());
 
-  // Eliminate the essential DOFs
-  for (auto& bc : bcs_.essentials()) {
-    bc.eliminateFromMatrix(*K_mat_);
+    // Eliminate the essential DOFs
+    for (auto& bc : bcs_.essentials()) {
+      bc.eliminateFromMatrix(*K_mat_);
+    }
   }
 
   // Initialize the eliminate BC RHS vector
@@ -97,6 +135,7 @@ void Elasticity::completeSetup()
 
 void Elasticity::advanceTimestep(double&)
 {
+  SERAC_MARK_SCOPE("Elasticity::advanceTimestep");
   // Initialize the true vector
   displacement_.initializeTrueVec();
 
@@ -114,6 +153,24 @@ void Elasticity::advanceTimestep(double&)
 // Solve the Quasi-static system
 void Elasticity::QuasiStaticSolve()
 {
+  if (static_condensation_) {
+    // The condensed system takes the essential values from the grid function
+    for (auto& bc : bcs_.essentials()) {
+      bc.projectBdr(displacement_, time_, false);
+    }
+
+    mfem::OperatorHandle K_condensed;
+    mfem::Vector         X, B;
+    K_form_->FormLinearSystem(bcs_.allEssentialDofs(), displacement_.gridFunc(), *l_form_, K_condensed, X, B);
+    K_inv_.SetOperator(*K_condensed);
+    K_inv_.Mult(B, X);
+
+    // Recover the interior DOFs element by element
+    K_form_->RecoverFEMSolution(X, *l_form_, displacement_.gridFunc());
+    displacement_.initializeTrueVec();
+    return;
+  }
+
   // Apply the boundary conditions
   *bc_rhs_ = *rhs_;
   for (auto& bc : bcs_.essentials()) {
@@ -126,6 +183,100 @@ void Elasticity::QuasiStaticSolve()
   K_inv_.Mult(*bc_rhs_, displacement_.trueVec());
 }
 
+std::vector<mfem::Vector> Elasticity::solveLoadCases(const std::vector<LoadCase>& load_cases)
+{
+  SERAC_MARK_SCOPE("Elasticity::solveLoadCases");
+  SLIC_ERROR_ROOT_IF(!K_mat_, mpi_rank_, "Load cases require completeSetup to be called without static condensation.");
+
+  const int    size      = displacement_.space().TrueVSize();
+  const int    num_cases = static_cast<int>(load_cases.size());
+  const int    num_attrs = mesh_->bdr_attributes.Size() > 0 ? mesh_->bdr_attributes.Max() : 0;
+  mfem::Vector state     = displacement_.trueVec();
+
+  // Assemble the right-hand side of every case with the essential conditions eliminated
+  mfem::DenseMatrix rhs(size, num_cases);
+  for (int j = 0; j < num_cases; j++) {
+    const auto& load_case = load_cases[static_cast<std::size_t>(j)];
+    auto        l_form    = displacement_.createOnSpace<mfem::ParLinearForm>();
+
+    std::vector<mfem::Array<int>> markers;
+    markers.reserve(load_case.tractions.size());
+    for (const auto& [attrs, traction] : load_case.tractions) {
+      auto& marker = markers.emplace_back(num_attrs);
+      marker       = 0;
+      for (int attr : attrs) {
+        marker[attr - 1] = 1;
+      }
+      l_form->AddBoundaryIntegrator(new mfem::VectorBoundaryLFIntegrator(*traction), marker);
+    }
+    if (load_case.body_force) {
+      l_form->AddDomainIntegrator(new mfem::VectorDomainLFIntegrator(*load_case.body_force));
+    }
+    l_form->Assemble();
+
+    mfem::Vector column(rhs.GetColumn(j), size);
+    l_form->ParallelAssemble(column);
+
+    // The essential values are the same for every case, so they are only projected once
+    for (auto& bc : bcs_.essentials()) {
+      if (j == 0) {
+        bool should_be_scalar = false;
+        bc.apply(*K_mat_, column, displacement_, time_, should_be_scalar);
+      } else {
+        bc.eliminateToRHS(*K_mat_, displacement_.trueVec(), column);
+      }
+    }
+  }
+
+  // The preconditioner or factorization is set up once for all of the cases
+  K_inv_.SetOperator(*K_mat_);
+
+  mfem::DenseMatrix solution(size, num_cases);
+  solution = 0.0;
+
+  const auto iter_options = std::get_if<IterativeSolverOptions>(&lin_options_);
+  if (iter_options && (iter_options->lin_solver == LinearSolver::CG ||
+                       iter_options->lin_solver == LinearSolver::PipelinedCG ||
+                       iter_options->lin_solver == LinearSolver::DeflatedCG)) {
+    mfem_ext::BlockCGSolver block_cg(mesh_->GetComm());
+    block_cg.SetRelTol(iter_options->rel_tol);
+    block_cg.SetAbsTol(iter_options->abs_tol);
+    block_cg.SetMaxIter(iter_options->max_iter);
+    block_cg.SetPrintLevel(iter_options->print_level);
+    block_cg.SetOperator(*K_mat_);
+
+    // Set after the operator, which would otherwise set up the preconditioner again
+    if (auto prec = K_inv_.LinearPreconditioner()) {
+      block_cg.SetPreconditioner(*prec);
+    }
+    block_cg.Mult(rhs, solution);
+  } else {
+    for (int j = 0; j < num_cases; j++) {
+      mfem::Vector rhs_column(rhs.GetColumn(j), size);
+      mfem::Vector solution_column(solution.GetColumn(j), size);
+      K_inv_.Mult(rhs_column, solution_column);
+    }
+  }
+
+  displacement_.trueVec() = state;
+  displacement_.distributeSharedDofs();
+
+  std::vector<mfem::Vector> displacements;
+  displacements.reserve(load_cases.size());
+  for (int j = 0; j < num_cases; j++) {
+    // The copy owns its data, unlike the view of the column
+    const mfem::Vector column(solution.GetColumn(j), size);
+    displacements.push_back(column);
+  }
+  return displacements;
+}
+
+void Elasticity::endMeshChange()
+{
+  BasePhysics::endMeshChange();
+  completeSetup();
+}
+
 Elasticity::~Elasticity() {}
 
 }  // namespace serac
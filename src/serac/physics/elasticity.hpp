@@ -12,6 +12,9 @@
 
 #pragma once
 
+#include <utility>
+#include <vector>
+
 #include "mfem.hpp"
 
 #include "serac/physics/base_physics.hpp"
@@ -31,6 +34,21 @@ namespace serac {
  */
 class Elasticity : public BasePhysics {
 public:
+  /**
+   * @brief The loads of one of several independent load cases
+   */
+  struct LoadCase {
+    /**
+     * @brief The traction coefficients, each with the boundary attributes it acts on
+     */
+    std::vector<std::pair<std::set<int>, std::shared_ptr<mfem::VectorCoefficient>>> tractions;
+
+    /**
+     * @brief The body force, if there is one
+     */
+    std::shared_ptr<mfem::VectorCoefficient> body_force;
+  };
+
   /**
    * @brief Construct a new Elasticity Solver object
    *
@@ -67,6 +85,21 @@ public:
    */
   void advanceTimestep(double& dt) override;
 
+  /**
+   * @brief Solves independent load cases with the current material and displacement conditions
+   *
+   * The stiffness matrix and the preconditioner or factorization are set up once for all of the
+   * cases. With a conjugate gradient linear solver, the cases are solved together by block CG,
+   * which applies the matrix to every case in a single sparse matrix-matrix product per iteration.
+   * Other solvers are applied to one case after the other. The tractions set on the solver itself
+   * are not applied, and the displacement state is left unchanged.
+   *
+   * @param[in] load_cases The loads of each case
+   * @return The true DOFs of the displacement of each case
+   * @pre completeSetup has been called, without static condensation
+   */
+  std::vector<mfem::Vector> solveLoadCases(const std::vector<LoadCase>& load_cases);
+
   /**
    * @brief Set the elastic lame parameters
    *
@@ -82,11 +115,28 @@ public:
    */
   void setBodyForce(mfem::VectorCoefficient& force);
 
+  /**
+   * @brief Eliminate the element-interior DOFs before solving
+   *
+   * The interior DOFs of each element are condensed out during assembly, the system on the
+   * element boundaries is solved globally, and the interior DOFs are recovered element by
+   * element. This pays off for high orders, e.g., p >= 3 on hexahedra, where most DOFs are
+   * interior. It must be set before completeSetup and cannot be combined with p-multigrid.
+   *
+   * @param[in] static_condensation Whether to use static condensation
+   */
+  void setStaticCondensation(const bool static_condensation);
+
   /**
    * @brief Finish the setup of the solver and allocate and initialize the associated MFEM data structures
    */
   void completeSetup() override;
 
+  /**
+   * @brief Reassemble the system after the mesh has been repartitioned
+   */
+  void endMeshChange() override;
+
   /**
    * @brief The destructor
    */
@@ -128,6 +178,16 @@ protected:
    */
   mfem_ext::EquationSolver K_inv_;
 
+  /**
+   * @brief The linear solver options, kept to rebuild the solver on the condensed space
+   */
+  LinearSolverOptions lin_options_;
+
+  /**
+   * @brief Whether the element-interior DOFs are condensed out of the stiffness matrix
+   */
+  bool static_condensation_ = false;
+
   /**
    * @brief Lame mu elasticity parameter
    */
@@ -0,0 +1,167 @@
+// Copyright (c) 2019-2021, Lawrence Livermore National Security, LLC and
+// other Serac Project Developers. See the top-level LICENSE file for
+// details.
+//
+// SPDX-License-Identifier: (BSD-3-Clause)
+
+#include "serac/physics/mixed_nonlinear_solid.hpp"
+
+#include <algorithm>
+
+#include "serac/infrastructure/logger.hpp"
+#include "serac/infrastructure/profiling.hpp"
+#include "serac/integrators/incompressibility_integrator.hpp"
+
+namespace serac {
+
+MixedNonlinearSolid::MixedNonlinearSolid(int order, std::shared_ptr<mfem::ParMesh> mesh, const SolverOptions& options)
+    : NonlinearSolid(order, mesh, options),
+      pressure_(*mesh, FiniteElementState::Options{.order = std::max(order - 1, 1), .name = "pressure"})
+{
+  SLIC_ERROR_ROOT_IF(order < 2, mpi_rank_, "The mixed formulation requires a displacement order of at least 2.");
+  initialize(options);
+}
+
+MixedNonlinearSolid::MixedNonlinearSolid(std::shared_ptr<mfem::ParMesh> mesh, const InputOptions& options)
+    : NonlinearSolid(mesh, options),
+      pressure_(*mesh, FiniteElementState::Options{.order = std::max(options.order - 1, 1), .name = "pressure"})
+{
+  SLIC_ERROR_ROOT_IF(options.order < 2, mpi_rank_,
+                     "The mixed formulation requires a displacement order of at least 2.");
+  initialize(options.solver_options);
+
+  // The base class constructor could only set the full hyperelastic model
+  setHyperelasticMaterialParameters(options.mu, options.K);
+}
+
+void MixedNonlinearSolid::initialize(const SolverOptions& options)
+{
+  SLIC_ERROR_ROOT_IF(options.dyn_options.has_value(), mpi_rank_,
+                     "The mixed formulation is only implemented for quasi-static problems.");
+  SLIC_ERROR_ROOT_IF(options.static_condensation, mpi_rank_,
+                     "Static condensation is not implemented for the mixed formulation.");
+
+  state_.push_back(pressure_);
+  gf_initialized_.push_back(false);
+  pressure_.trueVec() = 0.0;
+
+  // The linear solver sees the coupled system, so the block preconditioner replaces the displacement one
+  const auto& block_options = mfem_ext::AugmentBlockSchur(
+      options.H_lin_options, displacement_.space(), [this]() -> const mfem::HypreParMatrix& { return *schur_; });
+  nonlin_solver_ = mfem_ext::EquationSolver(mesh_->GetComm(), block_options, options.H_nonlin_options);
+}
+
+void MixedNonlinearSolid::setHyperelasticMaterialParameters(const double mu, const double K)
+{
+  // The volumetric response is carried by the pressure, so the displacement only sees the deviatoric part
+  NonlinearSolid::setHyperelasticMaterialParameters(mu, 0.0);
+  shear_modulus_ = mu;
+  bulk_modulus_  = K;
+
+  // After completeSetup, the terms that depend on the bulk modulus are rebuilt
+  if (pressure_form_) {
+    assembleVolumetricTerms();
+  }
+}
+
+void MixedNonlinearSolid::assembleVolumetricTerms()
+{
+  SLIC_ERROR_ROOT_IF(bulk_modulus_ <= 0.0 || shear_modulus_ <= 0.0, mpi_rank_,
+                     "The mixed formulation requires positive shear and bulk moduli.");
+
+  mfem::Array<mfem::ParFiniteElementSpace*> spaces(2);
+  spaces[0]      = &displacement_.space();
+  spaces[1]      = &pressure_.space();
+  pressure_form_ = std::make_unique<mfem::ParBlockNonlinearForm>(spaces);
+  pressure_form_->AddDomainIntegrator(new mfem_ext::IncompressibilityIntegrator(bulk_modulus_));
+
+  // The Schur complement B A^-1 B^T + M / K is spectrally equivalent to (1 / mu + 1 / K) M
+  mfem::ConstantCoefficient compliance(1.0 / shear_modulus_ + 1.0 / bulk_modulus_);
+  auto                      schur_form = pressure_.createOnSpace<mfem::ParBilinearForm>();
+  schur_form->AddDomainIntegrator(new mfem::MassIntegrator(compliance));
+  schur_form->Assemble(0);
+  schur_form->Finalize(0);
+  schur_.reset(schur_form->ParallelAssemble());
+}
+
+void MixedNonlinearSolid::completeSetup()
+{
+  SERAC_MARK_SCOPE("MixedNonlinearSolid::completeSetup");
+  assembleVolumetricTerms();
+
+  block_offsets_.SetSize(3);
+  block_offsets_[0] = 0;
+  block_offsets_[1] = displacement_.space().TrueVSize();
+  block_offsets_[2] = block_offsets_[1] + pressure_.space().TrueVSize();
+  solution_.Update(block_offsets_);
+  block_zero_.SetSize(block_offsets_.Last());
+  block_zero_ = 0.0;
+  displacement_residual_.SetSize(block_offsets_[1]);
+
+  NonlinearSolid::completeSetup();
+}
+
+void MixedNonlinearSolid::quasiStaticSolve()
+{
+  SLIC_ERROR_ROOT_IF(snapshot_basis_ || cubature_, mpi_rank_,
+                     "Reduced-order models are not implemented for the mixed formulation.");
+
+  pressure_.initializeTrueVec();
+  solution_.GetBlock(0) = displacement_.trueVec();
+  solution_.GetBlock(1) = pressure_.trueVec();
+
+  nonlin_solver_.Mult(block_zero_, solution_);
+
+  // A rejected step is restored by advanceTimestep, which only knows about the displacement
+  displacement_.trueVec() = solution_.GetBlock(0);
+  if (!jacobian_violated_) {
+    pressure_.trueVec() = solution_.GetBlock(1);
+  }
+  pressure_.distributeSharedDofs();
+}
+
+std::unique_ptr<mfem::Operator> MixedNonlinearSolid::buildQuasistaticOperator()
+{
+  auto residual = std::make_unique<mfem_ext::StdFunctionOperator>(
+      block_offsets_.Last(),
+
+      // residual function
+      [this](const mfem::Vector& x, mfem::Vector& r) {
+        SERAC_MARK_SCOPE("Residual");
+        profiling::ScopedTimer timer(work_seconds_);
+        const mfem::Vector     u(const_cast<double*>(x.GetData()), block_offsets_[1]);
+        pressure_form_->Mult(x, r);  // r := [p J F^-T; J - 1 - p / K]
+        H_->Mult(u, displacement_residual_);
+
+        mfem::Vector r_u(r.GetData(), block_offsets_[1]);
+        r_u += displacement_residual_;
+        r_u.SetSubVector(bcs_.allEssentialDofs(), 0.0);
+      },
+
+      // gradient of residual function
+      [this](const mfem::Vector& x) -> mfem::Operator& {
+        SERAC_MARK_SCOPE("Jacobian");
+        profiling::ScopedTimer timer(work_seconds_);
+        const mfem::Vector     u(const_cast<double*>(x.GetData()), block_offsets_[1]);
+
+        auto& H_grad = dynamic_cast<mfem::HypreParMatrix&>(H_->GetGradient(u));
+        auto& P_grad = pressure_form_->GetGradient(x);
+        J_uu_.reset(mfem::ParAdd(&H_grad, &dynamic_cast<mfem::HypreParMatrix&>(P_grad.GetBlock(0, 0))));
+        bcs_.eliminateAllEssentialDofsFromMatrix(*J_uu_);
+
+        // The constrained displacements are decoupled from the pressure, which keeps the system symmetric
+        J_up_ = std::make_unique<mfem::HypreParMatrix>(dynamic_cast<mfem::HypreParMatrix&>(P_grad.GetBlock(0, 1)));
+        J_up_->EliminateRows(bcs_.allEssentialDofs());
+        J_pu_.reset(J_up_->Transpose());
+
+        J_block_ = std::make_unique<mfem::BlockOperator>(block_offsets_);
+        J_block_->SetBlock(0, 0, J_uu_.get());
+        J_block_->SetBlock(0, 1, J_up_.get());
+        J_block_->SetBlock(1, 0, J_pu_.get());
+        J_block_->SetBlock(1, 1, &P_grad.GetBlock(1, 1));
+        return *J_block_;
+      });
+  return residual;
+}
+
+}  // namespace serac
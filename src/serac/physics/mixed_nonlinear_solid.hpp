@@ -0,0 +1,151 @@
+// Copyright (c) 2019-2021, Lawrence Livermore National Security, LLC and
+// other Serac Project Developers. See the top-level LICENSE file for
+// details.
+//
+// SPDX-License-Identifier: (BSD-3-Clause)
+
+/**
+ * @file mixed_nonlinear_solid.hpp
+ *
+ * @brief The solver object for nearly incompressible finite deformation hyperelasticity
+ */
+
+#pragma once
+
+#include "mfem.hpp"
+
+#include "serac/physics/nonlinear_solid.hpp"
+
+namespace serac {
+
+/**
+ * @brief The nonlinear solid solver with a mixed displacement-pressure formulation
+ *
+ * The displacement of order p is paired with a continuous pressure of order p - 1 (Taylor-Hood
+ * on simplices, Q2/Q1 and higher on tensor product meshes). The hyperelastic model only carries
+ * the deviatoric response, and the pressure enforces J - 1 = p / K weakly, so the discretization
+ * does not lock as the bulk modulus K grows. The Newton systems are symmetric saddle point
+ * problems, intended for MINRES with the block Schur preconditioner. Only quasi-static problems
+ * are supported.
+ */
+class MixedNonlinearSolid : public NonlinearSolid {
+public:
+  /**
+   * @brief Construct a new Mixed Nonlinear Solid Solver object
+   *
+   * @param[in] order The order of the displacement field, at least 2
+   * @param[in] mesh The MFEM parallel mesh to solve on
+   * @param[in] options The system solver parameters
+   */
+  MixedNonlinearSolid(int order, std::shared_ptr<mfem::ParMesh> mesh, const SolverOptions& options);
+
+  /**
+   * @brief Construct a new Mixed Nonlinear Solid Solver object
+   *
+   * @param[in] mesh The MFEM parallel mesh to solve on
+   * @param[in] options The solver information parsed from the input file
+   */
+  MixedNonlinearSolid(std::shared_ptr<mfem::ParMesh> mesh, const InputOptions& options);
+
+  /**
+   * @brief Set the hyperelastic material parameters
+   *
+   * @param[in] mu Set the mu Lame parameter for the hyperelastic solid
+   * @param[in] K Set the K Lame parameter for the hyperelastic solid, which is carried by the pressure
+   */
+  void setHyperelasticMaterialParameters(double mu, double K) override;
+
+  /**
+   * @brief Get the pressure state
+   *
+   * @return The pressure state field
+   */
+  const FiniteElementState& pressure() const { return pressure_; };
+  FiniteElementState&       pressure() { return pressure_; };
+
+  /**
+   * @brief Complete the setup of all of the internal MFEM objects and prepare for timestepping
+   */
+  void completeSetup() override;
+
+protected:
+  /**
+   * @brief Constructs the quasi-static operator of the coupled displacement and pressure
+   *
+   * @return The quasi-static operator, whose gradient is a 2 x 2 BlockOperator
+   */
+  std::unique_ptr<mfem::Operator> buildQuasistaticOperator() override;
+
+  /**
+   * @brief Complete a quasi-static solve for the displacement and the pressure
+   */
+  void quasiStaticSolve() override;
+
+  /**
+   * @brief Pressure field
+   */
+  FiniteElementState pressure_;
+
+  /**
+   * @brief The shear modulus, which scales the Schur complement approximation
+   */
+  double shear_modulus_ = 0.0;
+
+  /**
+   * @brief The bulk modulus
+   */
+  double bulk_modulus_ = 0.0;
+
+  /**
+   * @brief The form of the pressure terms, coupling the displacement and the pressure
+   */
+  std::unique_ptr<mfem::ParBlockNonlinearForm> pressure_form_;
+
+  /**
+   * @brief The offsets of the displacement and pressure true DOFs in the coupled vectors
+   */
+  mfem::Array<int> block_offsets_;
+
+  /**
+   * @brief The coupled solution vector
+   */
+  mfem::BlockVector solution_;
+
+  /**
+   * @brief zero vector of the coupled dimensions
+   */
+  mfem::Vector block_zero_;
+
+  /**
+   * @brief The displacement residual of the hyperelastic, traction and body force terms
+   */
+  mfem::Vector displacement_residual_;
+
+  /**
+   * @brief The blocks of the Jacobian with the essential displacement DOFs eliminated
+   */
+  std::unique_ptr<mfem::HypreParMatrix> J_uu_, J_up_, J_pu_;
+
+  /**
+   * @brief The Jacobian of the coupled system
+   */
+  std::unique_ptr<mfem::BlockOperator> J_block_;
+
+  /**
+   * @brief The pressure mass matrix scaled by the compliance, approximating the negative Schur complement
+   */
+  std::unique_ptr<mfem::HypreParMatrix> schur_;
+
+private:
+  /**
+   * @brief Adds the pressure to the state and builds the solver with the block Schur preconditioner
+   */
+  void initialize(const SolverOptions& options);
+
+  /**
+   * @brief Builds the pressure form and the Schur complement approximation from the current moduli
+   */
+  void assembleVolumetricTerms();
+};
+
+}  // namespace serac
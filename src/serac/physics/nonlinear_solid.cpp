@@ -7,6 +7,7 @@
 #include "serac/physics/nonlinear_solid.hpp"
 
 #include "serac/infrastructure/logger.hpp"
+#include "serac/infrastructure/profiling.hpp"
 #include "serac/integrators/hyperelastic_traction_integrator.hpp"
 #include "serac/integrators/inc_hyperelastic_integrator.hpp"
 #include "serac/integrators/wrapper_integrator.hpp"
@@ -24,7 +25,8 @@ NonlinearSolid::NonlinearSolid(int order, std::shared_ptr<mfem::ParMesh> mesh, c
       displacement_(
           *mesh, FiniteElementState::Options{.order = order, .vector_dim = mesh->Dimension(), .name = "displacement"}),
       ode2_(displacement_.space().TrueVSize(), {.c0 = c0_, .c1 = c1_, .u = u_, .du_dt = du_dt_, .d2u_dt2 = previous_},
-            nonlin_solver_, bcs_)
+            nonlin_solver_, bcs_),
+      reduced_residual_(0)
 {
   state_.push_back(velocity_);
   state_.push_back(displacement_);
@@ -40,12 +42,34 @@ NonlinearSolid::NonlinearSolid(int order, std::shared_ptr<mfem::ParMesh> mesh, c
   displacement_.trueVec() = 0.0;
   velocity_.trueVec()     = 0.0;
 
+  nonlin_options_ = options.H_nonlin_options;
+
   const auto& lin_options = options.H_lin_options;
   // If the user wants the AMG preconditioner with a linear solver, set the pfes
   // to be the displacement
   const auto& augmented_options = mfem_ext::AugmentAMGForElasticity(lin_options, displacement_.space());
 
-  nonlin_solver_ = mfem_ext::EquationSolver(mesh->GetComm(), augmented_options, options.H_nonlin_options);
+  // If the user wants the LOR preconditioner, provide the low-order-refined Jacobian
+  use_lor_ = mfem_ext::UsesLOR(lin_options);
+
+  const auto& lor_options = mfem_ext::AugmentLOR(augmented_options, displacement_.space(),
+                                                 [this]() -> const mfem::HypreParMatrix& { return *J_lor_; });
+
+  if (options.static_condensation) {
+    SLIC_ERROR_ROOT_IF(options.dyn_options.has_value(), mpi_rank_,
+                       "Static condensation is only implemented for quasi-static problems.");
+    SLIC_ERROR_ROOT_IF(use_lor_, mpi_rank_, "Static condensation cannot be combined with the LOR preconditioner.");
+
+    // Newton solves by condensation, and the user's linear solver only sees the system on the element boundaries
+    condensation_    = std::make_unique<mfem_ext::StaticCondensationSolver>(displacement_.space());
+    skeleton_solver_ = mfem_ext::EquationSolver(
+        mesh->GetComm(), mfem_ext::AugmentAMGForElasticity(lin_options, condensation_->traceSpace()));
+    condensation_->setSkeletonSolver(skeleton_solver_.LinearSolver());
+    nonlin_solver_ = mfem_ext::EquationSolver(mesh->GetComm(), CustomSolverOptions{condensation_.get()},
+                                              options.H_nonlin_options);
+  } else {
+    nonlin_solver_ = mfem_ext::EquationSolver(mesh->GetComm(), lor_options, options.H_nonlin_options);
+  }
 
   // Check for dynamic mode
   if (options.dyn_options) {
@@ -62,6 +86,7 @@ NonlinearSolid::NonlinearSolid(int order, std::shared_ptr<mfem::ParMesh> mesh, c
   du_dt_.SetSize(true_size);
   previous_.SetSize(true_size);
   previous_ = 0.0;
+  registerHistory(previous_, displacement_);
 
   zero_.SetSize(true_size);
   zero_ = 0.0;
@@ -84,6 +109,11 @@ NonlinearSolid::NonlinearSolid(std::shared_ptr<mfem::ParMesh> mesh, const Nonlin
     auto velo = options.initial_velocity->constructVector(dim);
     setVelocity(*velo);
   }
+
+  if (options.min_jacobian) {
+    setMinimumJacobian(*options.min_jacobian);
+  }
+
   setViscosity(std::make_unique<mfem::ConstantCoefficient>(options.viscosity));
 
   for (const auto& [name, bc] : options.boundary_conditions) {
@@ -133,7 +163,11 @@ void NonlinearSolid::addBodyForce(std::shared_ptr<mfem::VectorCoefficient> ext_f
 
 void NonlinearSolid::setHyperelasticMaterialParameters(const double mu, const double K)
 {
-  model_ = std::make_unique<mfem::NeoHookeanModel>(mu, K);
+  if (model_) {
+    *model_ = mfem::NeoHookeanModel(mu, K);
+  } else {
+    model_ = std::make_unique<mfem::NeoHookeanModel>(mu, K);
+  }
 }
 
 void NonlinearSolid::setViscosity(std::unique_ptr<mfem::Coefficient>&& visc_coef) { viscosity_ = std::move(visc_coef); }
@@ -152,8 +186,69 @@ void NonlinearSolid::setVelocity(mfem::VectorCoefficient& velo_state)
   gf_initialized_[0] = true;
 }
 
+void NonlinearSolid::setMinimumJacobian(const double min_jacobian) { min_jacobian_ = min_jacobian; }
+
+bool NonlinearSolid::checkJacobian(const mfem::Vector& displacement)
+{
+  if (!min_jacobian_) {
+    return true;
+  }
+
+  // The reference geometry does not depend on which nodes the mesh currently holds
+  if (!reference_geometry_) {
+    reference_geometry_ = std::make_unique<ReferenceGeometry>(*reference_nodes_);
+  }
+
+  if (reference_geometry_->minJacobian(displacement) < *min_jacobian_) {
+    jacobian_violated_ = true;
+  }
+  return !jacobian_violated_;
+}
+
+void NonlinearSolid::assembleLOR(const mfem::Vector& x, const double c0, const double c1)
+{
+  // The refined mesh is built while the mesh holds the reference nodes, i.e., during a solve
+  if (!lor_) {
+    lor_ = std::make_unique<mfem_ext::LowOrderRefinedSpace>(displacement_.space());
+    if (!is_quasistatic_) {
+      mfem::ConstantCoefficient       rho0(1.0);
+      mfem::VectorMassIntegrator      mass(rho0);
+      mfem::VectorDiffusionIntegrator viscosity(*viscosity_);
+      M_lor_ = lor_->assemble(mass);
+      C_lor_ = lor_->assemble(viscosity);
+    }
+  }
+
+  std::unique_ptr<mfem::SparseMatrix> local_J_lor;
+  if (is_quasistatic_) {
+    mfem_ext::IncrementalHyperelasticIntegrator hyperelastic(model_.get());
+    local_J_lor = lor_->assembleGradient(hyperelastic, x);
+  } else {
+    mfem::HyperelasticNLFIntegrator hyperelastic(model_.get());
+    local_J_lor.reset(mfem::Add(1.0, *M_lor_, c1, *C_lor_));
+    local_J_lor->Add(c0, *lor_->assembleGradient(hyperelastic, x));
+  }
+
+  J_lor_ = lor_->parallelAssemble(*local_J_lor);
+  bcs_.eliminateAllEssentialDofsFromMatrix(*J_lor_);
+}
+
+void NonlinearSolid::assembleElementJacobian(const mfem::Vector& u)
+{
+  mfem_ext::IncrementalHyperelasticIntegrator hyperelastic(model_.get());
+  J_elements_->assembleGradient(hyperelastic, u);
+
+  // The body forces do not depend on the displacement
+  for (auto& nat_bc_data : bcs_.naturals()) {
+    mfem_ext::HyperelasticTractionIntegrator traction(nat_bc_data.vectorCoefficient());
+    J_elements_->addBoundaryGradient(traction, nat_bc_data.markers(), u);
+  }
+  J_elements_->setEssentialDofs(bcs_.allEssentialDofs());
+}
+
 void NonlinearSolid::completeSetup()
 {
+  SERAC_MARK_SCOPE("NonlinearSolid::completeSetup");
   // Define the nonlinear form
   H_ = displacement_.createOnSpace<mfem::ParNonlinearForm>();
 
@@ -215,6 +310,10 @@ void NonlinearSolid::completeSetup()
   // the nonlinear solve.
   nonlin_solver_.NonlinearSolver().iterative_mode = true;
 
+  if (condensation_) {
+    J_elements_ = std::make_unique<mfem_ext::ElementMatrixOperator>(displacement_.space());
+  }
+
   if (is_quasistatic_) {
     residual_ = buildQuasistaticOperator();
 
@@ -227,26 +326,56 @@ void NonlinearSolid::completeSetup()
 
         // residual function
         [this](const mfem::Vector& d2u_dt2, mfem::Vector& r) {
+          SERAC_MARK_SCOPE("Residual");
+          profiling::ScopedTimer timer(work_seconds_);
           r = (*M_mat_) * d2u_dt2 + (*C_mat_) * (du_dt_ + c1_ * d2u_dt2) + (*H_) * (x_ + u_ + c0_ * d2u_dt2);
           r.SetSubVector(bcs_.allEssentialDofs(), 0.0);
         },
 
         // gradient of residual function
         [this](const mfem::Vector& d2u_dt2) -> mfem::Operator& {
+          SERAC_MARK_SCOPE("Jacobian");
+          profiling::ScopedTimer timer(work_seconds_);
+
           // J = M + c1 * C + c0 * H(u_predicted)
           auto localJ = std::unique_ptr<mfem::SparseMatrix>(Add(1.0, M_->SpMat(), c1_, C_->SpMat()));
           localJ->Add(c0_, H_->GetLocalGradient(x_ + u_ + c0_ * d2u_dt2));
           J_mat_.reset(M_->ParallelAssemble(localJ.get()));
           bcs_.eliminateAllEssentialDofsFromMatrix(*J_mat_);
+          if (use_lor_) {
+            assembleLOR(x_ + u_ + c0_ * d2u_dt2, c0_, c1_);
+          }
           return *J_mat_;
         });
   }
 
   nonlin_solver_.SetOperator(*residual_);
+
+  // Each Newton update is checked before it is taken, so the residual is never evaluated at a rejected state.
+  // The displacement leads the unknowns of the quasi-static solve, and the dynamic solve is for the acceleration.
+  if (is_quasistatic_) {
+    nonlin_solver_.SetStateCheck([this](const mfem::Vector& x) {
+      const mfem::Vector u(const_cast<double*>(x.GetData()), displacement_.space().TrueVSize());
+      return checkJacobian(u);
+    });
+  } else {
+    nonlin_solver_.SetStateCheck([this](const mfem::Vector& d2u_dt2) { return checkJacobian(u_ + c0_ * d2u_dt2); });
+  }
 }
 
 // Solve the Quasi-static Newton system
-void NonlinearSolid::quasiStaticSolve() { nonlin_solver_.Mult(zero_, displacement_.trueVec()); }
+void NonlinearSolid::quasiStaticSolve()
+{
+  if (cubature_) {
+    reducedSolve();
+    return;
+  }
+
+  nonlin_solver_.Mult(zero_, displacement_.trueVec());
+  if (snapshot_basis_ && !jacobian_violated_) {
+    recordSnapshot();
+  }
+}
 
 std::unique_ptr<mfem::Operator> NonlinearSolid::buildQuasistaticOperator()
 {
@@ -257,14 +386,28 @@ std::unique_ptr<mfem::Operator> NonlinearSolid::buildQuasistaticOperator()
 
       // residual function
       [this](const mfem::Vector& u, mfem::Vector& r) {
+        SERAC_MARK_SCOPE("Residual");
+        profiling::ScopedTimer timer(work_seconds_);
         H_->Mult(u, r);  // r := H(u)
         r.SetSubVector(bcs_.allEssentialDofs(), 0.0);
       },
 
       // gradient of residual function
       [this](const mfem::Vector& u) -> mfem::Operator& {
+        SERAC_MARK_SCOPE("Jacobian");
+        profiling::ScopedTimer timer(work_seconds_);
+
+        // Static condensation eliminates the interior DOFs element by element, so nothing is assembled globally
+        if (condensation_) {
+          assembleElementJacobian(u);
+          return *J_elements_;
+        }
+
         auto& J = dynamic_cast<mfem::HypreParMatrix&>(H_->GetGradient(u));
         bcs_.eliminateAllEssentialDofsFromMatrix(J);
+        if (use_lor_) {
+          assembleLOR(u);
+        }
         return J;
       });
   return residual;
@@ -273,6 +416,7 @@ std::unique_ptr<mfem::Operator> NonlinearSolid::buildQuasistaticOperator()
 // Advance the timestep
 void NonlinearSolid::advanceTimestep(double& dt)
 {
+  SERAC_MARK_SCOPE("NonlinearSolid::advanceTimestep");
   // Initialize the true vector
   velocity_.initializeTrueVec();
   displacement_.initializeTrueVec();
@@ -282,6 +426,18 @@ void NonlinearSolid::advanceTimestep(double& dt)
 
   bcs_.setTime(time_);
 
+  // Keep the state at the start of the step in case it is rejected
+  const double start_time = time_;
+  mfem::Vector start_displacement;
+  mfem::Vector start_velocity;
+  mfem::Vector start_acceleration;
+  if (min_jacobian_) {
+    start_displacement = displacement_.trueVec();
+    start_velocity     = velocity_.trueVec();
+    start_acceleration = previous_;
+  }
+  jacobian_violated_ = false;
+
   if (is_quasistatic_) {
     quasiStaticSolve();
     // Update the time for housekeeping purposes
@@ -290,6 +446,17 @@ void NonlinearSolid::advanceTimestep(double& dt)
     ode2_.Step(displacement_.trueVec(), velocity_.trueVec(), time_, dt);
   }
 
+  if (jacobian_violated_) {
+    SLIC_WARNING_ROOT(mpi_rank_, fmt::format("Rejecting the timestep at cycle {0}, the deformation gradient "
+                                             "determinant fell below {1}",
+                                             cycle_, *min_jacobian_));
+    time_                   = start_time;
+    displacement_.trueVec() = start_displacement;
+    velocity_.trueVec()     = start_velocity;
+    previous_               = start_acceleration;
+    dt                      = 0.0;
+  }
+
   // Distribute the shared DOFs
   velocity_.distributeSharedDofs();
   displacement_.distributeSharedDofs();
@@ -300,7 +467,356 @@ void NonlinearSolid::advanceTimestep(double& dt)
 
   mesh_->NewNodes(*deformed_nodes_);
 
-  cycle_ += 1;
+  if (!jacobian_violated_) {
+    cycle_ += 1;
+  }
+}
+
+namespace {
+
+/**
+ * @brief Copies the rows of the local modes at the DOFs of an element
+ *
+ * @param[in] local_modes The modes on the local DOFs
+ * @param[in] vdofs The DOFs of the element
+ * @param[out] element_modes The rows at the element DOFs
+ */
+void gatherModes(const mfem::DenseMatrix& local_modes, const mfem::Array<int>& vdofs, mfem::DenseMatrix& element_modes)
+{
+  element_modes.SetSize(vdofs.Size(), local_modes.Width());
+  for (int j = 0; j < local_modes.Width(); j++) {
+    for (int i = 0; i < vdofs.Size(); i++) {
+      element_modes(i, j) = local_modes(vdofs[i], j);
+    }
+  }
+}
+
+/**
+ * @brief Computes the modes of a basis on the local DOFs of its space
+ *
+ * @param[in] basis The basis, whose modes are distributed like the true DOFs of the space
+ * @param[in] space The space
+ * @param[out] local_modes The modes on the local DOFs, one mode per column
+ */
+void prolongateModes(const mfem_ext::ReducedBasis& basis, const mfem::ParFiniteElementSpace& space,
+                     mfem::DenseMatrix& local_modes)
+{
+  const auto& modes = basis.modes();
+  local_modes.SetSize(space.GetVSize(), basis.size());
+  for (int j = 0; j < basis.size(); j++) {
+    const mfem::Vector mode(const_cast<double*>(modes.GetColumn(j)), modes.Height());
+    mfem::Vector       local_mode(local_modes.GetColumn(j), local_modes.Height());
+    space.GetProlongationMatrix()->Mult(mode, local_mode);
+  }
+}
+
+}  // namespace
+
+void NonlinearSolid::recordSnapshots(std::shared_ptr<mfem_ext::ReducedBasis> basis)
+{
+  snapshot_basis_ = basis;
+  training_displacements_.clear();
+  if (snapshot_basis_) {
+    displacement_.initializeTrueVec();
+    recordSnapshot();
+  }
+}
+
+void NonlinearSolid::recordSnapshot()
+{
+  training_displacements_.emplace_back(displacement_.trueVec());
+  mfem::Vector snapshot(displacement_.trueVec());
+  snapshot.SetSubVector(bcs_.allEssentialDofs(), 0.0);
+  snapshot_basis_->addSnapshot(snapshot);
+}
+
+std::shared_ptr<mfem_ext::EmpiricalCubature> NonlinearSolid::trainHyperReduction(const mfem_ext::ReducedBasis& basis,
+                                                                                 const double tolerance)
+{
+  SERAC_MARK_FUNCTION;
+  SLIC_ERROR_ROOT_IF(training_displacements_.empty(), mpi_rank_,
+                     "No snapshots have been recorded to train the hyper-reduction.");
+  SLIC_ERROR_ROOT_IF(basis.size() == 0, mpi_rank_, "The reduced basis has no modes.");
+  SLIC_ERROR_IF(basis.modes().Height() != displacement_.space().TrueVSize(),
+                "The reduced basis is not distributed like the displacement.");
+
+  auto&             space = displacement_.space();
+  mfem::DenseMatrix local_modes;
+  prolongateModes(basis, space, local_modes);
+
+  // The elements are evaluated in the reference configuration
+  mesh_->NewNodes(*reference_nodes_);
+
+  // The rows of the contributions hold the projected element residual at each snapshot in turn
+  const int         size = basis.size();
+  mfem::DenseMatrix contributions(size * static_cast<int>(training_displacements_.size()), space.GetNE());
+  mfem::Vector      local_u(space.GetVSize());
+  mfem::Array<int>  vdofs;
+  mfem::Vector      u_element;
+  mfem::Vector      r_element;
+  mfem::DenseMatrix element_modes;
+  mfem::Vector      contribution(size);
+
+  mfem_ext::IncrementalHyperelasticIntegrator hyperelastic(model_.get());
+  for (std::size_t s = 0; s < training_displacements_.size(); s++) {
+    space.GetProlongationMatrix()->Mult(training_displacements_[s], local_u);
+    for (int e = 0; e < space.GetNE(); e++) {
+      space.GetElementVDofs(e, vdofs);
+      local_u.GetSubVector(vdofs, u_element);
+      hyperelastic.AssembleElementVector(*space.GetFE(e), *space.GetElementTransformation(e), u_element, r_element);
+      gatherModes(local_modes, vdofs, element_modes);
+      element_modes.MultTranspose(r_element, contribution);
+      for (int j = 0; j < size; j++) {
+        contributions(static_cast<int>(s) * size + j, e) = contribution(j);
+      }
+    }
+  }
+
+  mesh_->NewNodes(*deformed_nodes_);
+
+  auto cubature = std::make_shared<mfem_ext::EmpiricalCubature>(mesh_->GetComm());
+  cubature->train(contributions, tolerance);
+  return cubature;
+}
+
+void NonlinearSolid::enableHyperReduction(std::shared_ptr<const mfem_ext::ReducedBasis>      basis,
+                                          std::shared_ptr<const mfem_ext::EmpiricalCubature> cubature)
+{
+  SLIC_ERROR_ROOT_IF(!is_quasistatic_, mpi_rank_, "Hyper-reduction is only implemented for quasi-static problems.");
+  SLIC_ERROR_ROOT_IF(!H_, mpi_rank_, "completeSetup must be called before enabling hyper-reduction.");
+  SLIC_ERROR_ROOT_IF(basis->size() == 0, mpi_rank_, "The reduced basis has no modes.");
+  SLIC_ERROR_IF(basis->modes().Height() != displacement_.space().TrueVSize(),
+                "The reduced basis is not distributed like the displacement.");
+  for (const int e : cubature->elements()) {
+    SLIC_ERROR_IF(e >= mesh_->GetNE(), "The sampled elements were trained on a different mesh.");
+  }
+
+  reduced_basis_ = basis;
+  cubature_      = cubature;
+  prolongateModes(*reduced_basis_, displacement_.space(), local_modes_);
+
+  traction_faces_.clear();
+  for (auto& nat_bc_data : bcs_.naturals()) {
+    auto& faces = traction_faces_.emplace_back();
+    for (int be = 0; be < mesh_->GetNBE(); be++) {
+      if (nat_bc_data.markers()[mesh_->GetBdrAttribute(be) - 1] != 0) {
+        faces.push_back(be);
+      }
+    }
+  }
+
+  // The body forces do not depend on the displacement, so they are projected once in the reference configuration
+  const int size = reduced_basis_->size();
+  body_force_r_.SetSize(size);
+  body_force_r_ = 0.0;
+  if (!ext_force_coefs_.empty()) {
+    mesh_->NewNodes(*reference_nodes_);
+    auto forces = displacement_.createOnSpace<mfem::ParNonlinearForm>();
+    for (auto& force : ext_force_coefs_) {
+      forces->AddDomainIntegrator(new serac::mfem_ext::LinearToNonlinearFormIntegrator(
+          std::make_shared<mfem::VectorDomainLFIntegrator>(*force),
+          std::make_shared<mfem::ParFiniteElementSpace>(*forces->ParFESpace())));
+    }
+    mfem::Vector body_force(displacement_.space().TrueVSize());
+    forces->Mult(zero_, body_force);
+    reduced_basis_->project(body_force, body_force_r_);
+    mesh_->NewNodes(*deformed_nodes_);
+  }
+
+  zero_r_.SetSize(size);
+  zero_r_ = 0.0;
+
+  reduced_residual_ = mfem_ext::StdFunctionOperator(
+      size,
+      [this](const mfem::Vector& coefficients, mfem::Vector& r) {
+        SERAC_MARK_SCOPE("ReducedResidual");
+        profiling::ScopedTimer timer(work_seconds_);
+        reducedResidual(coefficients, r);
+      },
+
+      [this](const mfem::Vector& coefficients) -> mfem::Operator& {
+        SERAC_MARK_SCOPE("ReducedJacobian");
+        profiling::ScopedTimer timer(work_seconds_);
+        reducedGradient(coefficients, J_r_);
+        return J_r_;
+      });
+
+  reduced_solver_ = mfem_ext::EquationSolver(MPI_COMM_SELF, CustomSolverOptions{&J_r_inv_}, nonlin_options_);
+  reduced_solver_.SetOperator(reduced_residual_);
+  reduced_solver_.NonlinearSolver().iterative_mode = true;
+}
+
+void NonlinearSolid::disableHyperReduction()
+{
+  reduced_basis_.reset();
+  cubature_.reset();
+  local_modes_.Clear();
+}
+
+void NonlinearSolid::gatherReducedElement(const int e, const mfem::Vector& coefficients, mfem::Vector& u_element,
+                                          mfem::DenseMatrix& element_modes)
+{
+  mfem::Array<int> vdofs;
+  displacement_.space().GetElementVDofs(e, vdofs);
+  local_bc_values_.GetSubVector(vdofs, u_element);
+  gatherModes(local_modes_, vdofs, element_modes);
+  element_modes.AddMult(coefficients, u_element);
+}
+
+void NonlinearSolid::reducedResidual(const mfem::Vector& coefficients, mfem::Vector& r)
+{
+  auto&             space = displacement_.space();
+  mfem::Vector      u_element;
+  mfem::Vector      r_element;
+  mfem::DenseMatrix element_modes;
+
+  r.SetSize(coefficients.Size());
+  r = 0.0;
+
+  mfem_ext::IncrementalHyperelasticIntegrator hyperelastic(model_.get());
+  for (std::size_t i = 0; i < cubature_->elements().size(); i++) {
+    const int e = cubature_->elements()[i];
+    gatherReducedElement(e, coefficients, u_element, element_modes);
+    hyperelastic.AssembleElementVector(*space.GetFE(e), *space.GetElementTransformation(e), u_element, r_element);
+    r_element *= cubature_->weights()[i];
+    element_modes.AddMultTranspose(r_element, r);
+  }
+
+  // The face contributes to the element it bounds, as in mfem::NonlinearForm::Mult
+  std::size_t natural = 0;
+  for (auto& nat_bc_data : bcs_.naturals()) {
+    mfem_ext::HyperelasticTractionIntegrator traction(nat_bc_data.vectorCoefficient());
+    for (const int be : traction_faces_[natural]) {
+      auto tr = mesh_->GetBdrFaceTransformations(be);
+      if (tr == nullptr) {
+        continue;
+      }
+      const auto& fe = *space.GetFE(tr->Elem1No);
+      gatherReducedElement(tr->Elem1No, coefficients, u_element, element_modes);
+      traction.AssembleFaceVector(fe, fe, *tr, u_element, r_element);
+      element_modes.AddMultTranspose(r_element, r);
+    }
+    natural++;
+  }
+
+  MPI_Allreduce(MPI_IN_PLACE, r.GetData(), r.Size(), MPI_DOUBLE, MPI_SUM, mesh_->GetComm());
+  r += body_force_r_;
+}
+
+void NonlinearSolid::reducedGradient(const mfem::Vector& coefficients, mfem::DenseMatrix& J)
+{
+  auto&             space = displacement_.space();
+  mfem::Vector      u_element;
+  mfem::DenseMatrix element_modes;
+  mfem::DenseMatrix element_matrix;
+  mfem::DenseMatrix applied_modes;
+  mfem::DenseMatrix projected(coefficients.Size());
+
+  J.SetSize(coefficients.Size());
+  J = 0.0;
+
+  mfem_ext::IncrementalHyperelasticIntegrator hyperelastic(model_.get());
+  for (std::size_t i = 0; i < cubature_->elements().size(); i++) {
+    const int e = cubature_->elements()[i];
+    gatherReducedElement(e, coefficients, u_element, element_modes);
+    hyperelastic.AssembleElementGrad(*space.GetFE(e), *space.GetElementTransformation(e), u_element, element_matrix);
+    applied_modes.SetSize(element_matrix.Height(), element_modes.Width());
+    mfem::Mult(element_matrix, element_modes, applied_modes);
+    mfem::MultAtB(element_modes, applied_modes, projected);
+    J.Add(cubature_->weights()[i], projected);
+  }
+
+  std::size_t natural = 0;
+  for (auto& nat_bc_data : bcs_.naturals()) {
+    mfem_ext::HyperelasticTractionIntegrator traction(nat_bc_data.vectorCoefficient());
+    for (const int be : traction_faces_[natural]) {
+      auto tr = mesh_->GetBdrFaceTransformations(be);
+      if (tr == nullptr) {
+        continue;
+      }
+      const auto& fe = *space.GetFE(tr->Elem1No);
+      gatherReducedElement(tr->Elem1No, coefficients, u_element, element_modes);
+      traction.AssembleFaceGrad(fe, fe, *tr, u_element, element_matrix);
+      applied_modes.SetSize(element_matrix.Height(), element_modes.Width());
+      mfem::Mult(element_matrix, element_modes, applied_modes);
+      mfem::MultAtB(element_modes, applied_modes, projected);
+      J += projected;
+    }
+    natural++;
+  }
+
+  MPI_Allreduce(MPI_IN_PLACE, J.GetData(), J.Height() * J.Width(), MPI_DOUBLE, MPI_SUM, mesh_->GetComm());
+}
+
+void NonlinearSolid::reducedSolve()
+{
+  SERAC_MARK_FUNCTION;
+
+  // The displacement is its boundary values plus a combination of the modes, which vanish on the boundary
+  bc_values_ = displacement_.trueVec();
+  bc_values_.SetSubVectorComplement(bcs_.allEssentialDofs(), 0.0);
+  local_bc_values_.SetSize(displacement_.space().GetVSize());
+  displacement_.space().GetProlongationMatrix()->Mult(bc_values_, local_bc_values_);
+  reduced_basis_->project(displacement_.trueVec(), coefficients_);
+
+  reduced_solver_.Mult(zero_r_, coefficients_);
+
+  reduced_basis_->lift(coefficients_, displacement_.trueVec());
+  displacement_.trueVec() += bc_values_;
+}
+
+void NonlinearSolid::restart(const std::vector<mfem::Vector>& initial_state)
+{
+  BasePhysics::restart(initial_state);
+  jacobian_violated_ = false;
+
+  // The boundary values are projected in the reference configuration at the initial time, as in completeSetup
+  mesh_->NewNodes(*reference_nodes_);
+  for (auto& bc : bcs_.essentials()) {
+    bc.project(displacement_);
+  }
+  displacement_.initializeTrueVec();
+  ode2_.Resize(displacement_.space().TrueVSize());
+
+  deformed_nodes_->Set(1.0, displacement_.gridFunc());
+  deformed_nodes_->Add(1.0, *reference_nodes_);
+  mesh_->NewNodes(*deformed_nodes_);
+}
+
+void NonlinearSolid::endMeshChange()
+{
+  BasePhysics::endMeshChange();
+
+  // The modes and the sampled elements belong to the old mesh
+  if (cubature_) {
+    SLIC_WARNING_ROOT(mpi_rank_, "The mesh has changed, returning to the full model.");
+    disableHyperReduction();
+  }
+  if (snapshot_basis_) {
+    SLIC_WARNING_ROOT(mpi_rank_, "The mesh has changed, no longer recording snapshots.");
+    recordSnapshots(nullptr);
+  }
+
+  // Only the grid function currently used as the mesh nodes is migrated by the mesh itself
+  reference_nodes_->Update();
+  deformed_nodes_->Update();
+  reference_geometry_.reset();
+  lor_.reset();
+  if (condensation_) {
+    condensation_->update();
+  }
+
+  int true_size = displacement_.space().TrueVSize();
+  x_.SetSize(true_size);
+  reference_nodes_->GetTrueDofs(x_);
+
+  u_.SetSize(true_size);
+  du_dt_.SetSize(true_size);
+  zero_.SetSize(true_size);
+  zero_ = 0.0;
+  ode2_.Resize(true_size);
+
+  completeSetup();
 }
 
 NonlinearSolid::~NonlinearSolid() {}
@@ -331,6 +847,14 @@ void NonlinearSolid::InputOptions::defineInputFileSchema(axom::inlet::Table& tab
   serac::input::CoefficientInputOptions::defineInputFileSchema(init_displ);
   auto& init_velo = table.addStruct("initial_velocity", "Coefficient for initial condition");
   serac::input::CoefficientInputOptions::defineInputFileSchema(init_velo);
+
+  table.addDouble("min_jacobian", "Reject timesteps where the deformation gradient determinant falls below this");
+
+  table.addBool("mixed", "Use a mixed displacement-pressure formulation for nearly incompressible materials.")
+      .defaultValue(false);
+
+  table.addBool("static_condensation", "Eliminate the element-interior DOFs from the Newton systems.")
+      .defaultValue(false);
 }
 
 }  // namespace serac
@@ -392,5 +916,10 @@ NonlinearSolid::InputOptions FromInlet<NonlinearSolid::InputOptions>::operator()
   if (base.contains("initial_velocity")) {
     result.initial_velocity = base["initial_velocity"].get<serac::input::CoefficientInputOptions>();
   }
+  if (base.contains("min_jacobian")) {
+    result.min_jacobian = base["min_jacobian"].get<double>();
+  }
+  result.mixed                              = base["mixed"];
+  result.solver_options.static_condensation = base["static_condensation"];
   return result;
 }
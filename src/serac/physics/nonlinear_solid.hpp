@@ -20,6 +20,11 @@
 #include "serac/physics/base_physics.hpp"
 #include "serac/physics/operators/odes.hpp"
 #include "serac/physics/operators/stdfunction_operator.hpp"
+#include "serac/physics/utilities/empirical_cubature.hpp"
+#include "serac/physics/utilities/low_order_refined.hpp"
+#include "serac/physics/utilities/reduced_basis.hpp"
+#include "serac/physics/utilities/reference_geometry.hpp"
+#include "serac/physics/utilities/static_condensation.hpp"
 
 namespace serac {
 
@@ -47,6 +52,8 @@ public:
     LinearSolverOptions                H_lin_options;
     NonlinearSolverOptions             H_nonlin_options;
     std::optional<TimesteppingOptions> dyn_options = std::nullopt;
+    // Whether the Newton systems are solved by static condensation of the element-interior DOFs
+    bool static_condensation = false;
   };
 
   /**
@@ -76,6 +83,12 @@ public:
     // Initial conditions for displacement and velocity
     std::optional<input::CoefficientInputOptions> initial_displacement;
     std::optional<input::CoefficientInputOptions> initial_velocity;
+
+    // Smallest deformation gradient determinant allowed before a timestep is rejected
+    std::optional<double> min_jacobian;
+
+    // Whether to use the mixed displacement-pressure formulation for nearly incompressible materials
+    bool mixed = false;
   };
 
   /**
@@ -140,10 +153,13 @@ public:
   /**
    * @brief Set the hyperelastic material parameters
    *
+   * The integrators refer to the material model, so it is updated in place and the parameters can
+   * also be changed after completeSetup.
+   *
    * @param[in] mu Set the mu Lame parameter for the hyperelastic solid
    * @param[in] K Set the K Lame parameter for the hyperelastic solid
    */
-  void setHyperelasticMaterialParameters(double mu, double K);
+  virtual void setHyperelasticMaterialParameters(double mu, double K);
 
   /**
    * @brief Set the initial displacement value
@@ -175,6 +191,66 @@ public:
   const FiniteElementState& velocity() const { return velocity_; };
   FiniteElementState&       velocity() { return velocity_; };
 
+  /**
+   * @brief Reject timesteps that distort elements too much
+   *
+   * The determinant of the deformation gradient is checked at every quadrature point of the
+   * configuration each Newton update would produce, before it is taken. Once it falls below the
+   * given value, the nonlinear solve stops unconverged without evaluating the residual at the bad
+   * configuration, the state is restored to the start of the step, and advanceTimestep returns a
+   * timestep of zero.
+   *
+   * @param[in] min_jacobian The smallest allowed determinant, e.g., zero to reject inverted elements
+   */
+  void setMinimumJacobian(const double min_jacobian);
+
+  /**
+   * @brief Record the displacement after every full-order quasi-static solve as a snapshot of a reduced basis
+   *
+   * The current displacement is recorded immediately. The essential DOFs are zeroed in the
+   * snapshots, as the reduced model takes them from the boundary conditions, and the full
+   * displacements are kept to train the hyper-reduction.
+   *
+   * @param[in] basis The basis to add the snapshots to, or nullptr to stop recording
+   */
+  void recordSnapshots(std::shared_ptr<mfem_ext::ReducedBasis> basis);
+
+  /**
+   * @brief Select the elements and weights of a hyper-reduced residual from the recorded snapshots
+   *
+   * The training contributions of an element are the projections onto the modes of its
+   * hyperelastic residual at every recorded displacement. The selected elements and weights
+   * reproduce the projected residual of the whole mesh at the snapshots to the tolerance.
+   *
+   * @param[in] basis The computed basis the reduced model will use
+   * @param[in] tolerance The largest error of the projected residuals, relative to their full-mesh values
+   * @return The sampled elements, which can be used by any solid with the same mesh, partitioning and order
+   */
+  std::shared_ptr<mfem_ext::EmpiricalCubature> trainHyperReduction(const mfem_ext::ReducedBasis& basis,
+                                                                   const double                  tolerance);
+
+  /**
+   * @brief Solve a hyper-reduced model instead of the full quasi-static problem
+   *
+   * The displacement is approximated by its boundary values plus a combination of the basis
+   * modes. The Newton iterations for the mode coefficients evaluate the hyperelastic residual
+   * and tangent only on the sampled elements, scaled by their weights, and the tractions only on
+   * their boundary faces, so their cost does not depend on the size of the mesh. The body
+   * forces do not depend on the displacement and are projected once.
+   *
+   * @param[in] basis The computed basis, whose modes must be distributed like the displacement true DOFs
+   * @param[in] cubature The sampled elements, trained for this basis
+   * @pre completeSetup has been called and the problem is quasi-static. The minimum Jacobian is
+   * not checked by the reduced model.
+   */
+  void enableHyperReduction(std::shared_ptr<const mfem_ext::ReducedBasis>      basis,
+                            std::shared_ptr<const mfem_ext::EmpiricalCubature> cubature);
+
+  /**
+   * @brief Return to solving the full model
+   */
+  void disableHyperReduction();
+
   /**
    * @brief Complete the setup of all of the internal MFEM objects and prepare for timestepping
    */
@@ -184,10 +260,23 @@ public:
    * @brief Advance the timestep
    *
    * @param[inout] dt The timestep to attempt. This will return the actual timestep for adaptive timestepping
-   * schemes
+   * schemes, or zero if the step was rejected by the minimum Jacobian check
    */
   void advanceTimestep(double& dt) override;
 
+  /**
+   * @brief Return to time zero from the given velocity and displacement, keeping the forms and solvers
+   *
+   * @param[in] initial_state The values of the velocity and displacement grid functions, followed
+   * by those of any other state variables
+   */
+  void restart(const std::vector<mfem::Vector>& initial_state) override;
+
+  /**
+   * @brief Migrate the mesh nodes and rebuild the forms after the mesh has been repartitioned
+   */
+  void endMeshChange() override;
+
   /**
    * @brief Destroy the Nonlinear Solid Solver object
    */
@@ -207,6 +296,67 @@ protected:
    */
   virtual void quasiStaticSolve();
 
+  /**
+   * @brief Checks a trial displacement against the minimum Jacobian, if one is set
+   *
+   * @param[in] displacement The true DOFs of the trial displacement
+   * @return Whether the configuration is acceptable, failures are recorded for the current step
+   */
+  bool checkJacobian(const mfem::Vector& displacement);
+
+  /**
+   * @brief Assembles the low-order-refined counterpart of the Jacobian for the LOR preconditioner
+   *
+   * @param[in] x The state passed to the hyperelastic integrator
+   * @param[in] c0 The scaling of the hyperelastic gradient in the dynamic Jacobian M + c1 C + c0 H'
+   * @param[in] c1 The scaling of the viscosity matrix in the dynamic Jacobian
+   */
+  void assembleLOR(const mfem::Vector& x, const double c0 = 1.0, const double c1 = 0.0);
+
+  /**
+   * @brief Assembles the element matrices of the quasi-static Jacobian for static condensation
+   *
+   * @param[in] u The true DOFs of the displacement
+   */
+  void assembleElementJacobian(const mfem::Vector& u);
+
+  /**
+   * @brief Add the current displacement to the snapshots being recorded
+   */
+  void recordSnapshot();
+
+  /**
+   * @brief Solve the hyper-reduced model for the mode coefficients and lift the result to the displacement
+   */
+  void reducedSolve();
+
+  /**
+   * @brief Computes the hyper-reduced residual
+   *
+   * @param[in] coefficients The coefficients of the modes
+   * @param[out] r The residual projected onto the modes
+   */
+  void reducedResidual(const mfem::Vector& coefficients, mfem::Vector& r);
+
+  /**
+   * @brief Computes the hyper-reduced tangent
+   *
+   * @param[in] coefficients The coefficients of the modes
+   * @param[out] J The tangent projected onto the modes
+   */
+  void reducedGradient(const mfem::Vector& coefficients, mfem::DenseMatrix& J);
+
+  /**
+   * @brief Gathers the displacement and the rows of the modes on the DOFs of an element for the reduced model
+   *
+   * @param[in] e The local element
+   * @param[in] coefficients The coefficients of the modes
+   * @param[out] u_element The displacement on the element DOFs
+   * @param[out] element_modes The rows of the modes at the element DOFs
+   */
+  void gatherReducedElement(const int e, const mfem::Vector& coefficients, mfem::Vector& u_element,
+                            mfem::DenseMatrix& element_modes);
+
   /**
    * @brief Velocity field
    */
@@ -235,7 +385,7 @@ protected:
   /**
    * @brief The hyperelastic material model
    */
-  std::unique_ptr<mfem::HyperelasticModel> model_;
+  std::unique_ptr<mfem::NeoHookeanModel> model_;
 
   /**
    * @brief Pointer to the reference mesh data
@@ -247,6 +397,21 @@ protected:
    */
   std::unique_ptr<mfem::ParGridFunction> deformed_nodes_;
 
+  /**
+   * @brief Reference configuration geometry used to check the deformation, built if a minimum Jacobian is set
+   */
+  std::unique_ptr<ReferenceGeometry> reference_geometry_;
+
+  /**
+   * @brief The smallest allowed deformation gradient determinant
+   */
+  std::optional<double> min_jacobian_;
+
+  /**
+   * @brief Whether the minimum Jacobian was violated during the current step
+   */
+  bool jacobian_violated_ = false;
+
   /**
    * @brief Mass matrix
    */
@@ -262,6 +427,46 @@ protected:
    */
   std::unique_ptr<mfem::HypreParMatrix> J_mat_;
 
+  /**
+   * @brief Whether the LOR preconditioner is used, which requires the low-order-refined matrices
+   */
+  bool use_lor_ = false;
+
+  /**
+   * @brief The low-order-refined discretization on the displacement DOFs, built in the reference configuration
+   */
+  std::unique_ptr<mfem_ext::LowOrderRefinedSpace> lor_;
+
+  /**
+   * @brief Low-order-refined local mass matrix
+   */
+  std::unique_ptr<mfem::SparseMatrix> M_lor_;
+
+  /**
+   * @brief Low-order-refined local viscosity matrix
+   */
+  std::unique_ptr<mfem::SparseMatrix> C_lor_;
+
+  /**
+   * @brief Low-order-refined counterpart of the Jacobian, used by the LOR preconditioner
+   */
+  std::unique_ptr<mfem::HypreParMatrix> J_lor_;
+
+  /**
+   * @brief The static condensation of the Newton systems, if it is enabled
+   */
+  std::unique_ptr<mfem_ext::StaticCondensationSolver> condensation_;
+
+  /**
+   * @brief The solver of the condensed systems on the element boundaries
+   */
+  mfem_ext::EquationSolver skeleton_solver_;
+
+  /**
+   * @brief The quasi-static Jacobian stored as element matrices, used with static condensation
+   */
+  std::unique_ptr<mfem_ext::ElementMatrixOperator> J_elements_;
+
   /**
    * @brief Mass bilinear form object
    */
@@ -320,6 +525,72 @@ protected:
    */
   mfem::Vector previous_;
 
+  /**
+   * @brief The nonlinear solver parameters, which the reduced model also uses
+   */
+  NonlinearSolverOptions nonlin_options_;
+
+  /**
+   * @brief The basis that snapshots are being recorded into, unset if they are not
+   */
+  std::shared_ptr<mfem_ext::ReducedBasis> snapshot_basis_;
+
+  /**
+   * @brief The recorded displacements including their boundary values, which train the hyper-reduction
+   */
+  std::vector<mfem::Vector> training_displacements_;
+
+  /**
+   * @brief The basis of the hyper-reduced model, unset if the full model is solved
+   */
+  std::shared_ptr<const mfem_ext::ReducedBasis> reduced_basis_;
+
+  /**
+   * @brief The sampled elements of the hyper-reduced model
+   */
+  std::shared_ptr<const mfem_ext::EmpiricalCubature> cubature_;
+
+  /**
+   * @brief The boundary elements of each traction boundary condition
+   */
+  std::vector<std::vector<int>> traction_faces_;
+
+  /**
+   * @brief The modes on the local DOFs, one mode per column
+   */
+  mfem::DenseMatrix local_modes_;
+
+  /**
+   * @brief The essential boundary values on the true DOFs and on the local DOFs
+   */
+  mfem::Vector bc_values_, local_bc_values_;
+
+  /**
+   * @brief The body forces projected onto the modes
+   */
+  mfem::Vector body_force_r_;
+
+  /**
+   * @brief The coefficients of the modes in the current displacement, and a zero right hand side
+   */
+  mfem::Vector coefficients_, zero_r_;
+
+  /**
+   * @brief The reduced tangent and its factorization
+   */
+  mfem::DenseMatrix        J_r_;
+  mfem::DenseMatrixInverse J_r_inv_;
+
+  /**
+   * @brief The hyper-reduced residual
+   */
+  mfem_ext::StdFunctionOperator reduced_residual_;
+
+  /**
+   * @brief The solver of the hyper-reduced residual, which is replicated on every rank
+   */
+  mfem_ext::EquationSolver reduced_solver_;
+
   // current and previous timesteps
   double c0_, c1_;
 };
@@ -6,6 +6,7 @@
 
 #include "serac/physics/operators/odes.hpp"
 
+#include "serac/infrastructure/profiling.hpp"
 #include "serac/numerics/expr_template_ops.hpp"
 
 namespace serac::mfem_ext {
@@ -76,6 +77,7 @@ void SecondOrderODE::SetTimestepper(const serac::TimestepMethod timestepper)
 
 void SecondOrderODE::Step(mfem::Vector& x, mfem::Vector& dxdt, double& time, double& dt)
 {
+  SERAC_MARK_SCOPE("SecondOrderODE::Step");
   if (second_order_ode_solver_) {
     // if we used a 2nd order method
     second_order_ode_solver_->Step(x, dxdt, time, dt);
@@ -117,6 +119,26 @@ void SecondOrderODE::Step(mfem::Vector& x, mfem::Vector& dxdt, double& time, dou
   }
 }
 
+void SecondOrderODE::Resize(const int n)
+{
+  height = n;
+  width  = first_order_system_ode_solver_ ? 2 * n : n;
+
+  zero_.SetSize(n);
+  zero_ = 0.0;
+  U_minus_.SetSize(n);
+  U_.SetSize(n);
+  U_plus_.SetSize(n);
+  dU_dt_.SetSize(n);
+  d2U_dt2_.SetSize(n);
+
+  if (second_order_ode_solver_) {
+    second_order_ode_solver_->Init(*this);
+  } else if (first_order_system_ode_solver_) {
+    first_order_system_ode_solver_->Init(*this);
+  }
+}
+
 void SecondOrderODE::ImplicitSolve(const double dt, const mfem::Vector& u, mfem::Vector& du_dt)
 {
   /* A second order o.d.e can be recast as a first order system
@@ -148,6 +170,7 @@ void SecondOrderODE::ImplicitSolve(const double dt, const mfem::Vector& u, mfem:
 void SecondOrderODE::Solve(const double time, const double c0, const double c1, const mfem::Vector& u,
                            const mfem::Vector& du_dt, mfem::Vector& d2u_dt2) const
 {
+  SERAC_MARK_SCOPE("SecondOrderODE::Solve");
   // assign these values to variables with greater scope,
   // so that the residual operator can see them
   state_.c0    = c0;
@@ -263,8 +286,26 @@ void FirstOrderODE::SetTimestepper(const serac::TimestepMethod timestepper)
   ode_solver_->Init(*this);
 }
 
+void FirstOrderODE::Resize(const int n)
+{
+  height = n;
+  width  = n;
+
+  zero_.SetSize(n);
+  zero_ = 0.0;
+  U_minus_.SetSize(n);
+  U_.SetSize(n);
+  U_plus_.SetSize(n);
+  dU_dt_.SetSize(n);
+
+  if (ode_solver_) {
+    ode_solver_->Init(*this);
+  }
+}
+
 void FirstOrderODE::Solve(const double dt, const mfem::Vector& u, mfem::Vector& du_dt) const
 {
+  SERAC_MARK_SCOPE("FirstOrderODE::Solve");
   // assign these values to variables with greater scope,
   // so that the residual operator can see them
   state_.dt = dt;
@@ -10,6 +10,7 @@
 
 #include "mfem.hpp"
 
+#include "serac/infrastructure/profiling.hpp"
 #include "serac/physics/utilities/boundary_condition_manager.hpp"
 #include "serac/physics/utilities/equation_solver.hpp"
 
@@ -147,6 +148,16 @@ public:
    */
   void Step(mfem::Vector& x, mfem::Vector& dxdt, double& time, double& dt);
 
+  /**
+   * @brief Changes the number of components in each vector of the ODE
+   *
+   * This is used after the mesh has been repartitioned. The time integrator is
+   * reinitialized, so multistep methods restart from the current state.
+   *
+   * @param[in] n The new number of components
+   */
+  void Resize(const int n);
+
 private:
   /**
    * @brief Internal implementation used for mfem::SOTDO::Mult and mfem::SOTDO::ImplicitSolve
@@ -317,6 +328,7 @@ public:
    */
   void Step(mfem::Vector& x, double& time, double& dt)
   {
+    SERAC_MARK_SCOPE("FirstOrderODE::Step");
     if (ode_solver_) {
       ode_solver_->Step(x, time, dt);
     } else {
@@ -324,6 +336,16 @@ public:
     }
   }
 
+  /**
+   * @brief Changes the number of components in each vector of the ODE
+   *
+   * This is used after the mesh has been repartitioned. The time integrator is
+   * reinitialized, so multistep methods restart from the current state.
+   *
+   * @param[in] n The new number of components
+   */
+  void Resize(const int n);
+
   /**
    * @brief Internal implementation used for mfem::TDO::Mult and mfem::TDO::ImplicitSolve
    * @param[in] dt The time step
@@ -6,7 +6,10 @@
 
 #include "serac/physics/thermal_conduction.hpp"
 
+#include <limits>
+
 #include "serac/infrastructure/logger.hpp"
+#include "serac/infrastructure/profiling.hpp"
 #include "serac/numerics/expr_template_ops.hpp"
 
 namespace serac {
@@ -20,16 +23,37 @@ ThermalConduction::ThermalConduction(int order, std::shared_ptr<mfem::ParMesh> m
                        .order = order, .vector_dim = 1, .ordering = mfem::Ordering::byNODES, .name = "temperature"}),
       residual_(temperature_.space().TrueVSize()),
       ode_(temperature_.space().TrueVSize(), {.u = u_, .dt = dt_, .du_dt = previous_, .previous_dt = previous_dt_},
-           nonlin_solver_, bcs_)
+           nonlin_solver_, bcs_),
+      reduced_residual_(0),
+      reduced_bcs_(*mesh)
 {
   state_.push_back(temperature_);
 
-  nonlin_solver_ = mfem_ext::EquationSolver(mesh->GetComm(), options.T_lin_options, options.T_nonlin_options);
+  // If the user wants the LOR preconditioner, provide the low-order-refined Jacobian
+  use_lor_ = mfem_ext::UsesLOR(options.T_lin_options);
+
+  const auto& lor_options = mfem_ext::AugmentLOR(options.T_lin_options, temperature_.space(),
+                                                 [this]() -> const mfem::HypreParMatrix& { return *J_lor_; });
+
+  // If the user wants the p-multigrid preconditioner, describe the Jacobian on each level
+  const auto& lin_options = mfem_ext::AugmentPMultigrid(
+      lor_options, temperature_.space(),
+      [this](mfem::ParBilinearForm& form) {
+        if (!is_quasistatic_) {
+          form.AddDomainIntegrator(new mfem::MassIntegrator(*mass_coef_));
+        }
+        form.AddDomainIntegrator(new mfem::DiffusionIntegrator(*jacobian_kappa_));
+      },
+      [this](mfem::ParFiniteElementSpace& space, mfem::Array<int>& dofs) { dofs = bcs_.allEssentialDofs(space); },
+      true);
+
+  nonlin_solver_ = mfem_ext::EquationSolver(mesh->GetComm(), lin_options, options.T_nonlin_options);
   nonlin_solver_.SetOperator(residual_);
 
   // Check for dynamic mode
   if (options.dyn_options) {
-    ode_.SetTimestepper(options.dyn_options->timestepper);
+    timestepper_ = options.dyn_options->timestepper;
+    ode_.SetTimestepper(timestepper_);
     ode_.SetEnforcementMethod(options.dyn_options->enforcement_method);
     is_quasistatic_ = false;
   } else {
@@ -43,6 +67,7 @@ ThermalConduction::ThermalConduction(int order, std::shared_ptr<mfem::ParMesh> m
   u_.SetSize(true_size);
   previous_.SetSize(true_size);
   previous_ = 0.0;
+  registerHistory(previous_, temperature_);
 
   zero_.SetSize(true_size);
   zero_ = 0.0;
@@ -64,6 +89,10 @@ ThermalConduction::ThermalConduction(std::shared_ptr<mfem::ParMesh> mesh, const
     setTemperature(*temp);
   }
 
+  if (options.adaptivity) {
+    enableAdaptivity(*options.adaptivity);
+  }
+
   // Process the BCs in sorted order for correct behavior with repeated attributes
   std::map<std::string, input::BoundaryConditionInputOptions> sorted_bcs(options.boundary_conditions.begin(),
                                                                          options.boundary_conditions.end());
@@ -107,6 +136,36 @@ void ThermalConduction::setConductivity(std::unique_ptr<mfem::Coefficient>&& kap
   kappa_ = std::move(kappa);
 }
 
+void ThermalConduction::updateConductivity(const double kappa)
+{
+  auto constant = dynamic_cast<mfem::ConstantCoefficient*>(kappa_.get());
+  SLIC_ERROR_ROOT_IF(!constant, mpi_rank_, "Only a constant conductivity can be updated.");
+  constant->constant = kappa;
+  if (!K_form_) {
+    return;
+  }
+
+  // The integrators refer to the coefficient, so the new values are assembled into the existing matrix
+  *K_form_ = 0.0;
+  K_form_->Assemble(0);
+  K_.reset(K_form_->ParallelAssemble());
+
+  if (lor_) {
+    mfem::DiffusionIntegrator diffusion(*kappa_);
+    K_lor_ = lor_->assemble(diffusion);
+  }
+
+  // The reduced operators were projected with the previous conductivity
+  if (reduced_basis_) {
+    SLIC_WARNING_ROOT(mpi_rank_, "The conductivity has changed, returning to the full model.");
+    disableReducedOrder();
+  }
+
+  // Force the Jacobian to be reassembled
+  J_.reset();
+  previous_dt_ = -1.0;
+}
+
 void ThermalConduction::setSource(std::unique_ptr<mfem::Coefficient>&& source)
 {
   // Set the body source integral coefficient
@@ -125,15 +184,87 @@ void ThermalConduction::setDensity(std::unique_ptr<mfem::Coefficient>&& rho)
   rho_ = std::move(rho);
 }
 
+void ThermalConduction::enableAdaptivity(const AdaptivityOptions& options)
+{
+  adaptivity_options_ = options;
+
+  // Recover a continuous flux in H(div) from the discontinuous gradient of the temperature
+  const int dim      = mesh_->Dimension();
+  const int order    = temperature_.space().GetOrder(0);
+  flux_integrator_   = std::make_unique<mfem::DiffusionIntegrator>();
+  flux_fec_          = std::make_unique<mfem::L2_FECollection>(order, dim);
+  smooth_flux_fec_   = std::make_unique<mfem::RT_FECollection>(order - 1, dim);
+  flux_space_        = std::make_unique<mfem::ParFiniteElementSpace>(mesh_.get(), flux_fec_.get(), dim);
+  smooth_flux_space_ = std::make_unique<mfem::ParFiniteElementSpace>(mesh_.get(), smooth_flux_fec_.get());
+
+  estimator_ = std::make_unique<mfem::L2ZienkiewiczZhuEstimator>(*flux_integrator_, temperature_.gridFunc(),
+                                                                 *flux_space_, *smooth_flux_space_);
+}
+
+bool ThermalConduction::adapt()
+{
+  SERAC_MARK_SCOPE("ThermalConduction::adapt");
+  if (!adaptivity_options_ || (cycle_ % adaptivity_options_->every_n_steps != 0)) {
+    return false;
+  }
+
+  // The estimator only recomputes its errors when the mesh has changed, but the temperature changes every step
+  estimator_->Reset();
+  const mfem::Vector& errors    = estimator_->GetLocalErrors();
+  double              max_error = (errors.Size() > 0) ? errors.Normlinf() : 0.0;
+  MPI_Allreduce(MPI_IN_PLACE, &max_error, 1, MPI_DOUBLE, MPI_MAX, comm_);
+  if (max_error <= 0.0) {
+    return false;
+  }
+
+  const double                  refine_threshold = adaptivity_options_->refine_fraction * max_error;
+  mfem::Array<mfem::Refinement> marked;
+  if (mesh_->GetGlobalNE() < adaptivity_options_->max_elements) {
+    for (int e = 0; e < errors.Size(); e++) {
+      if (errors(e) > refine_threshold) {
+        marked.Append(mfem::Refinement(e));
+      }
+    }
+  }
+  int num_marked = marked.Size();
+  MPI_Allreduce(MPI_IN_PLACE, &num_marked, 1, MPI_INT, MPI_SUM, comm_);
+
+  beginMeshChange();
+  bool changed = false;
+  if (num_marked > 0) {
+    // Conforming refinement is used for simplices and nonconforming refinement otherwise
+    mesh_->GeneralRefine(marked, -1, adaptivity_options_->nc_limit);
+    changed = true;
+  } else if (mesh_->Nonconforming()) {
+    // Coarsen where the maximum error over the children of an element is small
+    changed = mesh_->DerefineByError(errors, adaptivity_options_->derefine_fraction * refine_threshold,
+                                     adaptivity_options_->nc_limit, 1);
+  }
+
+  if (!changed) {
+    cancelMeshChange();
+    return false;
+  }
+
+  endMeshChange();
+  SLIC_INFO_ROOT(mpi_rank_,
+                 fmt::format("Adapted the mesh at cycle {0}, now {1} elements", cycle_, mesh_->GetGlobalNE()));
+  return true;
+}
+
 void ThermalConduction::completeSetup()
 {
+  SERAC_MARK_SCOPE("ThermalConduction::completeSetup");
   SLIC_ASSERT_MSG(kappa_, "Conductivity not set in ThermalSolver!");
 
   // Add the domain diffusion integrator to the K form and assemble the matrix
   K_form_ = temperature_.createOnSpace<mfem::ParBilinearForm>();
   K_form_->AddDomainIntegrator(new mfem::DiffusionIntegrator(*kappa_));
   K_form_->Assemble(0);  // keep sparsity pattern of M and K the same
-  K_form_->Finalize();
+  K_form_->Finalize(0);
+
+  // The conductivity scaled by the timestep, as it appears in the Jacobian
+  jacobian_kappa_ = std::make_unique<mfem::ProductCoefficient>(jacobian_dt_, *kappa_);
 
   // Add the body source to the RS if specified
   l_form_ = temperature_.createOnSpace<mfem::ParLinearForm>();
@@ -156,6 +287,12 @@ void ThermalConduction::completeSetup()
   // Assemble the stiffness matrix
   K_.reset(K_form_->ParallelAssemble());
 
+  if (use_lor_) {
+    lor_ = std::make_unique<mfem_ext::LowOrderRefinedSpace>(temperature_.space());
+    mfem::DiffusionIntegrator diffusion(*kappa_);
+    K_lor_ = lor_->assemble(diffusion);
+  }
+
   // Initialize the eliminated BC RHS vector
   bc_rhs_  = temperature_.createOnSpace<mfem::HypreParVector>();
   *bc_rhs_ = 0.0;
@@ -168,14 +305,22 @@ void ThermalConduction::completeSetup()
         temperature_.space().TrueVSize(),
 
         [this](const mfem::Vector& u, mfem::Vector& r) {
+          SERAC_MARK_SCOPE("Residual");
+          profiling::ScopedTimer timer(work_seconds_);
           r = (*K_) * u;
           r.SetSubVector(bcs_.allEssentialDofs(), 0.0);
         },
 
         [this](const mfem::Vector & /*du_dt*/) -> mfem::Operator& {
+          SERAC_MARK_SCOPE("Jacobian");
+          profiling::ScopedTimer timer(work_seconds_);
           if (J_ == nullptr) {
             J_.reset(K_form_->ParallelAssemble());
             bcs_.eliminateAllEssentialDofsFromMatrix(*J_);
+            if (lor_) {
+              J_lor_ = lor_->parallelAssemble(*K_lor_);
+              bcs_.eliminateAllEssentialDofsFromMatrix(*J_lor_);
+            }
           }
           return *J_;
         });
@@ -189,21 +334,36 @@ void ThermalConduction::completeSetup()
 
     M_form_->AddDomainIntegrator(new mfem::MassIntegrator(*mass_coef_));
     M_form_->Assemble(0);  // keep sparsity pattern of M and K the same
-    M_form_->Finalize();
+    M_form_->Finalize(0);
 
     M_.reset(M_form_->ParallelAssemble());
 
+    if (lor_) {
+      mfem::MassIntegrator mass(*mass_coef_);
+      M_lor_ = lor_->assemble(mass);
+    }
+
     residual_ = mfem_ext::StdFunctionOperator(
         temperature_.space().TrueVSize(),
         [this](const mfem::Vector& du_dt, mfem::Vector& r) {
+          SERAC_MARK_SCOPE("Residual");
+          profiling::ScopedTimer timer(work_seconds_);
           r = (*M_) * du_dt + (*K_) * (u_ + dt_ * du_dt);
           r.SetSubVector(bcs_.allEssentialDofs(), 0.0);
         },
 
         [this](const mfem::Vector & /*du_dt*/) -> mfem::Operator& {
+          SERAC_MARK_SCOPE("Jacobian");
+          profiling::ScopedTimer timer(work_seconds_);
           if (dt_ != previous_dt_) {
             J_.reset(mfem::Add(1.0, *M_, dt_, *K_));
+            jacobian_dt_.constant = dt_;
             bcs_.eliminateAllEssentialDofsFromMatrix(*J_);
+            if (lor_) {
+              auto local_J_lor = std::unique_ptr<mfem::SparseMatrix>(mfem::Add(1.0, *M_lor_, dt_, *K_lor_));
+              J_lor_           = lor_->parallelAssemble(*local_J_lor);
+              bcs_.eliminateAllEssentialDofsFromMatrix(*J_lor_);
+            }
           }
           return *J_;
         });
@@ -212,6 +372,7 @@ void ThermalConduction::completeSetup()
 
 void ThermalConduction::advanceTimestep(double& dt)
 {
+  SERAC_MARK_SCOPE("ThermalConduction::advanceTimestep");
   temperature_.initializeTrueVec();
 
   if (is_quasistatic_) {
@@ -219,12 +380,270 @@ void ThermalConduction::advanceTimestep(double& dt)
   } else {
     SLIC_ASSERT_MSG(gf_initialized_[0], "Thermal state not initialized!");
 
-    // Step the time integrator
-    ode_.Step(temperature_.trueVec(), time_, dt);
+    // Step the reduced model if it is enabled, and the full model if not or if the reduced step is rejected
+    if (!reduced_basis_ || !reducedStep(dt)) {
+      ode_.Step(temperature_.trueVec(), time_, dt);
+
+      // Restart the reduced model from the full solution
+      if (reduced_basis_) {
+        reduced_basis_->project(temperature_.trueVec(), coefficients_);
+      }
+      if (snapshot_basis_) {
+        recordSnapshot();
+      }
+    }
   }
 
   temperature_.distributeSharedDofs();
   cycle_ += 1;
+
+  adapt();
+}
+
+void ThermalConduction::recordSnapshots(std::shared_ptr<mfem_ext::ReducedBasis> basis)
+{
+  snapshot_basis_ = basis;
+  if (snapshot_basis_) {
+    temperature_.initializeTrueVec();
+    recordSnapshot();
+  }
+}
+
+void ThermalConduction::recordSnapshot()
+{
+  mfem::Vector snapshot(temperature_.trueVec());
+  snapshot.SetSubVector(bcs_.allEssentialDofs(), 0.0);
+  snapshot_basis_->addSnapshot(snapshot);
+}
+
+void ThermalConduction::enableReducedOrder(std::shared_ptr<const mfem_ext::ReducedBasis> basis,
+                                           const ReducedOrderOptions&                    options)
+{
+  SLIC_ERROR_ROOT_IF(is_quasistatic_, mpi_rank_, "The reduced-order model is only implemented for dynamic problems.");
+  SLIC_ERROR_ROOT_IF(!M_ || !K_, mpi_rank_, "completeSetup must be called before enabling the reduced-order model.");
+  SLIC_ERROR_ROOT_IF(adaptivity_options_, mpi_rank_, "The reduced-order model cannot be used with adaptivity.");
+  // The error indicator evaluates the residual of a backward Euler step
+  SLIC_ERROR_ROOT_IF(timestepper_ != TimestepMethod::BackwardEuler, mpi_rank_,
+                     "The reduced-order model is only implemented for backward Euler timestepping.");
+  SLIC_ERROR_ROOT_IF(options.check_every_n_steps < 1, mpi_rank_,
+                     "The reduced-order error must be checked at least every step.");
+  SLIC_ERROR_ROOT_IF(basis->size() == 0, mpi_rank_, "The reduced basis has no modes.");
+  SLIC_ERROR_IF(basis->modes().Height() != temperature_.space().TrueVSize(),
+                "The reduced basis is not distributed like the temperature.");
+
+  reduced_basis_   = basis;
+  reduced_options_ = options;
+  reduced_steps_   = 0;
+
+  // Project the operators once, keeping the rows that couple to the boundary values
+  mfem::DenseMatrix M_modes;
+  mfem::DenseMatrix K_modes;
+  reduced_basis_->projectOperator(*M_, M_r_, &M_modes);
+  reduced_basis_->projectOperator(*K_, K_r_, &K_modes);
+
+  const int   size      = reduced_basis_->size();
+  const auto& essential = bcs_.allEssentialDofs();
+  M_modes_essential_.SetSize(essential.Size(), size);
+  K_modes_essential_.SetSize(essential.Size(), size);
+  for (int j = 0; j < size; j++) {
+    for (int i = 0; i < essential.Size(); i++) {
+      M_modes_essential_(i, j) = M_modes(essential[i], j);
+      K_modes_essential_(i, j) = K_modes(essential[i], j);
+    }
+  }
+
+  const int true_size = temperature_.space().TrueVSize();
+  bc_values_.SetSize(true_size);
+  bc_minus_.SetSize(true_size);
+  bc_plus_.SetSize(true_size);
+  bc_rate_.SetSize(true_size);
+  bc_load_r_.SetSize(size);
+  bc_load_time_ = std::numeric_limits<double>::quiet_NaN();
+
+  temperature_.initializeTrueVec();
+  reduced_basis_->project(temperature_.trueVec(), coefficients_);
+  u_r_.SetSize(size);
+  previous_r_.SetSize(size);
+  previous_r_ = 0.0;
+  zero_r_.SetSize(size);
+  zero_r_              = 0.0;
+  reduced_previous_dt_ = -1.0;
+
+  // M_r du_dt + K_r (u + dt du_dt) plus the load of the boundary values at the time of the implicit state
+  reduced_residual_ = mfem_ext::StdFunctionOperator(
+      size,
+      [this](const mfem::Vector& du_dt, mfem::Vector& r) {
+        SERAC_MARK_SCOPE("ReducedResidual");
+        profiling::ScopedTimer timer(work_seconds_);
+        updateReducedBoundaryLoad(reduced_ode_->GetTime());
+        mfem::Vector implicit_u(u_r_);
+        implicit_u.Add(dt_, du_dt);
+        r = bc_load_r_;
+        M_r_.AddMult(du_dt, r);
+        K_r_.AddMult(implicit_u, r);
+      },
+
+      [this](const mfem::Vector & /*du_dt*/) -> mfem::Operator& {
+        SERAC_MARK_SCOPE("ReducedJacobian");
+        profiling::ScopedTimer timer(work_seconds_);
+        J_r_ = M_r_;
+        J_r_.Add(dt_, K_r_);
+        return J_r_;
+      });
+
+  // The reduced system is linear, so Newton converges in one iteration with the dense factorization
+  reduced_solver_ = mfem_ext::EquationSolver(
+      MPI_COMM_SELF, CustomSolverOptions{&J_r_inv_},
+      NonlinearSolverOptions{.rel_tol = 1.0e-10, .abs_tol = 1.0e-14, .max_iter = 5, .print_level = -1});
+  reduced_solver_.SetOperator(reduced_residual_);
+
+  reduced_ode_ = std::make_unique<mfem_ext::FirstOrderODE>(
+      size,
+      mfem_ext::FirstOrderODE::State{
+          .u = u_r_, .dt = dt_, .du_dt = previous_r_, .previous_dt = reduced_previous_dt_},
+      reduced_solver_, reduced_bcs_);
+  reduced_ode_->SetTimestepper(timestepper_);
+}
+
+void ThermalConduction::disableReducedOrder()
+{
+  reduced_basis_.reset();
+  reduced_ode_.reset();
+}
+
+void ThermalConduction::updateReducedBoundaryLoad(const double t)
+{
+  if (t == bc_load_time_) {
+    return;
+  }
+  bc_load_time_ = t;
+
+  // The boundary rate is approximated like the full ODE does
+  bc_values_ = 0.0;
+  bc_minus_  = 0.0;
+  bc_plus_   = 0.0;
+  for (const auto& bc : bcs_.essentials()) {
+    bc.projectBdrToDofs(bc_minus_, t - mfem_ext::FirstOrderODE::epsilon);
+    bc.projectBdrToDofs(bc_values_, t);
+    bc.projectBdrToDofs(bc_plus_, t + mfem_ext::FirstOrderODE::epsilon);
+  }
+  mfem::subtract(bc_plus_, bc_minus_, bc_rate_);
+  bc_rate_ /= 2.0 * mfem_ext::FirstOrderODE::epsilon;
+
+  // The matrices are symmetric, so the rows of M Phi and K Phi give the columns of Phi^T M and Phi^T K
+  const auto&  essential = bcs_.allEssentialDofs();
+  mfem::Vector essential_values(essential.Size());
+  mfem::Vector essential_rate(essential.Size());
+  bc_values_.GetSubVector(essential, essential_values);
+  bc_rate_.GetSubVector(essential, essential_rate);
+  M_modes_essential_.MultTranspose(essential_rate, bc_load_r_);
+  K_modes_essential_.AddMultTranspose(essential_values, bc_load_r_);
+  MPI_Allreduce(MPI_IN_PLACE, bc_load_r_.GetData(), bc_load_r_.Size(), MPI_DOUBLE, MPI_SUM, comm_);
+}
+
+bool ThermalConduction::reducedStep(double& dt)
+{
+  SERAC_MARK_SCOPE("ThermalConduction::reducedStep");
+  const double       start_time = time_;
+  const double       start_dt   = dt;
+  const mfem::Vector start_coefficients(coefficients_);
+
+  reduced_ode_->Step(coefficients_, time_, dt);
+  reduced_steps_++;
+
+  // The temperature is its boundary values plus the combination of the modes, which vanish on the boundary
+  {
+    profiling::ScopedTimer timer(work_seconds_);
+    updateReducedBoundaryLoad(time_);
+    reduced_basis_->lift(coefficients_, reduced_temperature_);
+    reduced_temperature_ += bc_values_;
+  }
+
+  if (reduced_steps_ % reduced_options_.check_every_n_steps == 0) {
+    // The residual of a backward Euler step of the full model, M (u - u_old) / dt + K u
+    mfem::Vector stiffness(reduced_temperature_.Size());
+    mfem::Vector increment(reduced_temperature_.Size());
+    mfem::Vector residual(reduced_temperature_.Size());
+    K_->Mult(reduced_temperature_, stiffness);
+    mfem::subtract(reduced_temperature_, temperature_.trueVec(), increment);
+    M_->Mult(increment, residual);
+    residual *= 1.0 / dt;
+    residual += stiffness;
+    residual.SetSubVector(bcs_.allEssentialDofs(), 0.0);
+
+    const double scale = mfem::ParNormlp(stiffness, 2, comm_);
+    double       error = mfem::ParNormlp(residual, 2, comm_);
+    if (scale > 0.0) {
+      error /= scale;
+    }
+
+    if (error > reduced_options_.error_tolerance) {
+      SLIC_WARNING_ROOT(mpi_rank_, fmt::format("The reduced-order step at cycle {0} has a relative residual of {1}, "
+                                               "repeating it with the full model",
+                                               cycle_, error));
+      time_         = start_time;
+      dt            = start_dt;
+      coefficients_ = start_coefficients;
+      bc_load_time_ = std::numeric_limits<double>::quiet_NaN();
+      full_order_fallbacks_++;
+      return false;
+    }
+  }
+
+  temperature_.trueVec() = reduced_temperature_;
+  return true;
+}
+
+void ThermalConduction::restart(const std::vector<mfem::Vector>& initial_state)
+{
+  BasePhysics::restart(initial_state);
+
+  // The boundary values are projected at the initial time, as in completeSetup
+  for (auto& bc : bcs_.essentials()) {
+    bc.projectBdr(temperature_, time_);
+  }
+  temperature_.initializeTrueVec();
+  ode_.Resize(temperature_.space().TrueVSize());
+
+  if (reduced_basis_) {
+    reduced_basis_->project(temperature_.trueVec(), coefficients_);
+    previous_r_   = 0.0;
+    bc_load_time_ = std::numeric_limits<double>::quiet_NaN();
+    reduced_ode_->Resize(reduced_basis_->size());
+  }
+}
+
+void ThermalConduction::endMeshChange()
+{
+  BasePhysics::endMeshChange();
+
+  // The modes are distributed like the temperature on the old mesh
+  if (reduced_basis_) {
+    SLIC_WARNING_ROOT(mpi_rank_, "The mesh has changed, returning to the full model.");
+    disableReducedOrder();
+  }
+  if (snapshot_basis_) {
+    SLIC_WARNING_ROOT(mpi_rank_, "The mesh has changed, no longer recording snapshots.");
+    snapshot_basis_.reset();
+  }
+
+  int true_size = temperature_.space().TrueVSize();
+  u_.SetSize(true_size);
+  zero_.SetSize(true_size);
+  zero_ = 0.0;
+  ode_.Resize(true_size);
+
+  if (estimator_) {
+    flux_space_->Update(false);
+    smooth_flux_space_->Update(false);
+  }
+
+  // Force the Jacobian to be reassembled on the new partition
+  J_.reset();
+  previous_dt_ = -1.0;
+
+  completeSetup();
+  nonlin_solver_.SetOperator(residual_);
 }
 
 void ThermalConduction::InputOptions::defineInputFileSchema(axom::inlet::Table& table)
@@ -250,6 +669,9 @@ void ThermalConduction::InputOptions::defineInputFileSchema(axom::inlet::Table&
 
   auto& init_temp = table.addStruct("initial_temperature", "Coefficient for initial condition");
   serac::input::CoefficientInputOptions::defineInputFileSchema(init_temp);
+
+  auto& adaptivity_table = table.addStruct("adaptivity", "Adaptive mesh refinement parameters");
+  serac::input::defineAdaptivityOptionsInputFileSchema(adaptivity_table);
 }
 
 }  // namespace serac
@@ -304,5 +726,9 @@ ThermalConduction::InputOptions FromInlet<ThermalConduction::InputOptions>::oper
   if (base.contains("initial_temperature")) {
     result.initial_temperature = base["initial_temperature"].get<serac::input::CoefficientInputOptions>();
   }
+
+  if (base.contains("adaptivity")) {
+    result.adaptivity = base["adaptivity"].get<serac::AdaptivityOptions>();
+  }
   return result;
 }
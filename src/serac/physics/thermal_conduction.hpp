@@ -17,6 +17,8 @@
 #include "serac/physics/base_physics.hpp"
 #include "serac/physics/operators/odes.hpp"
 #include "serac/physics/operators/stdfunction_operator.hpp"
+#include "serac/physics/utilities/low_order_refined.hpp"
+#include "serac/physics/utilities/reduced_basis.hpp"
 
 namespace serac {
 
@@ -40,6 +42,22 @@ public:
     DirichletEnforcementMethod enforcement_method;
   };
 
+  /**
+   * @brief Parameters of the reduced-order model
+   */
+  struct ReducedOrderOptions {
+    /**
+     * @brief The largest residual of the full model, relative to the stiffness term, at which a reduced step is
+     * accepted
+     */
+    double error_tolerance;
+
+    /**
+     * @brief Check the residual of the full model every this many reduced steps
+     */
+    int check_every_n_steps;
+  };
+
   /**
    * @brief A configuration variant for the various solves
    * Either quasistatic, or time-dependent with timestep and M options
@@ -75,6 +93,9 @@ public:
 
     // Initial conditions for temperature
     std::optional<input::CoefficientInputOptions> initial_temperature;
+
+    // Adaptive mesh refinement parameters
+    std::optional<AdaptivityOptions> adaptivity;
   };
 
   static IterativeSolverOptions defaultLinearOptions()
@@ -150,6 +171,17 @@ public:
    */
   void setConductivity(std::unique_ptr<mfem::Coefficient>&& kappa);
 
+  /**
+   * @brief Change the value of a constant thermal conductivity
+   *
+   * After completeSetup, the stiffness matrix is reassembled into its existing sparsity pattern,
+   * so a direct solver can reuse its symbolic factorization for the next Jacobian.
+   *
+   * @param[in] kappa The thermal conductivity
+   * @pre The conductivity was set as an mfem::ConstantCoefficient, e.g., from the input file
+   */
+  void updateConductivity(const double kappa);
+
   /**
    * @brief Set the temperature state vector from a coefficient
    *
@@ -178,6 +210,63 @@ public:
    */
   void setSpecificHeatCapacity(std::unique_ptr<mfem::Coefficient>&& cp);
 
+  /**
+   * @brief Enable adaptive refinement and derefinement of the mesh between timesteps
+   *
+   * The error in each element is estimated by Zienkiewicz-Zhu recovery of the temperature
+   * gradient. Elements with large errors are refined, and when nothing needs refining on a
+   * nonconforming mesh, groups of elements with small errors are coarsened.
+   *
+   * @param[in] options The refinement thresholds and limits
+   * @note The mesh must not be shared with other physics modules
+   */
+  void enableAdaptivity(const AdaptivityOptions& options);
+
+  /**
+   * @brief Adapt the mesh to the current temperature if adaptivity is enabled and due this cycle
+   *
+   * This is called at the end of each timestep.
+   *
+   * @return Whether the mesh was changed
+   */
+  bool adapt();
+
+  /**
+   * @brief Record the temperature after every full-order timestep as a snapshot of a reduced basis
+   *
+   * The current temperature is recorded immediately. The essential DOFs are zeroed in the
+   * snapshots, as the reduced-order model takes them from the boundary conditions.
+   *
+   * @param[in] basis The basis to add the snapshots to, or nullptr to stop recording
+   */
+  void recordSnapshots(std::shared_ptr<mfem_ext::ReducedBasis> basis);
+
+  /**
+   * @brief Step a POD-Galerkin reduced-order model instead of the full model
+   *
+   * The temperature is approximated by its boundary values plus a combination of the basis
+   * modes. The mass and stiffness matrices are projected onto the modes once, so a step only
+   * solves a dense system the size of the basis. Every few steps the residual of the full
+   * model is evaluated at the reduced solution, as a backward Euler step from the previous
+   * temperature. If it is too large the step is repeated with the full model and the reduced
+   * model restarts from the result.
+   *
+   * @param[in] basis The computed basis, whose modes must be distributed like the temperature true DOFs
+   * @param[in] options The error indicator parameters
+   * @pre completeSetup has been called and the problem is dynamic with backward Euler timestepping
+   */
+  void enableReducedOrder(std::shared_ptr<const mfem_ext::ReducedBasis> basis, const ReducedOrderOptions& options);
+
+  /**
+   * @brief Return to stepping the full model
+   */
+  void disableReducedOrder();
+
+  /**
+   * @brief The number of reduced steps that were rejected and repeated with the full model
+   */
+  int fullOrderFallbacks() const { return full_order_fallbacks_; }
+
   /**
    * @brief Get the temperature state
    *
@@ -194,12 +283,44 @@ public:
    */
   void completeSetup() override;
 
+  /**
+   * @brief Return to time zero from the given temperature, keeping the assembled operators and solvers
+   *
+   * @param[in] initial_state The values of the temperature grid function
+   */
+  void restart(const std::vector<mfem::Vector>& initial_state) override;
+
+  /**
+   * @brief Rebuild the forms and operators after the mesh has been repartitioned or adapted
+   */
+  void endMeshChange() override;
+
   /**
    * @brief Destroy the Thermal Solver object
    */
   virtual ~ThermalConduction() = default;
 
 protected:
+  /**
+   * @brief Add the current temperature to the snapshots being recorded
+   */
+  void recordSnapshot();
+
+  /**
+   * @brief Advance the reduced-order model by one timestep
+   *
+   * @param[inout] dt The timestep, which is restored if the step is rejected
+   * @return Whether the step was accepted by the error indicator
+   */
+  bool reducedStep(double& dt);
+
+  /**
+   * @brief Compute the reduced load of the essential boundary values and their rate at a time
+   *
+   * @param[in] t The time
+   */
+  void updateReducedBoundaryLoad(const double t);
+
   /**
    * @brief The temperature finite element state
    */
@@ -268,6 +389,16 @@ protected:
    */
   std::unique_ptr<mfem::Coefficient> mass_coef_;
 
+  /**
+   * @brief The timestep that scales the conductivity in the Jacobian
+   */
+  mfem::ConstantCoefficient jacobian_dt_{1.0};
+
+  /**
+   * @brief Conduction coefficient scaled by the timestep (dt * kappa), used by the p-multigrid levels
+   */
+  std::unique_ptr<mfem::Coefficient> jacobian_kappa_;
+
   /**
    * @brief mfem::Operator that describes the weight residual
    * and its gradient with respect to temperature
@@ -293,6 +424,31 @@ protected:
    */
   std::unique_ptr<mfem::HypreParMatrix> J_;
 
+  /**
+   * @brief Whether the LOR preconditioner is used, which requires the low-order-refined matrices
+   */
+  bool use_lor_ = false;
+
+  /**
+   * @brief The low-order-refined discretization on the temperature DOFs
+   */
+  std::unique_ptr<mfem_ext::LowOrderRefinedSpace> lor_;
+
+  /**
+   * @brief Low-order-refined local mass matrix
+   */
+  std::unique_ptr<mfem::SparseMatrix> M_lor_;
+
+  /**
+   * @brief Low-order-refined local stiffness matrix
+   */
+  std::unique_ptr<mfem::SparseMatrix> K_lor_;
+
+  /**
+   * @brief Low-order-refined counterpart of the Jacobian, used by the LOR preconditioner
+   */
+  std::unique_ptr<mfem::HypreParMatrix> J_lor_;
+
   double       dt_, previous_dt_;
   mfem::Vector zero_;
 
@@ -306,6 +462,129 @@ protected:
    * nonlinear solver
    */
   mfem::Vector previous_;
+
+  /**
+   * @brief Adaptive mesh refinement parameters, unset if adaptivity is disabled
+   */
+  std::optional<AdaptivityOptions> adaptivity_options_;
+
+  /**
+   * @brief Integrator defining the temperature gradient flux used by the error estimator
+   */
+  std::unique_ptr<mfem::DiffusionIntegrator> flux_integrator_;
+
+  /**
+   * @brief Finite element collections for the discontinuous and smoothed fluxes
+   */
+  std::unique_ptr<mfem::FiniteElementCollection> flux_fec_, smooth_flux_fec_;
+
+  /**
+   * @brief Finite element spaces for the discontinuous and smoothed fluxes
+   */
+  std::unique_ptr<mfem::ParFiniteElementSpace> flux_space_, smooth_flux_space_;
+
+  /**
+   * @brief Zienkiewicz-Zhu error estimator for the temperature
+   */
+  std::unique_ptr<mfem::L2ZienkiewiczZhuEstimator> estimator_;
+
+  /**
+   * @brief The timestepping method of the dynamic problem
+   */
+  TimestepMethod timestepper_ = TimestepMethod::BackwardEuler;
+
+  /**
+   * @brief The basis that snapshots are being recorded into, unset if they are not
+   */
+  std::shared_ptr<mfem_ext::ReducedBasis> snapshot_basis_;
+
+  /**
+   * @brief The basis of the reduced-order model, unset if the full model is stepped
+   */
+  std::shared_ptr<const mfem_ext::ReducedBasis> reduced_basis_;
+
+  /**
+   * @brief The error indicator parameters of the reduced-order model
+   */
+  ReducedOrderOptions reduced_options_;
+
+  /**
+   * @brief The projected mass and stiffness matrices
+   */
+  mfem::DenseMatrix M_r_, K_r_;
+
+  /**
+   * @brief The rows of the mass and stiffness matrices applied to the modes at the essential DOFs,
+   * which couple the boundary values into the reduced equations
+   */
+  mfem::DenseMatrix M_modes_essential_, K_modes_essential_;
+
+  /**
+   * @brief The reduced Jacobian and its factorization
+   */
+  mfem::DenseMatrix        J_r_;
+  mfem::DenseMatrixInverse J_r_inv_;
+
+  /**
+   * @brief The coefficients of the modes in the current temperature
+   */
+  mfem::Vector coefficients_;
+
+  /**
+   * @brief The predicted coefficients, previous coefficient rate and zero vector of the reduced ODE
+   */
+  mfem::Vector u_r_, previous_r_, zero_r_;
+
+  /**
+   * @brief Previous value of dt in the reduced ODE
+   */
+  double reduced_previous_dt_ = -1.0;
+
+  /**
+   * @brief The essential boundary values at a time, one step before and after it, and the boundary rate
+   */
+  mfem::Vector bc_values_, bc_minus_, bc_plus_, bc_rate_;
+
+  /**
+   * @brief The reduced load of the boundary values and the time it was computed at
+   */
+  mfem::Vector bc_load_r_;
+  double       bc_load_time_ = 0.0;
+
+  /**
+   * @brief The temperature lifted from the reduced solution before it is accepted
+   */
+  mfem::Vector reduced_temperature_;
+
+  /**
+   * @brief The residual of the reduced ODE
+   */
+  mfem_ext::StdFunctionOperator reduced_residual_;
+
+  /**
+   * @brief The solver of the reduced residual, which is replicated on every rank
+   */
+  mfem_ext::EquationSolver reduced_solver_;
+
+  /**
+   * @brief The reduced ODE has no essential DOFs of its own
+   */
+  BoundaryConditionManager reduced_bcs_;
+
+  /**
+   * @brief The ODE of the mode coefficients
+   */
+  std::unique_ptr<mfem_ext::FirstOrderODE> reduced_ode_;
+
+  /**
+   * @brief The number of reduced steps taken since the reduced-order model was enabled
+   */
+  int reduced_steps_ = 0;
+
+  /**
+   * @brief The number of reduced steps repeated with the full model
+   */
+  int full_order_fallbacks_ = 0;
 };
 
 }  // namespace serac
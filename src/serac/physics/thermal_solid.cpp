@@ -7,6 +7,7 @@
 #include "serac/physics/thermal_solid.hpp"
 
 #include "serac/infrastructure/logger.hpp"
+#include "serac/infrastructure/profiling.hpp"
 #include "serac/physics/utilities/solver_config.hpp"
 
 namespace serac {
@@ -42,6 +43,10 @@ ThermalSolid::ThermalSolid(std::shared_ptr<mfem::ParMesh> mesh, const ThermalCon
       velocity_(solid_solver_.velocity()),
       displacement_(solid_solver_.displacement())
 {
+  // Adapting the shared mesh from within the thermal solver would invalidate the solid solver
+  SLIC_ERROR_ROOT_IF(thermal_input.adaptivity, mpi_rank_,
+                     "Adaptive mesh refinement is not supported for coupled thermal-solid problems");
+
   // The temperature_, velocity_, displacement_ members are not currently used
   // but presumably will be needed when further coupling schemes are implemented
   // This calls the non-const version
@@ -54,6 +59,7 @@ ThermalSolid::ThermalSolid(std::shared_ptr<mfem::ParMesh> mesh, const ThermalCon
 
 void ThermalSolid::completeSetup()
 {
+  SERAC_MARK_SCOPE("ThermalSolid::completeSetup");
   SLIC_ERROR_ROOT_IF(coupling_ != serac::CouplingScheme::OperatorSplit, mpi_rank_,
                      "Only operator split is currently implemented in the thermal structural solver.");
 
@@ -64,6 +70,7 @@ void ThermalSolid::completeSetup()
 // Advance the timestep
 void ThermalSolid::advanceTimestep(double& dt)
 {
+  SERAC_MARK_SCOPE("ThermalSolid::advanceTimestep");
   if (coupling_ == serac::CouplingScheme::OperatorSplit) {
     double initial_dt = dt;
     therm_solver_.advanceTimestep(dt);
@@ -77,4 +84,31 @@ void ThermalSolid::advanceTimestep(double& dt)
   cycle_ += 1;
 }
 
+double ThermalSolid::takeMeasuredWork()
+{
+  return BasePhysics::takeMeasuredWork() + therm_solver_.takeMeasuredWork() + solid_solver_.takeMeasuredWork();
+}
+
+void ThermalSolid::beginMeshChange()
+{
+  BasePhysics::beginMeshChange();
+  therm_solver_.beginMeshChange();
+  solid_solver_.beginMeshChange();
+}
+
+void ThermalSolid::restart(const std::vector<mfem::Vector>& initial_state)
+{
+  BasePhysics::restart(initial_state);
+  therm_solver_.restart({initial_state[0]});
+  solid_solver_.restart({initial_state[1], initial_state[2]});
+}
+
+void ThermalSolid::endMeshChange()
+{
+  // The single physics solvers migrate the shared state variables, so the base class only reinitializes them
+  therm_solver_.endMeshChange();
+  solid_solver_.endMeshChange();
+  BasePhysics::endMeshChange();
+}
+
 }  // namespace serac
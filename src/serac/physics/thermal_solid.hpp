@@ -75,6 +75,13 @@ public:
    */
   void SetConductivity(std::unique_ptr<mfem::Coefficient>&& kappa) { therm_solver_.setConductivity(std::move(kappa)); };
 
+  /**
+   * @brief Change the value of a constant thermal conductivity, also after completeSetup
+   *
+   * @param[in] kappa The thermal conductivity
+   */
+  void UpdateConductivity(const double kappa) { therm_solver_.updateConductivity(kappa); };
+
   /**
    * @brief Set the density
    *
@@ -223,6 +230,28 @@ public:
    */
   void advanceTimestep(double& dt) override;
 
+  /**
+   * @brief Returns the local work measured by both single physics solvers since the last call
+   */
+  double takeMeasuredWork() override;
+
+  /**
+   * @brief Prepare both single physics solvers for the mesh to be repartitioned
+   */
+  void beginMeshChange() override;
+
+  /**
+   * @brief Return both single physics solvers to time zero from the given state
+   *
+   * @param[in] initial_state The values of the temperature, velocity, and displacement grid functions
+   */
+  void restart(const std::vector<mfem::Vector>& initial_state) override;
+
+  /**
+   * @brief Migrate the data of both single physics solvers after the mesh has been repartitioned
+   */
+  void endMeshChange() override;
+
   /**
    * @brief Destroy the Thermal Structural Solver object
    */
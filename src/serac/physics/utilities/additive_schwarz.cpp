@@ -0,0 +1,216 @@
+// Copyright (c) 2019-2021, Lawrence Livermore National Security, LLC and
+// other Serac Project Developers. See the top-level LICENSE file for
+// details.
+//
+// SPDX-License-Identifier: (BSD-3-Clause)
+
+#include "serac/physics/utilities/additive_schwarz.hpp"
+
+#include <algorithm>
+
+#include "serac/infrastructure/logger.hpp"
+
+namespace serac::mfem_ext {
+
+AdditiveSchwarzPreconditioner::AdditiveSchwarzPreconditioner(const SchwarzPrec& options)
+    : options_(options), lu_(std::make_unique<SuperLUSolver>(MPI_COMM_SELF, 0))
+{
+  SLIC_ERROR_IF(options_.overlap < 0, "The additive Schwarz overlap must not be negative.");
+}
+
+void AdditiveSchwarzPreconditioner::SetOperator(const mfem::Operator& op)
+{
+  auto matrix = dynamic_cast<const mfem::HypreParMatrix*>(&op);
+  SLIC_ERROR_IF(matrix == nullptr, "The additive Schwarz preconditioner requires a HypreParMatrix.");
+
+  auto parcsr = static_cast<hypre_ParCSRMatrix*>(*const_cast<mfem::HypreParMatrix*>(matrix));
+  auto offd   = hypre_ParCSRMatrixOffd(parcsr);
+
+  std::vector<long long> signature{hypre_ParCSRMatrixGlobalNumRows(parcsr),
+                                   hypre_CSRMatrixNumNonzeros(hypre_ParCSRMatrixDiag(parcsr)),
+                                   hypre_CSRMatrixNumNonzeros(offd)};
+  signature.insert(signature.end(), hypre_ParCSRMatrixColMapOffd(parcsr),
+                   hypre_ParCSRMatrixColMapOffd(parcsr) + hypre_CSRMatrixNumCols(offd));
+
+  // The overlap pattern is built collectively, so every rank has to agree on whether it changed
+  auto all_agree = [matrix](bool local) {
+    int local_flag = local ? 1 : 0;
+    int all_flag   = 0;
+    MPI_Allreduce(&local_flag, &all_flag, 1, MPI_INT, MPI_MIN, matrix->GetComm());
+    return all_flag == 1;
+  };
+
+  bool reuse = all_agree(signature == signature_) && all_agree(extract(*matrix));
+  if (!reuse) {
+    signature_ = std::move(signature);
+    analyze(*matrix);
+  }
+
+  // The subdomain matrix is copied, as hypre moves the diagonal entry to the front of each row
+  const int         rows    = subdomainSize();
+  const std::size_t entries = subdomain_columns_.size();
+  auto              offsets = new int[static_cast<std::size_t>(rows) + 1];
+  auto              columns = new int[entries];
+  auto              values  = new double[entries];
+  std::copy(subdomain_offsets_.begin(), subdomain_offsets_.end(), offsets);
+  std::copy(subdomain_columns_.begin(), subdomain_columns_.end(), columns);
+  std::copy(subdomain_values_.begin(), subdomain_values_.end(), values);
+  mfem::SparseMatrix   local(offsets, columns, values, rows, rows);
+  HYPRE_BigInt         row_starts[2] = {0, rows};
+  mfem::HypreParMatrix subdomain(MPI_COMM_SELF, rows, row_starts, &local);
+  lu_->SetOperator(subdomain);
+
+  height = op.Height();
+  width  = op.Width();
+}
+
+void AdditiveSchwarzPreconditioner::analyze(const mfem::HypreParMatrix& matrix)
+{
+  pattern_.reset();
+  if (options_.overlap > 0) {
+    pattern_ = std::make_unique<mfem::HypreParMatrix>(matrix);
+    for (int level = 1; level < options_.overlap; level++) {
+      pattern_.reset(mfem::ParMult(pattern_.get(), &matrix));
+    }
+    auto pattern = static_cast<hypre_ParCSRMatrix*>(*pattern_);
+    if (hypre_ParCSRMatrixCommPkg(pattern) == nullptr) {
+      hypre_MatvecCommPkgCreate(pattern);
+    }
+  }
+
+  subdomain_offsets_.clear();
+  extract(matrix);
+  analyses_++;
+}
+
+bool AdditiveSchwarzPreconditioner::extract(const mfem::HypreParMatrix& matrix)
+{
+  // Without an analyzed structure, the structure is built from this matrix
+  const bool build = subdomain_offsets_.empty();
+
+  auto       parcsr     = static_cast<hypre_ParCSRMatrix*>(const_cast<mfem::HypreParMatrix&>(matrix));
+  auto       diag       = hypre_ParCSRMatrixDiag(parcsr);
+  auto       offd       = hypre_ParCSRMatrixOffd(parcsr);
+  auto       col_map    = hypre_ParCSRMatrixColMapOffd(parcsr);
+  const auto first_row  = hypre_ParCSRMatrixFirstRowIndex(parcsr);
+  const int  local_rows = hypre_CSRMatrixNumRows(diag);
+
+  HYPRE_BigInt* extra_rows     = nullptr;
+  int           num_extra_rows = 0;
+  if (pattern_) {
+    auto pattern   = static_cast<hypre_ParCSRMatrix*>(*pattern_);
+    extra_rows     = hypre_ParCSRMatrixColMapOffd(pattern);
+    num_extra_rows = hypre_CSRMatrixNumCols(hypre_ParCSRMatrixOffd(pattern));
+  }
+
+  // Owned rows come first, then the overlapping rows in the order of the pattern's column map
+  auto local_index = [&](HYPRE_BigInt global) {
+    if (global >= first_row && global < first_row + local_rows) {
+      return static_cast<int>(global - first_row);
+    }
+    auto position = std::lower_bound(extra_rows, extra_rows + num_extra_rows, global);
+    if (position == extra_rows + num_extra_rows || *position != global) {
+      return -1;
+    }
+    return local_rows + static_cast<int>(position - extra_rows);
+  };
+
+  bool        same  = true;
+  std::size_t count = 0;
+
+  auto add = [&](int column, double value) {
+    if (build) {
+      subdomain_columns_.push_back(column);
+      subdomain_values_.push_back(value);
+    } else {
+      same = same && count < subdomain_columns_.size() && subdomain_columns_[count] == column;
+      if (same) {
+        subdomain_values_[count] = value;
+      }
+    }
+    count++;
+  };
+  auto end_row = [&]() {
+    if (build) {
+      subdomain_offsets_.push_back(static_cast<int>(count));
+    }
+  };
+
+  if (build) {
+    subdomain_offsets_.assign(1, 0);
+    subdomain_columns_.clear();
+    subdomain_values_.clear();
+  }
+  for (int row = 0; row < local_rows; row++) {
+    for (int k = hypre_CSRMatrixI(diag)[row]; k < hypre_CSRMatrixI(diag)[row + 1]; k++) {
+      add(hypre_CSRMatrixJ(diag)[k], hypre_CSRMatrixData(diag)[k]);
+    }
+    for (int k = hypre_CSRMatrixI(offd)[row]; k < hypre_CSRMatrixI(offd)[row + 1]; k++) {
+      const int column = local_index(col_map[hypre_CSRMatrixJ(offd)[k]]);
+      if (column >= 0) {
+        add(column, hypre_CSRMatrixData(offd)[k]);
+      }
+    }
+    end_row();
+  }
+
+  if (pattern_) {
+    // The rows of the matrix for the off-diagonal columns of the pattern, with global column indices
+    auto external = hypre_ParCSRMatrixExtractBExt(parcsr, static_cast<hypre_ParCSRMatrix*>(*pattern_), 1);
+#if MFEM_HYPRE_VERSION >= 21600
+    auto external_columns = hypre_CSRMatrixBigJ(external);
+#else
+    auto external_columns = hypre_CSRMatrixJ(external);
+#endif
+    for (int row = 0; row < num_extra_rows; row++) {
+      for (int k = hypre_CSRMatrixI(external)[row]; k < hypre_CSRMatrixI(external)[row + 1]; k++) {
+        const int column = local_index(external_columns[k]);
+        if (column >= 0) {
+          add(column, hypre_CSRMatrixData(external)[k]);
+        }
+      }
+      end_row();
+    }
+    hypre_CSRMatrixDestroy(external);
+  }
+
+  return same && count == subdomain_columns_.size();
+}
+
+void AdditiveSchwarzPreconditioner::Mult(const mfem::Vector& b, mfem::Vector& x) const
+{
+  const int local_rows = height;
+  local_.SetSize(subdomainSize());
+  std::copy(b.GetData(), b.GetData() + local_rows, local_.GetData());
+
+  hypre_ParCSRCommPkg* comm_pkg  = nullptr;
+  HYPRE_Int*           send_rows = nullptr;
+  int                  num_sent  = 0;
+  if (pattern_) {
+    comm_pkg  = hypre_ParCSRMatrixCommPkg(static_cast<hypre_ParCSRMatrix*>(*pattern_));
+    send_rows = hypre_ParCSRCommPkgSendMapElmts(comm_pkg);
+    num_sent  = hypre_ParCSRCommPkgSendMapStart(comm_pkg, hypre_ParCSRCommPkgNumSends(comm_pkg));
+    send_.resize(static_cast<std::size_t>(num_sent));
+
+    // Restriction: gather the overlapping rows of the input from their owners
+    for (int i = 0; i < num_sent; i++) {
+      send_[static_cast<std::size_t>(i)] = b(send_rows[i]);
+    }
+    auto handle = hypre_ParCSRCommHandleCreate(1, comm_pkg, send_.data(), local_.GetData() + local_rows);
+    hypre_ParCSRCommHandleDestroy(handle);
+  }
+
+  lu_->Mult(local_, local_solution_);
+  std::copy(local_solution_.GetData(), local_solution_.GetData() + local_rows, x.GetData());
+
+  if (pattern_) {
+    // Prolongation: return the overlapping rows of the solution to their owners and sum them
+    auto handle = hypre_ParCSRCommHandleCreate(2, comm_pkg, local_solution_.GetData() + local_rows, send_.data());
+    hypre_ParCSRCommHandleDestroy(handle);
+    for (int i = 0; i < num_sent; i++) {
+      x(send_rows[i]) += send_[static_cast<std::size_t>(i)];
+    }
+  }
+}
+
+}  // namespace serac::mfem_ext
@@ -0,0 +1,133 @@
+// Copyright (c) 2019-2021, Lawrence Livermore National Security, LLC and
+// other Serac Project Developers. See the top-level LICENSE file for
+// details.
+//
+// SPDX-License-Identifier: (BSD-3-Clause)
+
+/**
+ * @file additive_schwarz.hpp
+ *
+ * @brief An overlapping additive Schwarz preconditioner with local sparse direct solves
+ */
+
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "mfem.hpp"
+
+#include "serac/physics/utilities/solver_config.hpp"
+#include "serac/physics/utilities/superlu_solver.hpp"
+
+namespace serac::mfem_ext {
+
+/**
+ * @brief An overlapping additive Schwarz preconditioner, x = sum_i R_i^T A_i^-1 R_i b
+ *
+ * Each rank's subdomain holds its own rows plus the rows reachable within the given number of
+ * steps through the matrix graph, which are extracted from the other ranks with hypre. Couplings
+ * to rows outside the subdomain are dropped. Each subdomain matrix is factored by SuperLU_DIST on
+ * MPI_COMM_SELF, which only refactors numerically while its pattern is unchanged. The exchange of
+ * the overlapping values follows the communication package of the overlap pattern, forward for
+ * the restriction and transposed for the sum of the prolongations, so the preconditioner is
+ * symmetric and can be used with CG.
+ */
+class AdditiveSchwarzPreconditioner : public mfem::Solver {
+public:
+  /**
+   * @brief Constructs the preconditioner
+   *
+   * @param[in] options The overlap of the subdomains
+   */
+  explicit AdditiveSchwarzPreconditioner(const SchwarzPrec& options);
+
+  /**
+   * @brief Extracts and factors the subdomain matrix, only refactoring numerically if the pattern is unchanged
+   *
+   * @param[in] op The operator, which must be a HypreParMatrix
+   * @note Implements mfem::Solver::SetOperator
+   */
+  void SetOperator(const mfem::Operator& op) override;
+
+  /**
+   * @brief Applies the preconditioner
+   *
+   * @param[in] b The input vector
+   * @param[out] x The output vector
+   * @note Implements mfem::Operator::Mult
+   */
+  void Mult(const mfem::Vector& b, mfem::Vector& x) const override;
+
+  /**
+   * @brief Returns the number of rows of this rank's subdomain, including the overlap
+   */
+  int subdomainSize() const { return static_cast<int>(subdomain_offsets_.size()) - 1; }
+
+  /**
+   * @brief Returns the number of times the overlap and the subdomain structure were built
+   */
+  int numAnalyses() const { return analyses_; }
+
+  /**
+   * @brief Returns the number of subdomain factorizations that computed the ordering and symbolic factorization
+   */
+  int numSymbolicFactorizations() const { return lu_->NumSymbolicFactorizations(); }
+
+private:
+  /**
+   * @brief Builds the overlap pattern and the subdomain structure for a new sparsity pattern
+   */
+  void analyze(const mfem::HypreParMatrix& matrix);
+
+  /**
+   * @brief Copies the values of the matrix and of the overlapping rows into the subdomain matrix
+   *
+   * @return Whether the subdomain pattern matched the analyzed one
+   */
+  bool extract(const mfem::HypreParMatrix& matrix);
+
+  /**
+   * @brief The overlap configuration
+   */
+  SchwarzPrec options_;
+
+  /**
+   * @brief A matrix whose off-diagonal columns are the overlapping rows, A^overlap, kept for its
+   * communication package
+   */
+  std::unique_ptr<mfem::HypreParMatrix> pattern_;
+
+  /**
+   * @brief A summary of the sparsity pattern of the analyzed operator, used to detect changes
+   */
+  std::vector<long long> signature_;
+
+  /**
+   * @brief The CSR structure and values of the subdomain matrix, owned rows first
+   */
+  std::vector<int>    subdomain_offsets_, subdomain_columns_;
+  std::vector<double> subdomain_values_;
+
+  /**
+   * @brief The rank-local direct solver of the subdomain matrix
+   */
+  std::unique_ptr<SuperLUSolver> lu_;
+
+  /**
+   * @brief The number of analyses
+   */
+  int analyses_ = 0;
+
+  /**
+   * @brief The subdomain right-hand side and solution
+   */
+  mutable mfem::Vector local_, local_solution_;
+
+  /**
+   * @brief The send buffer of the exchange
+   */
+  mutable std::vector<double> send_;
+};
+
+}  // namespace serac::mfem_ext
@@ -0,0 +1,57 @@
+// Copyright (c) 2019-2021, Lawrence Livermore National Security, LLC and
+// other Serac Project Developers. See the top-level LICENSE file for
+// details.
+//
+// SPDX-License-Identifier: (BSD-3-Clause)
+
+#include "serac/physics/utilities/block_schur_preconditioner.hpp"
+
+#include "serac/infrastructure/logger.hpp"
+
+namespace serac::mfem_ext {
+
+BlockSchurPreconditioner::BlockSchurPreconditioner(const BlockSchurPrec& options, const int print_level)
+    : schur_(options.schur),
+      amg_(std::make_unique<mfem::HypreBoomerAMG>()),
+      jacobi_(std::make_unique<mfem::HypreSmoother>())
+{
+  if (options.pfes != nullptr && options.pfes->GetVDim() > 1) {
+    amg_->SetSystemsOptions(options.pfes->GetVDim(), options.pfes->GetOrdering() == mfem::Ordering::byNODES);
+  }
+  amg_->SetPrintLevel(print_level);
+  jacobi_->SetType(mfem::HypreSmoother::Jacobi);
+  jacobi_->SetPositiveDiagonal(true);
+}
+
+void BlockSchurPreconditioner::SetOperator(const mfem::Operator& op)
+{
+  // The block accessors of mfem::BlockOperator are not const
+  auto block_op = dynamic_cast<mfem::BlockOperator*>(const_cast<mfem::Operator*>(&op));
+  SLIC_ERROR_IF(block_op == nullptr || block_op->NumRowBlocks() != 2,
+                "The block Schur preconditioner requires a 2 x 2 BlockOperator.");
+  SLIC_ERROR_IF(!schur_, "The block Schur preconditioner is not supported by this physics module.");
+
+  auto displacement_block = dynamic_cast<mfem::HypreParMatrix*>(&block_op->GetBlock(0, 0));
+  SLIC_ERROR_IF(displacement_block == nullptr, "The displacement block must be a HypreParMatrix.");
+  const auto& schur = schur_();
+  SLIC_ERROR_IF(schur.Height() != block_op->GetBlock(1, 1).Height(),
+                "The Schur complement approximation does not match the pressure block.");
+
+  amg_->SetOperator(*displacement_block);
+  jacobi_->SetOperator(schur);
+
+  // The offsets only change with the mesh
+  if (!block_prec_ || offsets_ != block_op->RowOffsets()) {
+    block_op->RowOffsets().Copy(offsets_);
+    block_prec_ = std::make_unique<mfem::BlockDiagonalPreconditioner>(offsets_);
+    block_prec_->SetDiagonalBlock(0, amg_.get());
+    block_prec_->SetDiagonalBlock(1, jacobi_.get());
+  }
+
+  height = op.Height();
+  width  = op.Width();
+}
+
+void BlockSchurPreconditioner::Mult(const mfem::Vector& b, mfem::Vector& x) const { block_prec_->Mult(b, x); }
+
+}  // namespace serac::mfem_ext
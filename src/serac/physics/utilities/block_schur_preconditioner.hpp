@@ -0,0 +1,85 @@
+// Copyright (c) 2019-2021, Lawrence Livermore National Security, LLC and
+// other Serac Project Developers. See the top-level LICENSE file for
+// details.
+//
+// SPDX-License-Identifier: (BSD-3-Clause)
+
+/**
+ * @file block_schur_preconditioner.hpp
+ *
+ * @brief A block diagonal preconditioner for displacement-pressure saddle point systems
+ */
+
+#pragma once
+
+#include <memory>
+
+#include "mfem.hpp"
+
+#include "serac/physics/utilities/solver_config.hpp"
+
+namespace serac::mfem_ext {
+
+/**
+ * @brief A block diagonal preconditioner diag(A^-1, S^-1) for the system [A B^T; B -C]
+ *
+ * The displacement block A is approximated by one BoomerAMG cycle with the systems options. The
+ * Schur complement C + B A^-1 B^T is spectrally equivalent to a pressure mass matrix scaled by the
+ * sum of the shear and bulk compliances, independently of the mesh size and the bulk modulus, and
+ * its inverse is approximated by Jacobi scaling.
+ */
+class BlockSchurPreconditioner : public mfem::Solver {
+public:
+  /**
+   * @brief Constructs the preconditioner
+   *
+   * @param[in] options The displacement space and the Schur complement approximation
+   * @param[in] print_level The BoomerAMG print level
+   */
+  BlockSchurPreconditioner(const BlockSchurPrec& options, const int print_level);
+
+  /**
+   * @brief Sets up AMG on the displacement block and Jacobi on the Schur complement approximation
+   *
+   * @param[in] op The 2 x 2 block operator, whose diagonal blocks must be HypreParMatrix
+   * @note Implements mfem::Solver::SetOperator
+   */
+  void SetOperator(const mfem::Operator& op) override;
+
+  /**
+   * @brief Applies the block diagonal preconditioner
+   *
+   * @param[in] b The input vector
+   * @param[out] x The output vector
+   * @note Implements mfem::Operator::Mult
+   */
+  void Mult(const mfem::Vector& b, mfem::Vector& x) const override;
+
+private:
+  /**
+   * @brief Returns the approximation of the negative Schur complement
+   */
+  std::function<const mfem::HypreParMatrix&()> schur_;
+
+  /**
+   * @brief The AMG preconditioner for the displacement block
+   */
+  std::unique_ptr<mfem::HypreBoomerAMG> amg_;
+
+  /**
+   * @brief The Jacobi preconditioner for the Schur complement
+   */
+  std::unique_ptr<mfem::HypreSmoother> jacobi_;
+
+  /**
+   * @brief The offsets of the blocks of the operator
+   */
+  mfem::Array<int> offsets_;
+
+  /**
+   * @brief The block diagonal preconditioner built from the two block preconditioners
+   */
+  std::unique_ptr<mfem::BlockDiagonalPreconditioner> block_prec_;
+};
+
+}  // namespace serac::mfem_ext
@@ -8,6 +8,8 @@
 
 #include <algorithm>
 
+#include "serac/infrastructure/profiling.hpp"
+
 namespace serac {
 
 BoundaryCondition::BoundaryCondition(GeneralCoefficient coef, const std::optional<int> component,
@@ -46,8 +48,21 @@ void BoundaryCondition::setTrueDofs(FiniteElementState& state)
   }
 }
 
+void BoundaryCondition::updateTrueDofs()
+{
+  SLIC_ERROR_IF(!state_, "Boundary conditions specified by DOF indices cannot be updated after the mesh changes.");
+  setTrueDofs(*state_);
+}
+
+void BoundaryCondition::getTrueDofs(mfem::ParFiniteElementSpace& space, mfem::Array<int>& dofs) const
+{
+  SLIC_ERROR_IF(!state_, "Boundary conditions specified by DOF indices cannot be mapped to another space.");
+  space.GetEssentialTrueDofs(markers_, dofs, component_.value_or(-1));
+}
+
 void BoundaryCondition::project(FiniteElementState& state) const
 {
+  SERAC_MARK_SCOPE("BoundaryCondition::project");
   SLIC_ERROR_IF(!true_dofs_, "Only essential boundary conditions can be projected over all DOFs.");
   // Value semantics for convenience
   auto tdofs = *true_dofs_;
@@ -84,6 +99,7 @@ void BoundaryCondition::project() const
 
 void BoundaryCondition::projectBdr(mfem::ParGridFunction& gf, const double time, const bool should_be_scalar) const
 {
+  SERAC_MARK_SCOPE("BoundaryCondition::projectBdr");
   if (should_be_scalar) {
     SLIC_ASSERT_MSG(std::holds_alternative<std::shared_ptr<mfem::Coefficient>>(coef_),
                     "Boundary condition should have been an mfem::Coefficient");
@@ -123,6 +139,7 @@ void BoundaryCondition::projectBdrToDofs(mfem::Vector& dof_values, const double
 
 void BoundaryCondition::eliminateFromMatrix(mfem::HypreParMatrix& k_mat) const
 {
+  SERAC_MARK_SCOPE("BoundaryCondition::eliminateFromMatrix");
   SLIC_ERROR_IF(!true_dofs_, "Can only eliminate essential boundary conditions.");
   eliminated_matrix_entries_.reset(k_mat.EliminateRowsCols(*true_dofs_));
 }
@@ -130,6 +147,7 @@ void BoundaryCondition::eliminateFromMatrix(mfem::HypreParMatrix& k_mat) const
 void BoundaryCondition::eliminateToRHS(mfem::HypreParMatrix& k_mat_post_elim, const mfem::Vector& soln,
                                        mfem::Vector& rhs) const
 {
+  SERAC_MARK_SCOPE("BoundaryCondition::eliminateToRHS");
   SLIC_ERROR_IF(!true_dofs_, "Can only eliminate essential boundary conditions.");
   SLIC_ERROR_IF(!eliminated_matrix_entries_,
                 "Must set eliminated matrix entries with eliminateFrom before applying to RHS.");
@@ -143,6 +143,21 @@ public:
    */
   void setTrueDofs(FiniteElementState& state);
 
+  /**
+   * @brief Recomputes the DOFs for the boundary condition from the field it was associated with
+   * @pre A corresponding field (FiniteElementState) has been associated
+   * with the calling object via BoundaryCondition::setTrueDofs(FiniteElementState&)
+   */
+  void updateTrueDofs();
+
+  /**
+   * @brief Computes the true DOFs of the boundary condition on another space over the same mesh
+   * @param[in] space The space, e.g., a level of a p-multigrid hierarchy
+   * @param[out] dofs The true DOFs of the boundary condition's attributes and component in the space
+   * @pre The boundary condition was specified by boundary attributes
+   */
+  void getTrueDofs(mfem::ParFiniteElementSpace& space, mfem::Array<int>& dofs) const;
+
   /**
    * @brief Returns the DOF indices for an essential boundary condition
    * @return A non-owning reference to the array of indices
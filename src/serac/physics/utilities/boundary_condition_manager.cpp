@@ -10,6 +10,7 @@
 #include <iterator>
 
 #include "serac/infrastructure/logger.hpp"
+#include "serac/infrastructure/profiling.hpp"
 
 namespace serac {
 
@@ -47,6 +48,14 @@ void BoundaryConditionManager::addEssentialTrueDofs(const mfem::Array<int>&   tr
   all_dofs_valid_ = false;
 }
 
+void BoundaryConditionManager::updateEssentialDofs()
+{
+  for (auto& bc : ess_bdr_) {
+    bc.updateTrueDofs();
+  }
+  all_dofs_valid_ = false;
+}
+
 void BoundaryConditionManager::updateAllEssentialDofs() const
 {
   all_dofs_.DeleteAll();
@@ -58,6 +67,26 @@ void BoundaryConditionManager::updateAllEssentialDofs() const
   all_dofs_valid_ = true;
 }
 
+mfem::Array<int> BoundaryConditionManager::allEssentialDofs(mfem::ParFiniteElementSpace& space) const
+{
+  mfem::Array<int> all_dofs;
+  mfem::Array<int> dofs;
+  for (const auto& bc : ess_bdr_) {
+    bc.getTrueDofs(space, dofs);
+    all_dofs.Append(dofs);
+  }
+  all_dofs.Sort();
+  all_dofs.Unique();
+  return all_dofs;
+}
+
+std::unique_ptr<mfem::HypreParMatrix> BoundaryConditionManager::eliminateAllEssentialDofsFromMatrix(
+    mfem::HypreParMatrix& matrix) const
+{
+  SERAC_MARK_SCOPE("BoundaryConditionManager::eliminateAllEssentialDofsFromMatrix");
+  return std::unique_ptr<mfem::HypreParMatrix>(matrix.EliminateRowsCols(allEssentialDofs()));
+}
+
 void BoundaryConditionManager::setTime(const double time)
 {
   for (auto& bc : ess_bdr_) {
@@ -187,6 +187,12 @@ public:
   void addEssentialTrueDofs(const mfem::Array<int>& true_dofs, serac::GeneralCoefficient ess_bdr_coef,
                             std::optional<int> component = {});
 
+  /**
+   * @brief Recomputes the DOFs of the essential BCs after the mesh has been refined or repartitioned
+   * @pre All essential BCs were specified by boundary attributes
+   */
+  void updateEssentialDofs();
+
   /**
    * @brief Returns all the degrees of freedom associated with all the essential BCs
    * @return A const reference to the list of DOF indices, without duplicates and sorted
@@ -199,6 +205,14 @@ public:
     return all_dofs_;
   }
 
+  /**
+   * @brief Computes the degrees of freedom of all the essential BCs on another space over the same mesh
+   * @param[in] space The space, e.g., a level of a p-multigrid hierarchy
+   * @return The list of DOF indices, without duplicates and sorted
+   * @pre All essential BCs were specified by boundary attributes
+   */
+  mfem::Array<int> allEssentialDofs(mfem::ParFiniteElementSpace& space) const;
+
   /**
    * @brief Eliminates all essential BCs from a matrix
    * @param[inout] matrix The matrix to eliminate from, will be modified
@@ -206,10 +220,7 @@ public:
    * @note The sum of the eliminated matrix and the modified parameter is
    * equal to the initial state of the parameter
    */
-  std::unique_ptr<mfem::HypreParMatrix> eliminateAllEssentialDofsFromMatrix(mfem::HypreParMatrix& matrix) const
-  {
-    return std::unique_ptr<mfem::HypreParMatrix>(matrix.EliminateRowsCols(allEssentialDofs()));
-  }
+  std::unique_ptr<mfem::HypreParMatrix> eliminateAllEssentialDofsFromMatrix(mfem::HypreParMatrix& matrix) const;
 
   /**
    * @brief Sets the time for all stored boundary conditions
@@ -0,0 +1,101 @@
+// Copyright (c) 2019-2021, Lawrence Livermore National Security, LLC and
+// other Serac Project Developers. See the top-level LICENSE file for
+// details.
+//
+// SPDX-License-Identifier: (BSD-3-Clause)
+
+#include "serac/physics/utilities/chebyshev_preconditioner.hpp"
+
+#include <cmath>
+
+#include "serac/infrastructure/logger.hpp"
+
+namespace serac::mfem_ext {
+
+ChebyshevPreconditioner::ChebyshevPreconditioner(const ChebyshevPrec& options) : options_(options)
+{
+  SLIC_ERROR_IF(options_.order < 1, "The Chebyshev polynomial order must be positive.");
+  SLIC_ERROR_IF(options_.eigenvalue_ratio <= 1.0, "The Chebyshev eigenvalue ratio must be greater than one.");
+}
+
+void ChebyshevPreconditioner::SetOperator(const mfem::Operator& op)
+{
+  matrix_ = dynamic_cast<const mfem::HypreParMatrix*>(&op);
+  SLIC_ERROR_IF(matrix_ == nullptr, "The Chebyshev preconditioner requires a HypreParMatrix.");
+
+  // A new size means the mesh has changed, so the previous estimate no longer applies
+  if (op.Height() != height) {
+    largest_eigenvalue_.reset();
+  }
+  height = op.Height();
+  width  = op.Width();
+
+  matrix_->GetDiag(inv_diag_);
+  for (int i = 0; i < inv_diag_.Size(); i++) {
+    inv_diag_(i) = 1.0 / inv_diag_(i);
+  }
+
+  residual_.SetSize(height);
+  update_.SetSize(height);
+  product_.SetSize(height);
+
+  if (!largest_eigenvalue_) {
+    estimateLargestEigenvalue();
+  }
+}
+
+void ChebyshevPreconditioner::estimateLargestEigenvalue()
+{
+  const MPI_Comm comm = matrix_->GetComm();
+
+  mfem::Vector v(height);
+  v.Randomize(1);
+  v /= std::sqrt(mfem::InnerProduct(comm, v, v));
+
+  double estimate = 0.0;
+  for (int i = 0; i < options_.power_iterations; i++) {
+    matrix_->Mult(v, product_);
+    product_ *= inv_diag_;
+    estimate = std::sqrt(mfem::InnerProduct(comm, product_, product_));
+    if (estimate == 0.0) {
+      break;
+    }
+    v.Set(1.0 / estimate, product_);
+  }
+
+  SLIC_ERROR_IF(estimate <= 0.0, "Unable to estimate the largest eigenvalue for the Chebyshev preconditioner.");
+  largest_eigenvalue_ = estimate;
+}
+
+void ChebyshevPreconditioner::Mult(const mfem::Vector& b, mfem::Vector& x) const
+{
+  // The power iteration underestimates the largest eigenvalue, so the interval is widened
+  const double upper = 1.1 * *largest_eigenvalue_;
+  const double lower = upper / options_.eigenvalue_ratio;
+  const double theta = 0.5 * (upper + lower);
+  const double delta = 0.5 * (upper - lower);
+  const double sigma = theta / delta;
+  double       rho   = 1.0 / sigma;
+
+  // The first iterate is the scaled Jacobi update
+  residual_ = b;
+  update_   = b;
+  update_ *= inv_diag_;
+  update_ /= theta;
+  x = update_;
+
+  for (int k = 1; k < options_.order; k++) {
+    matrix_->Mult(update_, product_);
+    residual_ -= product_;
+
+    const double rho_next = 1.0 / (2.0 * sigma - rho);
+    product_              = residual_;
+    product_ *= inv_diag_;
+    update_ *= rho_next * rho;
+    update_.Add(2.0 * rho_next / delta, product_);
+    x += update_;
+    rho = rho_next;
+  }
+}
+
+}  // namespace serac::mfem_ext
@@ -0,0 +1,95 @@
+// Copyright (c) 2019-2021, Lawrence Livermore National Security, LLC and
+// other Serac Project Developers. See the top-level LICENSE file for
+// details.
+//
+// SPDX-License-Identifier: (BSD-3-Clause)
+
+/**
+ * @file chebyshev_preconditioner.hpp
+ *
+ * @brief A Chebyshev polynomial preconditioner that needs no global reductions once set up
+ */
+
+#pragma once
+
+#include <optional>
+
+#include "mfem.hpp"
+
+#include "serac/physics/utilities/solver_config.hpp"
+
+namespace serac::mfem_ext {
+
+/**
+ * @brief Applies a Chebyshev polynomial in the Jacobi-preconditioned operator
+ *
+ * The polynomial is the one of the Chebyshev iteration for D^-1 A on an interval below the
+ * largest eigenvalue, started from a zero initial guess. Each application takes one
+ * matrix-vector product per degree and no inner products. The estimate of the largest
+ * eigenvalue comes from a power iteration on the first operator and is kept for later
+ * operators of the same size, e.g., the Jacobians of subsequent timesteps.
+ */
+class ChebyshevPreconditioner : public mfem::Solver {
+public:
+  /**
+   * @brief Constructs the preconditioner
+   *
+   * @param[in] options The polynomial degree and eigenvalue estimation parameters
+   */
+  explicit ChebyshevPreconditioner(const ChebyshevPrec& options);
+
+  /**
+   * @brief Sets the operator, estimating its largest eigenvalue if this is the first operator of its size
+   *
+   * @param[in] op The operator, which must be a HypreParMatrix
+   * @note Implements mfem::Solver::SetOperator
+   */
+  void SetOperator(const mfem::Operator& op) override;
+
+  /**
+   * @brief Applies the polynomial
+   *
+   * @param[in] b The input vector
+   * @param[out] x The output vector
+   * @note Implements mfem::Operator::Mult
+   */
+  void Mult(const mfem::Vector& b, mfem::Vector& x) const override;
+
+  /**
+   * @brief Returns the estimate of the largest eigenvalue of the diagonally scaled operator
+   */
+  double largestEigenvalue() const { return largest_eigenvalue_.value_or(0.0); }
+
+private:
+  /**
+   * @brief Estimates the largest eigenvalue of D^-1 A with a power iteration
+   */
+  void estimateLargestEigenvalue();
+
+  /**
+   * @brief The polynomial degree and eigenvalue estimation parameters
+   */
+  ChebyshevPrec options_;
+
+  /**
+   * @brief The operator
+   */
+  const mfem::HypreParMatrix* matrix_ = nullptr;
+
+  /**
+   * @brief The inverse of the diagonal of the operator
+   */
+  mfem::Vector inv_diag_;
+
+  /**
+   * @brief The estimate of the largest eigenvalue, unset until the first operator is set
+   */
+  std::optional<double> largest_eigenvalue_;
+
+  /**
+   * @brief Work vectors for the residual and the update
+   */
+  mutable mfem::Vector residual_, update_, product_;
+};
+
+}  // namespace serac::mfem_ext
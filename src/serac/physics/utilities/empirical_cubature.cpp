@@ -0,0 +1,202 @@
+// Copyright (c) 2019-2021, Lawrence Livermore National Security, LLC and
+// other Serac Project Developers. See the top-level LICENSE file for
+// details.
+//
+// SPDX-License-Identifier: (BSD-3-Clause)
+
+#include "serac/physics/utilities/empirical_cubature.hpp"
+
+#include <algorithm>
+#include <limits>
+
+#include "serac/infrastructure/logger.hpp"
+#include "serac/infrastructure/profiling.hpp"
+
+namespace serac::mfem_ext {
+
+namespace {
+
+/**
+ * @brief Solves a linear least-squares problem with a Gram-Schmidt QR factorization
+ *
+ * Each column is orthogonalized twice, which keeps the orthogonal factor accurate to working
+ * precision. Columns that are numerically dependent on the previous ones get a zero coefficient.
+ *
+ * @param[in] columns The columns of the matrix
+ * @param[in] b The right hand side
+ * @param[out] x The coefficients of the columns that minimize the residual
+ */
+void leastSquares(const std::vector<mfem::Vector>& columns, const mfem::Vector& b, mfem::Vector& x)
+{
+  const int rows = b.Size();
+  const int cols = static_cast<int>(columns.size());
+
+  mfem::DenseMatrix q(rows, cols);
+  mfem::DenseMatrix r(cols);
+  r = 0.0;
+  std::vector<bool> independent(columns.size(), false);
+  for (int j = 0; j < cols; j++) {
+    const auto&  column = columns[static_cast<std::size_t>(j)];
+    mfem::Vector v(q.GetColumn(j), rows);
+    v = column;
+    for (int pass = 0; pass < 2; pass++) {
+      for (int i = 0; i < j; i++) {
+        if (!independent[static_cast<std::size_t>(i)]) {
+          continue;
+        }
+        const mfem::Vector q_i(q.GetColumn(i), rows);
+        const double       projection = q_i * v;
+        v.Add(-projection, q_i);
+        r(i, j) += projection;
+      }
+    }
+
+    const double norm = v.Norml2();
+    if (norm > 1.0e-12 * column.Norml2()) {
+      independent[static_cast<std::size_t>(j)] = true;
+      r(j, j)                                  = norm;
+      v /= norm;
+    }
+  }
+
+  x.SetSize(cols);
+  for (int j = cols - 1; j >= 0; j--) {
+    x(j) = 0.0;
+    if (!independent[static_cast<std::size_t>(j)]) {
+      continue;
+    }
+    const mfem::Vector q_j(q.GetColumn(j), rows);
+    double             value = q_j * b;
+    for (int c = j + 1; c < cols; c++) {
+      value -= r(j, c) * x(c);
+    }
+    x(j) = value / r(j, j);
+  }
+}
+
+}  // namespace
+
+void EmpiricalCubature::train(const mfem::DenseMatrix& contributions, const double tolerance)
+{
+  SERAC_MARK_FUNCTION;
+  const int rows         = contributions.Height();
+  const int num_elements = contributions.Width();
+  int       comm_rank    = 0;
+  MPI_Comm_rank(comm_, &comm_rank);
+
+  // Every subset has to reproduce the sum over all the elements
+  mfem::Vector target(rows);
+  target = 0.0;
+  for (int e = 0; e < num_elements; e++) {
+    for (int i = 0; i < rows; i++) {
+      target(i) += contributions(i, e);
+    }
+  }
+  MPI_Allreduce(MPI_IN_PLACE, target.GetData(), rows, MPI_DOUBLE, MPI_SUM, comm_);
+  const double target_norm = target.Norml2();
+
+  int global_elements = 0;
+  MPI_Allreduce(&num_elements, &global_elements, 1, MPI_INT, MPI_SUM, comm_);
+
+  // The contributions of the selected elements are replicated on every rank along with their owners
+  std::vector<mfem::Vector> columns;
+  std::vector<int>          owners;
+  std::vector<int>          local_elements;
+  std::vector<double>       weights;
+  std::vector<bool>         considered(static_cast<std::size_t>(num_elements), false);
+
+  mfem::Vector residual(target);
+  for (int iteration = 0; iteration < global_elements && residual.Norml2() > tolerance * target_norm; iteration++) {
+    // The element whose contribution is best aligned with the remaining error
+    struct {
+      double value;
+      int    rank;
+    } best         = {-std::numeric_limits<double>::max(), comm_rank};
+    int best_local = -1;
+    for (int e = 0; e < num_elements; e++) {
+      if (considered[static_cast<std::size_t>(e)]) {
+        continue;
+      }
+      const mfem::Vector column(const_cast<double*>(contributions.GetColumn(e)), rows);
+      const double       alignment = column * residual;
+      if (alignment > best.value) {
+        best.value = alignment;
+        best_local = e;
+      }
+    }
+    MPI_Allreduce(MPI_IN_PLACE, &best, 1, MPI_DOUBLE_INT, MPI_MAXLOC, comm_);
+    if (best.value <= 0.0) {
+      break;
+    }
+
+    mfem::Vector column(rows);
+    if (comm_rank == best.rank) {
+      column = mfem::Vector(const_cast<double*>(contributions.GetColumn(best_local)), rows);
+      considered[static_cast<std::size_t>(best_local)] = true;
+    }
+    MPI_Bcast(column.GetData(), rows, MPI_DOUBLE, best.rank, comm_);
+    MPI_Bcast(&best_local, 1, MPI_INT, best.rank, comm_);
+    columns.push_back(column);
+    owners.push_back(best.rank);
+    local_elements.push_back(best_local);
+    weights.push_back(0.0);
+
+    // Move towards the unconstrained least-squares weights, dropping elements whose weights reach zero
+    mfem::Vector unconstrained;
+    while (!columns.empty()) {
+      leastSquares(columns, target, unconstrained);
+
+      double step     = 1.0;
+      int    blocking = -1;
+      for (int i = 0; i < unconstrained.Size(); i++) {
+        if (unconstrained(i) > 0.0) {
+          continue;
+        }
+        const double weight = weights[static_cast<std::size_t>(i)];
+        const double limit  = (weight > 0.0) ? weight / (weight - unconstrained(i)) : 0.0;
+        if (limit <= step) {
+          step     = limit;
+          blocking = i;
+        }
+      }
+      if (blocking < 0) {
+        std::copy(unconstrained.begin(), unconstrained.end(), weights.begin());
+        break;
+      }
+
+      for (int i = 0; i < unconstrained.Size(); i++) {
+        weights[static_cast<std::size_t>(i)] += step * (unconstrained(i) - weights[static_cast<std::size_t>(i)]);
+      }
+      weights[static_cast<std::size_t>(blocking)] = 0.0;
+      for (std::size_t i = columns.size(); i-- > 0;) {
+        if (weights[i] <= 0.0) {
+          columns.erase(columns.begin() + static_cast<std::ptrdiff_t>(i));
+          owners.erase(owners.begin() + static_cast<std::ptrdiff_t>(i));
+          local_elements.erase(local_elements.begin() + static_cast<std::ptrdiff_t>(i));
+          weights.erase(weights.begin() + static_cast<std::ptrdiff_t>(i));
+        }
+      }
+    }
+
+    residual = target;
+    for (std::size_t i = 0; i < columns.size(); i++) {
+      residual.Add(-weights[i], columns[i]);
+    }
+  }
+
+  elements_.clear();
+  weights_.clear();
+  for (std::size_t i = 0; i < columns.size(); i++) {
+    if (owners[i] == comm_rank) {
+      elements_.push_back(local_elements[i]);
+      weights_.push_back(weights[i]);
+    }
+  }
+  global_size_    = static_cast<int>(columns.size());
+  training_error_ = (target_norm > 0.0) ? residual.Norml2() / target_norm : 0.0;
+  SLIC_WARNING_IF(comm_rank == 0 && training_error_ > tolerance,
+                  "The sampled elements only reproduce the training contributions to a relative error of "
+                      << training_error_ << ".");
+}
+
+}  // namespace serac::mfem_ext
@@ -0,0 +1,101 @@
+// Copyright (c) 2019-2021, Lawrence Livermore National Security, LLC and
+// other Serac Project Developers. See the top-level LICENSE file for
+// details.
+//
+// SPDX-License-Identifier: (BSD-3-Clause)
+
+/**
+ * @file empirical_cubature.hpp
+ *
+ * @brief An energy-conserving sampling and weighting of the elements for hyper-reduced models
+ */
+
+#pragma once
+
+#include <vector>
+
+#include "mfem.hpp"
+
+namespace serac::mfem_ext {
+
+/**
+ * @brief A sparse, weighted subset of the elements of a distributed mesh
+ *
+ * The subset is trained on the per-element contributions to some reduced quantities, such as
+ * the projections of an element residual onto the modes of a reduced basis at a set of
+ * snapshots. The weights are nonnegative and are chosen so the weighted sum of the
+ * contributions of the subset matches the sum over all the elements to a tolerance. This is
+ * the energy-conserving sampling and weighting (ECSW) method of Farhat et al. The weights
+ * solve a nonnegative least-squares problem with the active-set method of Lawson and Hanson,
+ * stopped as soon as the tolerance is met, so the subset stays small.
+ */
+class EmpiricalCubature {
+public:
+  /**
+   * @brief Constructs an empty subset
+   *
+   * @param[in] comm The communicator the elements are distributed over
+   */
+  explicit EmpiricalCubature(MPI_Comm comm) : comm_(comm) {}
+
+  /**
+   * @brief Selects the elements and their weights
+   *
+   * Each rank passes the contributions of its own elements. Elements are added one at a time,
+   * picking the one whose contribution is best aligned with the remaining error, and elements
+   * whose weights drop to zero are removed and not considered again.
+   *
+   * @param[in] contributions The contributions of the local elements, one column per element,
+   * with the same rows on every rank
+   * @param[in] tolerance The largest error of the weighted sum, relative to the sum over all the elements
+   */
+  void train(const mfem::DenseMatrix& contributions, const double tolerance);
+
+  /**
+   * @brief The selected local elements
+   */
+  const std::vector<int>& elements() const { return elements_; }
+
+  /**
+   * @brief The weights of the selected local elements
+   */
+  const std::vector<double>& weights() const { return weights_; }
+
+  /**
+   * @brief The number of selected elements on all ranks
+   */
+  int globalSize() const { return global_size_; }
+
+  /**
+   * @brief The error of the weighted sum on the training contributions, relative to the sum over all the elements
+   */
+  double trainingError() const { return training_error_; }
+
+private:
+  /**
+   * @brief The communicator of the elements
+   */
+  MPI_Comm comm_;
+
+  /**
+   * @brief The indices of the selected local elements
+   */
+  std::vector<int> elements_;
+
+  /**
+   * @brief The weights of the selected local elements
+   */
+  std::vector<double> weights_;
+
+  /**
+   * @brief The number of selected elements on all ranks
+   */
+  int global_size_ = 0;
+
+  /**
+   * @brief The relative training error
+   */
+  double training_error_ = 0.0;
+};
+
+}  // namespace serac::mfem_ext
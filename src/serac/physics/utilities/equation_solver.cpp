@@ -7,7 +7,15 @@
 #include "serac/physics/utilities/equation_solver.hpp"
 
 #include "serac/infrastructure/logger.hpp"
+#include "serac/infrastructure/profiling.hpp"
 #include "serac/infrastructure/terminator.hpp"
+#include "serac/physics/utilities/additive_schwarz.hpp"
+#include "serac/physics/utilities/block_schur_preconditioner.hpp"
+#include "serac/physics/utilities/chebyshev_preconditioner.hpp"
+#include "serac/physics/utilities/krylov_solvers.hpp"
+#include "serac/physics/utilities/low_order_refined.hpp"
+#include "serac/physics/utilities/mixed_precision.hpp"
+#include "serac/physics/utilities/p_multigrid.hpp"
 
 namespace serac::mfem_ext {
 
@@ -25,12 +33,18 @@ EquationSolver::EquationSolver(MPI_Comm comm, const LinearSolverOptions& lin_opt
   }
   // If it's a direct solver (currently SuperLU only)
   else if (auto direct_options = std::get_if<DirectSolverOptions>(&lin_options)) {
-    auto direct_solver = std::make_unique<mfem::SuperLUSolver>(comm);
-    direct_solver->SetColumnPermutation(mfem::superlu::PARMETIS);
-    if (direct_options->print_level == 0) {
-      direct_solver->SetPrintStatistics(false);
-    }
-    lin_solver_ = std::move(direct_solver);
+    lin_solver_ = std::make_unique<SuperLUSolver>(comm, direct_options->print_level);
+  }
+  // If it's mixed precision, the double-precision FGMRES guarantees the tolerance
+  else if (auto mixed_options = std::get_if<MixedPrecisionSolverOptions>(&lin_options)) {
+    auto fgmres = std::make_unique<mfem::FGMRESSolver>(comm);
+    fgmres->SetRelTol(mixed_options->rel_tol);
+    fgmres->SetAbsTol(mixed_options->abs_tol);
+    fgmres->SetMaxIter(mixed_options->max_iter);
+    fgmres->SetPrintLevel(mixed_options->print_level);
+    prec_ = std::make_unique<SinglePrecisionSolver>(mixed_options->inner_max_iter, mixed_options->inner_rel_tol);
+    fgmres->SetPreconditioner(*prec_);
+    lin_solver_ = std::move(fgmres);
   }
 
   if (nonlin_options) {
@@ -216,6 +230,27 @@ std::unique_ptr<mfem::IterativeSolver> EquationSolver::BuildIterativeLinearSolve
     case LinearSolver::MINRES:
       iter_lin_solver = std::make_unique<mfem::MINRESSolver>(comm);
       break;
+    case LinearSolver::PipelinedCG:
+      iter_lin_solver = std::make_unique<PipelinedCGSolver>(comm);
+      break;
+    case LinearSolver::SStepGMRES: {
+      auto sstep_solver = std::make_unique<SStepGMRESSolver>(comm);
+      sstep_solver->SetSteps(lin_options.steps_per_reduction);
+      iter_lin_solver = std::move(sstep_solver);
+      break;
+    }
+    case LinearSolver::DeflatedCG: {
+      auto deflated_solver = std::make_unique<DeflatedCGSolver>(comm);
+      deflated_solver->SetRecycleSize(lin_options.recycle_size);
+      iter_lin_solver = std::move(deflated_solver);
+      break;
+    }
+    case LinearSolver::RecycledGMRES: {
+      auto recycled_solver = std::make_unique<RecycledGMRESSolver>(comm);
+      recycled_solver->SetRecycleSize(lin_options.recycle_size);
+      iter_lin_solver = std::move(recycled_solver);
+      break;
+    }
     default:
       SLIC_ERROR("Linear solver type not recognized.");
       exitGracefully(true);
@@ -235,7 +270,12 @@ std::unique_ptr<mfem::IterativeSolver> EquationSolver::BuildIterativeLinearSolve
       if (par_fes != nullptr) {
         SLIC_WARNING_IF(par_fes->GetOrdering() == mfem::Ordering::byNODES,
                         "Attempting to use BoomerAMG with nodal ordering on an elasticity problem.");
-        prec_amg->SetElasticityOptions(par_fes);
+        if (dynamic_cast<const mfem::H1_Trace_FECollection*>(par_fes->FEColl()) != nullptr) {
+          // The rigid body modes cannot be computed on the trace space of a statically condensed system
+          prec_amg->SetSystemsOptions(par_fes->GetVDim(), par_fes->GetOrdering() == mfem::Ordering::byNODES);
+        } else {
+          prec_amg->SetElasticityOptions(par_fes);
+        }
       }
       prec_amg->SetPrintLevel(lin_options.print_level);
       prec_ = std::move(prec_amg);
@@ -253,6 +293,17 @@ std::unique_ptr<mfem::IterativeSolver> EquationSolver::BuildIterativeLinearSolve
 #endif
     } else if (auto ilu_options = std::get_if<BlockILUPrec>(prec_ptr)) {
       prec_ = std::make_unique<mfem::BlockILU>(ilu_options->block_size);
+    } else if (auto chebyshev_options = std::get_if<ChebyshevPrec>(prec_ptr)) {
+      prec_ = std::make_unique<ChebyshevPreconditioner>(*chebyshev_options);
+    } else if (auto lor_options = std::get_if<LORPrec>(prec_ptr)) {
+      SLIC_ERROR_IF(!lor_options->matrix, "The LOR preconditioner is not supported by this physics module.");
+      prec_ = std::make_unique<LORPreconditioner>(lor_options->matrix, lor_options->pfes, lin_options.print_level);
+    } else if (auto pmg_options = std::get_if<PMultigridPrec>(prec_ptr)) {
+      prec_ = std::make_unique<PMultigridPreconditioner>(*pmg_options, lin_options.print_level);
+    } else if (auto schwarz_options = std::get_if<SchwarzPrec>(prec_ptr)) {
+      prec_ = std::make_unique<AdditiveSchwarzPreconditioner>(*schwarz_options);
+    } else if (auto block_options = std::get_if<BlockSchurPrec>(prec_ptr)) {
+      prec_ = std::make_unique<BlockSchurPreconditioner>(*block_options, lin_options.print_level);
     }
     iter_lin_solver->SetPreconditioner(*prec_);
   }
@@ -265,7 +316,7 @@ std::unique_ptr<mfem::NewtonSolver> EquationSolver::BuildNewtonSolver(MPI_Comm
   std::unique_ptr<mfem::NewtonSolver> newton_solver;
 
   if (nonlin_options.nonlin_solver == NonlinearSolver::MFEMNewton) {
-    newton_solver = std::make_unique<mfem::NewtonSolver>(comm);
+    newton_solver = std::make_unique<CheckedNewtonSolver>(comm);
   }
   // KINSOL
   else {
@@ -287,54 +338,86 @@ std::unique_ptr<mfem::NewtonSolver> EquationSolver::BuildNewtonSolver(MPI_Comm
 
 void EquationSolver::SetOperator(const mfem::Operator& op)
 {
+  SERAC_MARK_SCOPE("EquationSolver::SetOperator");
   if (nonlin_solver_) {
-    if (std::holds_alternative<std::unique_ptr<mfem::SuperLUSolver>>(lin_solver_)) {
-      superlu_wrapper_ = std::make_unique<SuperLUNonlinearOperatorWrapper>(op);
-      nonlin_solver_->SetOperator(*superlu_wrapper_);
-    } else {
-      nonlin_solver_->SetOperator(op);
-    }
+    nonlin_solver_->SetOperator(op);
     // Now that the nonlinear solver knows about the operator, we can set its linear solver
     if (!nonlin_solver_set_solver_called_) {
-      nonlin_solver_->SetSolver(LinearSolver());
+      profiled_lin_solver_ = std::make_unique<ProfiledLinearSolver>(LinearSolver());
+      nonlin_solver_->SetSolver(*profiled_lin_solver_);
       nonlin_solver_set_solver_called_ = true;
     }
   } else {
+    SERAC_MARK_SCOPE("LinearSolverSetup");
     std::visit([&op](auto&& solver) { solver->SetOperator(op); }, lin_solver_);
   }
   height = op.Height();
   width  = op.Width();
 }
 
-void EquationSolver::SetOperator(const mfem::HypreParMatrix& matrix)
+void EquationSolver::SetStateCheck(std::function<bool(const mfem::Vector&)> check)
 {
-  if (std::holds_alternative<std::unique_ptr<mfem::SuperLUSolver>>(lin_solver_)) {
-    superlu_mat_ = matrix;
-    SetOperator(*superlu_mat_);
-  }
-  // Otherwise just upcast and call as usual
-  else {
-    SetOperator(static_cast<const mfem::Operator&>(matrix));
+  SLIC_ERROR_IF(!nonlin_solver_, "States can only be checked for nonlinear solves.");
+  state_check_ = std::move(check);
+  if (auto newton = dynamic_cast<CheckedNewtonSolver*>(nonlin_solver_.get())) {
+    newton->check = state_check_;
   }
 }
 
 void EquationSolver::Mult(const mfem::Vector& b, mfem::Vector& x) const
 {
+  rejected_ = false;
   if (nonlin_solver_) {
+    SERAC_MARK_SCOPE("NonlinearSolve");
+    auto newton = dynamic_cast<CheckedNewtonSolver*>(nonlin_solver_.get());
+    if (newton) {
+      newton->rejected = false;
+    }
     nonlin_solver_->Mult(b, x);
+    if (newton) {
+      rejected_ = newton->rejected;
+    } else if (state_check_) {
+      // Other solvers cannot be stopped part way, so only their result is checked
+      rejected_ = !state_check_(x);
+    }
   } else {
+    SERAC_MARK_SCOPE("LinearSolve");
     std::visit([&b, &x](auto&& solver) { solver->Mult(b, x); }, lin_solver_);
   }
 }
 
-mfem::Operator& EquationSolver::SuperLUNonlinearOperatorWrapper::GetGradient(const mfem::Vector& x) const
+double EquationSolver::CheckedNewtonSolver::ComputeScalingFactor(const mfem::Vector& x, const mfem::Vector&) const
 {
-  mfem::Operator&       grad      = oper_.GetGradient(x);
-  mfem::HypreParMatrix* matr_grad = dynamic_cast<mfem::HypreParMatrix*>(&grad);
+  if (!check) {
+    return 1.0;
+  }
 
-  SLIC_ERROR_IF(matr_grad == nullptr, "Nonlinear operator gradient must be a HypreParMatrix");
-  superlu_grad_mat_.emplace(*matr_grad);
-  return *superlu_grad_mat_;
+  // The update is the member c, which Mult subtracts from x after scaling
+  SERAC_MARK_SCOPE("StateCheck");
+  trial_.SetSize(x.Size());
+  mfem::subtract(x, c, trial_);
+  if (!check(trial_)) {
+    // A zero scaling factor ends the solve, which is then not converged
+    rejected = true;
+    return 0.0;
+  }
+  return 1.0;
+}
+
+void EquationSolver::ProfiledLinearSolver::SetOperator(const mfem::Operator& op)
+{
+  SERAC_MARK_SCOPE("LinearSolverSetup");
+  solver_.SetOperator(op);
+  height = op.Height();
+  width  = op.Width();
+}
+
+void EquationSolver::ProfiledLinearSolver::Mult(const mfem::Vector& b, mfem::Vector& x) const
+{
+  SERAC_MARK_SCOPE("LinearSolve");
+  // The nonlinear solver sets the iterative mode of the solver it is given
+  solver_.iterative_mode = iterative_mode;
+  solver_.Mult(b, x);
 }
 
 void EquationSolver::DefineInputFileSchema(axom::inlet::Table& table)
@@ -347,26 +430,48 @@ void EquationSolver::DefineInputFileSchema(axom::inlet::Table& table)
                                                        table_to_verify.contains("iterative_options");
                              const bool is_direct = (table_to_verify["type"].get<std::string>() == "direct") &&
                                                     table_to_verify.contains("direct_options");
-                             return is_iterative || is_direct;
+                             const bool is_mixed = (table_to_verify["type"].get<std::string>() == "mixed") &&
+                                                   table_to_verify.contains("mixed_options");
+                             return is_iterative || is_direct || is_mixed;
                            });
 
-  // Enforce the solver type - must be iterative or direct
-  linear_table.addString("type", "The type of solver parameters to use (iterative|direct)")
+  // Enforce the solver type - must be iterative, direct or mixed precision
+  linear_table.addString("type", "The type of solver parameters to use (iterative|direct|mixed)")
       .required()
-      .validValues({"iterative", "direct"});
+      .validValues({"iterative", "direct", "mixed"});
 
   auto& iterative_table = linear_table.addStruct("iterative_options", "Iterative solver parameters");
   iterative_table.addDouble("rel_tol", "Relative tolerance for the linear solve.").defaultValue(1.0e-6);
   iterative_table.addDouble("abs_tol", "Absolute tolerance for the linear solve.").defaultValue(1.0e-8);
   iterative_table.addInt("max_iter", "Maximum iterations for the linear solve.").defaultValue(5000);
   iterative_table.addInt("print_level", "Linear print level.").defaultValue(0);
-  iterative_table.addString("solver_type", "Solver type (gmres|minres|cg).").defaultValue("gmres");
-  iterative_table.addString("prec_type", "Preconditioner type (JacobiSmoother|L1JacobiSmoother|AMG|BlockILU).")
+  iterative_table
+      .addString("solver_type", "Solver type (gmres|minres|cg|pipelinedcg|sstepgmres|deflatedcg|recycledgmres).")
+      .defaultValue("gmres");
+  iterative_table.addInt("steps_per_reduction", "Krylov vectors generated per global reduction by sstepgmres.")
+      .defaultValue(4);
+  iterative_table.addInt("recycle_size", "Vectors kept between solves by deflatedcg and recycledgmres.")
+      .defaultValue(5);
+  iterative_table
+      .addString("prec_type",
+                 "Preconditioner type "
+                 "(JacobiSmoother|L1JacobiSmoother|AMG|BlockILU|Chebyshev|LOR|PMultigrid|Schwarz|BlockSchur).")
       .defaultValue("JacobiSmoother");
+  iterative_table.addInt("schwarz_overlap", "Overlap of the Schwarz subdomains, in layers of the matrix graph.")
+      .defaultValue(1);
 
   auto& direct_table = linear_table.addStruct("direct_options", "Direct solver parameters");
   direct_table.addInt("print_level", "Linear print level.").defaultValue(0);
 
+  auto& mixed_table = linear_table.addStruct("mixed_options", "Mixed-precision solver parameters");
+  mixed_table.addDouble("rel_tol", "Relative tolerance for the linear solve.").defaultValue(1.0e-6);
+  mixed_table.addDouble("abs_tol", "Absolute tolerance for the linear solve.").defaultValue(1.0e-8);
+  mixed_table.addInt("max_iter", "Maximum double-precision iterations for the linear solve.").defaultValue(500);
+  mixed_table.addInt("print_level", "Linear print level.").defaultValue(0);
+  mixed_table.addInt("inner_max_iter", "Maximum single-precision iterations per double-precision iteration.")
+      .defaultValue(20);
+  mixed_table.addDouble("inner_rel_tol", "Relative tolerance of the single-precision iterations.").defaultValue(1.0e-2);
+
   // Only needed for nonlinear problems
   auto& nonlinear_table = table.addStruct("nonlinear", "Newton Equation Solver Parameters").required(false);
   nonlinear_table.addDouble("rel_tol", "Relative tolerance for the Newton solve.").defaultValue(1.0e-2);
@@ -401,6 +506,17 @@ LinearSolverOptions FromInlet<LinearSolverOptions>::operator()(const axom::inlet
       iter_options.lin_solver = serac::LinearSolver::MINRES;
     } else if (solver_type == "cg") {
       iter_options.lin_solver = serac::LinearSolver::CG;
+    } else if (solver_type == "pipelinedcg") {
+      iter_options.lin_solver = serac::LinearSolver::PipelinedCG;
+    } else if (solver_type == "sstepgmres") {
+      iter_options.lin_solver          = serac::LinearSolver::SStepGMRES;
+      iter_options.steps_per_reduction = config["steps_per_reduction"];
+    } else if (solver_type == "deflatedcg") {
+      iter_options.lin_solver   = serac::LinearSolver::DeflatedCG;
+      iter_options.recycle_size = config["recycle_size"];
+    } else if (solver_type == "recycledgmres") {
+      iter_options.lin_solver   = serac::LinearSolver::RecycledGMRES;
+      iter_options.recycle_size = config["recycle_size"];
     } else {
       std::string msg = fmt::format("Unknown Linear solver type given: {0}", solver_type);
       SLIC_ERROR(msg);
@@ -418,6 +534,16 @@ LinearSolverOptions FromInlet<LinearSolverOptions>::operator()(const axom::inlet
       iter_options.prec = serac::AMGXPrec{.smoother = serac::AMGXSolver::JACOBI_L1};
     } else if (prec_type == "BlockILU") {
       iter_options.prec = serac::BlockILUPrec{};
+    } else if (prec_type == "Chebyshev") {
+      iter_options.prec = serac::ChebyshevPrec{};
+    } else if (prec_type == "LOR") {
+      iter_options.prec = serac::LORPrec{};
+    } else if (prec_type == "PMultigrid") {
+      iter_options.prec = serac::PMultigridPrec{};
+    } else if (prec_type == "Schwarz") {
+      iter_options.prec = serac::SchwarzPrec{.overlap = config["schwarz_overlap"]};
+    } else if (prec_type == "BlockSchur") {
+      iter_options.prec = serac::BlockSchurPrec{};
     } else {
       std::string msg = fmt::format("Unknown preconditioner type given: {0}", prec_type);
       SLIC_ERROR(msg);
@@ -427,6 +553,16 @@ LinearSolverOptions FromInlet<LinearSolverOptions>::operator()(const axom::inlet
     serac::DirectSolverOptions direct_options;
     direct_options.print_level = base["direct_options/print_level"];
     options                    = direct_options;
+  } else if (type == "mixed") {
+    serac::MixedPrecisionSolverOptions mixed_options;
+    auto                               config = base["mixed_options"];
+    mixed_options.rel_tol                     = config["rel_tol"];
+    mixed_options.abs_tol                     = config["abs_tol"];
+    mixed_options.max_iter                    = config["max_iter"];
+    mixed_options.print_level                 = config["print_level"];
+    mixed_options.inner_max_iter              = config["inner_max_iter"];
+    mixed_options.inner_rel_tol               = config["inner_rel_tol"];
+    options                                   = mixed_options;
   }
   return options;
 }
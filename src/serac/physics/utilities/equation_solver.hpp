@@ -12,14 +12,17 @@
 
 #pragma once
 
+#include <functional>
 #include <memory>
 #include <optional>
+#include <utility>
 #include <variant>
 
 #include "mfem.hpp"
 
 #include "serac/infrastructure/input.hpp"
 #include "serac/physics/utilities/solver_config.hpp"
+#include "serac/physics/utilities/superlu_solver.hpp"
 
 namespace serac::mfem_ext {
 
@@ -49,14 +52,6 @@ public:
    */
   void SetOperator(const mfem::Operator& op) override;
 
-  /**
-   * @brief An overload for "intercepting" HypreParMatrices
-   * such that they can be converted to a SuperLURowLocMatrix
-   * when running in SuperLU mode
-   * @param[in] op The operator (system matrix) to use, "A" in Ax = b
-   */
-  void SetOperator(const mfem::HypreParMatrix& matrix);
-
   /**
    * Solves the system
    * @param[in] b RHS of the system of equations
@@ -65,6 +60,20 @@ public:
    */
   void Mult(const mfem::Vector& b, mfem::Vector& x) const override;
 
+  /**
+   * Sets a check of the states visited by the nonlinear solver
+   * @param[in] check Returns whether a state is acceptable
+   * @note Each Newton update is checked before it is taken. An unacceptable update ends the solve
+   * without evaluating the residual there, and the solve is reported as not converged. Nonlinear
+   * solvers other than MFEM's Newton solver only have their final state checked.
+   */
+  void SetStateCheck(std::function<bool(const mfem::Vector&)> check);
+
+  /**
+   * Returns whether the last solve was ended by the state check
+   */
+  bool Rejected() const { return rejected_; }
+
   /**
    * Returns the underlying solver object
    * @return A non-owning reference to the underlying nonlinear solver
@@ -85,6 +94,12 @@ public:
     return std::visit([](auto&& solver) -> const mfem::Solver& { return *solver; }, lin_solver_);
   }
 
+  /**
+   * Returns the preconditioner of the iterative linear solver
+   * @return A non-owning pointer to the preconditioner, or null if there is none
+   */
+  mfem::Solver* LinearPreconditioner() { return prec_.get(); }
+
   /**
    * Input file parameters specific to this class
    **/
@@ -92,65 +107,89 @@ public:
 
 private:
   /**
-   * @brief Builds an iterative solver given a set of linear solver parameters
-   * @param[in] comm The MPI communicator object
-   * @param[in] lin_options The parameters for the linear solver
+   * @brief Marks the setups and solves of the linear solver inside the nonlinear solver for profiling
    */
-  std::unique_ptr<mfem::IterativeSolver> BuildIterativeLinearSolver(MPI_Comm                      comm,
-                                                                    const IterativeSolverOptions& lin_options);
+  class ProfiledLinearSolver : public mfem::Solver {
+  public:
+    /**
+     * @brief Wraps a linear solver
+     * @param[in] solver The linear solver, which must outlive the wrapper
+     */
+    explicit ProfiledLinearSolver(mfem::Solver& solver) : solver_(solver) {}
 
-  /**
-   * @brief Builds an Newton-Raphson solver given a set of nonlinear solver parameters
-   * @param[in] comm The MPI communicator object
-   * @param[in] nonlin_options The parameters for the nonlinear solver
-   */
-  static std::unique_ptr<mfem::NewtonSolver> BuildNewtonSolver(MPI_Comm                      comm,
-                                                               const NonlinearSolverOptions& nonlin_options);
+    /**
+     * @brief Sets up the linear solver, including its preconditioner
+     * @param[in] op The linear system
+     */
+    void SetOperator(const mfem::Operator& op) override;
+
+    /**
+     * @brief Solves the linear system
+     * @param[in] b The right hand side
+     * @param[out] x The solution
+     */
+    void Mult(const mfem::Vector& b, mfem::Vector& x) const override;
+
+  private:
+    /**
+     * @brief The wrapped linear solver
+     */
+    mfem::Solver& solver_;
+  };
 
   /**
-   * @brief A wrapper class for combining a nonlinear solver with a SuperLU direct solver
+   * @brief A Newton solver that stops when an update would produce an unacceptable state
    */
-  class SuperLUNonlinearOperatorWrapper : public mfem::Operator {
+  class CheckedNewtonSolver : public mfem::NewtonSolver {
   public:
     /**
-     * @brief Constructs a wrapper over an mfem::Operator
-     * @param[in] oper The operator to wrap
+     * @brief Constructs a solver without a check
+     * @param[in] comm The MPI communicator object
      */
-    SuperLUNonlinearOperatorWrapper(const mfem::Operator& oper) : oper_(oper)
-    {
-      height = oper_.Height();
-      width  = oper_.Width();
-    }
+    explicit CheckedNewtonSolver(MPI_Comm comm) : mfem::NewtonSolver(comm) {}
+
     /**
-     * @brief Applies the operator
-     * @param[in] b The input vector
-     * @param[out] x The output vector
-     * @note Implements mfem::Operator::Mult, forwards directly to underlying operator
+     * @brief Checks the state the next update would produce
+     * @param[in] x The current state
+     * @param[in] b The right hand side
+     * @return The full step if the updated state is acceptable, or zero to end the solve
+     * @note Implements mfem::NewtonSolver::ComputeScalingFactor
      */
-    void Mult(const mfem::Vector& b, mfem::Vector& x) const override { oper_.Mult(b, x); }
+    double ComputeScalingFactor(const mfem::Vector& x, const mfem::Vector& b) const override;
 
     /**
-     * @brief Obtains the gradient of the underlying operator
-     * as a SuperLU matrix
-     * @param[in] x The point at which the gradient should be evaluated
-     * @return A non-owning reference to an mfem::SuperLURowLocMatrix (upcasts
-     * to match interface)
-     * @note Implements mfem::Operator::GetGradient
+     * @brief The check of the updated states, or an empty function to accept them all
      */
-    mfem::Operator& GetGradient(const mfem::Vector& x) const override;
+    std::function<bool(const mfem::Vector&)> check;
 
-  private:
     /**
-     * @brief The underlying operator
+     * @brief Whether the check ended the last solve
      */
-    const mfem::Operator& oper_;
+    mutable bool rejected = false;
 
+  private:
     /**
-     * @brief The owner of the SuperLU matrix for the gradient, stored
-     * as a member variable for lifetime purposes
+     * @brief Workspace for the updated state
      */
-    mutable std::optional<mfem::SuperLURowLocMatrix> superlu_grad_mat_;
+    mutable mfem::Vector trial_;
   };
+
+  /**
+   * @brief Builds an iterative solver given a set of linear solver parameters
+   * @param[in] comm The MPI communicator object
+   * @param[in] lin_options The parameters for the linear solver
+   */
+  std::unique_ptr<mfem::IterativeSolver> BuildIterativeLinearSolver(MPI_Comm                      comm,
+                                                                    const IterativeSolverOptions& lin_options);
+
+  /**
+   * @brief Builds an Newton-Raphson solver given a set of nonlinear solver parameters
+   * @param[in] comm The MPI communicator object
+   * @param[in] nonlin_options The parameters for the nonlinear solver
+   */
+  static std::unique_ptr<mfem::NewtonSolver> BuildNewtonSolver(MPI_Comm                      comm,
+                                                               const NonlinearSolverOptions& nonlin_options);
+
   /**
    * @brief The preconditioner (used for an iterative solver only)
    */
@@ -159,7 +198,7 @@ private:
   /**
    * @brief The linear solver object, either custom, direct (SuperLU), or iterative
    */
-  std::variant<std::unique_ptr<mfem::IterativeSolver>, std::unique_ptr<mfem::SuperLUSolver>, mfem::Solver*> lin_solver_;
+  std::variant<std::unique_ptr<mfem::IterativeSolver>, std::unique_ptr<SuperLUSolver>, mfem::Solver*> lin_solver_;
 
   /**
    * @brief The optional nonlinear Newton-Raphson solver object
@@ -167,21 +206,26 @@ private:
   std::unique_ptr<mfem::NewtonSolver> nonlin_solver_;
 
   /**
-   * @brief Whether the solver (linear solver) has been configured with the nonlinear solver
-   * @note This is a workaround as some nonlinear solvers require SetOperator to be called
-   * before SetSolver
+   * @brief The linear solver as seen by the nonlinear solver
    */
-  bool nonlin_solver_set_solver_called_ = false;
+  std::unique_ptr<ProfiledLinearSolver> profiled_lin_solver_;
 
   /**
-   * @brief The operator (system matrix) used with a SuperLU solver
+   * @brief The check of the states visited by the nonlinear solver, if any
    */
-  std::optional<mfem::SuperLURowLocMatrix> superlu_mat_;
+  std::function<bool(const mfem::Vector&)> state_check_;
 
   /**
-   * @brief A wrapper class that allows a direct solver to be used underneath a Newton-Raphson solver
+   * @brief Whether the last solve was ended by the state check
    */
-  std::unique_ptr<SuperLUNonlinearOperatorWrapper> superlu_wrapper_;
+  mutable bool rejected_ = false;
+
+  /**
+   * @brief Whether the solver (linear solver) has been configured with the nonlinear solver
+   * @note This is a workaround as some nonlinear solvers require SetOperator to be called
+   * before SetSolver
+   */
+  bool nonlin_solver_set_solver_called_ = false;
 };
 
 /**
@@ -207,6 +251,91 @@ inline LinearSolverOptions AugmentAMGForElasticity(const LinearSolverOptions&
   return augmented_options;
 }
 
+/**
+ * @brief A helper method intended to be called by physics modules to provide the matrix for the LOR preconditioner
+ * @param[in] init_options The user-provided solver parameters to possibly modify
+ * @param[in] pfes The high-order FiniteElementSpace of the system
+ * @param[in] matrix Returns the low-order-refined counterpart of the current system matrix
+ * @note A full copy of the object is made, pending C++20 relaxation of "mutable"
+ */
+inline LinearSolverOptions AugmentLOR(const LinearSolverOptions& init_options, mfem::ParFiniteElementSpace& pfes,
+                                      std::function<const mfem::HypreParMatrix&()> matrix)
+{
+  auto augmented_options = init_options;
+  if (auto iter_options = std::get_if<IterativeSolverOptions>(&augmented_options)) {
+    if (iter_options->prec) {
+      if (auto lor_options = std::get_if<LORPrec>(&iter_options->prec.value())) {
+        lor_options->matrix = std::move(matrix);
+        lor_options->pfes   = &pfes;
+      }
+    }
+  }
+  return augmented_options;
+}
+
+/**
+ * @brief Checks whether a set of solver parameters uses the LOR preconditioner
+ * @param[in] options The solver parameters
+ * @return Whether the physics module needs to assemble low-order-refined matrices
+ */
+inline bool UsesLOR(const LinearSolverOptions& options)
+{
+  auto iter_options = std::get_if<IterativeSolverOptions>(&options);
+  return iter_options && iter_options->prec && std::holds_alternative<LORPrec>(*iter_options->prec);
+}
+
+/**
+ * @brief A helper method intended to be called by physics modules to describe the levels of the p-multigrid
+ * preconditioner
+ * @param[in] init_options The user-provided solver parameters to possibly modify
+ * @param[in] pfes The high-order FiniteElementSpace of the system
+ * @param[in] integrators Adds the integrators of the current system to a form on one level
+ * @param[in] essential_dofs Computes the essential true DOFs on one level
+ * @param[in] partial_assembly Whether the integrators support partial assembly
+ * @note A full copy of the object is made, pending C++20 relaxation of "mutable"
+ */
+inline LinearSolverOptions AugmentPMultigrid(
+    const LinearSolverOptions& init_options, mfem::ParFiniteElementSpace& pfes,
+    std::function<void(mfem::ParBilinearForm&)>                          integrators,
+    std::function<void(mfem::ParFiniteElementSpace&, mfem::Array<int>&)> essential_dofs, const bool partial_assembly)
+{
+  auto augmented_options = init_options;
+  if (auto iter_options = std::get_if<IterativeSolverOptions>(&augmented_options)) {
+    if (iter_options->prec) {
+      if (auto pmg_options = std::get_if<PMultigridPrec>(&iter_options->prec.value())) {
+        pmg_options->integrators      = std::move(integrators);
+        pmg_options->essential_dofs   = std::move(essential_dofs);
+        pmg_options->pfes             = &pfes;
+        pmg_options->partial_assembly = partial_assembly;
+      }
+    }
+  }
+  return augmented_options;
+}
+
+/**
+ * @brief A helper method intended to be called by physics modules with a mixed displacement-pressure formulation to
+ * configure the block Schur preconditioner
+ * @param[in] init_options The user-provided solver parameters to possibly modify
+ * @param[in] pfes The displacement FiniteElementSpace
+ * @param[in] schur Returns the approximation of the negative Schur complement of the pressure block
+ * @note A full copy of the object is made, pending C++20 relaxation of "mutable"
+ */
+inline LinearSolverOptions AugmentBlockSchur(const LinearSolverOptions& init_options, mfem::ParFiniteElementSpace& pfes,
+                                             std::function<const mfem::HypreParMatrix&()> schur)
+{
+  auto augmented_options = init_options;
+  if (auto iter_options = std::get_if<IterativeSolverOptions>(&augmented_options)) {
+    if (iter_options->prec) {
+      if (auto block_options = std::get_if<BlockSchurPrec>(&iter_options->prec.value())) {
+        block_options->schur = std::move(schur);
+        block_options->pfes  = &pfes;
+      }
+    }
+  }
+  return augmented_options;
+}
+
 }  // namespace serac::mfem_ext
 
 // Prototype the specialization
@@ -14,11 +14,19 @@ FiniteElementState::FiniteElementState(mfem::ParMesh& mesh, FiniteElementState::
                          : std::make_unique<mfem::H1_FECollection>(options.order, mesh.Dimension())),
       space_(&mesh, coll_.get(), options.vector_dim, options.ordering),
       gf_(std::make_unique<mfem::ParGridFunction>(&space_)),
-      true_vec_(&space_),
+      true_vec_(std::make_unique<mfem::HypreParVector>(&space_)),
       name_(options.name)
 {
-  *gf_      = 0.0;
-  true_vec_ = 0.0;
+  *gf_       = 0.0;
+  *true_vec_ = 0.0;
+}
+
+void FiniteElementState::update()
+{
+  space_.Update();
+  gf_->Update();
+  true_vec_ = std::make_unique<mfem::HypreParVector>(&space_);
+  initializeTrueVec();
 }
 
 }  // namespace serac
@@ -119,7 +119,7 @@ public:
   /**
    * Returns a non-owning reference to the vector of true DOFs
    */
-  mfem::HypreParVector& trueVec() { return true_vec_; }
+  mfem::HypreParVector& trueVec() { return *true_vec_; }
 
   /**
    * Returns the name of the FEState (field)
@@ -145,12 +145,21 @@ public:
    * Initialize the true DOF vector by extracting true DOFs from the internal
    * grid function into the internal true DOF vector
    */
-  void initializeTrueVec() { gf_->GetTrueDofs(true_vec_); }
+  void initializeTrueVec() { gf_->GetTrueDofs(*true_vec_); }
 
   /**
    * Set the internal grid function using the true DOF values
    */
-  void distributeSharedDofs() { gf_->SetFromTrueDofs(true_vec_); }
+  void distributeSharedDofs() { gf_->SetFromTrueDofs(*true_vec_); }
+
+  /**
+   * Update the space, grid function, and true DOF vector after the mesh has changed
+   *
+   * The grid function values follow their elements to their new ranks (or are
+   * interpolated, for refinement), and the true DOF vector is reallocated and
+   * initialized from them. References previously obtained from trueVec() are invalidated.
+   */
+  void update();
 
   /**
    * Utility function for creating a tensor, e.g. mfem::HypreParVector,
@@ -172,7 +181,7 @@ private:
   std::unique_ptr<mfem::FiniteElementCollection> coll_;
   mfem::ParFiniteElementSpace                    space_;
   std::unique_ptr<mfem::ParGridFunction>         gf_;
-  mfem::HypreParVector                           true_vec_;
+  std::unique_ptr<mfem::HypreParVector>          true_vec_;
   std::string                                    name_ = "";
 };
 
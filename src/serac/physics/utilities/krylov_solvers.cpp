@@ -0,0 +1,876 @@
+// Copyright (c) 2019-2021, Lawrence Livermore National Security, LLC and
+// other Serac Project Developers. See the top-level LICENSE file for
+// details.
+//
+// SPDX-License-Identifier: (BSD-3-Clause)
+
+#include "serac/physics/utilities/krylov_solvers.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+#include <numeric>
+
+#include "serac/infrastructure/logger.hpp"
+
+namespace serac::mfem_ext {
+
+namespace {
+
+/**
+ * @brief Prints the residual norm of an iteration on the root rank
+ */
+void printIteration(MPI_Comm comm, const int print_level, const int iteration, const double norm)
+{
+  int rank;
+  MPI_Comm_rank(comm, &rank);
+  if (print_level > 0 && rank == 0) {
+    mfem::out << "   Iteration : " << std::setw(3) << iteration << "  ||r|| = " << norm << '\n';
+  }
+}
+
+/**
+ * @brief Applies a preconditioner, or copies the input if there is none
+ */
+void applyPreconditioner(const mfem::Solver* prec, const mfem::Vector& in, mfem::Vector& out)
+{
+  if (prec) {
+    prec->Mult(in, out);
+  } else {
+    out = in;
+  }
+}
+
+/**
+ * @brief Computes the inner products of a vector with every vector of a basis in a single reduction
+ */
+std::vector<double> innerProducts(const std::deque<mfem::Vector>& basis, const mfem::Vector& v, MPI_Comm comm)
+{
+  std::vector<double> products;
+  products.reserve(basis.size());
+  for (const auto& vector : basis) {
+    products.push_back(vector * v);
+  }
+  MPI_Allreduce(MPI_IN_PLACE, products.data(), static_cast<int>(products.size()), MPI_DOUBLE, MPI_SUM, comm);
+  return products;
+}
+
+/**
+ * @brief Computes a pivoted Cholesky factorization of a symmetric positive semi-definite matrix
+ *
+ * Columns are selected by largest remaining diagonal, and the factorization stops once the
+ * remaining diagonal is negligible, which leaves out the linearly dependent columns.
+ *
+ * @param[in] a The matrix, which is overwritten
+ * @param[out] pivots The selected columns, in the order of the factor
+ * @param[out] factor The lower triangular factor L with a(pivots, pivots) = L L^T
+ */
+void pivotedCholesky(mfem::DenseMatrix& a, std::vector<int>& pivots, mfem::DenseMatrix& factor)
+{
+  const int size     = a.Height();
+  double    max_diag = 0.0;
+  for (int i = 0; i < size; i++) {
+    max_diag = std::max(max_diag, a(i, i));
+  }
+  const double threshold = 1.0e-12 * max_diag;
+
+  std::vector<int> order(static_cast<std::size_t>(size));
+  std::iota(order.begin(), order.end(), 0);
+  mfem::DenseMatrix lower(size);
+  lower = 0.0;
+
+  int rank = 0;
+  for (; rank < size; rank++) {
+    auto best = rank;
+    for (int i = rank + 1; i < size; i++) {
+      if (a(order[i], order[i]) > a(order[best], order[best])) {
+        best = i;
+      }
+    }
+    if (a(order[best], order[best]) <= threshold) {
+      break;
+    }
+    std::swap(order[rank], order[best]);
+    for (int j = 0; j < rank; j++) {
+      std::swap(lower(rank, j), lower(best, j));
+    }
+
+    const int    column = order[rank];
+    const double pivot  = std::sqrt(a(column, column));
+    lower(rank, rank)   = pivot;
+    for (int i = rank + 1; i < size; i++) {
+      lower(i, rank) = a(order[i], column) / pivot;
+    }
+    for (int i = rank + 1; i < size; i++) {
+      for (int j = rank + 1; j < size; j++) {
+        a(order[i], order[j]) -= lower(i, rank) * lower(j, rank);
+      }
+    }
+  }
+
+  pivots.assign(order.begin(), order.begin() + rank);
+  factor.SetSize(rank);
+  for (int i = 0; i < rank; i++) {
+    for (int j = 0; j < rank; j++) {
+      factor(i, j) = lower(i, j);
+    }
+  }
+}
+
+/**
+ * @brief Sums the entries of several dense matrices over all ranks in a single reduction
+ */
+void allreduce(std::initializer_list<mfem::DenseMatrix*> matrices, MPI_Comm comm)
+{
+  std::vector<double> buffer;
+  for (auto matrix : matrices) {
+    buffer.insert(buffer.end(), matrix->Data(), matrix->Data() + matrix->Height() * matrix->Width());
+  }
+  MPI_Allreduce(MPI_IN_PLACE, buffer.data(), static_cast<int>(buffer.size()), MPI_DOUBLE, MPI_SUM, comm);
+  auto entry = buffer.begin();
+  for (auto matrix : matrices) {
+    std::copy(entry, entry + matrix->Height() * matrix->Width(), matrix->Data());
+    entry += matrix->Height() * matrix->Width();
+  }
+}
+
+/**
+ * @brief Computes the inner product of each column of a with the same column of b
+ *
+ * @return A row vector of the local inner products
+ */
+mfem::DenseMatrix columnProducts(const mfem::DenseMatrix& a, const mfem::DenseMatrix& b)
+{
+  mfem::DenseMatrix products(1, a.Width());
+  for (int j = 0; j < a.Width(); j++) {
+    const mfem::Vector a_column(const_cast<double*>(a.GetColumn(j)), a.Height());
+    const mfem::Vector b_column(const_cast<double*>(b.GetColumn(j)), b.Height());
+    products(0, j) = a_column * b_column;
+  }
+  return products;
+}
+
+}  // namespace
+
+void PipelinedCGSolver::Mult(const mfem::Vector& b, mfem::Vector& x) const
+{
+  for (auto vector : {&r_, &u_, &w_, &m_, &n_, &z_, &q_, &s_, &p_}) {
+    vector->SetSize(height);
+  }
+
+  if (iterative_mode) {
+    oper->Mult(x, r_);
+    subtract(b, r_, r_);
+  } else {
+    x  = 0.0;
+    r_ = b;
+  }
+  applyPreconditioner(prec, r_, u_);
+  oper->Mult(u_, w_);
+
+  converged         = 0;
+  double tolerance  = 0.0;
+  double gamma_prev = 0.0;
+  double alpha_prev = 0.0;
+  for (int i = 0;; i++) {
+    double dots[2] = {r_ * u_, w_ * u_};
+
+    // The reduction completes while the preconditioner and the operator are applied
+    MPI_Request request;
+    MPI_Iallreduce(MPI_IN_PLACE, dots, 2, MPI_DOUBLE, MPI_SUM, comm, &request);
+    applyPreconditioner(prec, w_, m_);
+    oper->Mult(m_, n_);
+    MPI_Wait(&request, MPI_STATUS_IGNORE);
+
+    const double gamma = dots[0];
+    const double delta = dots[1];
+    final_norm         = std::sqrt(std::abs(gamma));
+    if (i == 0) {
+      tolerance = std::max(rel_tol * final_norm, abs_tol);
+    }
+    printIteration(comm, print_level, i, final_norm);
+
+    if (final_norm <= tolerance) {
+      converged  = 1;
+      final_iter = i;
+      return;
+    }
+    if (i == max_iter) {
+      final_iter = i;
+      SLIC_WARNING_IF(print_level >= 0, "Pipelined CG did not converge.");
+      return;
+    }
+
+    double alpha = gamma / delta;
+    double beta  = 0.0;
+    if (i > 0) {
+      beta  = gamma / gamma_prev;
+      alpha = gamma / (delta - beta * gamma / alpha_prev);
+    }
+
+    // The directions are set from scratch on the first iteration, as scaling their
+    // uninitialized entries by zero would keep any NaNs
+    if (i == 0) {
+      z_ = n_;
+      q_ = m_;
+      s_ = w_;
+      p_ = u_;
+    } else {
+      z_ *= beta;
+      z_ += n_;
+      q_ *= beta;
+      q_ += m_;
+      s_ *= beta;
+      s_ += w_;
+      p_ *= beta;
+      p_ += u_;
+    }
+
+    x.Add(alpha, p_);
+    r_.Add(-alpha, s_);
+    u_.Add(-alpha, q_);
+    w_.Add(-alpha, z_);
+
+    gamma_prev = gamma;
+    alpha_prev = alpha;
+  }
+}
+
+void SStepGMRESSolver::applyOperator(const mfem::Vector& in, mfem::Vector& out) const
+{
+  if (prec) {
+    prec->Mult(in, work_);
+    oper->Mult(work_, out);
+  } else {
+    oper->Mult(in, out);
+  }
+}
+
+void SStepGMRESSolver::Mult(const mfem::Vector& b, mfem::Vector& x) const
+{
+  SLIC_ERROR_IF(steps_ < 1, "The number of s-step GMRES steps must be positive.");
+
+  const int s = steps_;
+  basis_.resize(static_cast<std::size_t>(s + 1));
+  for (auto& vector : basis_) {
+    vector.SetSize(height);
+  }
+  r_.SetSize(height);
+  work_.SetSize(height);
+  if (!iterative_mode) {
+    x = 0.0;
+  }
+
+  // Row-major (s + 1) x (s + 1) matrices, of which only the lower triangle of the Gram matrix
+  // and the upper triangle of its Cholesky factor are used
+  const auto               size = static_cast<std::size_t>(s + 1);
+  std::vector<double>      gram(size * size);
+  std::vector<double>      factor(size * size);
+  std::vector<MPI_Request> requests(size);
+
+  // The monomial basis is scaled by an estimate of the spectral radius of A M, taken from the
+  // growth of the basis in the previous cycle, so that its norms stay comparable
+  double scale     = 1.0;
+  double tolerance = 0.0;
+
+  converged  = 0;
+  final_iter = 0;
+  for (int cycle = 0;; cycle++) {
+    // The true residual is recomputed every cycle to avoid drift in the recurrence
+    oper->Mult(x, r_);
+    subtract(b, r_, r_);
+    basis_[0] = r_;
+
+    for (std::size_t j = 0; j < size; j++) {
+      if (j > 0) {
+        applyOperator(basis_[j - 1], basis_[j]);
+        basis_[j] /= scale;
+      }
+      double* row = &gram[j * size];
+      for (std::size_t i = 0; i <= j; i++) {
+        row[i] = basis_[j] * basis_[i];
+      }
+      // This row is reduced while the next basis vector is generated
+      MPI_Iallreduce(MPI_IN_PLACE, row, static_cast<int>(j + 1), MPI_DOUBLE, MPI_SUM, comm, &requests[j]);
+    }
+    MPI_Waitall(static_cast<int>(size), requests.data(), MPI_STATUSES_IGNORE);
+
+    const double residual_norm = std::sqrt(gram[0]);
+    if (cycle == 0) {
+      tolerance = std::max(rel_tol * residual_norm, abs_tol);
+    }
+    final_norm = residual_norm;
+    printIteration(comm, print_level, final_iter, final_norm);
+    if (residual_norm <= tolerance) {
+      converged = 1;
+      return;
+    }
+    if (final_iter >= max_iter) {
+      SLIC_WARNING_IF(print_level >= 0, "s-step GMRES did not converge.");
+      return;
+    }
+
+    // Cholesky factorization G = R^T R, stopping at the first basis vector that is numerically
+    // dependent on the previous ones
+    std::size_t independent = 0;
+    for (std::size_t j = 0; j < size; j++) {
+      for (std::size_t i = 0; i < j; i++) {
+        double sum = gram[j * size + i];
+        for (std::size_t l = 0; l < i; l++) {
+          sum -= factor[l * size + i] * factor[l * size + j];
+        }
+        factor[i * size + j] = sum / factor[i * size + i];
+      }
+      double diagonal = gram[j * size + j];
+      for (std::size_t l = 0; l < j; l++) {
+        diagonal -= factor[l * size + j] * factor[l * size + j];
+      }
+      if (!(diagonal > 1.0e-14 * gram[j * size + j])) {
+        break;
+      }
+      factor[j * size + j] = std::sqrt(diagonal);
+      independent++;
+    }
+    const std::size_t steps = independent > 0 ? independent - 1 : 0;
+    if (steps == 0) {
+      SLIC_WARNING_IF(print_level >= 0, "s-step GMRES broke down: the Krylov basis is not linearly independent.");
+      return;
+    }
+
+    // Since A M V[0, steps) = scale * V[1, steps], the least squares problem is
+    // min || R e_0 - scale * R[:, 1:steps] c ||, whose matrix is upper Hessenberg
+    std::vector<double> hessenberg((steps + 1) * steps);
+    std::vector<double> rhs(steps + 1, 0.0);
+    for (std::size_t k = 0; k < steps; k++) {
+      for (std::size_t i = 0; i <= k + 1; i++) {
+        hessenberg[i * steps + k] = scale * factor[i * size + k + 1];
+      }
+    }
+    rhs[0] = factor[0];
+
+    // Reduce the Hessenberg matrix to triangular form with Givens rotations
+    for (std::size_t k = 0; k < steps; k++) {
+      const double a      = hessenberg[k * steps + k];
+      const double c      = hessenberg[(k + 1) * steps + k];
+      const double radius = std::hypot(a, c);
+      const double cosine = a / radius;
+      const double sine   = c / radius;
+      for (std::size_t l = k; l < steps; l++) {
+        const double upper              = hessenberg[k * steps + l];
+        const double lower              = hessenberg[(k + 1) * steps + l];
+        hessenberg[k * steps + l]       = cosine * upper + sine * lower;
+        hessenberg[(k + 1) * steps + l] = -sine * upper + cosine * lower;
+      }
+      const double upper = rhs[k];
+      rhs[k]             = cosine * upper;
+      rhs[k + 1]         = -sine * upper;
+    }
+
+    std::vector<double> coefficients(steps);
+    for (std::size_t k = steps; k-- > 0;) {
+      double sum = rhs[k];
+      for (std::size_t l = k + 1; l < steps; l++) {
+        sum -= hessenberg[k * steps + l] * coefficients[l];
+      }
+      coefficients[k] = sum / hessenberg[k * steps + k];
+    }
+
+    // x += M V c, with a single preconditioner application
+    r_ = 0.0;
+    for (std::size_t k = 0; k < steps; k++) {
+      r_.Add(coefficients[k], basis_[k]);
+    }
+    if (prec) {
+      prec->Mult(r_, work_);
+      x += work_;
+    } else {
+      x += r_;
+    }
+    final_iter += static_cast<int>(steps);
+
+    // Re-estimate the scale from the independent part of the basis, so a cycle that broke down
+    // because of a badly scaled basis does not pass the same scale on to the next one
+    const std::size_t last = independent - 1;
+    scale *= std::pow(gram[last * size + last] / gram[0], 0.5 / static_cast<double>(last));
+  }
+}
+
+void RecyclingSolver::SetOperator(const mfem::Operator& op)
+{
+  // The recycled vectors are meaningless on a different space, e.g., after a mesh change
+  if (op.Height() != height) {
+    basis_.clear();
+    images_.clear();
+  }
+  mfem::IterativeSolver::SetOperator(op);
+  stale_ = !basis_.empty();
+}
+
+void RecyclingSolver::refresh() const
+{
+  if (!stale_) {
+    return;
+  }
+  stale_ = false;
+
+  auto old_basis = std::move(basis_);
+  basis_.clear();
+  images_.clear();
+  for (auto& u : old_basis) {
+    mfem::Vector c(u.Size());
+    oper->Mult(u, c);
+    recycle(std::move(u), std::move(c));
+  }
+}
+
+std::vector<double> RecyclingSolver::coefficients(const mfem::Vector& v) const
+{
+  return innerProducts(images_, v, comm);
+}
+
+void RecyclingSolver::project(mfem::Vector& x, mfem::Vector& r) const
+{
+  if (basis_.empty()) {
+    return;
+  }
+  const auto coefs = innerProducts(energy_ ? basis_ : images_, r, comm);
+  for (std::size_t i = 0; i < basis_.size(); i++) {
+    x.Add(coefs[i], basis_[i]);
+    r.Add(-coefs[i], images_[i]);
+  }
+}
+
+void RecyclingSolver::recycle(mfem::Vector u, mfem::Vector c) const
+{
+  if (recycle_size_ < 1) {
+    return;
+  }
+
+  const auto   products     = coefficients(energy_ ? u : c);
+  const double norm_squared = energy_ ? mfem::InnerProduct(comm, u, c) : mfem::InnerProduct(comm, c, c);
+
+  double projected_squared = 0.0;
+  for (std::size_t i = 0; i < basis_.size(); i++) {
+    u.Add(-products[i], basis_[i]);
+    c.Add(-products[i], images_[i]);
+    projected_squared += products[i] * products[i];
+  }
+
+  // A pair that lies (nearly) in the recycled subspace adds nothing
+  const double remaining = norm_squared - projected_squared;
+  if (!(remaining > 1.0e-12 * norm_squared)) {
+    return;
+  }
+  const double norm = std::sqrt(energy_ ? mfem::InnerProduct(comm, u, c) : mfem::InnerProduct(comm, c, c));
+  u /= norm;
+  c /= norm;
+  basis_.push_back(std::move(u));
+  images_.push_back(std::move(c));
+  if (static_cast<int>(basis_.size()) > recycle_size_) {
+    basis_.pop_front();
+    images_.pop_front();
+  }
+}
+
+void DeflatedCGSolver::Mult(const mfem::Vector& b, mfem::Vector& x) const
+{
+  refresh();
+  for (auto vector : {&r_, &z_, &p_, &Ap_, &delta_, &A_delta_}) {
+    vector->SetSize(height);
+  }
+
+  if (!iterative_mode) {
+    x = 0.0;
+  }
+  oper->Mult(x, r_);
+  subtract(b, r_, r_);
+
+  // The tolerance is relative to the residual before the projection, as it would be for CG
+  applyPreconditioner(prec, r_, z_);
+  const double tolerance = std::max(rel_tol * std::sqrt(std::abs(mfem::InnerProduct(comm, r_, z_))), abs_tol);
+
+  project(x, r_);
+  applyPreconditioner(prec, r_, z_);
+  double nom = mfem::InnerProduct(comm, r_, z_);
+
+  // The search directions are kept conjugate to the recycled subspace
+  auto deflate = [this]() {
+    const auto coefs = coefficients(z_);
+    for (std::size_t i = 0; i < basis_.size(); i++) {
+      p_.Add(-coefs[i], basis_[i]);
+    }
+  };
+  p_ = z_;
+  deflate();
+  delta_   = 0.0;
+  A_delta_ = 0.0;
+
+  converged = 0;
+  int i     = 0;
+  for (;; i++) {
+    final_norm = std::sqrt(std::abs(nom));
+    printIteration(comm, print_level, i, final_norm);
+    if (final_norm <= tolerance) {
+      converged = 1;
+      break;
+    }
+    if (i == max_iter) {
+      SLIC_WARNING_IF(print_level >= 0, "Deflated CG did not converge.");
+      break;
+    }
+
+    oper->Mult(p_, Ap_);
+    const double den = mfem::InnerProduct(comm, p_, Ap_);
+    if (den <= 0.0) {
+      SLIC_WARNING_IF(print_level >= 0, "Deflated CG broke down: the operator is not positive definite.");
+      break;
+    }
+    const double alpha = nom / den;
+    x.Add(alpha, p_);
+    delta_.Add(alpha, p_);
+    r_.Add(-alpha, Ap_);
+    A_delta_.Add(alpha, Ap_);
+
+    applyPreconditioner(prec, r_, z_);
+    const double nom_next = mfem::InnerProduct(comm, r_, z_);
+    p_ *= nom_next / nom;
+    p_ += z_;
+    deflate();
+    nom = nom_next;
+  }
+  final_iter = i;
+
+  // The image of the increment was accumulated along the way, so recycling it needs no product
+  if (converged && final_iter > 0) {
+    recycle(delta_, A_delta_);
+  }
+}
+
+void RecycledGMRESSolver::Mult(const mfem::Vector& b, mfem::Vector& x) const
+{
+  refresh();
+  const int m = kdim_;
+  arnoldi_.resize(static_cast<std::size_t>(m + 1));
+  for (auto& vector : arnoldi_) {
+    vector.SetSize(height);
+  }
+  for (auto vector : {&r_, &work_, &u_, &c_}) {
+    vector->SetSize(height);
+  }
+
+  if (!iterative_mode) {
+    x = 0.0;
+  }
+  oper->Mult(x, r_);
+  subtract(b, r_, r_);
+  const double tolerance = std::max(rel_tol * std::sqrt(mfem::InnerProduct(comm, r_, r_)), abs_tol);
+  project(x, r_);
+
+  // Row-major (m + 1) x m Hessenberg matrix, with the Givens rotations that triangularize it
+  const auto          columns = static_cast<std::size_t>(m);
+  std::vector<double> hessenberg((columns + 1) * columns);
+  std::vector<double> rhs(columns + 1);
+  std::vector<double> cosines(columns);
+  std::vector<double> sines(columns);
+  std::vector<double> y(columns);
+
+  // The coefficients of each Arnoldi vector's image against the images of the recycled vectors
+  std::vector<std::vector<double>> projections;
+
+  converged  = 0;
+  final_iter = 0;
+  for (;;) {
+    const double beta = std::sqrt(mfem::InnerProduct(comm, r_, r_));
+    final_norm        = beta;
+    printIteration(comm, print_level, final_iter, final_norm);
+    if (beta <= tolerance) {
+      converged = 1;
+      return;
+    }
+    if (final_iter >= max_iter) {
+      SLIC_WARNING_IF(print_level >= 0, "Recycled GMRES did not converge.");
+      return;
+    }
+
+    arnoldi_[0].Set(1.0 / beta, r_);
+    std::fill(rhs.begin(), rhs.end(), 0.0);
+    rhs[0] = beta;
+    projections.clear();
+
+    std::size_t j = 0;
+    while (j < columns && final_iter < max_iter) {
+      auto& w = arnoldi_[j + 1];
+      applyPreconditioner(prec, arnoldi_[j], work_);
+      oper->Mult(work_, w);
+
+      projections.push_back(coefficients(w));
+      for (std::size_t i = 0; i < images_.size(); i++) {
+        w.Add(-projections.back()[i], images_[i]);
+      }
+      for (std::size_t i = 0; i <= j; i++) {
+        const double h              = mfem::InnerProduct(comm, w, arnoldi_[i]);
+        hessenberg[i * columns + j] = h;
+        w.Add(-h, arnoldi_[i]);
+      }
+      const double subdiagonal = std::sqrt(mfem::InnerProduct(comm, w, w));
+      if (subdiagonal > 0.0) {
+        w /= subdiagonal;
+      }
+
+      for (std::size_t i = 0; i < j; i++) {
+        const double upper                = hessenberg[i * columns + j];
+        const double lower                = hessenberg[(i + 1) * columns + j];
+        hessenberg[i * columns + j]       = cosines[i] * upper + sines[i] * lower;
+        hessenberg[(i + 1) * columns + j] = -sines[i] * upper + cosines[i] * lower;
+      }
+      const double diagonal = hessenberg[j * columns + j];
+      const double radius   = std::hypot(diagonal, subdiagonal);
+      if (radius == 0.0) {
+        break;
+      }
+      cosines[j]                  = diagonal / radius;
+      sines[j]                    = subdiagonal / radius;
+      hessenberg[j * columns + j] = radius;
+      rhs[j + 1]                  = -sines[j] * rhs[j];
+      rhs[j]                      = cosines[j] * rhs[j];
+
+      j++;
+      final_iter++;
+      if (std::abs(rhs[j]) <= tolerance || subdiagonal == 0.0) {
+        break;
+      }
+    }
+    if (j == 0) {
+      SLIC_WARNING_IF(print_level >= 0, "Recycled GMRES broke down.");
+      return;
+    }
+
+    for (std::size_t k = j; k-- > 0;) {
+      double sum = rhs[k];
+      for (std::size_t l = k + 1; l < j; l++) {
+        sum -= hessenberg[k * columns + l] * y[l];
+      }
+      y[k] = sum / hessenberg[k * columns + k];
+    }
+
+    // The correction u = M V y - U B y, whose image A u = V H y lies outside the recycled images
+    work_ = 0.0;
+    for (std::size_t k = 0; k < j; k++) {
+      work_.Add(y[k], arnoldi_[k]);
+    }
+    applyPreconditioner(prec, work_, u_);
+    for (std::size_t k = 0; k < j; k++) {
+      for (std::size_t i = 0; i < basis_.size(); i++) {
+        u_.Add(-projections[k][i] * y[k], basis_[i]);
+      }
+    }
+
+    // The image is recomputed rather than formed from the Hessenberg matrix to limit drift
+    oper->Mult(u_, c_);
+    const double norm = std::sqrt(mfem::InnerProduct(comm, c_, c_));
+    if (norm == 0.0) {
+      SLIC_WARNING_IF(print_level >= 0, "Recycled GMRES broke down.");
+      return;
+    }
+    u_ /= norm;
+    c_ /= norm;
+    const double gamma = mfem::InnerProduct(comm, c_, r_);
+    x.Add(gamma, u_);
+    r_.Add(-gamma, c_);
+    recycle(u_, c_);
+  }
+}
+
+void BlockCGSolver::applyOperator(const mfem::DenseMatrix& in, mfem::DenseMatrix& out) const
+{
+  const int size   = in.Height();
+  const int blocks = in.Width();
+  out.SetSize(size, blocks);
+
+  auto matrix = dynamic_cast<const mfem::HypreParMatrix*>(oper);
+  if (matrix == nullptr) {
+    for (int j = 0; j < blocks; j++) {
+      const mfem::Vector in_column(const_cast<double*>(in.GetColumn(j)), size);
+      mfem::Vector       out_column(out.GetColumn(j), size);
+      oper->Mult(in_column, out_column);
+    }
+    return;
+  }
+
+  auto parcsr = static_cast<hypre_ParCSRMatrix*>(*const_cast<mfem::HypreParMatrix*>(matrix));
+  auto diag   = hypre_ParCSRMatrixDiag(parcsr);
+  auto offd   = hypre_ParCSRMatrixOffd(parcsr);
+  if (hypre_ParCSRMatrixCommPkg(parcsr) == nullptr) {
+    hypre_MatvecCommPkgCreate(parcsr);
+  }
+  auto       comm_pkg  = hypre_ParCSRMatrixCommPkg(parcsr);
+  auto       send_rows = hypre_ParCSRCommPkgSendMapElmts(comm_pkg);
+  const int  num_sent  = hypre_ParCSRCommPkgSendMapStart(comm_pkg, hypre_ParCSRCommPkgNumSends(comm_pkg));
+  const int  num_offd  = hypre_CSRMatrixNumCols(offd);
+  const auto in_data   = in.Data();
+  const auto out_data  = out.Data();
+
+  // Every column is sent before any local work, so all of the messages overlap the local product
+  send_.resize(static_cast<std::size_t>(num_sent * blocks));
+  external_.resize(static_cast<std::size_t>(num_offd * blocks));
+  std::vector<hypre_ParCSRCommHandle*> handles(static_cast<std::size_t>(blocks));
+  for (int j = 0; j < blocks; j++) {
+    for (int i = 0; i < num_sent; i++) {
+      send_[static_cast<std::size_t>(j * num_sent + i)] = in(send_rows[i], j);
+    }
+    handles[static_cast<std::size_t>(j)] = hypre_ParCSRCommHandleCreate(1, comm_pkg, send_.data() + j * num_sent,
+                                                                        external_.data() + j * num_offd);
+  }
+
+  // Each matrix entry is read once and applied to the whole block
+  out = 0.0;
+  for (int row = 0; row < size; row++) {
+    for (int k = hypre_CSRMatrixI(diag)[row]; k < hypre_CSRMatrixI(diag)[row + 1]; k++) {
+      const int    column = hypre_CSRMatrixJ(diag)[k];
+      const double value  = hypre_CSRMatrixData(diag)[k];
+      for (int j = 0; j < blocks; j++) {
+        out_data[j * size + row] += value * in_data[j * size + column];
+      }
+    }
+  }
+
+  for (auto handle : handles) {
+    hypre_ParCSRCommHandleDestroy(handle);
+  }
+  for (int row = 0; row < size; row++) {
+    for (int k = hypre_CSRMatrixI(offd)[row]; k < hypre_CSRMatrixI(offd)[row + 1]; k++) {
+      const int    column = hypre_CSRMatrixJ(offd)[k];
+      const double value  = hypre_CSRMatrixData(offd)[k];
+      for (int j = 0; j < blocks; j++) {
+        out_data[j * size + row] += value * external_[static_cast<std::size_t>(j * num_offd + column)];
+      }
+    }
+  }
+}
+
+void BlockCGSolver::applyPreconditioner(const mfem::DenseMatrix& in, mfem::DenseMatrix& out) const
+{
+  out.SetSize(in.Height(), in.Width());
+  for (int j = 0; j < in.Width(); j++) {
+    const mfem::Vector in_column(const_cast<double*>(in.GetColumn(j)), in.Height());
+    mfem::Vector       out_column(out.GetColumn(j), in.Height());
+    serac::mfem_ext::applyPreconditioner(prec, in_column, out_column);
+  }
+}
+
+void BlockCGSolver::Mult(const mfem::Vector& b, mfem::Vector& x) const
+{
+  x.SetSize(height);
+  const mfem::DenseMatrix b_block(const_cast<double*>(b.GetData()), height, 1);
+  mfem::DenseMatrix       x_block(x.GetData(), height, 1);
+  Mult(b_block, x_block);
+}
+
+void BlockCGSolver::Mult(const mfem::DenseMatrix& b, mfem::DenseMatrix& x) const
+{
+  const int size   = b.Height();
+  const int blocks = b.Width();
+  if (iterative_mode) {
+    applyOperator(x, r_);
+    r_.Neg();
+    r_ += b;
+  } else {
+    x.SetSize(size, blocks);
+    x  = 0.0;
+    r_ = b;
+  }
+  applyPreconditioner(r_, z_);
+
+  // Each column converges on its own preconditioned residual norm, as in mfem::CGSolver
+  auto residuals = columnProducts(r_, z_);
+  allreduce({&residuals}, comm);
+  std::vector<double> tolerances(static_cast<std::size_t>(blocks));
+  for (int j = 0; j < blocks; j++) {
+    tolerances[static_cast<std::size_t>(j)] = std::max(rel_tol * std::sqrt(std::abs(residuals(0, j))), abs_tol);
+  }
+
+  mfem::DenseMatrix energy, projections, factor, alpha, beta;
+  std::vector<int>  pivots;
+  p_         = z_;
+  converged  = 0;
+  final_iter = 0;
+  for (int i = 0;; i++) {
+    final_norm    = 0.0;
+    bool all_done = true;
+    for (int j = 0; j < blocks; j++) {
+      const double norm = std::sqrt(std::abs(residuals(0, j)));
+      final_norm        = std::max(final_norm, norm);
+      all_done          = all_done && norm <= tolerances[static_cast<std::size_t>(j)];
+    }
+    printIteration(comm, print_level, i, final_norm);
+
+    if (all_done) {
+      converged  = 1;
+      final_iter = i;
+      return;
+    }
+    if (i == max_iter) {
+      final_iter = i;
+      SLIC_WARNING_IF(print_level >= 0, "Block CG did not converge.");
+      return;
+    }
+
+    applyOperator(p_, q_);
+    energy.SetSize(blocks);
+    projections.SetSize(blocks);
+    mfem::MultAtB(p_, q_, energy);
+    mfem::MultAtB(p_, r_, projections);
+    allreduce({&energy, &projections}, comm);
+
+    // Orthonormalize the directions in the energy inner product, dropping the dependent ones
+    pivotedCholesky(energy, pivots, factor);
+    const int rank = static_cast<int>(pivots.size());
+    if (rank == 0) {
+      final_iter = i;
+      SLIC_WARNING_IF(print_level >= 0, "Block CG stagnated with no independent search directions.");
+      return;
+    }
+    p_orth_.SetSize(size, rank);
+    q_orth_.SetSize(size, rank);
+    alpha.SetSize(rank, blocks);
+    for (int j = 0; j < rank; j++) {
+      const int    pivot = pivots[static_cast<std::size_t>(j)];
+      mfem::Vector p_column(p_orth_.GetColumn(j), size);
+      mfem::Vector q_column(q_orth_.GetColumn(j), size);
+      p_column = mfem::Vector(p_.GetColumn(pivot), size);
+      q_column = mfem::Vector(q_.GetColumn(pivot), size);
+      for (int l = 0; l < blocks; l++) {
+        alpha(j, l) = projections(pivot, l);
+      }
+
+      // Forward substitution with the factor, which maps the selected directions to orthonormal ones
+      for (int k = 0; k < j; k++) {
+        p_column.Add(-factor(j, k), mfem::Vector(p_orth_.GetColumn(k), size));
+        q_column.Add(-factor(j, k), mfem::Vector(q_orth_.GetColumn(k), size));
+        for (int l = 0; l < blocks; l++) {
+          alpha(j, l) -= factor(j, k) * alpha(k, l);
+        }
+      }
+      p_column /= factor(j, j);
+      q_column /= factor(j, j);
+      for (int l = 0; l < blocks; l++) {
+        alpha(j, l) /= factor(j, j);
+      }
+    }
+
+    mfem::AddMult(p_orth_, alpha, x);
+    mfem::AddMult_a(-1.0, q_orth_, alpha, r_);
+    applyPreconditioner(r_, z_);
+
+    beta.SetSize(rank, blocks);
+    mfem::MultAtB(q_orth_, z_, beta);
+    residuals = columnProducts(r_, z_);
+    allreduce({&beta, &residuals}, comm);
+
+    // The new directions are energy-orthogonal to the current ones
+    p_ = z_;
+    mfem::AddMult_a(-1.0, p_orth_, beta, p_);
+  }
+}
+
+}  // namespace serac::mfem_ext
@@ -0,0 +1,358 @@
+// Copyright (c) 2019-2021, Lawrence Livermore National Security, LLC and
+// other Serac Project Developers. See the top-level LICENSE file for
+// details.
+//
+// SPDX-License-Identifier: (BSD-3-Clause)
+
+/**
+ * @file krylov_solvers.hpp
+ *
+ * @brief Krylov solvers that reduce or hide the latency of global reductions
+ */
+
+#pragma once
+
+#include <deque>
+#include <vector>
+
+#include "mfem.hpp"
+
+namespace serac::mfem_ext {
+
+/**
+ * @brief The pipelined preconditioned conjugate gradient method of Ghysels and Vanroose
+ *
+ * Both inner products of an iteration are combined into one non-blocking allreduce, which is
+ * overlapped with the preconditioner application and the matrix-vector product of the same
+ * iteration. The method is mathematically equivalent to mfem::CGSolver and uses the same
+ * convergence criterion on the preconditioned residual norm, at the cost of four more vectors.
+ */
+class PipelinedCGSolver : public mfem::IterativeSolver {
+public:
+  /**
+   * @brief Constructs the solver
+   *
+   * @param[in] comm The MPI communicator of the vectors
+   */
+  explicit PipelinedCGSolver(MPI_Comm comm) : mfem::IterativeSolver(comm) {}
+
+  /**
+   * @brief Solves the system
+   *
+   * @param[in] b The right-hand side
+   * @param[inout] x The solution, which is also the initial guess if iterative_mode is set
+   * @note Implements mfem::Operator::Mult
+   */
+  void Mult(const mfem::Vector& b, mfem::Vector& x) const override;
+
+private:
+  /**
+   * @brief The vectors of the recurrences, named as in Ghysels and Vanroose (2014)
+   */
+  mutable mfem::Vector r_, u_, w_, m_, n_, z_, q_, s_, p_;
+};
+
+/**
+ * @brief An s-step (communication-avoiding) restarted GMRES method
+ *
+ * Each cycle generates a scaled monomial basis of s Krylov vectors of the right-preconditioned
+ * operator with no reductions. The Gram matrix of the basis is reduced one row at a time with
+ * non-blocking allreduces, each overlapped with the preconditioner and matrix-vector product
+ * that generate the next vector. The least squares problem is then solved redundantly on every
+ * rank through a Cholesky QR factorization of the Gram matrix. One cycle therefore costs a single
+ * synchronization instead of the s + 1 of classical GMRES, and converges on the unpreconditioned
+ * residual norm.
+ */
+class SStepGMRESSolver : public mfem::IterativeSolver {
+public:
+  /**
+   * @brief Constructs the solver
+   *
+   * @param[in] comm The MPI communicator of the vectors
+   */
+  explicit SStepGMRESSolver(MPI_Comm comm) : mfem::IterativeSolver(comm) {}
+
+  /**
+   * @brief Sets the number of Krylov vectors generated per cycle
+   *
+   * @param[in] steps The number of steps, which should stay small (less than ten) as the monomial
+   * basis loses linear independence quickly
+   */
+  void SetSteps(const int steps) { steps_ = steps; }
+
+  /**
+   * @brief Solves the system
+   *
+   * @param[in] b The right-hand side
+   * @param[inout] x The solution, which is also the initial guess if iterative_mode is set
+   * @note Implements mfem::Operator::Mult
+   */
+  void Mult(const mfem::Vector& b, mfem::Vector& x) const override;
+
+private:
+  /**
+   * @brief Applies the right-preconditioned operator A M
+   */
+  void applyOperator(const mfem::Vector& in, mfem::Vector& out) const;
+
+  /**
+   * @brief The number of Krylov vectors generated per cycle
+   */
+  int steps_ = 4;
+
+  /**
+   * @brief The basis vectors of a cycle, starting with the residual
+   */
+  mutable std::vector<mfem::Vector> basis_;
+
+  /**
+   * @brief Work vectors for the residual and the preconditioned update
+   */
+  mutable mfem::Vector r_, work_;
+};
+
+/**
+ * @brief A Krylov solver that keeps a small subspace between solves to accelerate later solves
+ *
+ * The subspace is stored as pairs of vectors u and c = A u. They are orthonormal in the energy
+ * inner product, u_i^T A u_j = delta_ij, or in the Euclidean inner product of the images,
+ * c_i^T c_j = delta_ij. When the operator changes, for example between timesteps or Newton
+ * iterations, the images are recomputed and the pairs are orthonormalized again. Only the most
+ * recent pairs are kept.
+ */
+class RecyclingSolver : public mfem::IterativeSolver {
+public:
+  /**
+   * @brief Sets the maximum number of recycled vectors
+   *
+   * @param[in] size The number of vectors, where zero disables recycling
+   */
+  void SetRecycleSize(const int size) { recycle_size_ = size; }
+
+  /**
+   * @brief Sets the operator, marking the images of the recycled vectors as out of date
+   *
+   * @param[in] op The new operator
+   * @note Implements mfem::Solver::SetOperator
+   */
+  void SetOperator(const mfem::Operator& op) override;
+
+  /**
+   * @brief Returns the number of vectors currently recycled
+   */
+  int RecycledSize() const { return static_cast<int>(basis_.size()); }
+
+protected:
+  /**
+   * @brief Constructs the solver
+   *
+   * @param[in] comm The MPI communicator of the vectors
+   * @param[in] energy Whether the pairs are orthonormal in the energy inner product
+   */
+  RecyclingSolver(MPI_Comm comm, const bool energy) : mfem::IterativeSolver(comm), energy_(energy) {}
+
+  /**
+   * @brief Recomputes the images of the recycled vectors if the operator has changed
+   */
+  void refresh() const;
+
+  /**
+   * @brief Projects the solution onto the recycled subspace
+   *
+   * @param[inout] x The solution, updated with its optimal correction in the subspace
+   * @param[inout] r The residual of x, updated consistently
+   */
+  void project(mfem::Vector& x, mfem::Vector& r) const;
+
+  /**
+   * @brief Computes the coefficients of a vector's orthogonal projection onto the recycled subspace
+   *
+   * @param[in] v The vector, which is multiplied with the images of the recycled vectors
+   * @return The coefficients, computed with a single reduction
+   */
+  std::vector<double> coefficients(const mfem::Vector& v) const;
+
+  /**
+   * @brief Orthonormalizes a pair against the recycled ones and adds it, discarding the oldest if needed
+   *
+   * @param[in] u The vector
+   * @param[in] c The image of the vector under the current operator
+   */
+  void recycle(mfem::Vector u, mfem::Vector c) const;
+
+  /**
+   * @brief The recycled vectors
+   */
+  mutable std::deque<mfem::Vector> basis_;
+
+  /**
+   * @brief The images of the recycled vectors under the operator
+   */
+  mutable std::deque<mfem::Vector> images_;
+
+private:
+  /**
+   * @brief Whether the pairs are orthonormal in the energy inner product rather than in the images
+   */
+  bool energy_;
+
+  /**
+   * @brief The maximum number of recycled vectors
+   */
+  int recycle_size_ = 5;
+
+  /**
+   * @brief Whether the operator has changed since the images were computed
+   */
+  mutable bool stale_ = false;
+};
+
+/**
+ * @brief A deflated preconditioned conjugate gradient method for sequences of SPD systems
+ *
+ * Each solve starts from the energy-optimal initial guess in the recycled subspace and keeps
+ * its search directions conjugate to that subspace, as in the deflated CG of Saad et al.
+ * (2000). The solution increment of every converged solve is recycled, so the subspace
+ * accumulates the slowly converging components shared by successive systems.
+ */
+class DeflatedCGSolver : public RecyclingSolver {
+public:
+  /**
+   * @brief Constructs the solver
+   *
+   * @param[in] comm The MPI communicator of the vectors
+   */
+  explicit DeflatedCGSolver(MPI_Comm comm) : RecyclingSolver(comm, true) {}
+
+  /**
+   * @brief Solves the system
+   *
+   * @param[in] b The right-hand side
+   * @param[inout] x The solution, which is also the initial guess if iterative_mode is set
+   * @note Implements mfem::Operator::Mult
+   */
+  void Mult(const mfem::Vector& b, mfem::Vector& x) const override;
+
+private:
+  /**
+   * @brief Work vectors for the residual, the preconditioned residual, the search direction, its
+   * image, and the solution increment and its image
+   */
+  mutable mfem::Vector r_, z_, p_, Ap_, delta_, A_delta_;
+};
+
+/**
+ * @brief A GCRO method with recycling, in the spirit of GCRO-DR and GCROT(m, k)
+ *
+ * The inner GMRES(m) cycles are orthogonalized against the images of the recycled vectors, so
+ * the residual is minimized over the recycled subspace and the new Krylov subspace together.
+ * The correction of every cycle is recycled, which carries the subspace over to later solves.
+ * The method converges on the unpreconditioned residual norm.
+ */
+class RecycledGMRESSolver : public RecyclingSolver {
+public:
+  /**
+   * @brief Constructs the solver
+   *
+   * @param[in] comm The MPI communicator of the vectors
+   */
+  explicit RecycledGMRESSolver(MPI_Comm comm) : RecyclingSolver(comm, false) {}
+
+  /**
+   * @brief Sets the dimension of the Krylov subspace of each inner cycle
+   */
+  void SetKDim(const int dim) { kdim_ = dim; }
+
+  /**
+   * @brief Solves the system
+   *
+   * @param[in] b The right-hand side
+   * @param[inout] x The solution, which is also the initial guess if iterative_mode is set
+   * @note Implements mfem::Operator::Mult
+   */
+  void Mult(const mfem::Vector& b, mfem::Vector& x) const override;
+
+private:
+  /**
+   * @brief The dimension of the Krylov subspace of each inner cycle
+   */
+  int kdim_ = 50;
+
+  /**
+   * @brief The Arnoldi vectors of an inner cycle
+   */
+  mutable std::vector<mfem::Vector> arnoldi_;
+
+  /**
+   * @brief Work vectors for the residual and the correction and its image
+   */
+  mutable mfem::Vector r_, work_, u_, c_;
+};
+
+/**
+ * @brief A breakdown-free block preconditioned conjugate gradient method for several right-hand sides
+ *
+ * All right-hand sides share one Krylov space. Each iteration makes the search directions
+ * orthonormal in the energy inner product with a pivoted Cholesky factorization. Directions that
+ * become linearly dependent, e.g. once some right-hand sides have converged, are dropped, so the
+ * method does not break down. The operator is applied to all directions at once. For a
+ * HypreParMatrix, this is a sparse matrix-matrix product that reads each matrix entry once per
+ * block, with one message exchange for the whole block. The inner products of an iteration take
+ * two reductions, whatever the number of right-hand sides.
+ */
+class BlockCGSolver : public mfem::IterativeSolver {
+public:
+  /**
+   * @brief Constructs the solver
+   *
+   * @param[in] comm The MPI communicator of the vectors
+   */
+  explicit BlockCGSolver(MPI_Comm comm) : mfem::IterativeSolver(comm) {}
+
+  /**
+   * @brief Solves the system for every column of a block of right-hand sides
+   *
+   * Every column converges to the relative tolerance of its own right-hand side.
+   *
+   * @param[in] b The right-hand sides, one per column
+   * @param[inout] x The solutions, which are also the initial guesses if iterative_mode is set
+   */
+  void Mult(const mfem::DenseMatrix& b, mfem::DenseMatrix& x) const;
+
+  /**
+   * @brief Solves the system for a single right-hand side
+   *
+   * @param[in] b The right-hand side
+   * @param[inout] x The solution, which is also the initial guess if iterative_mode is set
+   * @note Implements mfem::Operator::Mult
+   */
+  void Mult(const mfem::Vector& b, mfem::Vector& x) const override;
+
+private:
+  /**
+   * @brief Applies the operator to every column of a block
+   */
+  void applyOperator(const mfem::DenseMatrix& in, mfem::DenseMatrix& out) const;
+
+  /**
+   * @brief Applies the preconditioner to every column of a block
+   */
+  void applyPreconditioner(const mfem::DenseMatrix& in, mfem::DenseMatrix& out) const;
+
+  /**
+   * @brief The residuals, preconditioned residuals, directions and their images
+   */
+  mutable mfem::DenseMatrix r_, z_, p_, q_;
+
+  /**
+   * @brief The directions and their images after orthonormalization
+   */
+  mutable mfem::DenseMatrix p_orth_, q_orth_;
+
+  /**
+   * @brief The values exchanged with other ranks by the matrix-matrix product
+   */
+  mutable std::vector<double> send_, external_;
+};
+
+}  // namespace serac::mfem_ext
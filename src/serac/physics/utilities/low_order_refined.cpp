@@ -0,0 +1,156 @@
+// Copyright (c) 2019-2021, Lawrence Livermore National Security, LLC and
+// other Serac Project Developers. See the top-level LICENSE file for
+// details.
+//
+// SPDX-License-Identifier: (BSD-3-Clause)
+
+#include "serac/physics/utilities/low_order_refined.hpp"
+
+#include <limits>
+#include <utility>
+
+#include "serac/infrastructure/logger.hpp"
+
+namespace serac::mfem_ext {
+
+LowOrderRefinedSpace::LowOrderRefinedSpace(mfem::ParFiniteElementSpace& space)
+    : space_(space), linear_fec_(1, space.GetMesh()->Dimension())
+{
+  const auto fec = dynamic_cast<const mfem::H1_FECollection*>(space_.FEColl());
+  SLIC_ERROR_IF(fec == nullptr || fec->GetBasisType() != mfem::BasisType::GaussLobatto,
+                "Low-order-refined discretizations require an H1 space with a Gauss-Lobatto basis.");
+  order_ = fec->GetOrder();
+
+  // Only the local elements are refined, the parallel structure comes from the high-order space
+  auto& mesh = *space_.GetParMesh();
+  mesh_      = std::make_unique<mfem::Mesh>(&mesh, order_, mfem::BasisType::GaussLobatto);
+
+  // The refined mesh lists the sub-elements of each element consecutively, with the vertices of
+  // each sub-element taken from the points of the Gauss-Lobatto refinement of the reference element
+  mfem::GlobGeometryRefiner.SetType(mfem::Quadrature1D::GaussLobatto);
+  for (int e = 0; e < mesh.GetNE(); e++) {
+    const auto geom     = mesh.GetElementBaseGeometry(e);
+    const int  nv       = mfem::Geometry::NumVerts[geom];
+    auto&      refined  = *mfem::GlobGeometryRefiner.Refine(geom, order_, order_);
+    auto&      vertices = vertex_dofs_[static_cast<std::size_t>(geom)];
+
+    if (vertices.empty()) {
+      const auto& nodes = fec->FiniteElementForGeometry(geom)->GetNodes();
+      vertices.resize(static_cast<std::size_t>(refined.RefGeoms.Size()));
+      for (int v = 0; v < refined.RefGeoms.Size(); v++) {
+        const auto& point   = refined.RefPts.IntPoint(refined.RefGeoms[v]);
+        double      closest = std::numeric_limits<double>::max();
+        int         nearest = 0;
+        for (int n = 0; n < nodes.GetNPoints(); n++) {
+          const auto&  node     = nodes.IntPoint(n);
+          const double distance = (point.x - node.x) * (point.x - node.x) + (point.y - node.y) * (point.y - node.y) +
+                                  (point.z - node.z) * (point.z - node.z);
+          if (distance < closest) {
+            closest = distance;
+            nearest = n;
+          }
+        }
+        vertices[static_cast<std::size_t>(v)] = nearest;
+      }
+    }
+
+    for (int j = 0; j < refined.RefGeoms.Size() / nv; j++) {
+      parents_.push_back(e);
+      sub_elements_.push_back(j);
+    }
+  }
+  SLIC_ERROR_IF(static_cast<int>(parents_.size()) != mesh_->GetNE(),
+                "The refined mesh does not match the refinement of its elements.");
+
+  assembler_ = std::make_unique<mfem::ParBilinearForm>(&space_);
+}
+
+void LowOrderRefinedSpace::subElementVDofs(const int element, mfem::Array<int>& vdofs) const
+{
+  mfem::Array<int> parent_vdofs;
+  space_.GetElementVDofs(parents_[static_cast<std::size_t>(element)], parent_vdofs);
+
+  const auto  geom     = mesh_->GetElementBaseGeometry(element);
+  const int   nv       = mfem::Geometry::NumVerts[geom];
+  const int   vdim     = space_.GetVDim();
+  const int   ndof     = parent_vdofs.Size() / vdim;
+  const auto& vertices = vertex_dofs_[static_cast<std::size_t>(geom)];
+  const auto  first    = static_cast<std::size_t>(sub_elements_[static_cast<std::size_t>(element)] * nv);
+
+  // Element vdofs are ordered by component and then by DOF, independent of the space's ordering
+  vdofs.SetSize(nv * vdim);
+  for (int c = 0; c < vdim; c++) {
+    for (int v = 0; v < nv; v++) {
+      vdofs[c * nv + v] = parent_vdofs[c * ndof + vertices[first + static_cast<std::size_t>(v)]];
+    }
+  }
+}
+
+std::unique_ptr<mfem::SparseMatrix> LowOrderRefinedSpace::assemble(mfem::BilinearFormIntegrator& integrator) const
+{
+  auto matrix = std::make_unique<mfem::SparseMatrix>(space_.GetVSize());
+
+  mfem::Array<int>  vdofs;
+  mfem::DenseMatrix elmat;
+  for (int e = 0; e < mesh_->GetNE(); e++) {
+    const auto& fe = *linear_fec_.FiniteElementForGeometry(mesh_->GetElementBaseGeometry(e));
+    integrator.AssembleElementMatrix(fe, *mesh_->GetElementTransformation(e), elmat);
+    subElementVDofs(e, vdofs);
+    matrix->AddSubMatrix(vdofs, vdofs, elmat, 0);
+  }
+
+  // Keep the zeros so that all matrices on this space share a sparsity pattern
+  matrix->Finalize(0);
+  return matrix;
+}
+
+std::unique_ptr<mfem::SparseMatrix> LowOrderRefinedSpace::assembleGradient(mfem::NonlinearFormIntegrator& integrator,
+                                                                           const mfem::Vector&            x) const
+{
+  mfem::Vector local_x(space_.GetVSize());
+  space_.GetProlongationMatrix()->Mult(x, local_x);
+
+  auto matrix = std::make_unique<mfem::SparseMatrix>(space_.GetVSize());
+
+  mfem::Array<int>  vdofs;
+  mfem::Vector      elfun;
+  mfem::DenseMatrix elmat;
+  for (int e = 0; e < mesh_->GetNE(); e++) {
+    const auto& fe = *linear_fec_.FiniteElementForGeometry(mesh_->GetElementBaseGeometry(e));
+    subElementVDofs(e, vdofs);
+    local_x.GetSubVector(vdofs, elfun);
+    integrator.AssembleElementGrad(fe, *mesh_->GetElementTransformation(e), elfun, elmat);
+    matrix->AddSubMatrix(vdofs, vdofs, elmat, 0);
+  }
+
+  matrix->Finalize(0);
+  return matrix;
+}
+
+std::unique_ptr<mfem::HypreParMatrix> LowOrderRefinedSpace::parallelAssemble(mfem::SparseMatrix& local)
+{
+  return std::unique_ptr<mfem::HypreParMatrix>(assembler_->ParallelAssemble(&local));
+}
+
+LORPreconditioner::LORPreconditioner(std::function<const mfem::HypreParMatrix&()> matrix,
+                                     const mfem::ParFiniteElementSpace* pfes, const int print_level)
+    : matrix_(std::move(matrix)), amg_(std::make_unique<mfem::HypreBoomerAMG>())
+{
+  if (pfes != nullptr && pfes->GetVDim() > 1) {
+    amg_->SetSystemsOptions(pfes->GetVDim(), pfes->GetOrdering() == mfem::Ordering::byNODES);
+  }
+  amg_->SetPrintLevel(print_level);
+}
+
+void LORPreconditioner::SetOperator(const mfem::Operator& op)
+{
+  const auto& matrix = matrix_();
+  SLIC_ERROR_IF(matrix.Height() != op.Height(), "The low-order-refined matrix does not match the operator.");
+  amg_->SetOperator(matrix);
+  height = op.Height();
+  width  = op.Width();
+}
+
+void LORPreconditioner::Mult(const mfem::Vector& b, mfem::Vector& x) const { amg_->Mult(b, x); }
+
+}  // namespace serac::mfem_ext
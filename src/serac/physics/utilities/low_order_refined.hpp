@@ -0,0 +1,161 @@
+// Copyright (c) 2019-2021, Lawrence Livermore National Security, LLC and
+// other Serac Project Developers. See the top-level LICENSE file for
+// details.
+//
+// SPDX-License-Identifier: (BSD-3-Clause)
+
+/**
+ * @file low_order_refined.hpp
+ *
+ * @brief Low-order-refined (LOR) discretizations of high-order H1 spaces and the preconditioner built on them
+ */
+
+#pragma once
+
+#include <array>
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include "mfem.hpp"
+
+namespace serac::mfem_ext {
+
+/**
+ * @brief A linear-element discretization that shares the DOFs of a high-order H1 space
+ *
+ * Each element of the high-order mesh is split into sub-elements whose vertices are the
+ * Gauss-Lobatto nodes of the high-order element. Matrices assembled with linear elements on the
+ * sub-elements are therefore written directly in the DOF numbering of the high-order space, and
+ * are spectrally equivalent to their high-order counterparts independent of the order.
+ */
+class LowOrderRefinedSpace {
+public:
+  /**
+   * @brief Builds the refined mesh and the map from its elements to the high-order DOFs
+   *
+   * @param[in] space The high-order space, which must use an H1 Gauss-Lobatto basis
+   */
+  explicit LowOrderRefinedSpace(mfem::ParFiniteElementSpace& space);
+
+  /**
+   * @brief Assembles a bilinear form integrator on the sub-elements
+   *
+   * @param[in] integrator The integrator, which is evaluated with linear elements
+   * @return The finalized local matrix on the local DOFs of the high-order space
+   */
+  std::unique_ptr<mfem::SparseMatrix> assemble(mfem::BilinearFormIntegrator& integrator) const;
+
+  /**
+   * @brief Assembles the gradient of a nonlinear form integrator on the sub-elements
+   *
+   * @param[in] integrator The integrator, which is evaluated with linear elements
+   * @param[in] x The true DOFs of the high-order state at which to evaluate the gradient
+   * @return The finalized local matrix on the local DOFs of the high-order space
+   */
+  std::unique_ptr<mfem::SparseMatrix> assembleGradient(mfem::NonlinearFormIntegrator& integrator,
+                                                       const mfem::Vector&            x) const;
+
+  /**
+   * @brief Assembles a local matrix into a parallel matrix on the true DOFs of the high-order space
+   *
+   * @param[in] local A finalized matrix returned by assemble or assembleGradient, or a combination of them
+   * @return The parallel matrix
+   */
+  std::unique_ptr<mfem::HypreParMatrix> parallelAssemble(mfem::SparseMatrix& local);
+
+private:
+  /**
+   * @brief Computes the high-order vdofs of the vertices of a sub-element
+   *
+   * @param[in] element The index of the sub-element in the refined mesh
+   * @param[out] vdofs The vdofs, ordered by component and then by vertex
+   */
+  void subElementVDofs(const int element, mfem::Array<int>& vdofs) const;
+
+  /**
+   * @brief The high-order space
+   */
+  mfem::ParFiniteElementSpace& space_;
+
+  /**
+   * @brief The order of the high-order space, which is also the number of sub-elements per edge
+   */
+  int order_;
+
+  /**
+   * @brief The refined mesh of this rank's elements
+   */
+  std::unique_ptr<mfem::Mesh> mesh_;
+
+  /**
+   * @brief The linear elements used on the refined mesh
+   */
+  mfem::H1_FECollection linear_fec_;
+
+  /**
+   * @brief The high-order element containing each sub-element
+   */
+  std::vector<int> parents_;
+
+  /**
+   * @brief The index of each sub-element within its high-order element
+   */
+  std::vector<int> sub_elements_;
+
+  /**
+   * @brief For each geometry, the local high-order DOF of each vertex of each sub-element
+   */
+  std::array<std::vector<int>, mfem::Geometry::NumGeom> vertex_dofs_;
+
+  /**
+   * @brief An empty form on the high-order space, used for its parallel assembly
+   */
+  std::unique_ptr<mfem::ParBilinearForm> assembler_;
+};
+
+/**
+ * @brief A BoomerAMG preconditioner for a high-order system that is set up on its low-order-refined counterpart
+ */
+class LORPreconditioner : public mfem::Solver {
+public:
+  /**
+   * @brief Constructs the preconditioner
+   *
+   * @param[in] matrix Returns the low-order-refined counterpart of the most recent high-order operator
+   * @param[in] pfes The high-order space, used to configure AMG for systems
+   * @param[in] print_level The BoomerAMG print level
+   */
+  LORPreconditioner(std::function<const mfem::HypreParMatrix&()> matrix, const mfem::ParFiniteElementSpace* pfes,
+                    const int print_level);
+
+  /**
+   * @brief Sets up AMG on the low-order-refined matrix
+   *
+   * @param[in] op The high-order operator, which is only used for its size
+   * @note Implements mfem::Solver::SetOperator
+   */
+  void SetOperator(const mfem::Operator& op) override;
+
+  /**
+   * @brief Applies one AMG cycle
+   *
+   * @param[in] b The input vector
+   * @param[out] x The output vector
+   * @note Implements mfem::Operator::Mult
+   */
+  void Mult(const mfem::Vector& b, mfem::Vector& x) const override;
+
+private:
+  /**
+   * @brief Returns the low-order-refined matrix
+   */
+  std::function<const mfem::HypreParMatrix&()> matrix_;
+
+  /**
+   * @brief The AMG preconditioner for the low-order-refined matrix
+   */
+  std::unique_ptr<mfem::HypreBoomerAMG> amg_;
+};
+
+}  // namespace serac::mfem_ext
@@ -0,0 +1,210 @@
+// Copyright (c) 2019-2021, Lawrence Livermore National Security, LLC and
+// other Serac Project Developers. See the top-level LICENSE file for
+// details.
+//
+// SPDX-License-Identifier: (BSD-3-Clause)
+
+#include "serac/physics/utilities/mixed_precision.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+#include "serac/infrastructure/logger.hpp"
+
+namespace serac::mfem_ext {
+
+namespace {
+
+/**
+ * @brief Copies a hypre CSR block into single-precision arrays
+ */
+void copyBlock(hypre_CSRMatrix* block, std::vector<int>& offsets, std::vector<int>& columns,
+               std::vector<float>& values)
+{
+  const int rows = hypre_CSRMatrixNumRows(block);
+  const int nnz  = hypre_CSRMatrixNumNonzeros(block);
+  offsets.assign(hypre_CSRMatrixI(block), hypre_CSRMatrixI(block) + rows + 1);
+  columns.assign(hypre_CSRMatrixJ(block), hypre_CSRMatrixJ(block) + nnz);
+  values.resize(static_cast<std::size_t>(nnz));
+  for (int k = 0; k < nnz; k++) {
+    values[static_cast<std::size_t>(k)] = static_cast<float>(hypre_CSRMatrixData(block)[k]);
+  }
+}
+
+/**
+ * @brief Computes the inner product of two distributed single-precision vectors in double precision
+ */
+double dot(const std::vector<float>& a, const std::vector<float>& b, MPI_Comm comm)
+{
+  double local = 0.0;
+  for (std::size_t i = 0; i < a.size(); i++) {
+    local += static_cast<double>(a[i]) * static_cast<double>(b[i]);
+  }
+  double global = 0.0;
+  MPI_Allreduce(&local, &global, 1, MPI_DOUBLE, MPI_SUM, comm);
+  return global;
+}
+
+}  // namespace
+
+SinglePrecisionMatrix::~SinglePrecisionMatrix()
+{
+  if (comm_ != MPI_COMM_NULL) {
+    MPI_Comm_free(&comm_);
+  }
+}
+
+void SinglePrecisionMatrix::update(const mfem::HypreParMatrix& matrix)
+{
+  auto parcsr = static_cast<hypre_ParCSRMatrix*>(const_cast<mfem::HypreParMatrix&>(matrix));
+  if (comm_ == MPI_COMM_NULL) {
+    MPI_Comm_dup(matrix.GetComm(), &comm_);
+  }
+
+  copyBlock(hypre_ParCSRMatrixDiag(parcsr), diag_offsets_, diag_columns_, diag_values_);
+  copyBlock(hypre_ParCSRMatrixOffd(parcsr), offd_offsets_, offd_columns_, offd_values_);
+
+  // hypre keeps the diagonal entry first in each row of the diagonal block
+  const auto rows = diag_offsets_.size() - 1;
+  inv_diag_.resize(rows);
+  for (std::size_t row = 0; row < rows; row++) {
+    const auto first = static_cast<std::size_t>(diag_offsets_[row]);
+    SLIC_ERROR_IF(diag_columns_[first] != static_cast<int>(row), "The single-precision matrix needs a diagonal.");
+    inv_diag_[row] = 1.0f / diag_values_[first];
+  }
+
+  auto comm_pkg = hypre_ParCSRMatrixCommPkg(parcsr);
+  if (comm_pkg == nullptr) {
+    hypre_MatvecCommPkgCreate(parcsr);
+    comm_pkg = hypre_ParCSRMatrixCommPkg(parcsr);
+  }
+  const int num_sends = hypre_ParCSRCommPkgNumSends(comm_pkg);
+  const int num_recvs = hypre_ParCSRCommPkgNumRecvs(comm_pkg);
+  send_procs_.assign(hypre_ParCSRCommPkgSendProcs(comm_pkg), hypre_ParCSRCommPkgSendProcs(comm_pkg) + num_sends);
+  send_offsets_.assign(hypre_ParCSRCommPkgSendMapStarts(comm_pkg),
+                       hypre_ParCSRCommPkgSendMapStarts(comm_pkg) + num_sends + 1);
+  send_rows_.assign(hypre_ParCSRCommPkgSendMapElmts(comm_pkg),
+                    hypre_ParCSRCommPkgSendMapElmts(comm_pkg) + send_offsets_.back());
+  recv_procs_.assign(hypre_ParCSRCommPkgRecvProcs(comm_pkg), hypre_ParCSRCommPkgRecvProcs(comm_pkg) + num_recvs);
+  recv_offsets_.assign(hypre_ParCSRCommPkgRecvVecStarts(comm_pkg),
+                       hypre_ParCSRCommPkgRecvVecStarts(comm_pkg) + num_recvs + 1);
+
+  send_buffer_.resize(send_rows_.size());
+  halo_.resize(static_cast<std::size_t>(hypre_CSRMatrixNumCols(hypre_ParCSRMatrixOffd(parcsr))));
+  requests_.resize(static_cast<std::size_t>(num_sends + num_recvs));
+}
+
+void SinglePrecisionMatrix::mult(const std::vector<float>& x, std::vector<float>& y) const
+{
+  // Start the halo exchange
+  std::size_t request = 0;
+  for (std::size_t i = 0; i < recv_procs_.size(); i++) {
+    MPI_Irecv(&halo_[static_cast<std::size_t>(recv_offsets_[i])], recv_offsets_[i + 1] - recv_offsets_[i], MPI_FLOAT,
+              recv_procs_[i], 0, comm_, &requests_[request++]);
+  }
+  for (std::size_t i = 0; i < send_rows_.size(); i++) {
+    send_buffer_[i] = x[static_cast<std::size_t>(send_rows_[i])];
+  }
+  for (std::size_t i = 0; i < send_procs_.size(); i++) {
+    MPI_Isend(&send_buffer_[static_cast<std::size_t>(send_offsets_[i])], send_offsets_[i + 1] - send_offsets_[i],
+              MPI_FLOAT, send_procs_[i], 0, comm_, &requests_[request++]);
+  }
+
+  // The diagonal block is applied while the exchange is in flight
+  const auto rows = inv_diag_.size();
+  for (std::size_t row = 0; row < rows; row++) {
+    float sum = 0.0f;
+    for (int k = diag_offsets_[row]; k < diag_offsets_[row + 1]; k++) {
+      sum += diag_values_[static_cast<std::size_t>(k)] * x[static_cast<std::size_t>(diag_columns_[k])];
+    }
+    y[row] = sum;
+  }
+
+  MPI_Waitall(static_cast<int>(requests_.size()), requests_.data(), MPI_STATUSES_IGNORE);
+  for (std::size_t row = 0; row < rows; row++) {
+    for (int k = offd_offsets_[row]; k < offd_offsets_[row + 1]; k++) {
+      y[row] += offd_values_[static_cast<std::size_t>(k)] * halo_[static_cast<std::size_t>(offd_columns_[k])];
+    }
+  }
+}
+
+void SinglePrecisionSolver::SetOperator(const mfem::Operator& op)
+{
+  auto matrix = dynamic_cast<const mfem::HypreParMatrix*>(&op);
+  SLIC_ERROR_IF(matrix == nullptr, "The single-precision solver requires a HypreParMatrix.");
+  matrix_.update(*matrix);
+
+  height = op.Height();
+  width  = op.Width();
+  for (auto vector : {&b_, &x_, &r_, &r_hat_, &p_, &v_, &y_, &s_, &z_, &t_}) {
+    vector->resize(static_cast<std::size_t>(height));
+  }
+}
+
+void SinglePrecisionSolver::Mult(const mfem::Vector& b, mfem::Vector& x) const
+{
+  const auto  n        = static_cast<std::size_t>(height);
+  const auto& inv_diag = matrix_.inverseDiagonal();
+  const auto  comm     = matrix_.comm();
+
+  for (std::size_t i = 0; i < n; i++) {
+    b_[i] = static_cast<float>(b(static_cast<int>(i)));
+    x_[i] = 0.0f;
+  }
+
+  // Right-preconditioned BiCGSTAB from a zero initial guess, with the Jacobi preconditioner
+  r_     = b_;
+  r_hat_ = b_;
+  std::fill(p_.begin(), p_.end(), 0.0f);
+  std::fill(v_.begin(), v_.end(), 0.0f);
+
+  const double tolerance = rel_tol_ * std::sqrt(dot(r_, r_, comm));
+  double       rho       = 1.0;
+  double       alpha     = 1.0;
+  double       omega     = 1.0;
+  for (int iteration = 0; iteration < max_iter_ && tolerance > 0.0; iteration++) {
+    const double rho_next = dot(r_hat_, r_, comm);
+    if (rho_next == 0.0) {
+      break;
+    }
+    const auto beta = static_cast<float>((rho_next / rho) * (alpha / omega));
+    for (std::size_t i = 0; i < n; i++) {
+      p_[i] = r_[i] + beta * (p_[i] - static_cast<float>(omega) * v_[i]);
+      y_[i] = inv_diag[i] * p_[i];
+    }
+    matrix_.mult(y_, v_);
+    alpha = rho_next / dot(r_hat_, v_, comm);
+
+    for (std::size_t i = 0; i < n; i++) {
+      s_[i] = r_[i] - static_cast<float>(alpha) * v_[i];
+      x_[i] += static_cast<float>(alpha) * y_[i];
+    }
+    if (std::sqrt(dot(s_, s_, comm)) <= tolerance) {
+      break;
+    }
+
+    for (std::size_t i = 0; i < n; i++) {
+      z_[i] = inv_diag[i] * s_[i];
+    }
+    matrix_.mult(z_, t_);
+    const double t_dot_t = dot(t_, t_, comm);
+    if (t_dot_t == 0.0) {
+      break;
+    }
+    omega = dot(t_, s_, comm) / t_dot_t;
+    for (std::size_t i = 0; i < n; i++) {
+      x_[i] += static_cast<float>(omega) * z_[i];
+      r_[i] = s_[i] - static_cast<float>(omega) * t_[i];
+    }
+    if (std::sqrt(dot(r_, r_, comm)) <= tolerance || omega == 0.0) {
+      break;
+    }
+    rho = rho_next;
+  }
+
+  for (std::size_t i = 0; i < n; i++) {
+    x(static_cast<int>(i)) = static_cast<double>(x_[i]);
+  }
+}
+
+}  // namespace serac::mfem_ext
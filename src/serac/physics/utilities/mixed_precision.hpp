@@ -0,0 +1,175 @@
+// Copyright (c) 2019-2021, Lawrence Livermore National Security, LLC and
+// other Serac Project Developers. See the top-level LICENSE file for
+// details.
+//
+// SPDX-License-Identifier: (BSD-3-Clause)
+
+/**
+ * @file mixed_precision.hpp
+ *
+ * @brief A single-precision matrix and the single-precision solver built on it
+ */
+
+#pragma once
+
+#include <vector>
+
+#include "mfem.hpp"
+
+namespace serac::mfem_ext {
+
+/**
+ * @brief A single-precision copy of a HypreParMatrix
+ *
+ * The diagonal and off-diagonal blocks are stored with float values and the halo exchange of the
+ * product sends floats, following the communication package of the hypre matrix. The product is
+ * overlapped with the exchange as in hypre.
+ */
+class SinglePrecisionMatrix {
+public:
+  SinglePrecisionMatrix() = default;
+
+  /**
+   * @brief The matrix owns a communicator, so it is not copyable
+   */
+  SinglePrecisionMatrix(const SinglePrecisionMatrix&) = delete;
+  SinglePrecisionMatrix& operator=(const SinglePrecisionMatrix&) = delete;
+
+  /**
+   * @brief Releases the communicator of the halo exchange
+   */
+  ~SinglePrecisionMatrix();
+
+  /**
+   * @brief Copies a matrix into single precision
+   *
+   * @param[in] matrix The double-precision matrix
+   */
+  void update(const mfem::HypreParMatrix& matrix);
+
+  /**
+   * @brief Computes y = A x
+   *
+   * @param[in] x The local part of the input vector
+   * @param[out] y The local part of the output vector
+   */
+  void mult(const std::vector<float>& x, std::vector<float>& y) const;
+
+  /**
+   * @brief Returns the inverse of the diagonal of the matrix
+   */
+  const std::vector<float>& inverseDiagonal() const { return inv_diag_; }
+
+  /**
+   * @brief Returns the number of local rows
+   */
+  int size() const { return static_cast<int>(inv_diag_.size()); }
+
+  /**
+   * @brief Returns the communicator of the matrix
+   */
+  MPI_Comm comm() const { return comm_; }
+
+private:
+  /**
+   * @brief A duplicate of the matrix's communicator, so the halo exchange cannot match other messages
+   */
+  MPI_Comm comm_ = MPI_COMM_NULL;
+
+  /**
+   * @brief The diagonal block in CSR format with local column indices
+   */
+  std::vector<int>   diag_offsets_, diag_columns_;
+  std::vector<float> diag_values_;
+
+  /**
+   * @brief The off-diagonal block in CSR format with indices into the halo
+   */
+  std::vector<int>   offd_offsets_, offd_columns_;
+  std::vector<float> offd_values_;
+
+  /**
+   * @brief The inverse of the diagonal
+   */
+  std::vector<float> inv_diag_;
+
+  /**
+   * @brief The ranks exchanged with, and the offsets of their entries in the send and halo buffers
+   */
+  std::vector<int> send_procs_, send_offsets_, recv_procs_, recv_offsets_;
+
+  /**
+   * @brief The local rows sent to other ranks
+   */
+  std::vector<int> send_rows_;
+
+  /**
+   * @brief The buffers of the halo exchange
+   */
+  mutable std::vector<float> send_buffer_, halo_;
+
+  /**
+   * @brief The requests of the halo exchange
+   */
+  mutable std::vector<MPI_Request> requests_;
+};
+
+/**
+ * @brief A single-precision Jacobi-preconditioned BiCGSTAB solve, for use as a preconditioner
+ *
+ * The right-hand side is rounded to single precision, the system is solved approximately with
+ * the single-precision copy of the matrix, and the result is converted back. Inner products are
+ * accumulated in double precision. Since the solve is inexact and changes with the right-hand
+ * side, it must be used within a flexible Krylov method such as mfem::FGMRESSolver, which then
+ * guarantees the requested tolerance in double precision.
+ */
+class SinglePrecisionSolver : public mfem::Solver {
+public:
+  /**
+   * @brief Constructs the solver
+   *
+   * @param[in] max_iter The maximum number of BiCGSTAB iterations per application
+   * @param[in] rel_tol The relative tolerance of each application
+   */
+  SinglePrecisionSolver(const int max_iter, const double rel_tol) : max_iter_(max_iter), rel_tol_(rel_tol) {}
+
+  /**
+   * @brief Copies the operator into single precision
+   *
+   * @param[in] op The operator, which must be a HypreParMatrix
+   * @note Implements mfem::Solver::SetOperator
+   */
+  void SetOperator(const mfem::Operator& op) override;
+
+  /**
+   * @brief Solves the system approximately in single precision
+   *
+   * @param[in] b The right-hand side
+   * @param[out] x The approximate solution
+   * @note Implements mfem::Operator::Mult
+   */
+  void Mult(const mfem::Vector& b, mfem::Vector& x) const override;
+
+private:
+  /**
+   * @brief The maximum number of iterations per application
+   */
+  int max_iter_;
+
+  /**
+   * @brief The relative tolerance of each application
+   */
+  double rel_tol_;
+
+  /**
+   * @brief The single-precision matrix
+   */
+  SinglePrecisionMatrix matrix_;
+
+  /**
+   * @brief The single-precision vectors of BiCGSTAB
+   */
+  mutable std::vector<float> b_, x_, r_, r_hat_, p_, v_, y_, s_, z_, t_;
+};
+
+}  // namespace serac::mfem_ext
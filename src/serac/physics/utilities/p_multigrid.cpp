@@ -0,0 +1,142 @@
+// Copyright (c) 2019-2021, Lawrence Livermore National Security, LLC and
+// other Serac Project Developers. See the top-level LICENSE file for
+// details.
+//
+// SPDX-License-Identifier: (BSD-3-Clause)
+
+#include "serac/physics/utilities/p_multigrid.hpp"
+
+#include <algorithm>
+
+#include "serac/infrastructure/logger.hpp"
+
+namespace serac::mfem_ext {
+
+namespace {
+
+/**
+ * @brief The levels of a p-multigrid cycle, built from the integrators provided by a physics module
+ */
+class OrderMultigrid : public mfem::GeometricMultigrid {
+public:
+  /**
+   * @brief Assembles the operator and builds the smoother of every level
+   *
+   * @param[in] spaces The hierarchy of spaces, from the coarsest to the finest order
+   * @param[in] options The level configuration provided by the physics module
+   * @param[in] print_level The BoomerAMG print level on the coarsest level
+   */
+  OrderMultigrid(mfem::ParFiniteElementSpaceHierarchy& spaces, const PMultigridPrec& options, const int print_level)
+      : mfem::GeometricMultigrid(spaces)
+  {
+    for (int level = 0; level < spaces.GetNumLevels(); level++) {
+      auto& space = spaces.GetFESpaceAtLevel(level);
+
+      // The forms and DOF lists are owned by the base class
+      essentialTrueDofs.Append(new mfem::Array<int>());
+      auto& ess_tdofs = *essentialTrueDofs.Last();
+      options.essential_dofs(space, ess_tdofs);
+
+      auto form = new mfem::ParBilinearForm(&space);
+      bfs.Append(form);
+      const bool partial = options.partial_assembly && level > 0;
+      if (partial) {
+        form->SetAssemblyLevel(mfem::AssemblyLevel::PARTIAL);
+      }
+      options.integrators(*form);
+      form->Assemble();
+
+      mfem::Vector diag(space.GetTrueVSize());
+      if (partial) {
+        mfem::OperatorPtr op(mfem::Operator::ANY_TYPE);
+        form->FormSystemMatrix(ess_tdofs, op);
+        op.SetOperatorOwner(false);
+        form->AssembleDiagonal(diag);
+        AddLevel(op.Ptr(), buildSmoother(*op, diag, ess_tdofs, options, space.GetComm()), true, true);
+      } else {
+        auto matrix = new mfem::HypreParMatrix();
+        form->FormSystemMatrix(ess_tdofs, *matrix);
+        if (level == 0) {
+          auto amg = new mfem::HypreBoomerAMG(*matrix);
+          if (space.GetVDim() > 1) {
+            amg->SetSystemsOptions(space.GetVDim(), space.GetOrdering() == mfem::Ordering::byNODES);
+          }
+          amg->SetPrintLevel(print_level);
+          AddLevel(matrix, amg, true, true);
+        } else {
+          matrix->GetDiag(diag);
+          AddLevel(matrix, buildSmoother(*matrix, diag, ess_tdofs, options, space.GetComm()), true, true);
+        }
+      }
+    }
+  }
+
+private:
+  /**
+   * @brief Builds the Chebyshev smoother of a level
+   *
+   * @param[in] op The operator of the level
+   * @param[in] diag The diagonal of the operator
+   * @param[in] ess_tdofs The essential true DOFs of the level
+   * @param[in] options The level configuration
+   * @param[in] comm The communicator of the level, used to estimate the largest eigenvalue
+   * @return The smoother, which is owned by the caller
+   */
+  static mfem::Solver* buildSmoother(mfem::Operator& op, const mfem::Vector& diag, const mfem::Array<int>& ess_tdofs,
+                                     const PMultigridPrec& options, MPI_Comm comm)
+  {
+    return new mfem::OperatorChebyshevSmoother(&op, diag, ess_tdofs, options.smoother_order, comm);
+  }
+};
+
+}  // namespace
+
+PMultigridPreconditioner::PMultigridPreconditioner(const PMultigridPrec& options, const int print_level)
+    : options_(options), print_level_(print_level)
+{
+  SLIC_ERROR_IF(!options_.integrators || !options_.essential_dofs || options_.pfes == nullptr,
+                "The p-multigrid preconditioner is not supported by this physics module.");
+  SLIC_ERROR_IF(dynamic_cast<const mfem::H1_FECollection*>(options_.pfes->FEColl()) == nullptr,
+                "The p-multigrid preconditioner requires an H1 space.");
+}
+
+void PMultigridPreconditioner::SetOperator(const mfem::Operator& op)
+{
+  auto& fine = *options_.pfes;
+  SLIC_ERROR_IF(fine.GetTrueVSize() != op.Height(), "The p-multigrid hierarchy does not match the operator.");
+
+  // The space changes when the mesh is repartitioned or adapted
+  if (fine.GetSequence() != sequence_) {
+    multigrid_.reset();
+    spaces_.reset();
+    collections_.clear();
+
+    std::vector<int> orders{fine.FEColl()->GetOrder()};
+    while (orders.back() > 1) {
+      orders.push_back(orders.back() / 2);
+    }
+    std::reverse(orders.begin(), orders.end());
+
+    const int dim = fine.GetParMesh()->Dimension();
+    for (const int order : orders) {
+      collections_.push_back(std::make_unique<mfem::H1_FECollection>(order, dim));
+    }
+
+    auto coarse = new mfem::ParFiniteElementSpace(fine.GetParMesh(), collections_.front().get(), fine.GetVDim(),
+                                                  fine.GetOrdering());
+    spaces_     = std::make_unique<mfem::ParFiniteElementSpaceHierarchy>(fine.GetParMesh(), coarse, false, true);
+    for (std::size_t level = 1; level < collections_.size(); level++) {
+      spaces_->AddOrderRefinedLevel(collections_[level].get(), fine.GetVDim(), fine.GetOrdering());
+    }
+    sequence_ = fine.GetSequence();
+  }
+
+  // The operators change with the state and the timestep, so the levels are always reassembled
+  multigrid_ = std::make_unique<OrderMultigrid>(*spaces_, options_, print_level_);
+  height     = op.Height();
+  width      = op.Width();
+}
+
+void PMultigridPreconditioner::Mult(const mfem::Vector& b, mfem::Vector& x) const { multigrid_->Mult(b, x); }
+
+}  // namespace serac::mfem_ext
@@ -0,0 +1,93 @@
+// Copyright (c) 2019-2021, Lawrence Livermore National Security, LLC and
+// other Serac Project Developers. See the top-level LICENSE file for
+// details.
+//
+// SPDX-License-Identifier: (BSD-3-Clause)
+
+/**
+ * @file p_multigrid.hpp
+ *
+ * @brief A geometric multigrid preconditioner over a hierarchy of polynomial orders
+ */
+
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "mfem.hpp"
+
+#include "serac/physics/utilities/solver_config.hpp"
+
+namespace serac::mfem_ext {
+
+/**
+ * @brief A p-multigrid preconditioner for systems on high-order H1 spaces
+ *
+ * The levels share the mesh of the system and have orders p, p/2, ..., 1. Each level above
+ * the coarsest is smoothed with a Chebyshev polynomial of its diagonally scaled operator, which
+ * only needs the action of the operator and its diagonal, so those levels can be partially
+ * assembled. The coarsest, linear level is assembled and preconditioned with BoomerAMG.
+ */
+class PMultigridPreconditioner : public mfem::Solver {
+public:
+  /**
+   * @brief Constructs the preconditioner
+   *
+   * @param[in] options The level configuration provided by the physics module
+   * @param[in] print_level The BoomerAMG print level on the coarsest level
+   */
+  PMultigridPreconditioner(const PMultigridPrec& options, const int print_level);
+
+  /**
+   * @brief Rebuilds the operators and smoothers of every level for the current system
+   *
+   * The hierarchy of spaces is only rebuilt when the space of the system has changed.
+   *
+   * @param[in] op The system operator, which is only used for its size
+   * @note Implements mfem::Solver::SetOperator
+   */
+  void SetOperator(const mfem::Operator& op) override;
+
+  /**
+   * @brief Applies one V-cycle
+   *
+   * @param[in] b The input vector
+   * @param[out] x The output vector
+   * @note Implements mfem::Operator::Mult
+   */
+  void Mult(const mfem::Vector& b, mfem::Vector& x) const override;
+
+private:
+  /**
+   * @brief The level configuration
+   */
+  PMultigridPrec options_;
+
+  /**
+   * @brief The BoomerAMG print level
+   */
+  int print_level_;
+
+  /**
+   * @brief The sequence number of the system's space when the hierarchy was built
+   */
+  long sequence_ = -1;
+
+  /**
+   * @brief The collections of each level, which must outlive the spaces
+   */
+  std::vector<std::unique_ptr<mfem::FiniteElementCollection>> collections_;
+
+  /**
+   * @brief The spaces of each level and the transfer operators between them
+   */
+  std::unique_ptr<mfem::ParFiniteElementSpaceHierarchy> spaces_;
+
+  /**
+   * @brief The multigrid cycle with the operators and smoothers of each level, destroyed before the spaces
+   */
+  std::unique_ptr<mfem::GeometricMultigrid> multigrid_;
+};
+
+}  // namespace serac::mfem_ext
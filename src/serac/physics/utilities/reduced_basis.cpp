@@ -0,0 +1,312 @@
+// Copyright (c) 2019-2021, Lawrence Livermore National Security, LLC and
+// other Serac Project Developers. See the top-level LICENSE file for
+// details.
+//
+// SPDX-License-Identifier: (BSD-3-Clause)
+
+#include "serac/physics/utilities/reduced_basis.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+
+#include "serac/infrastructure/logger.hpp"
+#include "serac/infrastructure/profiling.hpp"
+
+namespace serac::mfem_ext {
+
+namespace {
+
+/**
+ * @brief The Householder reflectors of a QR factorization, Q = H_0 H_1 ... H_{k-1}
+ */
+struct Reflectors {
+  /**
+   * @brief The reflector vectors, one per column, which are zero above the diagonal
+   */
+  mfem::DenseMatrix vectors;
+
+  /**
+   * @brief The squared norm of each reflector vector, zero if the column needed no reflection
+   */
+  mfem::Vector norms_sq;
+};
+
+/**
+ * @brief Computes a Householder QR factorization
+ *
+ * @param[inout] a The matrix to factor, which is overwritten
+ * @param[out] reflectors The reflectors whose product is the orthogonal factor
+ * @param[out] r The square upper triangular factor, with zero rows if a has fewer rows than columns
+ */
+void householderQR(mfem::DenseMatrix& a, Reflectors& reflectors, mfem::DenseMatrix& r)
+{
+  const int rows  = a.Height();
+  const int cols  = a.Width();
+  const int steps = std::min(rows, cols);
+
+  reflectors.vectors.SetSize(rows, steps);
+  reflectors.vectors = 0.0;
+  reflectors.norms_sq.SetSize(steps);
+  reflectors.norms_sq = 0.0;
+  for (int j = 0; j < steps; j++) {
+    double norm = 0.0;
+    for (int i = j; i < rows; i++) {
+      norm += a(i, j) * a(i, j);
+    }
+    norm = std::sqrt(norm);
+    if (norm == 0.0) {
+      continue;
+    }
+
+    // Reflect onto the sign that avoids cancellation
+    const double alpha = (a(j, j) > 0.0) ? -norm : norm;
+    for (int i = j; i < rows; i++) {
+      reflectors.vectors(i, j) = a(i, j);
+    }
+    reflectors.vectors(j, j) -= alpha;
+    for (int i = j; i < rows; i++) {
+      reflectors.norms_sq(j) += reflectors.vectors(i, j) * reflectors.vectors(i, j);
+    }
+
+    for (int c = j; c < cols; c++) {
+      double dot = 0.0;
+      for (int i = j; i < rows; i++) {
+        dot += reflectors.vectors(i, j) * a(i, c);
+      }
+      const double factor = 2.0 * dot / reflectors.norms_sq(j);
+      for (int i = j; i < rows; i++) {
+        a(i, c) -= factor * reflectors.vectors(i, j);
+      }
+    }
+  }
+
+  r.SetSize(cols);
+  r = 0.0;
+  for (int c = 0; c < cols; c++) {
+    for (int i = 0; i <= std::min(c, rows - 1); i++) {
+      r(i, c) = a(i, c);
+    }
+  }
+}
+
+/**
+ * @brief Multiplies a matrix by the orthogonal factor of a QR factorization
+ *
+ * @param[in] reflectors The reflectors of the factorization
+ * @param[inout] x The matrix, with as many rows as the factored matrix
+ */
+void applyQ(const Reflectors& reflectors, mfem::DenseMatrix& x)
+{
+  for (int j = reflectors.norms_sq.Size() - 1; j >= 0; j--) {
+    if (reflectors.norms_sq(j) == 0.0) {
+      continue;
+    }
+    for (int c = 0; c < x.Width(); c++) {
+      double dot = 0.0;
+      for (int i = j; i < x.Height(); i++) {
+        dot += reflectors.vectors(i, j) * x(i, c);
+      }
+      const double factor = 2.0 * dot / reflectors.norms_sq(j);
+      for (int i = j; i < x.Height(); i++) {
+        x(i, c) -= factor * reflectors.vectors(i, j);
+      }
+    }
+  }
+}
+
+/**
+ * @brief Computes the singular values and left singular vectors of a square matrix with one-sided Jacobi rotations
+ *
+ * The rotated columns are orthogonal to working precision relative to their own norms, so the
+ * left singular vectors stay orthonormal even for tiny singular values.
+ *
+ * @param[inout] a The matrix, which is overwritten
+ * @param[out] sigma The singular values, in decreasing order
+ * @param[out] u The left singular vectors, in the order of the singular values
+ */
+void jacobiSVD(mfem::DenseMatrix& a, mfem::Vector& sigma, mfem::DenseMatrix& u)
+{
+  const int    size       = a.Width();
+  const int    max_sweeps = 60;
+  const double tolerance  = 1.0e-15;
+
+  for (int sweep = 0; sweep < max_sweeps; sweep++) {
+    bool converged = true;
+    for (int p = 0; p < size - 1; p++) {
+      for (int q = p + 1; q < size; q++) {
+        double alpha = 0.0;
+        double beta  = 0.0;
+        double gamma = 0.0;
+        for (int i = 0; i < a.Height(); i++) {
+          alpha += a(i, p) * a(i, p);
+          beta += a(i, q) * a(i, q);
+          gamma += a(i, p) * a(i, q);
+        }
+        if (std::abs(gamma) <= tolerance * std::sqrt(alpha * beta)) {
+          continue;
+        }
+        converged = false;
+
+        // The rotation that makes columns p and q orthogonal
+        const double zeta = (beta - alpha) / (2.0 * gamma);
+        const double t    = std::copysign(1.0, zeta) / (std::abs(zeta) + std::sqrt(1.0 + zeta * zeta));
+        const double c    = 1.0 / std::sqrt(1.0 + t * t);
+        const double s    = c * t;
+        for (int i = 0; i < a.Height(); i++) {
+          const double a_p = a(i, p);
+          const double a_q = a(i, q);
+          a(i, p)          = c * a_p - s * a_q;
+          a(i, q)          = s * a_p + c * a_q;
+        }
+      }
+    }
+    if (converged) {
+      break;
+    }
+  }
+
+  mfem::Vector norms(size);
+  for (int j = 0; j < size; j++) {
+    norms(j) = mfem::Vector(a.GetColumn(j), a.Height()).Norml2();
+  }
+
+  std::vector<int> order(static_cast<std::size_t>(size));
+  std::iota(order.begin(), order.end(), 0);
+  std::stable_sort(order.begin(), order.end(), [&norms](const int i, const int j) { return norms(i) > norms(j); });
+
+  sigma.SetSize(size);
+  u.SetSize(a.Height(), size);
+  u = 0.0;
+  for (int j = 0; j < size; j++) {
+    const int column = order[static_cast<std::size_t>(j)];
+    sigma(j)         = norms(column);
+    if (sigma(j) > 0.0) {
+      for (int i = 0; i < a.Height(); i++) {
+        u(i, j) = a(i, column) / sigma(j);
+      }
+    }
+  }
+}
+
+}  // namespace
+
+void ReducedBasis::addSnapshot(const mfem::Vector& snapshot)
+{
+  SLIC_ERROR_IF(!snapshots_.empty() && snapshot.Size() != snapshots_.front().Size(),
+                "The snapshots of a reduced basis must all have the same size.");
+  snapshots_.emplace_back(snapshot);
+}
+
+void ReducedBasis::compute(const double tolerance, const int max_size)
+{
+  SERAC_MARK_FUNCTION;
+  SLIC_ERROR_IF(snapshots_.empty(), "A reduced basis needs at least one snapshot.");
+
+  const int rows      = snapshots_.front().Size();
+  const int snapshots = numSnapshots();
+  int       num_ranks = 0;
+  MPI_Comm_size(comm_, &num_ranks);
+
+  mfem::DenseMatrix snapshot_matrix(rows, snapshots);
+  for (int j = 0; j < snapshots; j++) {
+    mfem::Vector column(snapshot_matrix.GetColumn(j), rows);
+    column = snapshots_[static_cast<std::size_t>(j)];
+  }
+
+  // Factor the local rows, then stack and factor the triangular factors of every rank
+  mfem::DenseMatrix local_r;
+  Reflectors        local_reflectors;
+  householderQR(snapshot_matrix, local_reflectors, local_r);
+
+  mfem::DenseMatrix gathered(snapshots, snapshots * num_ranks);
+  MPI_Allgather(local_r.GetData(), snapshots * snapshots, MPI_DOUBLE, gathered.GetData(), snapshots * snapshots,
+                MPI_DOUBLE, comm_);
+  mfem::DenseMatrix stacked(snapshots * num_ranks, snapshots);
+  for (int rank = 0; rank < num_ranks; rank++) {
+    for (int j = 0; j < snapshots; j++) {
+      for (int i = 0; i < snapshots; i++) {
+        stacked(rank * snapshots + i, j) = gathered(i, rank * snapshots + j);
+      }
+    }
+  }
+  mfem::DenseMatrix r;
+  Reflectors        stacked_reflectors;
+  householderQR(stacked, stacked_reflectors, r);
+
+  // The snapshot matrix and its triangular factor have the same singular values
+  mfem::DenseMatrix left_vectors;
+  jacobiSVD(r, singular_values_, left_vectors);
+
+  double total_energy = 0.0;
+  for (int j = 0; j < snapshots; j++) {
+    total_energy += singular_values_(j) * singular_values_(j);
+  }
+
+  // Keep modes until the discarded energy is small enough, but never ones that are numerically zero
+  int    num_modes   = 0;
+  double kept_energy = 0.0;
+  while (num_modes < std::min(snapshots, max_size) && singular_values_(num_modes) > 1.0e-12 * singular_values_(0) &&
+         total_energy - kept_energy > tolerance * total_energy) {
+    kept_energy += singular_values_(num_modes) * singular_values_(num_modes);
+    num_modes++;
+  }
+  SLIC_WARNING_IF(num_modes == 0, "The snapshots of the reduced basis are all zero, the basis is empty.");
+
+  // The modes are the orthogonal factors applied to the left singular vectors of the triangular factor
+  mfem::DenseMatrix stacked_modes(snapshots * num_ranks, num_modes);
+  stacked_modes = 0.0;
+  for (int j = 0; j < num_modes; j++) {
+    for (int i = 0; i < snapshots; i++) {
+      stacked_modes(i, j) = left_vectors(i, j);
+    }
+  }
+  applyQ(stacked_reflectors, stacked_modes);
+
+  int comm_rank = 0;
+  MPI_Comm_rank(comm_, &comm_rank);
+  modes_.SetSize(rows, num_modes);
+  modes_ = 0.0;
+  for (int j = 0; j < num_modes; j++) {
+    for (int i = 0; i < std::min(rows, snapshots); i++) {
+      modes_(i, j) = stacked_modes(comm_rank * snapshots + i, j);
+    }
+  }
+  applyQ(local_reflectors, modes_);
+}
+
+void ReducedBasis::project(const mfem::Vector& u, mfem::Vector& coefficients) const
+{
+  coefficients.SetSize(size());
+  modes_.MultTranspose(u, coefficients);
+  MPI_Allreduce(MPI_IN_PLACE, coefficients.GetData(), size(), MPI_DOUBLE, MPI_SUM, comm_);
+}
+
+void ReducedBasis::lift(const mfem::Vector& coefficients, mfem::Vector& u) const
+{
+  u.SetSize(modes_.Height());
+  modes_.Mult(coefficients, u);
+}
+
+void ReducedBasis::projectOperator(const mfem::Operator& op, mfem::DenseMatrix& reduced,
+                                   mfem::DenseMatrix* applied_modes) const
+{
+  SERAC_MARK_FUNCTION;
+  const int         rows = modes_.Height();
+  mfem::DenseMatrix applied(rows, size());
+  for (int j = 0; j < size(); j++) {
+    const mfem::Vector mode(const_cast<double*>(modes_.GetColumn(j)), rows);
+    mfem::Vector       column(applied.GetColumn(j), rows);
+    op.Mult(mode, column);
+  }
+
+  reduced.SetSize(size());
+  mfem::MultAtB(modes_, applied, reduced);
+  MPI_Allreduce(MPI_IN_PLACE, reduced.GetData(), size() * size(), MPI_DOUBLE, MPI_SUM, comm_);
+
+  if (applied_modes) {
+    *applied_modes = applied;
+  }
+}
+
+}  // namespace serac::mfem_ext
@@ -0,0 +1,127 @@
+// Copyright (c) 2019-2021, Lawrence Livermore National Security, LLC and
+// other Serac Project Developers. See the top-level LICENSE file for
+// details.
+//
+// SPDX-License-Identifier: (BSD-3-Clause)
+
+/**
+ * @file reduced_basis.hpp
+ *
+ * @brief A proper orthogonal decomposition basis for reduced-order models
+ */
+
+#pragma once
+
+#include <limits>
+#include <vector>
+
+#include "mfem.hpp"
+
+namespace serac::mfem_ext {
+
+/**
+ * @brief A basis of the dominant modes of a set of snapshots of a distributed vector
+ *
+ * The modes are the left singular vectors of the snapshot matrix, whose rows are distributed
+ * like the true DOFs of a space. The singular value decomposition is computed with a
+ * tall-skinny QR factorization: each rank factors its own rows, the small triangular factors
+ * are gathered and factored again, and the SVD of the resulting square factor is computed
+ * redundantly on every rank. Only one collective of size (number of ranks) x (snapshots)^2 is
+ * needed, and the snapshots themselves never leave their ranks.
+ */
+class ReducedBasis {
+public:
+  /**
+   * @brief Constructs an empty basis
+   *
+   * @param[in] comm The communicator the rows of the snapshots are distributed over
+   */
+  explicit ReducedBasis(MPI_Comm comm) : comm_(comm) {}
+
+  /**
+   * @brief Stores a snapshot, which must have the same local size as the previous ones
+   *
+   * @param[in] snapshot The local entries of the snapshot
+   */
+  void addSnapshot(const mfem::Vector& snapshot);
+
+  /**
+   * @brief The number of stored snapshots
+   */
+  int numSnapshots() const { return static_cast<int>(snapshots_.size()); }
+
+  /**
+   * @brief Computes the modes from the stored snapshots
+   *
+   * The smallest number of modes is kept whose discarded singular values hold at most a
+   * fraction tolerance of the total energy (the sum of the squared singular values).
+   *
+   * @param[in] tolerance The fraction of the snapshot energy that may be discarded
+   * @param[in] max_size The largest number of modes to keep
+   */
+  void compute(const double tolerance, const int max_size = std::numeric_limits<int>::max());
+
+  /**
+   * @brief The number of modes
+   */
+  int size() const { return modes_.Width(); }
+
+  /**
+   * @brief The local rows of the modes, one mode per column
+   */
+  const mfem::DenseMatrix& modes() const { return modes_; }
+
+  /**
+   * @brief The singular values of all the snapshots, in decreasing order
+   */
+  const mfem::Vector& singularValues() const { return singular_values_; }
+
+  /**
+   * @brief Computes the coefficients of the orthogonal projection of a vector onto the modes
+   *
+   * @param[in] u The local entries of the vector
+   * @param[out] coefficients The coefficients of the modes, which are the same on every rank
+   */
+  void project(const mfem::Vector& u, mfem::Vector& coefficients) const;
+
+  /**
+   * @brief Computes the linear combination of the modes with the given coefficients
+   *
+   * @param[in] coefficients The coefficients of the modes
+   * @param[out] u The local entries of the combination
+   */
+  void lift(const mfem::Vector& coefficients, mfem::Vector& u) const;
+
+  /**
+   * @brief Computes the Galerkin projection of an operator onto the modes
+   *
+   * @param[in] op The operator, which acts on the distributed vectors
+   * @param[out] reduced The matrix of the projected operator, which is the same on every rank
+   * @param[out] applied_modes If given, the local rows of the operator applied to each mode
+   */
+  void projectOperator(const mfem::Operator& op, mfem::DenseMatrix& reduced,
+                       mfem::DenseMatrix* applied_modes = nullptr) const;
+
+private:
+  /**
+   * @brief The communicator of the snapshots
+   */
+  MPI_Comm comm_;
+
+  /**
+   * @brief The local entries of the snapshots
+   */
+  std::vector<mfem::Vector> snapshots_;
+
+  /**
+   * @brief The local rows of the modes
+   */
+  mfem::DenseMatrix modes_;
+
+  /**
+   * @brief The singular values of the snapshot matrix
+   */
+  mfem::Vector singular_values_;
+};
+
+}  // namespace serac::mfem_ext
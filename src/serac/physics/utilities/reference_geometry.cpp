@@ -0,0 +1,105 @@
+// Copyright (c) 2019-2021, Lawrence Livermore National Security, LLC and
+// other Serac Project Developers. See the top-level LICENSE file for
+// details.
+//
+// SPDX-License-Identifier: (BSD-3-Clause)
+
+#include "serac/physics/utilities/reference_geometry.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include "serac/infrastructure/logger.hpp"
+
+namespace serac {
+
+ReferenceGeometry::ReferenceGeometry(const mfem::ParGridFunction& reference_nodes,
+                                     const std::optional<int>     integration_order)
+    : space_(*reference_nodes.ParFESpace()), dim_(space_.GetMesh()->Dimension())
+{
+  SLIC_ERROR_IF(space_.GetVDim() != dim_, "The reference nodes must have one component per dimension.");
+
+  const int ne = space_.GetNE();
+  offsets_.assign(static_cast<std::size_t>(ne) + 1, 0);
+  for (int e = 0; e < ne; e++) {
+    const auto& fe    = *space_.GetFE(e);
+    const int   order = integration_order.value_or(2 * fe.GetOrder() + 3);
+    const auto& rule  = mfem::IntRules.Get(fe.GetGeomType(), order);
+    const auto  size  = static_cast<std::size_t>(rule.GetNPoints() * fe.GetDof() * dim_);
+
+    offsets_[static_cast<std::size_t>(e) + 1] = offsets_[static_cast<std::size_t>(e)] + size;
+  }
+  dshape_.resize(offsets_.back());
+
+  mfem::Array<int>  vdofs;
+  mfem::Vector      element_nodes;
+  mfem::DenseMatrix dshape_xi;
+  mfem::DenseMatrix dshape_x;
+  mfem::DenseMatrix jacobian(dim_);
+  mfem::DenseMatrix jacobian_inv(dim_);
+  for (int e = 0; e < ne; e++) {
+    const auto& fe    = *space_.GetFE(e);
+    const int   ndof  = fe.GetDof();
+    const int   order = integration_order.value_or(2 * fe.GetOrder() + 3);
+    const auto& rule  = mfem::IntRules.Get(fe.GetGeomType(), order);
+
+    space_.GetElementVDofs(e, vdofs);
+    reference_nodes.GetSubVector(vdofs, element_nodes);
+    mfem::DenseMatrix positions(element_nodes.GetData(), ndof, dim_);
+    dshape_xi.SetSize(ndof, dim_);
+    dshape_x.SetSize(ndof, dim_);
+
+    auto output = dshape_.begin() + static_cast<std::ptrdiff_t>(offsets_[static_cast<std::size_t>(e)]);
+    for (int q = 0; q < rule.GetNPoints(); q++) {
+      // dX/dxi from the reference nodes, then dN/dX = dN/dxi (dX/dxi)^-1
+      fe.CalcDShape(rule.IntPoint(q), dshape_xi);
+      mfem::MultAtB(positions, dshape_xi, jacobian);
+      SLIC_ERROR_IF(jacobian.Det() <= 0.0, fmt::format("Element {0} is inverted in the reference configuration", e));
+      mfem::CalcInverse(jacobian, jacobian_inv);
+      mfem::Mult(dshape_xi, jacobian_inv, dshape_x);
+      output = std::copy(dshape_x.Data(), dshape_x.Data() + ndof * dim_, output);
+    }
+  }
+}
+
+double ReferenceGeometry::minJacobian(const mfem::Vector& displacement) const
+{
+  mfem::Vector local_displacement(space_.GetVSize());
+  space_.GetProlongationMatrix()->Mult(displacement, local_displacement);
+
+  mfem::Array<int>  vdofs;
+  mfem::Vector      u;
+  mfem::DenseMatrix deformation_gradient(dim_);
+  double            min_jacobian = std::numeric_limits<double>::max();
+  for (int e = 0; e < space_.GetNE(); e++) {
+    const int ndof = space_.GetFE(e)->GetDof();
+    space_.GetElementVDofs(e, vdofs);
+    local_displacement.GetSubVector(vdofs, u);
+
+    const auto stride = static_cast<std::size_t>(ndof * dim_);
+    for (auto offset = offsets_[static_cast<std::size_t>(e)]; offset < offsets_[static_cast<std::size_t>(e) + 1];
+         offset += stride) {
+      // F = I + sum_a u_a (dN_a/dX)^T
+      const double* dshape = &dshape_[offset];
+      for (int i = 0; i < dim_; i++) {
+        for (int j = 0; j < dim_; j++) {
+          double value = (i == j) ? 1.0 : 0.0;
+          for (int a = 0; a < ndof; a++) {
+            value += u(i * ndof + a) * dshape[j * ndof + a];
+          }
+          deformation_gradient(i, j) = value;
+        }
+      }
+      const double jacobian = deformation_gradient.Det();
+
+      // A configuration with non-finite values is as bad as an inverted one
+      min_jacobian = std::isfinite(jacobian) ? std::min(min_jacobian, jacobian) : -std::numeric_limits<double>::max();
+    }
+  }
+
+  MPI_Allreduce(MPI_IN_PLACE, &min_jacobian, 1, MPI_DOUBLE, MPI_MIN, space_.GetComm());
+  return min_jacobian;
+}
+
+}  // namespace serac
@@ -0,0 +1,74 @@
+// Copyright (c) 2019-2021, Lawrence Livermore National Security, LLC and
+// other Serac Project Developers. See the top-level LICENSE file for
+// details.
+//
+// SPDX-License-Identifier: (BSD-3-Clause)
+
+/**
+ * @file reference_geometry.hpp
+ *
+ * @brief Precomputed geometry of the reference configuration of a mesh
+ */
+
+#pragma once
+
+#include <optional>
+#include <vector>
+
+#include "mfem.hpp"
+
+namespace serac {
+
+/**
+ * @brief The shape function gradients of a mesh's reference configuration at the quadrature points of each element
+ *
+ * The gradients are computed once from a grid function of reference nodes rather than from the
+ * mesh's current nodes, so they remain valid while the mesh is switched between its reference
+ * and deformed configurations. They are used to evaluate the deformation gradient of a
+ * displacement field without building any element transformations.
+ */
+class ReferenceGeometry {
+public:
+  /**
+   * @brief Precomputes the reference geometry
+   *
+   * @param[in] reference_nodes The nodes of the reference configuration, with one component per dimension
+   * @param[in] integration_order The order of the quadrature rule, which defaults to the order used by
+   * mfem::HyperelasticNLFIntegrator
+   */
+  explicit ReferenceGeometry(const mfem::ParGridFunction& reference_nodes,
+                             const std::optional<int>     integration_order = std::nullopt);
+
+  /**
+   * @brief Computes the smallest determinant of the deformation gradient at any quadrature point
+   *
+   * @param[in] displacement The true DOFs of a displacement on the space of the reference nodes
+   * @return The global minimum of det(I + grad u), which is not positive if any element is inverted,
+   * or the lowest double if any determinant is not finite
+   */
+  double minJacobian(const mfem::Vector& displacement) const;
+
+private:
+  /**
+   * @brief The space of the reference nodes
+   */
+  const mfem::ParFiniteElementSpace& space_;
+
+  /**
+   * @brief The spatial dimension
+   */
+  int dim_;
+
+  /**
+   * @brief The offset of each element's gradients, with a final entry for the total size
+   */
+  std::vector<std::size_t> offsets_;
+
+  /**
+   * @brief The gradients with respect to the reference coordinates, stored as a column-major
+   * dofs by dimension matrix for each quadrature point of each element
+   */
+  std::vector<double> dshape_;
+};
+
+}  // namespace serac
@@ -12,7 +12,11 @@
 
 #pragma once
 
+#include <functional>
+#include <optional>
+#include <string>
 #include <variant>
+#include <vector>
 
 #include "mfem.hpp"
 
@@ -28,6 +32,150 @@ enum class OutputType
   SidreVisIt
 };
 
+/**
+ * @brief Parameters controlling how state output is written
+ */
+struct OutputOptions {
+  /**
+   * @brief Whether to serialize output on a background I/O thread
+   *
+   * When enabled, outputState deep-copies the fields into a buffer and returns
+   * while the I/O thread writes the snapshot.
+   */
+  bool async = false;
+
+  /**
+   * @brief The number of snapshots that may be buffered before outputState blocks
+   */
+  int max_pending = 2;
+
+  /**
+   * @brief Write output every this many timesteps
+   */
+  int every_n_steps = 1;
+
+  /**
+   * @brief Write output every this much simulated time, takes precedence over every_n_steps
+   */
+  std::optional<double> every_dt;
+
+  /**
+   * @brief The names of the state fields to write, all fields are written if empty
+   */
+  std::vector<std::string> fields;
+
+  /**
+   * @brief The refinement level used to sample high-order fields, defaults to the maximum field order
+   * for ParaView and to 1 for VisIt
+   */
+  std::optional<int> levels_of_detail;
+
+  /**
+   * @brief Whether to write floating-point data in single precision (ParaView only)
+   */
+  bool float32 = false;
+
+  /**
+   * @brief The number of I/O aggregator ranks per node for GLVis output
+   *
+   * If set, the ranks' pieces are gathered to the aggregators and written into one
+   * shared file per field per cycle instead of one file per rank.
+   */
+  std::optional<int> aggregators_per_node;
+};
+
+/**
+ * @brief Parameters controlling dynamic load rebalancing
+ */
+struct RebalanceOptions {
+  /**
+   * @brief Check the load balance every this many timesteps
+   */
+  int every_n_steps = 10;
+
+  /**
+   * @brief Repartition when the most loaded rank's work exceeds the average by this factor
+   */
+  double imbalance_threshold = 1.2;
+};
+
+/**
+ * @brief The parameters that change in one case of a parameter sweep
+ */
+struct SweepCase {
+  /**
+   * @brief The shear modulus of the solid, if it differs from the input file
+   */
+  std::optional<double> mu;
+
+  /**
+   * @brief The bulk modulus of the solid, if it differs from the input file
+   */
+  std::optional<double> K;
+
+  /**
+   * @brief The thermal conductivity, if it differs from the input file
+   */
+  std::optional<double> kappa;
+
+  /**
+   * @brief The factor that scales the boundary conditions named in SweepOptions::scaled_bcs
+   */
+  double bc_scale = 1.0;
+};
+
+/**
+ * @brief Parameters of a sweep that runs many cases on the same mesh in one process
+ */
+struct SweepOptions {
+  /**
+   * @brief The cases, run in order
+   */
+  std::vector<SweepCase> cases;
+
+  /**
+   * @brief The names of the boundary conditions, in either physics module, scaled by each case's bc_scale
+   */
+  std::vector<std::string> scaled_bcs;
+
+  /**
+   * @brief The number of groups of ranks that run cases concurrently, each on its own copy of the mesh
+   */
+  int concurrent_groups = 1;
+};
+
+/**
+ * @brief Parameters controlling adaptive mesh refinement and derefinement
+ */
+struct AdaptivityOptions {
+  /**
+   * @brief Adapt the mesh every this many timesteps
+   */
+  int every_n_steps = 1;
+
+  /**
+   * @brief Refine elements whose estimated error exceeds this fraction of the largest element error
+   */
+  double refine_fraction = 0.7;
+
+  /**
+   * @brief Coarsen elements whose estimated error is below this fraction of the refinement threshold
+   *
+   * @note Derefinement is only supported on nonconforming meshes
+   */
+  double derefine_fraction = 0.1;
+
+  /**
+   * @brief Stop refining once the global number of elements reaches this value
+   */
+  int max_elements = 1000000;
+
+  /**
+   * @brief The maximum level of hanging nodes allowed on nonconforming meshes, zero for unlimited
+   */
+  int nc_limit = 3;
+};
+
 /**
  * @brief Timestep method of a solver
  */
@@ -102,10 +250,14 @@ enum class DirichletEnforcementMethod
  */
 enum class LinearSolver
 {
-  CG,     /**< Conjugate Gradient */
-  GMRES,  /**< Generalized minimal residual method */
-  MINRES, /**< Minimal residual method */
-  SuperLU /**< SuperLU Direct Solver */
+  CG,            /**< Conjugate Gradient */
+  GMRES,         /**< Generalized minimal residual method */
+  MINRES,        /**< Minimal residual method */
+  PipelinedCG,   /**< Conjugate Gradient with one non-blocking reduction per iteration */
+  SStepGMRES,    /**< Restarted GMRES with one reduction per s steps */
+  DeflatedCG,    /**< Conjugate Gradient deflated by a subspace recycled between solves */
+  RecycledGMRES, /**< GCRO with a subspace recycled between solves */
+  SuperLU        /**< SuperLU Direct Solver */
 };
 
 /**
@@ -178,10 +330,120 @@ struct BlockILUPrec {
   int block_size;
 };
 
+/**
+ * @brief Stores the information required to configure a Chebyshev polynomial preconditioner
+ *
+ * The preconditioner applies a fixed polynomial in the diagonally scaled operator, which takes
+ * only matrix-vector products and no inner products. The largest eigenvalue is estimated once,
+ * when the preconditioner is first set up, and is reused for later operators of the same size.
+ */
+struct ChebyshevPrec {
+  /**
+   * @brief The degree of the polynomial, i.e., the number of matrix-vector products per application
+   */
+  int order = 3;
+
+  /**
+   * @brief The number of power iterations used to estimate the largest eigenvalue
+   */
+  int power_iterations = 10;
+
+  /**
+   * @brief The ratio of the largest to the smallest eigenvalue targeted by the polynomial
+   */
+  double eigenvalue_ratio = 30.0;
+};
+
+/**
+ * @brief Stores the information required to configure a low-order-refined (LOR) preconditioner
+ *
+ * BoomerAMG is set up on a discretization with linear elements on a mesh whose vertices are the
+ * nodes of the high-order space. The two discretizations share their DOFs, so the iteration
+ * counts stay close to those of a linear problem at any order.
+ */
+struct LORPrec {
+  /**
+   * @brief Returns the low-order-refined counterpart of the current system matrix, set by the physics module
+   */
+  std::function<const mfem::HypreParMatrix&()> matrix;
+
+  /**
+   * @brief The high-order space, set by the physics module
+   */
+  mfem::ParFiniteElementSpace* pfes = nullptr;
+};
+
+/**
+ * @brief Stores the information required to configure a p-multigrid preconditioner
+ *
+ * The levels have orders p, p/2, ..., 1 on the mesh of the system, with Chebyshev smoothing on
+ * every level but the coarsest, which uses BoomerAMG.
+ */
+struct PMultigridPrec {
+  /**
+   * @brief The order of the Chebyshev smoothers
+   */
+  int smoother_order = 2;
+
+  /**
+   * @brief Adds the integrators of the current system to a form on one level, set by the physics module
+   */
+  std::function<void(mfem::ParBilinearForm&)> integrators;
+
+  /**
+   * @brief Computes the essential true DOFs on one level, set by the physics module
+   */
+  std::function<void(mfem::ParFiniteElementSpace&, mfem::Array<int>&)> essential_dofs;
+
+  /**
+   * @brief The finest space, set by the physics module
+   */
+  mfem::ParFiniteElementSpace* pfes = nullptr;
+
+  /**
+   * @brief Whether the integrators support partial assembly, which is then used above the coarsest level
+   */
+  bool partial_assembly = false;
+};
+
+/**
+ * @brief Stores the information required to configure an overlapping additive Schwarz preconditioner
+ *
+ * Each rank's subdomain is extended by the given number of layers of matrix neighbors and solved
+ * with a local sparse direct factorization. The ordering and symbolic factorization are kept while
+ * the sparsity pattern is unchanged, so later Newton iterations only refactor numerically.
+ */
+struct SchwarzPrec {
+  /**
+   * @brief The number of layers of rows owned by other ranks that are added to each subdomain
+   */
+  int overlap = 1;
+};
+
+/**
+ * @brief Stores the information required to configure a block preconditioner for displacement-pressure systems
+ *
+ * BoomerAMG is applied to the displacement block and the Schur complement of the pressure is
+ * approximated by a pressure mass matrix scaled by the material compliance. Both blocks are
+ * positive definite, so the preconditioner can be used with MINRES.
+ */
+struct BlockSchurPrec {
+  /**
+   * @brief The displacement space for the elasticity options of BoomerAMG, set by the physics module
+   */
+  mfem::ParFiniteElementSpace* pfes = nullptr;
+
+  /**
+   * @brief Returns the approximation of the negative Schur complement, set by the physics module
+   */
+  std::function<const mfem::HypreParMatrix&()> schur;
+};
+
 /**
  * @brief Preconditioning method
  */
-using Preconditioner = std::variant<HypreSmootherPrec, HypreBoomerAMGPrec, AMGXPrec, BlockILUPrec>;
+using Preconditioner = std::variant<HypreSmootherPrec, HypreBoomerAMGPrec, AMGXPrec, BlockILUPrec, ChebyshevPrec,
+                                    LORPrec, PMultigridPrec, SchwarzPrec, BlockSchurPrec>;
 
 /**
  * @brief Abstract multiphysics coupling scheme
@@ -226,6 +488,16 @@ struct IterativeSolverOptions {
    * @brief Preconditioner selection
    */
   std::optional<Preconditioner> prec;
+
+  /**
+   * @brief The number of Krylov vectors generated per global reduction by LinearSolver::SStepGMRES
+   */
+  int steps_per_reduction = 4;
+
+  /**
+   * @brief The number of vectors kept between solves by LinearSolver::DeflatedCG and LinearSolver::RecycledGMRES
+   */
+  int recycle_size = 5;
 };
 
 /**
@@ -247,10 +519,47 @@ struct DirectSolverOptions {
   int print_level;
 };
 
+/**
+ * @brief Parameters for a mixed-precision solver, which preconditions a double-precision flexible GMRES
+ * with a few single-precision iterations on a single-precision copy of the matrix
+ */
+struct MixedPrecisionSolverOptions {
+  /**
+   * @brief Relative tolerance, measured on the double-precision residual
+   */
+  double rel_tol;
+
+  /**
+   * @brief Absolute tolerance, measured on the double-precision residual
+   */
+  double abs_tol;
+
+  /**
+   * @brief Debugging print level
+   */
+  int print_level;
+
+  /**
+   * @brief Maximum number of double-precision iterations
+   */
+  int max_iter;
+
+  /**
+   * @brief Maximum number of single-precision iterations per double-precision iteration
+   */
+  int inner_max_iter = 20;
+
+  /**
+   * @brief Relative tolerance of the single-precision iterations
+   */
+  double inner_rel_tol = 1.0e-2;
+};
+
 /**
  * @brief Parameters for a linear solver
  */
-using LinearSolverOptions = std::variant<IterativeSolverOptions, CustomSolverOptions, DirectSolverOptions>;
+using LinearSolverOptions =
+    std::variant<IterativeSolverOptions, CustomSolverOptions, DirectSolverOptions, MixedPrecisionSolverOptions>;
 
 /**
  * @brief Nonlinear solution scheme parameters
@@ -0,0 +1,153 @@
+// Copyright (c) 2019-2021, Lawrence Livermore National Security, LLC and
+// other Serac Project Developers. See the top-level LICENSE file for
+// details.
+//
+// SPDX-License-Identifier: (BSD-3-Clause)
+
+#include "serac/physics/utilities/static_condensation.hpp"
+
+#include "serac/infrastructure/logger.hpp"
+#include "serac/infrastructure/profiling.hpp"
+
+namespace serac::mfem_ext {
+
+ElementMatrixOperator::ElementMatrixOperator(mfem::ParFiniteElementSpace& space)
+    : mfem::Operator(space.TrueVSize()), space_(space), matrices_(static_cast<std::size_t>(space.GetNE()))
+{
+}
+
+void ElementMatrixOperator::prolongate(const mfem::Vector& x) const
+{
+  x_local_.SetSize(space_.GetVSize());
+  space_.GetProlongationMatrix()->Mult(x, x_local_);
+}
+
+void ElementMatrixOperator::assembleGradient(mfem::NonlinearFormIntegrator& integrator, const mfem::Vector& x)
+{
+  SERAC_MARK_FUNCTION;
+  prolongate(x);
+  for (int e = 0; e < space_.GetNE(); e++) {
+    space_.GetElementVDofs(e, vdofs_);
+    x_local_.GetSubVector(vdofs_, x_element_);
+    integrator.AssembleElementGrad(*space_.GetFE(e), *space_.GetElementTransformation(e), x_element_,
+                                   matrices_[static_cast<std::size_t>(e)]);
+  }
+}
+
+void ElementMatrixOperator::addBoundaryGradient(mfem::NonlinearFormIntegrator& integrator,
+                                                const mfem::Array<int>& markers, const mfem::Vector& x)
+{
+  SERAC_MARK_FUNCTION;
+  prolongate(x);
+  auto&             mesh = *space_.GetParMesh();
+  mfem::DenseMatrix face_matrix;
+  for (int be = 0; be < mesh.GetNBE(); be++) {
+    if (markers[mesh.GetBdrAttribute(be) - 1] == 0) {
+      continue;
+    }
+
+    // The face contributes to the element it bounds, as in mfem::NonlinearForm::GetGradient
+    auto tr = mesh.GetBdrFaceTransformations(be);
+    if (tr == nullptr) {
+      continue;
+    }
+    const int   e  = tr->Elem1No;
+    const auto& fe = *space_.GetFE(e);
+    space_.GetElementVDofs(e, vdofs_);
+    x_local_.GetSubVector(vdofs_, x_element_);
+    integrator.AssembleFaceGrad(fe, fe, *tr, x_element_, face_matrix);
+    matrices_[static_cast<std::size_t>(e)] += face_matrix;
+  }
+}
+
+void ElementMatrixOperator::Mult(const mfem::Vector& x, mfem::Vector& y) const
+{
+  x_masked_ = x;
+  x_masked_.SetSubVector(ess_tdofs_, 0.0);
+  prolongate(x_masked_);
+
+  y_local_.SetSize(space_.GetVSize());
+  y_local_ = 0.0;
+  for (int e = 0; e < space_.GetNE(); e++) {
+    space_.GetElementVDofs(e, vdofs_);
+    x_local_.GetSubVector(vdofs_, x_element_);
+    y_element_.SetSize(x_element_.Size());
+    matrices_[static_cast<std::size_t>(e)].Mult(x_element_, y_element_);
+    y_local_.AddElementVector(vdofs_, y_element_);
+  }
+
+  y.SetSize(height);
+  space_.GetProlongationMatrix()->MultTranspose(y_local_, y);
+  for (int i = 0; i < ess_tdofs_.Size(); i++) {
+    y(ess_tdofs_[i]) = x(ess_tdofs_[i]);
+  }
+}
+
+StaticCondensationSolver::StaticCondensationSolver(mfem::ParFiniteElementSpace& space)
+    : mfem::Solver(space.TrueVSize()),
+      space_(space),
+      trace_collection_(space.FEColl()->GetTraceCollection()),
+      trace_space_(std::make_unique<mfem::ParFiniteElementSpace>(space.GetParMesh(), trace_collection_.get(),
+                                                                 space.GetVDim(), space.GetOrdering()))
+{
+}
+
+void StaticCondensationSolver::update()
+{
+  trace_space_->Update(false);
+  condensation_.reset();
+  height = width = space_.TrueVSize();
+}
+
+void StaticCondensationSolver::SetOperator(const mfem::Operator& op)
+{
+  SERAC_MARK_FUNCTION;
+  auto element_op = dynamic_cast<const ElementMatrixOperator*>(&op);
+  SLIC_ERROR_IF(element_op == nullptr, "Static condensation requires an ElementMatrixOperator.");
+  SLIC_ERROR_IF(&element_op->space() != &space_, "The operator is not defined on the condensed space.");
+  SLIC_ERROR_IF(skeleton_solver_ == nullptr, "The skeleton solver of the static condensation has not been set.");
+
+  // The element matrices change with every Newton iteration, so the condensation is rebuilt
+  const auto& ess_tdofs = element_op->essentialDofs();
+  condensation_         = std::make_unique<mfem::StaticCondensation>(&space_);
+  condensation_->Init(false, false);
+  for (int e = 0; e < space_.GetNE(); e++) {
+    condensation_->AssembleMatrix(e, element_op->elementMatrix(e));
+  }
+
+  // The same sequence as mfem::ParBilinearForm::FormSystemMatrix
+  condensation_->SetEssentialTrueDofs(ess_tdofs);
+  condensation_->Finalize();
+  condensation_->ConvertListToReducedTrueDofs(ess_tdofs, ess_rtdofs_);
+  condensation_->EliminateReducedTrueDofs(ess_rtdofs_, mfem::Matrix::DIAG_ONE);
+  condensation_->Finalize();
+
+  skeleton_solver_->SetOperator(condensation_->GetParallelMatrix());
+  height = width = op.Height();
+}
+
+void StaticCondensationSolver::Mult(const mfem::Vector& b, mfem::Vector& x) const
+{
+  SERAC_MARK_FUNCTION;
+  SLIC_ERROR_IF(!condensation_, "The static condensation solver has no operator.");
+
+  // The interior DOFs are never shared, so the restriction gives their full right-hand side
+  b_local_.SetSize(space_.GetVSize());
+  space_.GetRestrictionMatrix()->MultTranspose(b, b_local_);
+
+  const int reduced_size = condensation_->GetParallelMatrix().Height();
+  b_reduced_.SetSize(reduced_size);
+  condensation_->ReduceRHS(b_local_, b_reduced_);
+  b_reduced_.SetSubVector(ess_rtdofs_, 0.0);
+
+  x_reduced_.SetSize(reduced_size);
+  x_reduced_ = 0.0;
+  skeleton_solver_->Mult(b_reduced_, x_reduced_);
+
+  x_local_.SetSize(space_.GetVSize());
+  condensation_->ComputeSolution(b_local_, x_reduced_, x_local_);
+  x.SetSize(height);
+  space_.GetRestrictionMatrix()->Mult(x_local_, x);
+}
+
+}  // namespace serac::mfem_ext
@@ -0,0 +1,205 @@
+// Copyright (c) 2019-2021, Lawrence Livermore National Security, LLC and
+// other Serac Project Developers. See the top-level LICENSE file for
+// details.
+//
+// SPDX-License-Identifier: (BSD-3-Clause)
+
+/**
+ * @file static_condensation.hpp
+ *
+ * @brief Element-wise elimination of the interior DOFs of high-order H1 systems
+ */
+
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "mfem.hpp"
+
+namespace serac::mfem_ext {
+
+/**
+ * @brief An operator on the true DOFs of a space that is stored as its element matrices
+ *
+ * This is the form of a Jacobian that static condensation requires, as the interior DOFs of each
+ * element are eliminated from its element matrix before the skeleton system is assembled. The
+ * essential DOFs are eliminated with ones on the diagonal, like the assembled Jacobians.
+ */
+class ElementMatrixOperator : public mfem::Operator {
+public:
+  /**
+   * @brief Constructs an operator with empty element matrices
+   *
+   * @param[in] space The space of the operator, which must outlive it
+   */
+  explicit ElementMatrixOperator(mfem::ParFiniteElementSpace& space);
+
+  /**
+   * @brief Assembles the element gradients of a domain integrator, overwriting the element matrices
+   *
+   * @param[in] integrator The integrator
+   * @param[in] x The true DOFs at which to evaluate the gradient
+   */
+  void assembleGradient(mfem::NonlinearFormIntegrator& integrator, const mfem::Vector& x);
+
+  /**
+   * @brief Adds the gradients of a boundary face integrator to the matrices of the adjacent elements
+   *
+   * @param[in] integrator The integrator
+   * @param[in] markers The boundary attributes the integrator acts on
+   * @param[in] x The true DOFs at which to evaluate the gradient
+   */
+  void addBoundaryGradient(mfem::NonlinearFormIntegrator& integrator, const mfem::Array<int>& markers,
+                           const mfem::Vector& x);
+
+  /**
+   * @brief Sets the essential true DOFs, whose rows and columns are replaced by the identity
+   *
+   * @param[in] ess_tdofs The essential true DOFs
+   */
+  void setEssentialDofs(const mfem::Array<int>& ess_tdofs) { ess_tdofs.Copy(ess_tdofs_); }
+
+  /**
+   * @brief The essential true DOFs
+   */
+  const mfem::Array<int>& essentialDofs() const { return ess_tdofs_; }
+
+  /**
+   * @brief The matrix of an element, in the order of the element's vdofs
+   */
+  const mfem::DenseMatrix& elementMatrix(const int element) const { return matrices_[element]; }
+
+  /**
+   * @brief The space of the operator
+   */
+  mfem::ParFiniteElementSpace& space() const { return space_; }
+
+  /**
+   * @brief Applies the operator element by element
+   *
+   * @param[in] x The input true DOFs
+   * @param[out] y The output true DOFs
+   * @note Implements mfem::Operator::Mult
+   */
+  void Mult(const mfem::Vector& x, mfem::Vector& y) const override;
+
+private:
+  /**
+   * @brief Prolongates the true DOFs x to the local DOFs
+   */
+  void prolongate(const mfem::Vector& x) const;
+
+  /**
+   * @brief The space of the operator
+   */
+  mfem::ParFiniteElementSpace& space_;
+
+  /**
+   * @brief The element matrices, including the boundary face contributions
+   */
+  std::vector<mfem::DenseMatrix> matrices_;
+
+  /**
+   * @brief The essential true DOFs
+   */
+  mfem::Array<int> ess_tdofs_;
+
+  /**
+   * @brief Work vectors of local and element DOFs
+   */
+  mutable mfem::Vector x_local_, y_local_, x_element_, y_element_, x_masked_;
+
+  /**
+   * @brief The vdofs of the current element
+   */
+  mutable mfem::Array<int> vdofs_;
+};
+
+/**
+ * @brief Solves a system given as an ElementMatrixOperator by static condensation
+ *
+ * The interior DOFs of every element are eliminated with a local Schur complement, the
+ * skeleton system on the element boundaries is solved by a user-provided solver, and the
+ * interior DOFs are recovered element by element. The right-hand side and the solution are
+ * taken to vanish at the essential DOFs, as they do for Newton corrections.
+ */
+class StaticCondensationSolver : public mfem::Solver {
+public:
+  /**
+   * @brief Constructs the solver and the trace space the skeleton system lives on
+   *
+   * @param[in] space The space of the full system, which must be H1 and outlive the solver
+   */
+  explicit StaticCondensationSolver(mfem::ParFiniteElementSpace& space);
+
+  /**
+   * @brief The trace space of the skeleton system, e.g., to configure AMG for elasticity
+   */
+  mfem::ParFiniteElementSpace& traceSpace() { return *trace_space_; }
+
+  /**
+   * @brief Sets the solver of the skeleton system, which must outlive this one
+   */
+  void setSkeletonSolver(mfem::Solver& solver) { skeleton_solver_ = &solver; }
+
+  /**
+   * @brief Rebuilds the trace space after the mesh has changed
+   */
+  void update();
+
+  /**
+   * @brief Condenses the element matrices and sets up the skeleton solver
+   *
+   * @param[in] op The ElementMatrixOperator to solve with
+   * @note Implements mfem::Solver::SetOperator
+   */
+  void SetOperator(const mfem::Operator& op) override;
+
+  /**
+   * @brief Solves the skeleton system and recovers the interior DOFs
+   *
+   * @param[in] b The right-hand side
+   * @param[out] x The solution
+   * @note Implements mfem::Operator::Mult
+   */
+  void Mult(const mfem::Vector& b, mfem::Vector& x) const override;
+
+private:
+  /**
+   * @brief The space of the full system
+   */
+  mfem::ParFiniteElementSpace& space_;
+
+  /**
+   * @brief The trace collection of the space's collection
+   */
+  std::unique_ptr<mfem::FiniteElementCollection> trace_collection_;
+
+  /**
+   * @brief The space of the skeleton DOFs, numbered like the reduced system
+   */
+  std::unique_ptr<mfem::ParFiniteElementSpace> trace_space_;
+
+  /**
+   * @brief The condensation of the current operator
+   */
+  std::unique_ptr<mfem::StaticCondensation> condensation_;
+
+  /**
+   * @brief The essential DOFs in the numbering of the reduced system
+   */
+  mfem::Array<int> ess_rtdofs_;
+
+  /**
+   * @brief The solver of the skeleton system
+   */
+  mfem::Solver* skeleton_solver_ = nullptr;
+
+  /**
+   * @brief Work vectors of local and reduced DOFs
+   */
+  mutable mfem::Vector b_local_, x_local_, b_reduced_, x_reduced_;
+};
+
+}  // namespace serac::mfem_ext
@@ -0,0 +1,261 @@
+// Copyright (c) 2019-2021, Lawrence Livermore National Security, LLC and
+// other Serac Project Developers. See the top-level LICENSE file for
+// details.
+//
+// SPDX-License-Identifier: (BSD-3-Clause)
+
+#include "serac/physics/utilities/superlu_solver.hpp"
+
+#include <cmath>
+#include <vector>
+
+#include "superlu_ddefs.h"
+
+#include "serac/infrastructure/logger.hpp"
+
+// SuperLU_DIST 6.3 added a precision prefix to its structures, as handled in MFEM
+#if SUPERLU_DIST_MAJOR_VERSION > 6 || (SUPERLU_DIST_MAJOR_VERSION == 6 && SUPERLU_DIST_MINOR_VERSION > 2)
+#define ScalePermstruct_t dScalePermstruct_t
+#define LUstruct_t dLUstruct_t
+#define SOLVEstruct_t dSOLVEstruct_t
+#define ScalePermstructInit dScalePermstructInit
+#define ScalePermstructFree dScalePermstructFree
+#define Destroy_LU dDestroy_LU
+#define LUstructFree dLUstructFree
+#define LUstructInit dLUstructInit
+#define SolveFinalize dSolveFinalize
+#endif
+
+namespace serac::mfem_ext {
+
+struct SuperLUSolver::SuperLUData {
+  /**
+   * @brief The process grid
+   */
+  gridinfo_t grid;
+
+  /**
+   * @brief The solver options, whose Fact field selects how much of the factorization is reused
+   */
+  superlu_dist_options_t options;
+
+  /**
+   * @brief The row-local matrix, whose arrays are the vectors below
+   */
+  SuperMatrix matrix;
+
+  /**
+   * @brief The scalings and permutations, reused while the pattern is unchanged
+   */
+  ScalePermstruct_t scale_perm;
+
+  /**
+   * @brief The factors and their symbolic structure, reused while the pattern is unchanged
+   */
+  LUstruct_t lu;
+
+  /**
+   * @brief The communication pattern of the triangular solves
+   */
+  SOLVEstruct_t solve;
+
+  /**
+   * @brief Whether the matrix and the factorization structures have been created
+   */
+  bool initialized = false;
+
+  /**
+   * @brief Whether the current matrix has not yet been factored
+   */
+  bool needs_factorization = false;
+
+  /**
+   * @brief Whether a factorization has succeeded since the structures were created, so the
+   * permutations and symbolic factorization they hold can be reused
+   */
+  bool factored = false;
+
+  /**
+   * @brief The global row and column indices of the local rows, as given by the operator
+   *
+   * SuperLU_DIST permutes the column indices of the matrix in place, so the pattern is kept
+   * separately, both to detect a change and to restore the indices before a refactorization.
+   */
+  std::vector<int_t> row_offsets, columns;
+
+  /**
+   * @brief The arrays of the row-local matrix handed to SuperLU_DIST
+   */
+  std::vector<int_t> matrix_row_offsets, matrix_columns;
+
+  /**
+   * @brief The values of the row-local matrix handed to SuperLU_DIST
+   */
+  std::vector<double> values;
+
+  /**
+   * @brief Releases the matrix and the factorization structures
+   */
+  void release()
+  {
+    if (!initialized) {
+      return;
+    }
+    if (options.SolveInitialized == YES) {
+      SolveFinalize(&options, &solve);
+    }
+    Destroy_LU(matrix.ncol, &grid, &lu);
+    ScalePermstructFree(&scale_perm);
+    LUstructFree(&lu);
+    Destroy_SuperMatrix_Store_dist(&matrix);
+    initialized = false;
+    factored    = false;
+  }
+};
+
+SuperLUSolver::SuperLUSolver(MPI_Comm comm, const int print_level) : data_(std::make_unique<SuperLUData>())
+{
+  int size;
+  MPI_Comm_size(comm, &size);
+  int rows = static_cast<int>(std::sqrt(static_cast<double>(size)));
+  while (size % rows != 0) {
+    rows--;
+  }
+  superlu_gridinit(comm, rows, size / rows, &data_->grid);
+
+  set_default_options_dist(&data_->options);
+  data_->options.ColPerm   = PARMETIS;
+  data_->options.PrintStat = print_level > 0 ? YES : NO;
+}
+
+SuperLUSolver::~SuperLUSolver()
+{
+  data_->release();
+  superlu_gridexit(&data_->grid);
+}
+
+void SuperLUSolver::SetOperator(const mfem::Operator& op)
+{
+  auto matrix = dynamic_cast<const mfem::HypreParMatrix*>(&op);
+  SLIC_ERROR_IF(matrix == nullptr, "The SuperLU solver requires a HypreParMatrix.");
+
+  auto  parcsr    = static_cast<hypre_ParCSRMatrix*>(*const_cast<mfem::HypreParMatrix*>(matrix));
+  auto  diag      = hypre_ParCSRMatrixDiag(parcsr);
+  auto  offd      = hypre_ParCSRMatrixOffd(parcsr);
+  auto  col_map   = hypre_ParCSRMatrixColMapOffd(parcsr);
+  auto  first_col = hypre_ParCSRMatrixFirstColDiag(parcsr);
+  auto& data      = *data_;
+
+  const int  local_rows = hypre_CSRMatrixNumRows(diag);
+  const auto nnz        = static_cast<std::size_t>(hypre_CSRMatrixNumNonzeros(diag) + hypre_CSRMatrixNumNonzeros(offd));
+
+  // Each row lists the entries of the diagonal block, then those of the off-diagonal block,
+  // which is the ordering of hypre_MergeDiagAndOffd used by mfem::SuperLURowLocMatrix
+  auto row_offset = [&](int row) {
+    return static_cast<int_t>(hypre_CSRMatrixI(diag)[row] + hypre_CSRMatrixI(offd)[row]);
+  };
+  auto visit = [&](auto&& entry) {
+    std::size_t k = 0;
+    for (int row = 0; row < local_rows; row++) {
+      for (int j = hypre_CSRMatrixI(diag)[row]; j < hypre_CSRMatrixI(diag)[row + 1]; j++, k++) {
+        entry(k, static_cast<int_t>(hypre_CSRMatrixJ(diag)[j] + first_col), hypre_CSRMatrixData(diag)[j]);
+      }
+      for (int j = hypre_CSRMatrixI(offd)[row]; j < hypre_CSRMatrixI(offd)[row + 1]; j++, k++) {
+        entry(k, static_cast<int_t>(col_map[hypre_CSRMatrixJ(offd)[j]]), hypre_CSRMatrixData(offd)[j]);
+      }
+    }
+  };
+
+  // The permutations only exist once a factorization has been computed, e.g., not when the operator
+  // is set twice before a solve
+  bool same_pattern = data.initialized && data.factored && data.values.size() == nnz &&
+                      data.row_offsets.size() == static_cast<std::size_t>(local_rows + 1);
+  for (int row = 0; same_pattern && row <= local_rows; row++) {
+    same_pattern = data.row_offsets[static_cast<std::size_t>(row)] == row_offset(row);
+  }
+  if (same_pattern) {
+    visit([&](std::size_t k, int_t column, double value) {
+      same_pattern   = same_pattern && data.columns[k] == column;
+      data.values[k] = value;
+    });
+  }
+
+  // The pattern has to agree on every rank for the factorization structures to be reused
+  int local_same = same_pattern ? 1 : 0;
+  int all_same   = 0;
+  MPI_Allreduce(&local_same, &all_same, 1, MPI_INT, MPI_MIN, hypre_ParCSRMatrixComm(parcsr));
+
+  if (all_same == 1) {
+    data.options.Fact = SamePattern_SameRowPerm;
+  } else {
+    data.release();
+    data.row_offsets.resize(static_cast<std::size_t>(local_rows + 1));
+    for (int row = 0; row <= local_rows; row++) {
+      data.row_offsets[static_cast<std::size_t>(row)] = row_offset(row);
+    }
+    data.columns.resize(nnz);
+    data.values.resize(nnz);
+    visit([&](std::size_t k, int_t column, double value) {
+      data.columns[k] = column;
+      data.values[k]  = value;
+    });
+  }
+
+  // SuperLU_DIST permutes the column indices in place, so they are restored before every factorization
+  data.matrix_row_offsets = data.row_offsets;
+  data.matrix_columns     = data.columns;
+
+  if (data.initialized) {
+    auto store    = static_cast<NRformat_loc*>(data.matrix.Store);
+    store->rowptr = data.matrix_row_offsets.data();
+    store->colind = data.matrix_columns.data();
+    store->nzval  = data.values.data();
+  } else {
+    const auto global_size = static_cast<int_t>(hypre_ParCSRMatrixGlobalNumRows(parcsr));
+    dCreate_CompRowLoc_Matrix_dist(&data.matrix, global_size, global_size, static_cast<int_t>(nnz), local_rows,
+                                   static_cast<int_t>(hypre_ParCSRMatrixFirstRowIndex(parcsr)), data.values.data(),
+                                   data.matrix_columns.data(), data.matrix_row_offsets.data(), SLU_NR_loc, SLU_D,
+                                   SLU_GE);
+    ScalePermstructInit(global_size, global_size, &data.scale_perm);
+    LUstructInit(global_size, &data.lu);
+    data.options.Fact = DOFACT;
+    data.initialized  = true;
+  }
+
+  data.needs_factorization = true;
+  height                   = local_rows;
+  width                    = local_rows;
+}
+
+void SuperLUSolver::Mult(const mfem::Vector& b, mfem::Vector& x) const
+{
+  auto& data = *data_;
+  SLIC_ERROR_IF(!data.initialized, "The SuperLU solver needs an operator before it can solve.");
+
+  if (data.needs_factorization) {
+    if (data.options.Fact == DOFACT) {
+      symbolic_factorizations_++;
+    }
+  } else {
+    data.options.Fact = FACTORED;
+  }
+
+  // The right-hand side is overwritten with the solution
+  x = b;
+  double        berr;
+  int           info;
+  SuperLUStat_t stat;
+  PStatInit(&stat);
+  pdgssvx(&data.options, &data.matrix, &data.scale_perm, x.GetData(), height, 1, &data.grid, &data.lu, &data.solve,
+          &berr, &stat, &info);
+  if (data.options.PrintStat == YES) {
+    PStatPrint(&data.options, &stat, &data.grid);
+  }
+  PStatFree(&stat);
+  SLIC_ERROR_IF(info != 0, fmt::format("SuperLU failed with info = {0}", info));
+
+  data.needs_factorization = false;
+  data.factored            = true;
+}
+
+}  // namespace serac::mfem_ext
@@ -0,0 +1,85 @@
+// Copyright (c) 2019-2021, Lawrence Livermore National Security, LLC and
+// other Serac Project Developers. See the top-level LICENSE file for
+// details.
+//
+// SPDX-License-Identifier: (BSD-3-Clause)
+
+/**
+ * @file superlu_solver.hpp
+ *
+ * @brief A SuperLU_DIST direct solver that reuses its factorization structure across matrices
+ */
+
+#pragma once
+
+#include <memory>
+
+#include "mfem.hpp"
+
+namespace serac::mfem_ext {
+
+/**
+ * @brief Solves systems with SuperLU_DIST, refactoring only numerically while the sparsity pattern is unchanged
+ *
+ * mfem::SuperLUSolver needs its matrix converted into a new mfem::SuperLURowLocMatrix, and
+ * recomputes the fill-reducing ordering and the symbolic factorization for every matrix. This
+ * solver reads HypreParMatrix operators directly into row-local arrays that it owns. When a new
+ * operator has the same sparsity pattern as the previous one, e.g., the Jacobian of the next
+ * Newton iteration or timestep, only its values are copied and SuperLU_DIST refactors with
+ * SamePattern_SameRowPerm, reusing the column and row permutations and the symbolic factorization.
+ */
+class SuperLUSolver : public mfem::Solver {
+public:
+  /**
+   * @brief Constructs the solver over a square process grid
+   *
+   * @param[in] comm The MPI communicator of the systems
+   * @param[in] print_level Whether SuperLU_DIST prints statistics (when positive)
+   */
+  SuperLUSolver(MPI_Comm comm, const int print_level);
+
+  /**
+   * @brief Releases the SuperLU_DIST structures
+   */
+  ~SuperLUSolver() override;
+
+  /**
+   * @brief Sets the matrix, keeping the previous factorization structure if its sparsity pattern is unchanged
+   *
+   * @param[in] op The matrix, which must be a HypreParMatrix
+   * @note Implements mfem::Solver::SetOperator
+   */
+  void SetOperator(const mfem::Operator& op) override;
+
+  /**
+   * @brief Solves the system, factoring the matrix first if it has changed
+   *
+   * @param[in] b The right-hand side
+   * @param[out] x The solution
+   * @note Implements mfem::Operator::Mult
+   */
+  void Mult(const mfem::Vector& b, mfem::Vector& x) const override;
+
+  /**
+   * @brief Returns the number of factorizations that computed the ordering and symbolic factorization
+   */
+  int NumSymbolicFactorizations() const { return symbolic_factorizations_; }
+
+private:
+  /**
+   * @brief The SuperLU_DIST process grid, options and factorization structures
+   */
+  struct SuperLUData;
+
+  /**
+   * @brief The SuperLU_DIST data, which is kept out of this header
+   */
+  std::unique_ptr<SuperLUData> data_;
+
+  /**
+   * @brief The number of factorizations that computed the ordering and symbolic factorization
+   */
+  mutable int symbolic_factorizations_ = 0;
+};
+
+}  // namespace serac::mfem_ext
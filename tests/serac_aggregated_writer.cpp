@@ -0,0 +1,73 @@
+// Copyright (c) 2019-2021, Lawrence Livermore National Security, LLC and
+// other Serac Project Developers. See the top-level LICENSE file for
+// details.
+//
+// SPDX-License-Identifier: (BSD-3-Clause)
+
+#include "serac/infrastructure/aggregated_writer.hpp"
+
+#include <fstream>
+#include <string>
+
+#include <gtest/gtest.h>
+#include "mpi.h"
+
+namespace serac {
+
+TEST(aggregated_writer, blocks_recoverable_from_index)
+{
+  int rank      = 0;
+  int num_ranks = 0;
+  MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+  MPI_Comm_size(MPI_COMM_WORLD, &num_ranks);
+
+  // Give each rank a block of a different size
+  std::string block(static_cast<std::size_t>(rank + 1) * 100, static_cast<char>('a' + rank % 26));
+
+  AggregatedWriter writer(MPI_COMM_WORLD, 1);
+  writer.write("aggregated_writer_test.dat", block);
+  MPI_Barrier(MPI_COMM_WORLD);
+
+  std::ifstream index("aggregated_writer_test.dat.index");
+  int           num_entries = 0;
+  index >> num_entries;
+  ASSERT_EQ(num_entries, num_ranks);
+
+  long long offset = 0;
+  long long size   = 0;
+  for (int i = 0; i <= rank; ++i) {
+    int entry_rank = -1;
+    index >> entry_rank >> offset >> size;
+    EXPECT_EQ(entry_rank, i);
+  }
+  ASSERT_EQ(size, static_cast<long long>(block.size()));
+
+  std::ifstream file("aggregated_writer_test.dat", std::ios::binary);
+  file.seekg(offset);
+  std::string contents(static_cast<std::size_t>(size), '\0');
+  file.read(&contents[0], size);
+  EXPECT_EQ(contents, block);
+}
+
+}  // namespace serac
+
+//------------------------------------------------------------------------------
+#include "axom/slic/core/SimpleLogger.hpp"
+
+int main(int argc, char* argv[])
+{
+  int result = 0;
+
+  ::testing::InitGoogleTest(&argc, argv);
+
+  MPI_Init(&argc, &argv);
+
+  axom::slic::SimpleLogger logger;  // create & initialize test logger, finalized when
+                                    // exiting main scope
+
+  result = RUN_ALL_TESTS();
+
+  MPI_Finalize();
+
+  return result;
+}
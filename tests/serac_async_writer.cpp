@@ -0,0 +1,94 @@
+// Copyright (c) 2019-2021, Lawrence Livermore National Security, LLC and
+// other Serac Project Developers. See the top-level LICENSE file for
+// details.
+//
+// SPDX-License-Identifier: (BSD-3-Clause)
+
+#include "serac/infrastructure/async_writer.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <stdexcept>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include "mpi.h"
+
+namespace serac {
+
+TEST(async_writer, tasks_run_in_order)
+{
+  AsyncWriter      writer(2);
+  std::vector<int> written;
+
+  for (int i = 0; i < 10; ++i) {
+    int slot = writer.acquireSlot();
+    EXPECT_GE(slot, 0);
+    EXPECT_LT(slot, writer.numSlots());
+    writer.submit(slot, [&written, i]() { written.push_back(i); });
+  }
+  writer.flush();
+
+  ASSERT_EQ(written.size(), 10u);
+  for (int i = 0; i < 10; ++i) {
+    EXPECT_EQ(written[static_cast<std::size_t>(i)], i);
+  }
+}
+
+TEST(async_writer, pending_tasks_bounded_by_slots)
+{
+  constexpr int    num_slots = 3;
+  AsyncWriter      writer(num_slots);
+  std::atomic<int> pending{0};
+  int              max_pending = 0;
+
+  for (int i = 0; i < 12; ++i) {
+    int slot    = writer.acquireSlot();
+    max_pending = std::max(max_pending, ++pending);
+    writer.submit(slot, [&pending]() {
+      std::this_thread::sleep_for(std::chrono::milliseconds(2));
+      --pending;
+    });
+  }
+  writer.finalize();
+
+  EXPECT_LE(max_pending, num_slots);
+  EXPECT_EQ(pending, 0);
+}
+
+TEST(async_writer, task_errors_are_rethrown)
+{
+  AsyncWriter writer(1);
+  writer.submit(writer.acquireSlot(), []() { throw std::runtime_error("write failed"); });
+  EXPECT_THROW(writer.flush(), std::runtime_error);
+
+  // The writer remains usable after the error has been reported
+  bool written = false;
+  writer.submit(writer.acquireSlot(), [&written]() { written = true; });
+  writer.flush();
+  EXPECT_TRUE(written);
+}
+
+}  // namespace serac
+
+//------------------------------------------------------------------------------
+#include "axom/slic/core/SimpleLogger.hpp"
+
+int main(int argc, char* argv[])
+{
+  int result = 0;
+
+  ::testing::InitGoogleTest(&argc, argv);
+
+  MPI_Init(&argc, &argv);
+
+  axom::slic::SimpleLogger logger;  // create & initialize test logger, finalized when
+                                    // exiting main scope
+
+  result = RUN_ALL_TESTS();
+
+  MPI_Finalize();
+
+  return result;
+}
@@ -9,6 +9,8 @@
 #include <gtest/gtest.h>
 #include "mfem.hpp"
 
+#include "serac/physics/utilities/solver_config.hpp"
+
 class SlicErrorException : public std::exception {
 };
 
@@ -243,6 +245,77 @@ TEST_F(InputTest, coef_build_scalar_from_vec)
   EXPECT_THROW(coef_opts.constructScalar(), SlicErrorException);
 }
 
+TEST_F(InputTest, output_options)
+{
+  reader_->parseString("output = { every_dt = 0.5, fields = { 'temperature' }, levels_of_detail = 2, float32 = true }");
+  auto& output_table = inlet_->addTable("output");
+  input::defineOutputOptionsInputFileSchema(output_table);
+  auto options = output_table.get<OutputOptions>();
+  EXPECT_FALSE(options.async);
+  EXPECT_EQ(options.every_n_steps, 1);
+  ASSERT_TRUE(options.every_dt);
+  EXPECT_DOUBLE_EQ(*options.every_dt, 0.5);
+  ASSERT_EQ(options.fields.size(), 1u);
+  EXPECT_EQ(options.fields[0], "temperature");
+  EXPECT_EQ(options.levels_of_detail, 2);
+  EXPECT_TRUE(options.float32);
+}
+
+TEST_F(InputTest, output_options_bad_cadence)
+{
+  reader_->parseString("output = { every_n_steps = 0 }");
+  auto& output_table = inlet_->addTable("output");
+  input::defineOutputOptionsInputFileSchema(output_table);
+  EXPECT_THROW(output_table.get<OutputOptions>(), SlicErrorException);
+}
+
+TEST_F(InputTest, coef_factor)
+{
+  reader_->parseString("coef_opts = { constant = 2.0 }");
+  auto& coef_table = inlet_->addTable("coef_opts");
+  input::CoefficientInputOptions::defineInputFileSchema(coef_table);
+  auto coef_opts   = coef_table.get<input::CoefficientInputOptions>();
+  auto factor      = std::make_shared<double>(3.0);
+  coef_opts.factor = factor;
+  auto coef        = coef_opts.constructScalar();
+
+  // The constructed coefficient follows later changes to the factor
+  mfem::IsoparametricTransformation T;
+  mfem::IntegrationPoint            ip;
+  EXPECT_DOUBLE_EQ(coef->Eval(T, ip), 6.0);
+  *factor = 0.5;
+  EXPECT_DOUBLE_EQ(coef->Eval(T, ip), 1.0);
+}
+
+TEST_F(InputTest, sweep_options)
+{
+  reader_->parseString(
+      "sweep = { concurrent_groups = 2, scaled_bcs = { 'traction' }, cases = { { mu = 0.5 }, { K = 10.0, bc_scale = "
+      "2.0 }, { kappa = 0.1 } } }");
+  auto& sweep_table = inlet_->addTable("sweep");
+  input::defineSweepOptionsInputFileSchema(sweep_table);
+  auto options = sweep_table.get<SweepOptions>();
+  EXPECT_EQ(options.concurrent_groups, 2);
+  ASSERT_EQ(options.scaled_bcs.size(), 1u);
+  EXPECT_EQ(options.scaled_bcs[0], "traction");
+  ASSERT_EQ(options.cases.size(), 3u);
+  EXPECT_DOUBLE_EQ(*options.cases[0].mu, 0.5);
+  EXPECT_FALSE(options.cases[0].K);
+  EXPECT_DOUBLE_EQ(options.cases[0].bc_scale, 1.0);
+  EXPECT_DOUBLE_EQ(*options.cases[1].K, 10.0);
+  EXPECT_DOUBLE_EQ(options.cases[1].bc_scale, 2.0);
+  EXPECT_DOUBLE_EQ(*options.cases[2].kappa, 0.1);
+  EXPECT_FALSE(options.cases[2].mu);
+}
+
+TEST_F(InputTest, sweep_options_bad_groups)
+{
+  reader_->parseString("sweep = { concurrent_groups = 0 }");
+  auto& sweep_table = inlet_->addTable("sweep");
+  input::defineSweepOptionsInputFileSchema(sweep_table);
+  EXPECT_THROW(sweep_table.get<SweepOptions>(), SlicErrorException);
+}
+
 }  // namespace serac
 
 //------------------------------------------------------------------------------
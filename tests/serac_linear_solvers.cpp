@@ -0,0 +1,399 @@
+// Copyright (c) 2019-2021, Lawrence Livermore National Security, LLC and
+// other Serac Project Developers. See the top-level LICENSE file for
+// details.
+//
+// SPDX-License-Identifier: (BSD-3-Clause)
+
+#include <initializer_list>
+#include <memory>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include "mfem.hpp"
+
+#include "serac/numerics/mesh_utils.hpp"
+#include "serac/physics/utilities/additive_schwarz.hpp"
+#include "serac/physics/utilities/chebyshev_preconditioner.hpp"
+#include "serac/physics/utilities/equation_solver.hpp"
+#include "serac/physics/utilities/krylov_solvers.hpp"
+#include "serac/physics/utilities/low_order_refined.hpp"
+
+namespace serac {
+
+/**
+ * @brief Assembles the parallel matrix of a sum of domain integrators, keeping explicit zeros so that
+ * matrices assembled on the same space share their sparsity pattern
+ *
+ * @param[in] space The finite element space
+ * @param[in] integrators The integrators, which are owned by the form they are assembled with
+ */
+std::unique_ptr<mfem::HypreParMatrix> assembleMatrix(mfem::ParFiniteElementSpace&                      space,
+                                                     std::initializer_list<mfem::BilinearFormIntegrator*> integrators)
+{
+  mfem::ParBilinearForm form(&space);
+  for (auto integrator : integrators) {
+    form.AddDomainIntegrator(integrator);
+  }
+  form.Assemble(0);
+  form.Finalize(0);
+  return std::unique_ptr<mfem::HypreParMatrix>(form.ParallelAssemble());
+}
+
+TEST(linear_solvers, lor_preconditioner_high_order)
+{
+  MPI_Barrier(MPI_COMM_WORLD);
+
+  auto pmesh = buildRectangleMesh(4, 4, 2.0, 1.0);
+
+  mfem::H1_FECollection       fec(4, pmesh->Dimension());
+  mfem::ParFiniteElementSpace space(pmesh.get(), &fec);
+
+  mfem_ext::LowOrderRefinedSpace lor(space);
+
+  // The low-order-refined mass matrix integrates constants exactly
+  mfem::ConstantCoefficient one(1.0);
+  mfem::MassIntegrator      mass(one);
+  auto                      M_lor = lor.parallelAssemble(*lor.assemble(mass));
+  mfem::Vector              ones(space.GetTrueVSize());
+  mfem::Vector              M_ones(space.GetTrueVSize());
+  ones = 1.0;
+  M_lor->Mult(ones, M_ones);
+  double area = M_ones.Sum();
+  MPI_Allreduce(MPI_IN_PLACE, &area, 1, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD);
+  EXPECT_NEAR(area, 2.0, 1.0e-12);
+
+  // Solve a high-order diffusion problem preconditioned by AMG on its low-order-refined counterpart
+  mfem::Array<int> ess_bdr(pmesh->bdr_attributes.Max());
+  mfem::Array<int> ess_tdofs;
+  ess_bdr = 1;
+  space.GetEssentialTrueDofs(ess_bdr, ess_tdofs);
+
+  auto K = assembleMatrix(space, {new mfem::DiffusionIntegrator(one)});
+  delete K->EliminateRowsCols(ess_tdofs);
+
+  mfem::DiffusionIntegrator diffusion(one);
+  auto                      K_lor = lor.parallelAssemble(*lor.assemble(diffusion));
+  delete K_lor->EliminateRowsCols(ess_tdofs);
+
+  mfem_ext::LORPreconditioner prec([&K_lor]() -> const mfem::HypreParMatrix& { return *K_lor; }, &space, 0);
+  mfem::CGSolver              cg(MPI_COMM_WORLD);
+  cg.SetRelTol(1.0e-8);
+  cg.SetMaxIter(200);
+  cg.SetPreconditioner(prec);
+  cg.SetOperator(*K);
+
+  mfem::Vector b(space.GetTrueVSize());
+  mfem::Vector x(space.GetTrueVSize());
+  b = 1.0;
+  b.SetSubVector(ess_tdofs, 0.0);
+  x = 0.0;
+  cg.Mult(b, x);
+
+  EXPECT_TRUE(cg.GetConverged());
+  EXPECT_LT(cg.GetNumIterations(), 50);
+
+  MPI_Barrier(MPI_COMM_WORLD);
+}
+
+TEST(linear_solvers, chebyshev_preconditioner_reuses_estimate)
+{
+  MPI_Barrier(MPI_COMM_WORLD);
+
+  auto pmesh = buildRectangleMesh(16, 16);
+
+  mfem::H1_FECollection       fec(2, pmesh->Dimension());
+  mfem::ParFiniteElementSpace space(pmesh.get(), &fec);
+
+  mfem::ConstantCoefficient one(1.0);
+  auto                      M = assembleMatrix(space, {new mfem::MassIntegrator(one)});
+  auto                      K = assembleMatrix(space, {new mfem::DiffusionIntegrator(one)});
+
+  mfem_ext::ChebyshevPreconditioner prec(ChebyshevPrec{});
+  mfem::CGSolver                    cg(MPI_COMM_WORLD);
+  cg.SetRelTol(1.0e-8);
+  cg.SetMaxIter(500);
+  cg.SetPreconditioner(prec);
+
+  mfem::Vector b(space.GetTrueVSize());
+  mfem::Vector x(space.GetTrueVSize());
+  b = 1.0;
+
+  // Backward Euler Jacobians M + dt K for two timesteps
+  double first_estimate = 0.0;
+  for (double dt : {1.0e-3, 2.0e-3}) {
+    std::unique_ptr<mfem::HypreParMatrix> J(mfem::Add(1.0, *M, dt, *K));
+    cg.SetOperator(*J);
+    if (first_estimate == 0.0) {
+      first_estimate = prec.largestEigenvalue();
+    }
+    x = 0.0;
+    cg.Mult(b, x);
+    EXPECT_TRUE(cg.GetConverged());
+  }
+
+  // The eigenvalue estimate is only computed for the first operator
+  EXPECT_GT(first_estimate, 0.0);
+  EXPECT_EQ(first_estimate, prec.largestEigenvalue());
+
+  MPI_Barrier(MPI_COMM_WORLD);
+}
+
+TEST(linear_solvers, communication_avoiding_krylov_matches_cg)
+{
+  MPI_Barrier(MPI_COMM_WORLD);
+
+  auto pmesh = buildRectangleMesh(16, 16);
+
+  mfem::H1_FECollection       fec(2, pmesh->Dimension());
+  mfem::ParFiniteElementSpace space(pmesh.get(), &fec);
+
+  mfem::ConstantCoefficient one(1.0);
+
+  auto K = assembleMatrix(space, {new mfem::MassIntegrator(one), new mfem::DiffusionIntegrator(one)});
+
+  mfem::Vector b(space.GetTrueVSize());
+  b.Randomize(1);
+
+  auto solve = [&](mfem::IterativeSolver& solver) {
+    mfem::HypreSmoother prec(*K, mfem::HypreSmoother::Jacobi);
+    solver.SetRelTol(1.0e-10);
+    solver.SetMaxIter(1000);
+    solver.SetPreconditioner(prec);
+    solver.SetOperator(*K);
+    mfem::Vector x(space.GetTrueVSize());
+    x = 0.0;
+    solver.Mult(b, x);
+    EXPECT_TRUE(solver.GetConverged());
+    return x;
+  };
+
+  mfem::CGSolver              cg(MPI_COMM_WORLD);
+  mfem_ext::PipelinedCGSolver pipelined_cg(MPI_COMM_WORLD);
+  mfem_ext::SStepGMRESSolver  sstep_gmres(MPI_COMM_WORLD);
+  sstep_gmres.SetSteps(4);
+
+  mfem::Vector expected  = solve(cg);
+  mfem::Vector pipelined = solve(pipelined_cg);
+  mfem::Vector sstep     = solve(sstep_gmres);
+
+  // Pipelined CG is the same method in exact arithmetic
+  EXPECT_LE(std::abs(pipelined_cg.GetNumIterations() - cg.GetNumIterations()), 2);
+
+  const double norm = mfem::ParNormlp(expected, 2, MPI_COMM_WORLD);
+  pipelined -= expected;
+  sstep -= expected;
+  EXPECT_LT(mfem::ParNormlp(pipelined, 2, MPI_COMM_WORLD), 1.0e-6 * norm);
+  EXPECT_LT(mfem::ParNormlp(sstep, 2, MPI_COMM_WORLD), 1.0e-6 * norm);
+
+  MPI_Barrier(MPI_COMM_WORLD);
+}
+
+TEST(linear_solvers, recycling_krylov_reduces_iterations)
+{
+  MPI_Barrier(MPI_COMM_WORLD);
+
+  auto pmesh = buildRectangleMesh(16, 16);
+
+  mfem::H1_FECollection       fec(2, pmesh->Dimension());
+  mfem::ParFiniteElementSpace space(pmesh.get(), &fec);
+
+  mfem::ConstantCoefficient one(1.0);
+  auto                      M = assembleMatrix(space, {new mfem::MassIntegrator(one)});
+  auto                      K = assembleMatrix(space, {new mfem::DiffusionIntegrator(one)});
+
+  mfem_ext::DeflatedCGSolver    deflated_cg(MPI_COMM_WORLD);
+  mfem_ext::RecycledGMRESSolver recycled_gmres(MPI_COMM_WORLD);
+  recycled_gmres.SetKDim(20);
+
+  for (mfem::IterativeSolver* solver : std::initializer_list<mfem::IterativeSolver*>{&deflated_cg, &recycled_gmres}) {
+    solver->SetRelTol(1.0e-10);
+    solver->SetMaxIter(1000);
+
+    mfem::Vector b(space.GetTrueVSize());
+    mfem::Vector x(space.GetTrueVSize());
+    b.Randomize(1);
+
+    // A slowly varying sequence of backward Euler systems with the same right-hand side
+    std::vector<int> iterations;
+    for (double dt : {1.0e-2, 1.1e-2, 1.2e-2}) {
+      std::unique_ptr<mfem::HypreParMatrix> J(mfem::Add(1.0, *M, dt, *K));
+      solver->SetOperator(*J);
+      x = 0.0;
+      solver->Mult(b, x);
+      EXPECT_TRUE(solver->GetConverged());
+      iterations.push_back(solver->GetNumIterations());
+
+      mfem::Vector residual(b);
+      J->Mult(-1.0, x, 1.0, residual);
+      EXPECT_LT(mfem::ParNormlp(residual, 2, MPI_COMM_WORLD), 1.0e-8 * mfem::ParNormlp(b, 2, MPI_COMM_WORLD));
+    }
+
+    EXPECT_LT(iterations.back(), iterations.front());
+  }
+
+  EXPECT_GT(deflated_cg.RecycledSize(), 0);
+  EXPECT_GT(recycled_gmres.RecycledSize(), 0);
+
+  MPI_Barrier(MPI_COMM_WORLD);
+}
+
+TEST(linear_solvers, superlu_reuses_symbolic_factorization)
+{
+  MPI_Barrier(MPI_COMM_WORLD);
+
+  auto pmesh = buildRectangleMesh(8, 8);
+
+  mfem::H1_FECollection       fec(1, pmesh->Dimension());
+  mfem::ParFiniteElementSpace space(pmesh.get(), &fec);
+
+  mfem::ConstantCoefficient one(1.0);
+  auto                      M = assembleMatrix(space, {new mfem::MassIntegrator(one)});
+  auto                      K = assembleMatrix(space, {new mfem::DiffusionIntegrator(one)});
+
+  mfem_ext::EquationSolver solver(MPI_COMM_WORLD, DirectSolverOptions{0});
+  auto&                    superlu = dynamic_cast<mfem_ext::SuperLUSolver&>(solver.LinearSolver());
+
+  mfem::Vector b(space.GetTrueVSize());
+  mfem::Vector x(space.GetTrueVSize());
+  b.Randomize(1);
+
+  // Matrices with the same sparsity pattern only need one ordering and symbolic factorization
+  for (double dt : {1.0e-2, 2.0e-2, 4.0e-2}) {
+    std::unique_ptr<mfem::HypreParMatrix> J(mfem::Add(1.0, *M, dt, *K));
+    solver.SetOperator(*J);
+    solver.Mult(b, x);
+
+    mfem::Vector residual(b);
+    J->Mult(-1.0, x, 1.0, residual);
+    EXPECT_LT(mfem::ParNormlp(residual, 2, MPI_COMM_WORLD), 1.0e-10 * mfem::ParNormlp(b, 2, MPI_COMM_WORLD));
+  }
+  EXPECT_EQ(superlu.NumSymbolicFactorizations(), 1);
+
+  // An operator replaced before it is ever factored has no permutations to reuse
+  std::unique_ptr<mfem::HypreParMatrix> first(mfem::Add(1.0, *M, 1.0e-2, *K));
+  std::unique_ptr<mfem::HypreParMatrix> second(mfem::Add(1.0, *M, 1.0, *K));
+
+  mfem_ext::EquationSolver unfactored(MPI_COMM_WORLD, DirectSolverOptions{0});
+  auto&                    unfactored_superlu = dynamic_cast<mfem_ext::SuperLUSolver&>(unfactored.LinearSolver());
+  unfactored.SetOperator(*first);
+  unfactored.SetOperator(*second);
+  unfactored.Mult(b, x);
+
+  mfem::Vector residual(b);
+  second->Mult(-1.0, x, 1.0, residual);
+  EXPECT_LT(mfem::ParNormlp(residual, 2, MPI_COMM_WORLD), 1.0e-10 * mfem::ParNormlp(b, 2, MPI_COMM_WORLD));
+  EXPECT_EQ(unfactored_superlu.NumSymbolicFactorizations(), 1);
+
+  MPI_Barrier(MPI_COMM_WORLD);
+}
+
+TEST(linear_solvers, mixed_precision_reaches_double_tolerance)
+{
+  MPI_Barrier(MPI_COMM_WORLD);
+
+  auto pmesh = buildRectangleMesh(16, 16);
+
+  mfem::H1_FECollection       fec(2, pmesh->Dimension());
+  mfem::ParFiniteElementSpace space(pmesh.get(), &fec);
+
+  mfem::ConstantCoefficient one(1.0);
+
+  auto J = assembleMatrix(space, {new mfem::MassIntegrator(one), new mfem::DiffusionIntegrator(one)});
+
+  const MixedPrecisionSolverOptions options = {.rel_tol = 1.0e-12, .abs_tol = 0.0, .print_level = 0, .max_iter = 100};
+  mfem_ext::EquationSolver          solver(MPI_COMM_WORLD, options);
+  solver.SetOperator(*J);
+
+  mfem::Vector b(space.GetTrueVSize());
+  mfem::Vector x(space.GetTrueVSize());
+  b.Randomize(1);
+  x = 0.0;
+  solver.Mult(b, x);
+
+  // The tolerance is well below single-precision round-off
+  auto& fgmres = dynamic_cast<mfem::IterativeSolver&>(solver.LinearSolver());
+  EXPECT_TRUE(fgmres.GetConverged());
+  mfem::Vector residual(b);
+  J->Mult(-1.0, x, 1.0, residual);
+  EXPECT_LT(mfem::ParNormlp(residual, 2, MPI_COMM_WORLD), 1.0e-11 * mfem::ParNormlp(b, 2, MPI_COMM_WORLD));
+
+  MPI_Barrier(MPI_COMM_WORLD);
+}
+
+TEST(linear_solvers, additive_schwarz_refactors_numerically)
+{
+  MPI_Barrier(MPI_COMM_WORLD);
+
+  auto pmesh = buildRectangleMesh(16, 4, 4.0, 1.0);
+
+  mfem::H1_FECollection       fec(2, pmesh->Dimension());
+  mfem::ParFiniteElementSpace space(pmesh.get(), &fec, pmesh->Dimension());
+
+  // The left edge is clamped
+  mfem::Array<int> ess_bdr(pmesh->bdr_attributes.Max());
+  mfem::Array<int> ess_tdofs;
+  ess_bdr    = 0;
+  ess_bdr[3] = 1;
+  space.GetEssentialTrueDofs(ess_bdr, ess_tdofs);
+
+  mfem::Vector b(space.GetTrueVSize());
+  mfem::Vector x(space.GetTrueVSize());
+  b = 1.0;
+  b.SetSubVector(ess_tdofs, 0.0);
+
+  std::vector<int> iterations;
+  for (int overlap : {0, 2}) {
+    mfem_ext::AdditiveSchwarzPreconditioner prec(SchwarzPrec{.overlap = overlap});
+    mfem::CGSolver                          cg(MPI_COMM_WORLD);
+    cg.SetRelTol(1.0e-8);
+    cg.SetMaxIter(2000);
+    cg.SetPreconditioner(prec);
+
+    // Nearly incompressible stiffness matrices, K / mu of order 1e3, which share their sparsity pattern
+    for (double lambda : {1.0e3, 2.0e3}) {
+      mfem::ConstantCoefficient lambda_coef(lambda);
+      mfem::ConstantCoefficient mu_coef(1.0);
+      auto                      K = assembleMatrix(space, {new mfem::ElasticityIntegrator(lambda_coef, mu_coef)});
+      delete K->EliminateRowsCols(ess_tdofs);
+
+      cg.SetOperator(*K);
+      x = 0.0;
+      cg.Mult(b, x);
+      EXPECT_TRUE(cg.GetConverged());
+    }
+    iterations.push_back(cg.GetNumIterations());
+
+    // The subdomain is only ordered once, and later operators are only refactored numerically
+    EXPECT_EQ(prec.numAnalyses(), 1);
+    EXPECT_EQ(prec.numSymbolicFactorizations(), 1);
+    EXPECT_GE(prec.subdomainSize(), space.GetTrueVSize());
+  }
+
+  // Overlapping subdomains converge faster than block Jacobi
+  EXPECT_LT(iterations[1], iterations[0]);
+
+  MPI_Barrier(MPI_COMM_WORLD);
+}
+
+}  // namespace serac
+
+//------------------------------------------------------------------------------
+#include "axom/slic/core/SimpleLogger.hpp"
+
+int main(int argc, char* argv[])
+{
+  int result = 0;
+
+  ::testing::InitGoogleTest(&argc, argv);
+
+  MPI_Init(&argc, &argv);
+
+  axom::slic::SimpleLogger logger;  // create & initialize test logger, finalized when
+                                    // exiting main scope
+
+  result = RUN_ALL_TESTS();
+
+  MPI_Finalize();
+
+  return result;
+}
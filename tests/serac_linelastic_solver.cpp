@@ -75,6 +75,191 @@ TEST(elastic_solver, static_solve)
   MPI_Barrier(MPI_COMM_WORLD);
 }
 
+/**
+ * @brief Exposes the iteration count of the linear solver of an Elasticity module
+ */
+class ElasticityIterations : public Elasticity {
+public:
+  using Elasticity::Elasticity;
+
+  /**
+   * @brief The number of iterations taken by the last linear solve
+   */
+  int linearIterations() { return dynamic_cast<mfem::IterativeSolver&>(K_inv_.LinearSolver()).GetNumIterations(); }
+};
+
+TEST(elastic_solver, p_multigrid_matches_jacobi)
+{
+  MPI_Barrier(MPI_COMM_WORLD);
+
+  std::string mesh_file = std::string(SERAC_REPO_DIR) + "/data/meshes/beam-quad.mesh";
+
+  auto pmesh = buildMeshFromFile(mesh_file, 1, 0);
+
+  // Solves the same order 4 problem with a given preconditioner, returning the solution and the iteration count
+  auto solve = [&pmesh](const Preconditioner& prec) {
+    IterativeSolverOptions options = {.rel_tol     = 1.0e-10,
+                                      .abs_tol     = 1.0e-14,
+                                      .print_level = 0,
+                                      .max_iter    = 5000,
+                                      .lin_solver  = LinearSolver::CG,
+                                      .prec        = prec};
+
+    ElasticityIterations elas_solver(4, pmesh, options);
+
+    mfem::Vector disp(pmesh->Dimension());
+    disp = 0.0;
+    elas_solver.setDisplacementBCs({1}, std::make_shared<mfem::VectorConstantCoefficient>(disp));
+
+    mfem::Vector traction(pmesh->Dimension());
+    traction    = 0.0;
+    traction(1) = 1.0e-4;
+    elas_solver.setTractionBCs({2}, std::make_shared<mfem::VectorConstantCoefficient>(traction));
+
+    mfem::ConstantCoefficient mu_coef(0.25);
+    mfem::ConstantCoefficient K_coef(5.0);
+    elas_solver.setLameParameters(K_coef, mu_coef);
+    elas_solver.completeSetup();
+
+    double dt = 1.0;
+    elas_solver.advanceTimestep(dt);
+
+    return std::make_pair(mfem::Vector(elas_solver.getState()[0].get().trueVec()), elas_solver.linearIterations());
+  };
+
+  const auto [jacobi_solution, jacobi_iterations] = solve(HypreSmootherPrec{mfem::HypreSmoother::l1Jacobi});
+  const auto [pmg_solution, pmg_iterations]       = solve(PMultigridPrec{});
+
+  mfem::Vector difference(jacobi_solution);
+  difference -= pmg_solution;
+  const double jacobi_norm = mfem::ParNormlp(jacobi_solution, 2, MPI_COMM_WORLD);
+  EXPECT_GT(jacobi_norm, 0.0);
+  EXPECT_LT(mfem::ParNormlp(difference, 2, MPI_COMM_WORLD), 1.0e-6 * jacobi_norm);
+
+  // The point of the multigrid hierarchy is an iteration count that does not grow with the order
+  EXPECT_GT(pmg_iterations, 0);
+  EXPECT_LT(pmg_iterations, jacobi_iterations / 2);
+
+  MPI_Barrier(MPI_COMM_WORLD);
+}
+
+TEST(elastic_solver, static_condensation_matches_full_solve)
+{
+  MPI_Barrier(MPI_COMM_WORLD);
+
+  std::string mesh_file = std::string(SERAC_REPO_DIR) + "/data/meshes/beam-quad.mesh";
+
+  auto pmesh = buildMeshFromFile(mesh_file, 1, 0);
+
+  // Solves the same order 3 problem with or without the interior DOFs
+  auto solve = [&pmesh](const bool static_condensation) {
+    IterativeSolverOptions options = {.rel_tol     = 1.0e-10,
+                                      .abs_tol     = 1.0e-14,
+                                      .print_level = 0,
+                                      .max_iter    = 5000,
+                                      .lin_solver  = LinearSolver::CG,
+                                      .prec        = HypreBoomerAMGPrec{}};
+
+    Elasticity elas_solver(3, pmesh, options);
+    elas_solver.setStaticCondensation(static_condensation);
+
+    mfem::Vector disp(pmesh->Dimension());
+    disp = 0.0;
+    elas_solver.setDisplacementBCs({1}, std::make_shared<mfem::VectorConstantCoefficient>(disp));
+
+    mfem::Vector traction(pmesh->Dimension());
+    traction    = 0.0;
+    traction(1) = 1.0e-4;
+    elas_solver.setTractionBCs({2}, std::make_shared<mfem::VectorConstantCoefficient>(traction));
+
+    mfem::ConstantCoefficient mu_coef(0.25);
+    mfem::ConstantCoefficient K_coef(5.0);
+    elas_solver.setLameParameters(K_coef, mu_coef);
+    elas_solver.completeSetup();
+
+    double dt = 1.0;
+    elas_solver.advanceTimestep(dt);
+
+    mfem::Vector zero(pmesh->Dimension());
+    zero = 0.0;
+    mfem::VectorConstantCoefficient zerovec(zero);
+    return elas_solver.getState()[0].get().gridFunc().ComputeLpError(2.0, zerovec);
+  };
+
+  const double full_norm      = solve(false);
+  const double condensed_norm = solve(true);
+
+  EXPECT_NEAR(full_norm, condensed_norm, 1.0e-6 * full_norm);
+
+  MPI_Barrier(MPI_COMM_WORLD);
+}
+
+TEST(elastic_solver, load_cases_match_single_solves)
+{
+  MPI_Barrier(MPI_COMM_WORLD);
+
+  std::string mesh_file = std::string(SERAC_REPO_DIR) + "/data/meshes/beam-quad.mesh";
+
+  auto pmesh = buildMeshFromFile(mesh_file, 1, 0);
+
+  IterativeSolverOptions options = {.rel_tol     = 1.0e-10,
+                                    .abs_tol     = 1.0e-14,
+                                    .print_level = 0,
+                                    .max_iter    = 5000,
+                                    .lin_solver  = LinearSolver::CG,
+                                    .prec        = HypreBoomerAMGPrec{}};
+
+  Elasticity elas_solver(2, pmesh, options);
+
+  mfem::Vector disp(pmesh->Dimension());
+  disp = 0.0;
+  elas_solver.setDisplacementBCs({1}, std::make_shared<mfem::VectorConstantCoefficient>(disp));
+
+  mfem::Vector traction(pmesh->Dimension());
+  traction           = 0.0;
+  traction(1)        = 1.0e-4;
+  auto traction_coef = std::make_shared<mfem::VectorConstantCoefficient>(traction);
+  elas_solver.setTractionBCs({2}, traction_coef);
+
+  mfem::ConstantCoefficient mu_coef(0.25);
+  mfem::ConstantCoefficient K_coef(5.0);
+  elas_solver.setLameParameters(K_coef, mu_coef);
+  elas_solver.completeSetup();
+
+  double dt = 1.0;
+  elas_solver.advanceTimestep(dt);
+  const mfem::Vector single = elas_solver.getState()[0].get().trueVec();
+
+  // The same traction, twice the traction, and a body force alone
+  mfem::Vector double_traction(traction);
+  double_traction *= 2.0;
+  mfem::Vector gravity(pmesh->Dimension());
+  gravity    = 0.0;
+  gravity(1) = -1.0e-5;
+
+  std::vector<Elasticity::LoadCase> load_cases(3);
+  load_cases[0].tractions  = {{{2}, traction_coef}};
+  load_cases[1].tractions  = {{{2}, std::make_shared<mfem::VectorConstantCoefficient>(double_traction)}};
+  load_cases[2].body_force = std::make_shared<mfem::VectorConstantCoefficient>(gravity);
+
+  auto displacements = elas_solver.solveLoadCases(load_cases);
+  ASSERT_EQ(displacements.size(), 3u);
+
+  mfem::Vector difference(single);
+  difference -= displacements[0];
+  EXPECT_LT(mfem::ParNormlp(difference, 2.0, MPI_COMM_WORLD), 1.0e-8 * mfem::ParNormlp(single, 2.0, MPI_COMM_WORLD));
+
+  difference = displacements[1];
+  difference.Add(-2.0, displacements[0]);
+  EXPECT_LT(mfem::ParNormlp(difference, 2.0, MPI_COMM_WORLD), 1.0e-8 * mfem::ParNormlp(single, 2.0, MPI_COMM_WORLD));
+
+  // The body force pulls the beam down, against the traction
+  EXPECT_GT(mfem::ParNormlp(displacements[2], 2.0, MPI_COMM_WORLD), 0.0);
+  EXPECT_LT(mfem::InnerProduct(MPI_COMM_WORLD, displacements[2], single), 0.0);
+
+  MPI_Barrier(MPI_COMM_WORLD);
+}
+
 }  // namespace serac
 
 //------------------------------------------------------------------------------
@@ -5,16 +5,107 @@
 // SPDX-License-Identifier: (BSD-3-Clause)
 
 #include "serac/numerics/mesh_utils.hpp"
+#include "serac/numerics/structured_mesh.hpp"
 
+#include <dirent.h>
+#include <ftw.h>
+#include <stdlib.h>
+
+#include <cstdio>
 #include <fstream>
+#include <vector>
 
 #include <gtest/gtest.h>
+#include "axom/core.hpp"
 #include "mfem.hpp"
 
 #include "serac/serac_config.hpp"
 
 namespace serac {
 
+namespace {
+
+/**
+ * @brief Creates a fresh, uniquely named directory on the root rank and shares its name with the others
+ */
+std::string makeTemporaryDirectory(const std::string& prefix, MPI_Comm comm)
+{
+  int rank = 0;
+  MPI_Comm_rank(comm, &rank);
+  std::vector<char> name(prefix.begin(), prefix.end());
+  for (char c : std::string("XXXXXX")) {
+    name.push_back(c);
+  }
+  name.push_back('\0');
+  if (rank == 0) {
+    EXPECT_NE(mkdtemp(name.data()), nullptr);
+  }
+  MPI_Bcast(name.data(), static_cast<int>(name.size()), MPI_CHAR, 0, comm);
+  return name.data();
+}
+
+/**
+ * @brief Removes a directory and everything in it from the root rank
+ */
+void removeDirectory(const std::string& directory, MPI_Comm comm)
+{
+  MPI_Barrier(comm);
+  int rank = 0;
+  MPI_Comm_rank(comm, &rank);
+  if (rank == 0) {
+    nftw(
+        directory.c_str(), [](const char* path, const struct stat*, int, struct FTW*) { return std::remove(path); }, 16,
+        FTW_DEPTH | FTW_PHYS);
+  }
+  MPI_Barrier(comm);
+}
+
+/**
+ * @brief Whether a directory holds a cached set of mesh partitions, checked on the root rank
+ */
+bool containsCachedMesh(const std::string& directory, MPI_Comm comm)
+{
+  MPI_Barrier(comm);
+  int rank  = 0;
+  int found = 0;
+  MPI_Comm_rank(comm, &rank);
+  if (rank == 0) {
+    if (DIR* dir = opendir(directory.c_str())) {
+      while (const dirent* entry = readdir(dir)) {
+        auto partitions = axom::utilities::filesystem::joinPath(directory, entry->d_name + std::string("/partitions"));
+        found           = found || axom::utilities::filesystem::pathExists(partitions);
+      }
+      closedir(dir);
+    }
+  }
+  MPI_Bcast(&found, 1, MPI_INT, 0, comm);
+  return found;
+}
+
+/**
+ * @brief Checks that two meshes have the same local elements, attributes, and nodes
+ */
+void expectSameMesh(mfem::ParMesh& mesh, mfem::ParMesh& expected)
+{
+  EXPECT_EQ(mesh.GetNE(), expected.GetNE());
+  EXPECT_EQ(mesh.GetGlobalNE(), expected.GetGlobalNE());
+  EXPECT_EQ(mesh.GetNSharedFaces(), expected.GetNSharedFaces());
+  ASSERT_EQ(mesh.GetNE(), expected.GetNE());
+  for (int e = 0; e < mesh.GetNE(); e++) {
+    EXPECT_EQ(mesh.GetAttribute(e), expected.GetAttribute(e));
+  }
+
+  mfem::Vector nodes;
+  mfem::Vector expected_nodes;
+  mesh.GetNodes(nodes);
+  expected.GetNodes(expected_nodes);
+  ASSERT_EQ(nodes.Size(), expected_nodes.Size());
+  nodes -= expected_nodes;
+  EXPECT_NEAR(nodes.Normlinf(), 0.0, 1.0e-12);
+}
+
+}  // namespace
+
 TEST(mesh, load_exodus)
 {
   MPI_Barrier(MPI_COMM_WORLD);
@@ -24,6 +115,215 @@ TEST(mesh, load_exodus)
   MPI_Barrier(MPI_COMM_WORLD);
 }
 
+TEST(mesh, cached_mesh_matches_original)
+{
+  MPI_Barrier(MPI_COMM_WORLD);
+  std::string mesh_file = std::string(SERAC_REPO_DIR) + "/data/meshes/star.mesh";
+
+  auto original  = buildMeshFromFile(mesh_file, 1, 1);
+  auto cache_dir = makeTemporaryDirectory("mesh_cache_", MPI_COMM_WORLD);
+
+  // The first call populates the empty cache, the second loads from it
+  auto cached_first = buildCachedMeshFromFile(mesh_file, cache_dir, 1, 1);
+  EXPECT_TRUE(containsCachedMesh(cache_dir, MPI_COMM_WORLD));
+  auto cached_second = buildCachedMeshFromFile(mesh_file, cache_dir, 1, 1);
+
+  expectSameMesh(*cached_first, *original);
+  expectSameMesh(*cached_second, *original);
+
+  removeDirectory(cache_dir, MPI_COMM_WORLD);
+}
+
+TEST(mesh, partitioned_round_trip)
+{
+  MPI_Barrier(MPI_COMM_WORLD);
+  std::string mesh_file = std::string(SERAC_REPO_DIR) + "/data/meshes/beam-hex.mesh";
+
+  auto original = buildMeshFromFile(mesh_file, 1);
+  writePartitionedMesh(*original, "beam_hex_partitioned");
+
+  // Parallel refinement is applied after the partitions are loaded
+  auto loaded = buildMeshFromPartitionedFiles("beam_hex_partitioned", 1);
+  original->UniformRefinement();
+
+  EXPECT_EQ(loaded->GetNE(), original->GetNE());
+  EXPECT_EQ(loaded->GetGlobalNE(), original->GetGlobalNE());
+  EXPECT_EQ(loaded->GetNSharedFaces(), original->GetNSharedFaces());
+  EXPECT_NEAR(loaded->GetElementVolume(0), original->GetElementVolume(0), 1.0e-12);
+  MPI_Barrier(MPI_COMM_WORLD);
+}
+
+TEST(mesh, space_filling_curve_partitions_are_balanced)
+{
+  mfem::Mesh mesh(6, 6, 6, mfem::Element::HEXAHEDRON, true);
+
+  for (auto curve : {mesh::PartitionMethod::Hilbert, mesh::PartitionMethod::Morton}) {
+    auto partitioning = partitionBySpaceFillingCurve(mesh, 4, curve);
+    ASSERT_EQ(partitioning.size(), static_cast<std::size_t>(mesh.GetNE()));
+
+    std::vector<int> counts(4, 0);
+    for (auto part : partitioning) {
+      ASSERT_GE(part, 0);
+      ASSERT_LT(part, 4);
+      counts[static_cast<std::size_t>(part)]++;
+    }
+    for (auto count : counts) {
+      EXPECT_EQ(count, mesh.GetNE() / 4);
+    }
+
+    // The partitioning depends only on the mesh, so it's reproducible
+    EXPECT_EQ(partitioning, partitionBySpaceFillingCurve(mesh, 4, curve));
+  }
+}
+
+TEST(mesh, space_filling_curve_balances_weights)
+{
+  mfem::Mesh mesh(8, 8, mfem::Element::QUADRILATERAL, true);
+
+  // Make the left half of the domain three times as expensive
+  std::vector<double> weights(static_cast<std::size_t>(mesh.GetNE()));
+  mfem::Vector        center(2);
+  for (int e = 0; e < mesh.GetNE(); e++) {
+    mesh.GetElementCenter(e, center);
+    weights[static_cast<std::size_t>(e)] = (center(0) < 0.5) ? 3.0 : 1.0;
+  }
+
+  auto partitioning = partitionBySpaceFillingCurve(mesh, 2, mesh::PartitionMethod::Hilbert, weights);
+
+  std::vector<double> part_weights(2, 0.0);
+  for (std::size_t e = 0; e < weights.size(); e++) {
+    part_weights[static_cast<std::size_t>(partitioning[e])] += weights[e];
+  }
+  EXPECT_NEAR(part_weights[0], part_weights[1], 3.0);
+}
+
+TEST(mesh, element_costs_follow_order_and_loads)
+{
+  mfem::Mesh mesh(8, 8, mfem::Element::QUADRILATERAL, true);
+
+  // The left half is high order and the bottom edge (attribute 1) carries a load
+  mfem::Vector center(2);
+  for (int e = 0; e < mesh.GetNE(); e++) {
+    mesh.GetElementCenter(e, center);
+    mesh.SetAttribute(e, (center(0) < 0.5) ? 2 : 1);
+  }
+  mesh.SetAttributes();
+
+  mesh::PartitionOptions options{mesh::PartitionMethod::WeightedMETIS};
+  options.attribute_cost_orders      = {{2, 4}};
+  options.loaded_boundary_attributes = {1};
+  auto costs                         = measureElementCosts(mesh, options);
+  ASSERT_EQ(costs.size(), static_cast<std::size_t>(mesh.GetNE()));
+
+  std::vector<bool> loaded(costs.size(), false);
+  for (int be = 0; be < mesh.GetNBE(); be++) {
+    int element = 0;
+    int info    = 0;
+    mesh.GetBdrElementAdjacentElement(be, element, info);
+    if (mesh.GetBdrAttribute(be) == 1) {
+      loaded[static_cast<std::size_t>(element)] = true;
+    }
+  }
+
+  // Elements of the same order and load share a cost, and the order and the load both add to it
+  for (std::size_t e = 0; e < costs.size(); e++) {
+    for (std::size_t f = 0; f < costs.size(); f++) {
+      const bool high_order_e = mesh.GetAttribute(static_cast<int>(e)) == 2;
+      const bool high_order_f = mesh.GetAttribute(static_cast<int>(f)) == 2;
+      if ((high_order_e == high_order_f) && (loaded[e] == loaded[f])) {
+        EXPECT_EQ(costs[e], costs[f]);
+      } else if ((high_order_e >= high_order_f) && (loaded[e] >= loaded[f])) {
+        EXPECT_GT(costs[e], costs[f]);
+      }
+    }
+  }
+}
+
+TEST(mesh, distribute_with_partition_options)
+{
+  MPI_Barrier(MPI_COMM_WORLD);
+  std::string mesh_file = std::string(SERAC_REPO_DIR) + "/data/meshes/beam-hex.mesh";
+
+  mesh::PartitionOptions options{mesh::PartitionMethod::Hilbert};
+  auto                   hilbert = buildMeshFromFile(mesh_file, 1, 0, MPI_COMM_WORLD, options);
+  auto                   metis   = buildMeshFromFile(mesh_file, 1);
+
+  EXPECT_EQ(hilbert->GetGlobalNE(), metis->GetGlobalNE());
+
+  // The curve is split into equal pieces, so no rank is left empty
+  EXPECT_GT(hilbert->GetNE(), 0);
+  MPI_Barrier(MPI_COMM_WORLD);
+}
+
+TEST(mesh, rebalanced_partition_moves_work_off_heavy_rank)
+{
+  MPI_Barrier(MPI_COMM_WORLD);
+  mesh::PartitionOptions options{mesh::PartitionMethod::METIS, 1, true};
+  auto                   pmesh = buildCuboidMesh(4, 4, 4, 1., 1., 1., MPI_COMM_WORLD, options);
+  ASSERT_TRUE(pmesh->Nonconforming());
+
+  // Make every element on the first rank ten times as expensive
+  const double        cost = (pmesh->GetMyRank() == 0) ? 10.0 : 1.0;
+  std::vector<double> weights(static_cast<std::size_t>(pmesh->GetNE()), cost);
+
+  auto partition = rebalancedPartition(*pmesh, weights);
+  ASSERT_EQ(partition.Size(), pmesh->GetNE());
+
+  int kept = 0;
+  for (int e = 0; e < partition.Size(); e++) {
+    EXPECT_GE(partition[e], 0);
+    EXPECT_LT(partition[e], pmesh->GetNRanks());
+    kept += (partition[e] == pmesh->GetMyRank()) ? 1 : 0;
+  }
+  if ((pmesh->GetMyRank() == 0) && (pmesh->GetNRanks() > 1)) {
+    EXPECT_LT(kept, pmesh->GetNE());
+  }
+
+  pmesh->Rebalance(partition);
+  int global_ne = pmesh->GetNE();
+  MPI_Allreduce(MPI_IN_PLACE, &global_ne, 1, MPI_INT, MPI_SUM, MPI_COMM_WORLD);
+  EXPECT_EQ(global_ne, 64);
+  MPI_Barrier(MPI_COMM_WORLD);
+}
+
+TEST(mesh, box_decomposition_minimizes_interfaces)
+{
+  EXPECT_EQ(mesh::decomposeBox({100, 10, 10}, 8, 0).blocks, (std::array<int, 3>{8, 1, 1}));
+  EXPECT_EQ(mesh::decomposeBox({16, 16, 16}, 8, 0).blocks, (std::array<int, 3>{2, 2, 2}));
+  EXPECT_EQ(mesh::decomposeBox({12, 6}, 6, 0).blocks, (std::array<int, 3>{3, 2, 1}));
+
+  // The blocks cover every element exactly once
+  long long covered = 0;
+  for (int rank = 0; rank < 6; rank++) {
+    auto box = mesh::decomposeBox({7, 5, 3}, 6, rank);
+    covered += static_cast<long long>(box.last[0] - box.first[0]) * (box.last[1] - box.first[1]) *
+               (box.last[2] - box.first[2]);
+  }
+  EXPECT_EQ(covered, 7 * 5 * 3);
+}
+
+TEST(mesh, structured_mesh_is_connected_across_ranks)
+{
+  MPI_Barrier(MPI_COMM_WORLD);
+
+  // Quadratic elements check that the shared vertices, edges, and faces were all matched up
+  auto rectangle = buildStructuredMesh({6, 5}, {1.0, 2.0});
+  EXPECT_EQ(rectangle->GetGlobalNE(), 30);
+  EXPECT_EQ(rectangle->bdr_attributes.Max(), 4);
+  mfem::H1_FECollection       rectangle_fec(2, 2);
+  mfem::ParFiniteElementSpace rectangle_space(rectangle.get(), &rectangle_fec);
+  EXPECT_EQ(rectangle_space.GlobalTrueVSize(), 13 * 11);
+
+  auto cuboid = buildStructuredMesh({4, 3, 2}, {1.0, 1.0, 1.0});
+  EXPECT_EQ(cuboid->GetGlobalNE(), 24);
+  EXPECT_EQ(cuboid->bdr_attributes.Max(), 6);
+  mfem::H1_FECollection       cuboid_fec(2, 3);
+  mfem::ParFiniteElementSpace cuboid_space(cuboid.get(), &cuboid_fec);
+  EXPECT_EQ(cuboid_space.GlobalTrueVSize(), 9 * 7 * 5);
+
+  MPI_Barrier(MPI_COMM_WORLD);
+}
+
 }  // namespace serac
 
 //------------------------------------------------------------------------------
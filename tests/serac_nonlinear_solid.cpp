@@ -14,6 +14,7 @@
 #include "serac/coefficients/coefficient_extensions.hpp"
 #include "serac/infrastructure/input.hpp"
 #include "serac/numerics/mesh_utils.hpp"
+#include "serac/physics/mixed_nonlinear_solid.hpp"
 #include "serac/serac_config.hpp"
 #include "test_utilities.hpp"
 
@@ -103,6 +104,339 @@ TEST(nonlinear_solid_solver, qs_custom_solve)
   MPI_Barrier(MPI_COMM_WORLD);
 }
 
+TEST(nonlinear_solid_solver, static_condensation_matches_full_solve)
+{
+  MPI_Barrier(MPI_COMM_WORLD);
+
+  std::string input_file_path = std::string(SERAC_REPO_DIR) + "/data/input_files/tests/nonlinear_solid/qs_solve.lua";
+
+  axom::sidre::DataStore datastore;
+  auto                   inlet = serac::input::initialize(datastore, input_file_path);
+  test_utils::defineTestSchema<NonlinearSolid>(inlet);
+
+  auto mesh_options   = inlet["main_mesh"].get<serac::mesh::InputOptions>();
+  auto full_mesh_path = serac::input::findMeshFilePath(
+      std::get<serac::mesh::FileInputOptions>(mesh_options.extra_options).relative_mesh_file_name, input_file_path);
+
+  // Solves the qs_solve problem at order 3 with or without the interior DOFs. The solver moves the
+  // mesh nodes, so each solve gets its own mesh.
+  auto solve = [&](const bool static_condensation) {
+    auto mesh = serac::buildMeshFromFile(full_mesh_path, mesh_options.ser_ref_levels, mesh_options.par_ref_levels);
+
+    IterativeSolverOptions lin_options = {.rel_tol     = 1.0e-10,
+                                          .abs_tol     = 1.0e-14,
+                                          .print_level = 0,
+                                          .max_iter    = 5000,
+                                          .lin_solver  = LinearSolver::GMRES,
+                                          .prec        = HypreBoomerAMGPrec{}};
+
+    auto solid_solver_options = inlet["nonlinear_solid"].get<NonlinearSolid::InputOptions>();
+
+    solid_solver_options.order                              = 3;
+    solid_solver_options.solver_options.H_lin_options       = lin_options;
+    solid_solver_options.solver_options.static_condensation = static_condensation;
+
+    NonlinearSolid solid_solver(mesh, solid_solver_options);
+    solid_solver.completeSetup();
+
+    double dt = inlet["dt"];
+    solid_solver.advanceTimestep(dt);
+
+    mfem::Vector zero(mesh->Dimension());
+    zero = 0.0;
+    mfem::VectorConstantCoefficient zerovec(zero);
+    return solid_solver.displacement().gridFunc().ComputeLpError(2.0, zerovec);
+  };
+
+  const double full_norm      = solve(false);
+  const double condensed_norm = solve(true);
+
+  EXPECT_NEAR(full_norm, condensed_norm, 1.0e-6 * full_norm);
+
+  MPI_Barrier(MPI_COMM_WORLD);
+}
+
+TEST(nonlinear_solid_solver, hyper_reduction_matches_full_solve)
+{
+  MPI_Barrier(MPI_COMM_WORLD);
+
+  const IterativeSolverOptions lin_options = {.rel_tol     = 1.0e-12,
+                                              .abs_tol     = 1.0e-16,
+                                              .print_level = 0,
+                                              .max_iter    = 5000,
+                                              .lin_solver  = LinearSolver::GMRES,
+                                              .prec        = HypreBoomerAMGPrec{}};
+
+  const NonlinearSolverOptions nonlin_options = {
+      .rel_tol = 1.0e-10, .abs_tol = 1.0e-14, .max_iter = 10, .print_level = 0};
+
+  // A cantilever clamped on the left and pulled down on the right by a traction that grows in time. The
+  // solver moves the mesh nodes, so each solve gets its own mesh.
+  auto build = [&](std::shared_ptr<mfem::ParMesh> mesh) {
+    auto solid_solver =
+        std::make_unique<NonlinearSolid>(1, mesh, NonlinearSolid::SolverOptions{lin_options, nonlin_options});
+    solid_solver->setHyperelasticMaterialParameters(0.25, 5.0);
+
+    mfem::Vector zero(mesh->Dimension());
+    zero = 0.0;
+    solid_solver->setDisplacementBCs({4}, std::make_shared<mfem::VectorConstantCoefficient>(zero));
+    solid_solver->setTractionBCs(
+        {2}, std::make_shared<mfem::VectorFunctionCoefficient>(
+                 mesh->Dimension(), [](const mfem::Vector&, const double t, mfem::Vector& traction) {
+                   traction    = 0.0;
+                   traction(1) = -1.0e-4 * t;
+                 }));
+    solid_solver->completeSetup();
+    return solid_solver;
+  };
+
+  const int steps = 6;
+
+  auto full_mesh   = buildRectangleMesh(32, 8, 2.0, 0.5);
+  auto full_solver = build(full_mesh);
+  auto basis       = std::make_shared<mfem_ext::ReducedBasis>(MPI_COMM_WORLD);
+  full_solver->recordSnapshots(basis);
+  for (int i = 0; i < steps; i++) {
+    double dt = 1.0;
+    full_solver->advanceTimestep(dt);
+  }
+  EXPECT_EQ(basis->numSnapshots(), steps + 1);
+
+  basis->compute(1.0e-14);
+  auto cubature = full_solver->trainHyperReduction(*basis, 1.0e-8);
+
+  // The sampled elements are a small fraction of the mesh
+  int num_elements   = 0;
+  int local_elements = full_mesh->GetNE();
+  MPI_Allreduce(&local_elements, &num_elements, 1, MPI_INT, MPI_SUM, MPI_COMM_WORLD);
+  EXPECT_GT(cubature->globalSize(), 0);
+  EXPECT_LT(cubature->globalSize(), num_elements / 4);
+
+  auto reduced_mesh   = buildRectangleMesh(32, 8, 2.0, 0.5);
+  auto reduced_solver = build(reduced_mesh);
+  reduced_solver->enableHyperReduction(basis, cubature);
+  for (int i = 0; i < steps; i++) {
+    double dt = 1.0;
+    reduced_solver->advanceTimestep(dt);
+  }
+
+  mfem::Vector difference(full_solver->displacement().trueVec());
+  difference -= reduced_solver->displacement().trueVec();
+  const double full_norm = mfem::ParNormlp(full_solver->displacement().trueVec(), 2, MPI_COMM_WORLD);
+  EXPECT_GT(full_norm, 0.0);
+  EXPECT_LT(mfem::ParNormlp(difference, 2, MPI_COMM_WORLD), 1.0e-4 * full_norm);
+
+  MPI_Barrier(MPI_COMM_WORLD);
+}
+
+TEST(nonlinear_solid_solver, rebalance_preserves_dynamic_state)
+{
+  MPI_Barrier(MPI_COMM_WORLD);
+
+  const IterativeSolverOptions lin_options = {.rel_tol     = 1.0e-12,
+                                              .abs_tol     = 1.0e-16,
+                                              .print_level = 0,
+                                              .max_iter    = 5000,
+                                              .lin_solver  = LinearSolver::GMRES,
+                                              .prec        = HypreBoomerAMGPrec{}};
+
+  const NonlinearSolverOptions nonlin_options = {
+      .rel_tol = 1.0e-10, .abs_tol = 1.0e-14, .max_iter = 10, .print_level = 0};
+
+  const NonlinearSolid::SolverOptions options = {
+      lin_options, nonlin_options,
+      NonlinearSolid::TimesteppingOptions{TimestepMethod::AverageAcceleration,
+                                          DirichletEnforcementMethod::RateControl}};
+
+  // A cantilever clamped on the left and pulled down on the right, whose acceleration history
+  // enters every Newmark step, solved with or without rebalancing the mesh halfway through
+  auto solve = [&](const bool rebalance) {
+    mesh::PartitionOptions partition{mesh::PartitionMethod::METIS, 1, true};
+    auto                   mesh = buildRectangleMesh(16, 4, 2.0, 0.5, MPI_COMM_WORLD, partition);
+
+    NonlinearSolid solid_solver(1, mesh, options);
+    solid_solver.setHyperelasticMaterialParameters(0.25, 5.0);
+
+    mfem::Vector zero(mesh->Dimension());
+    zero = 0.0;
+    solid_solver.setDisplacementBCs({4}, std::make_shared<mfem::VectorConstantCoefficient>(zero));
+    mfem::Vector traction(mesh->Dimension());
+    traction    = 0.0;
+    traction(1) = -1.0e-3;
+    solid_solver.setTractionBCs({2}, std::make_shared<mfem::VectorConstantCoefficient>(traction));
+    solid_solver.completeSetup();
+
+    // Every check finds some imbalance, so the first one repartitions the mesh
+    if (rebalance) {
+      solid_solver.enableRebalancing({.every_n_steps = 1, .imbalance_threshold = 0.0});
+    }
+
+    const int steps = 4;
+    for (int i = 0; i < steps; i++) {
+      double dt = 0.5;
+      solid_solver.advanceTimestep(dt);
+      if (rebalance && (i == steps / 2 - 1)) {
+        EXPECT_TRUE(solid_solver.rebalance());
+      }
+    }
+
+    mfem::VectorConstantCoefficient zerovec(zero);
+    return std::make_pair(solid_solver.displacement().gridFunc().ComputeLpError(2.0, zerovec),
+                          solid_solver.velocity().gridFunc().ComputeLpError(2.0, zerovec));
+  };
+
+  const auto [displacement, velocity]                       = solve(false);
+  const auto [rebalanced_displacement, rebalanced_velocity] = solve(true);
+
+  EXPECT_GT(displacement, 0.0);
+  EXPECT_NEAR(displacement, rebalanced_displacement, 1.0e-6 * displacement);
+  EXPECT_NEAR(velocity, rebalanced_velocity, 1.0e-6 * velocity);
+
+  MPI_Barrier(MPI_COMM_WORLD);
+}
+
+TEST(nonlinear_solid_solver, reference_geometry_detects_inversion)
+{
+  MPI_Barrier(MPI_COMM_WORLD);
+
+  auto mesh = buildCuboidMesh(2, 2, 2, 1.0, 1.0, 1.0);
+  int  dim  = mesh->Dimension();
+
+  mfem::H1_FECollection       fec(1, dim);
+  mfem::ParFiniteElementSpace space(mesh.get(), &fec, dim, mfem::Ordering::byVDIM);
+  mfem::ParGridFunction       reference_nodes(&space);
+  mesh->GetNodes(reference_nodes);
+
+  ReferenceGeometry geometry(reference_nodes);
+
+  // The identity map has a unit Jacobian everywhere
+  mfem::Vector displacement(space.GetTrueVSize());
+  displacement = 0.0;
+  EXPECT_NEAR(geometry.minJacobian(displacement), 1.0, 1.0e-12);
+
+  // Moving the nodes back through their reference positions inverts every element
+  mfem::ParGridFunction           inverting(&space);
+  mfem::VectorFunctionCoefficient fold(dim, [](const mfem::Vector& x, mfem::Vector& u) {
+    u    = 0.0;
+    u(0) = -2.0 * x(0);
+  });
+  inverting.ProjectCoefficient(fold);
+  inverting.GetTrueDofs(displacement);
+  EXPECT_NEAR(geometry.minJacobian(displacement), -1.0, 1.0e-12);
+
+  // Moving the mesh nodes to a deformed configuration does not change the reference geometry
+  mfem::ParGridFunction deformed_nodes(reference_nodes);
+  deformed_nodes.Add(1.0, inverting);
+  mesh->NewNodes(deformed_nodes);
+  EXPECT_NEAR(geometry.minJacobian(displacement), -1.0, 1.0e-12);
+
+  MPI_Barrier(MPI_COMM_WORLD);
+}
+
+TEST(nonlinear_solid_solver, minimum_jacobian_rejects_large_step)
+{
+  MPI_Barrier(MPI_COMM_WORLD);
+
+  const IterativeSolverOptions lin_options = {.rel_tol     = 1.0e-10,
+                                              .abs_tol     = 1.0e-14,
+                                              .print_level = 0,
+                                              .max_iter    = 5000,
+                                              .lin_solver  = LinearSolver::GMRES,
+                                              .prec        = HypreBoomerAMGPrec{}};
+
+  const NonlinearSolverOptions nonlin_options = {
+      .rel_tol = 1.0e-8, .abs_tol = 1.0e-12, .max_iter = 10, .print_level = 0};
+
+  // A cantilever under a small load, followed by one so large that the first Newton update inverts elements
+  auto           mesh = buildRectangleMesh(16, 4, 2.0, 0.5);
+  NonlinearSolid solid_solver(1, mesh, NonlinearSolid::SolverOptions{lin_options, nonlin_options});
+  solid_solver.setHyperelasticMaterialParameters(0.25, 5.0);
+  solid_solver.setMinimumJacobian(0.1);
+
+  mfem::Vector zero(mesh->Dimension());
+  zero = 0.0;
+  solid_solver.setDisplacementBCs({4}, std::make_shared<mfem::VectorConstantCoefficient>(zero));
+  solid_solver.setTractionBCs(
+      {2}, std::make_shared<mfem::VectorFunctionCoefficient>(
+               mesh->Dimension(), [](const mfem::Vector&, const double t, mfem::Vector& traction) {
+                 traction    = 0.0;
+                 traction(1) = (t < 0.5) ? -1.0e-4 : -1.0;
+               }));
+  solid_solver.completeSetup();
+
+  double dt = 1.0;
+  solid_solver.advanceTimestep(dt);
+  EXPECT_EQ(dt, 1.0);
+  EXPECT_EQ(solid_solver.cycle(), 1);
+
+  const mfem::Vector accepted(solid_solver.displacement().trueVec());
+  EXPECT_GT(mfem::ParNormlp(accepted, 2, MPI_COMM_WORLD), 0.0);
+
+  // The rejected step leaves the time, cycle, and displacement where the accepted step left them
+  dt = 1.0;
+  solid_solver.advanceTimestep(dt);
+  EXPECT_EQ(dt, 0.0);
+  EXPECT_EQ(solid_solver.cycle(), 1);
+  EXPECT_DOUBLE_EQ(solid_solver.time(), 1.0);
+
+  mfem::Vector difference(solid_solver.displacement().trueVec());
+  difference -= accepted;
+  EXPECT_EQ(mfem::ParNormlp(difference, mfem::infinity(), MPI_COMM_WORLD), 0.0);
+
+  MPI_Barrier(MPI_COMM_WORLD);
+}
+
+TEST(nonlinear_solid_solver, mixed_formulation_conserves_volume)
+{
+  MPI_Barrier(MPI_COMM_WORLD);
+
+  auto mesh = buildRectangleMesh(4, 4);
+  int  dim  = mesh->Dimension();
+
+  const IterativeSolverOptions lin_options = {.rel_tol     = 1.0e-10,
+                                              .abs_tol     = 1.0e-12,
+                                              .print_level = 0,
+                                              .max_iter    = 500,
+                                              .lin_solver  = LinearSolver::MINRES,
+                                              .prec        = BlockSchurPrec{}};
+
+  const NonlinearSolverOptions nonlin_options = {.rel_tol = 1.0e-8, .abs_tol = 1.0e-9, .max_iter = 8, .print_level = 0};
+  MixedNonlinearSolid          solid_solver(2, mesh, {lin_options, nonlin_options});
+
+  // A nearly incompressible material, which locks with pure displacement elements on this mesh
+  const double mu = 0.25;
+  const double K  = 1.0e4 * mu;
+  solid_solver.setHyperelasticMaterialParameters(mu, K);
+
+  // Clamp the bottom and push the top down, so the block has to bulge sideways
+  mfem::Vector zero(dim);
+  zero = 0.0;
+  solid_solver.setDisplacementBCs({1}, std::make_shared<mfem::VectorConstantCoefficient>(zero));
+  solid_solver.setDisplacementBCs({3}, std::make_shared<mfem::ConstantCoefficient>(-0.05), 1);
+
+  solid_solver.completeSetup();
+  double dt = 1.0;
+  solid_solver.advanceTimestep(dt);
+
+  // The constraint is tested with constant pressures, so the area only changes by the integral of p / K
+  double area = 0.0;
+  for (int e = 0; e < mesh->GetNE(); e++) {
+    area += mesh->GetElementVolume(e);
+  }
+  double total_area = 0.0;
+  MPI_Allreduce(&area, &total_area, 1, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD);
+  EXPECT_NEAR(total_area, 1.0, 1.0e-4);
+
+  // The pressure stays on the scale of the shear response instead of K times the nominal compression
+  double max_pressure = 0.0;
+  double local_max    = solid_solver.pressure().trueVec().Normlinf();
+  MPI_Allreduce(&local_max, &max_pressure, 1, MPI_DOUBLE, MPI_MAX, MPI_COMM_WORLD);
+  EXPECT_GT(max_pressure, 0.0);
+  EXPECT_LT(max_pressure, 0.01 * K);
+
+  MPI_Barrier(MPI_COMM_WORLD);
+}
+
 }  // namespace serac
 
 //------------------------------------------------------------------------------
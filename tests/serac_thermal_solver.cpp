@@ -13,6 +13,7 @@
 #include <gtest/gtest.h>
 #include "mfem.hpp"
 
+#include "serac/infrastructure/input.hpp"
 #include "serac/numerics/mesh_utils.hpp"
 #include "serac/serac_config.hpp"
 #include "test_utilities.hpp"
@@ -118,6 +119,254 @@ TEST(thermal_solver_rework, dyn_imp_solve_time_varying)
   MPI_Barrier(MPI_COMM_WORLD);
 }
 
+TEST(thermal_solver, adaptive_refinement_follows_front)
+{
+  MPI_Barrier(MPI_COMM_WORLD);
+
+  mesh::PartitionOptions partition{mesh::PartitionMethod::METIS, 1, true};
+  auto                   pmesh = buildRectangleMesh(8, 8, 1.0, 1.0, MPI_COMM_WORLD, partition);
+
+  ThermalConduction therm_solver(1, pmesh, ThermalConduction::defaultDynamicOptions());
+
+  // A uniform temperature has no error, so the first step leaves the mesh unchanged
+  mfem::ConstantCoefficient zero(0.0);
+  therm_solver.setTemperature(zero);
+  therm_solver.setConductivity(std::make_unique<mfem::ConstantCoefficient>(1.0e-3));
+  therm_solver.enableAdaptivity({.every_n_steps = 1, .refine_fraction = 0.5, .max_elements = 1000});
+  therm_solver.completeSetup();
+
+  const auto initial_elements = pmesh->GetGlobalNE();
+  double     dt               = 0.01;
+  EXPECT_FALSE(therm_solver.adapt());
+  therm_solver.advanceTimestep(dt);
+  EXPECT_EQ(pmesh->GetGlobalNE(), initial_elements);
+
+  // A steep front along x = 0.5 appears, which the errors of the unchanged mesh must be recomputed to see
+  mfem::FunctionCoefficient front([](const mfem::Vector& x) { return std::tanh(50.0 * (x[0] - 0.5)); });
+  therm_solver.setTemperature(front);
+  therm_solver.advanceTimestep(dt);
+  EXPECT_GT(pmesh->GetGlobalNE(), initial_elements);
+
+  for (int i = 0; i < 2; i++) {
+    therm_solver.advanceTimestep(dt);
+  }
+
+  // Refinement is concentrated at the front, well below the uniformly refined count
+  EXPECT_GT(pmesh->GetGlobalNE(), initial_elements);
+  EXPECT_LT(pmesh->GetGlobalNE(), 4 * 4 * initial_elements);
+  EXPECT_EQ(therm_solver.temperature().space().GetTrueVSize(), therm_solver.temperature().trueVec().Size());
+
+  MPI_Barrier(MPI_COMM_WORLD);
+}
+
+/**
+ * @brief Exposes the statistics of the linear solver of a ThermalConduction module
+ */
+class ThermalConductionIterations : public ThermalConduction {
+public:
+  using ThermalConduction::ThermalConduction;
+
+  /**
+   * @brief The number of iterations taken by the last linear solve inside the Newton solver
+   */
+  int linearIterations()
+  {
+    return dynamic_cast<mfem::IterativeSolver&>(nonlin_solver_.LinearSolver()).GetNumIterations();
+  }
+
+  /**
+   * @brief The number of symbolic factorizations computed by a direct linear solver
+   */
+  int symbolicFactorizations()
+  {
+    return dynamic_cast<mfem_ext::SuperLUSolver&>(nonlin_solver_.LinearSolver()).NumSymbolicFactorizations();
+  }
+};
+
+TEST(thermal_solver, p_multigrid_matches_jacobi)
+{
+  MPI_Barrier(MPI_COMM_WORLD);
+
+  auto pmesh = buildRectangleMesh(8, 8, 1.0, 1.0);
+
+  // Takes one order 4 backward Euler step with a given preconditioner, which is partially assembled
+  // above the coarsest level for p-multigrid, returning the solution and the iteration count
+  auto solve = [&pmesh](const Preconditioner& prec) {
+    auto options             = ThermalConduction::defaultDynamicOptions();
+    options.T_lin_options    = IterativeSolverOptions{.rel_tol     = 1.0e-10,
+                                                      .abs_tol     = 1.0e-14,
+                                                      .print_level = 0,
+                                                      .max_iter    = 5000,
+                                                      .lin_solver  = LinearSolver::CG,
+                                                      .prec        = prec};
+    options.T_nonlin_options = {.rel_tol = 1.0e-8, .abs_tol = 1.0e-12, .max_iter = 10, .print_level = 0};
+
+    ThermalConductionIterations therm_solver(4, pmesh, options);
+
+    mfem::FunctionCoefficient initial_temp(InitialTemperature);
+    therm_solver.setTemperature(initial_temp);
+    therm_solver.setTemperatureBCs({1}, std::make_shared<mfem::FunctionCoefficient>(BoundaryTemperature));
+    therm_solver.setConductivity(std::make_unique<mfem::ConstantCoefficient>(0.5));
+    therm_solver.completeSetup();
+
+    double dt = 0.1;
+    therm_solver.advanceTimestep(dt);
+
+    return std::make_pair(mfem::Vector(therm_solver.temperature().trueVec()), therm_solver.linearIterations());
+  };
+
+  const auto [jacobi_solution, jacobi_iterations] = solve(HypreSmootherPrec{mfem::HypreSmoother::l1Jacobi});
+  const auto [pmg_solution, pmg_iterations]       = solve(PMultigridPrec{});
+
+  mfem::Vector difference(jacobi_solution);
+  difference -= pmg_solution;
+  const double jacobi_norm = mfem::ParNormlp(jacobi_solution, 2, MPI_COMM_WORLD);
+  EXPECT_GT(jacobi_norm, 0.0);
+  EXPECT_LT(mfem::ParNormlp(difference, 2, MPI_COMM_WORLD), 1.0e-6 * jacobi_norm);
+
+  EXPECT_GT(pmg_iterations, 0);
+  EXPECT_LT(pmg_iterations, jacobi_iterations / 2);
+
+  MPI_Barrier(MPI_COMM_WORLD);
+}
+
+TEST(thermal_solver, sweep_reuses_setup)
+{
+  MPI_Barrier(MPI_COMM_WORLD);
+
+  auto pmesh = buildRectangleMesh(8, 8);
+
+  auto options          = ThermalConduction::defaultDynamicOptions();
+  options.T_lin_options = DirectSolverOptions{0};
+
+  // The boundary temperature is scaled between the cases, as by a sweep's bc_scale
+  auto                           scale = std::make_shared<double>(1.0);
+  input::CoefficientInputOptions bc_options;
+  bc_options.scalar_function = [](const mfem::Vector& x, double) { return BoundaryTemperature(x); };
+  bc_options.factor          = scale;
+
+  mfem::FunctionCoefficient initial_temp(InitialTemperature);
+
+  auto build = [&](double kappa) {
+    auto therm_solver = std::make_unique<ThermalConductionIterations>(1, pmesh, options);
+    therm_solver->setTemperature(initial_temp);
+    therm_solver->setTemperatureBCs({1}, bc_options.constructScalar());
+    therm_solver->setConductivity(std::make_unique<mfem::ConstantCoefficient>(kappa));
+    therm_solver->completeSetup();
+    return therm_solver;
+  };
+  auto run = [](ThermalConduction& therm_solver) {
+    for (int i = 0; i < 3; i++) {
+      double dt = 0.1;
+      therm_solver.advanceTimestep(dt);
+    }
+    return mfem::Vector(therm_solver.temperature().trueVec());
+  };
+
+  auto                      sweep = build(1.0);
+  std::vector<mfem::Vector> initial_state{sweep->temperature().gridFunc()};
+  run(*sweep);
+
+  // The second case changes only values, so the Jacobian keeps its sparsity pattern
+  *scale = 2.0;
+  sweep->updateConductivity(2.0);
+  sweep->restart(initial_state);
+  EXPECT_EQ(sweep->time(), 0.0);
+  EXPECT_EQ(sweep->cycle(), 0);
+  auto second_case = run(*sweep);
+  EXPECT_EQ(sweep->symbolicFactorizations(), 1);
+
+  auto         fresh    = build(2.0);
+  auto         expected = run(*fresh);
+  const double norm     = mfem::ParNormlp(expected, 2, MPI_COMM_WORLD);
+  second_case -= expected;
+  EXPECT_LT(mfem::ParNormlp(second_case, 2, MPI_COMM_WORLD), 1.0e-10 * norm);
+
+  MPI_Barrier(MPI_COMM_WORLD);
+}
+
+TEST(thermal_solver, reduced_order_model_matches_full_model)
+{
+  MPI_Barrier(MPI_COMM_WORLD);
+
+  auto pmesh = buildRectangleMesh(8, 8);
+
+  // by construction, f(x, y, t) satisfies df_dt == d2f_dx2 + d2f_dy2
+  auto f = std::make_shared<mfem::FunctionCoefficient>([](const mfem::Vector& x, double t) {
+    return 1.0 + 6.0 * x[0] * t - 2.0 * x[1] * t + (x[0] - x[1]) * x[0] * x[0];
+  });
+
+  auto options          = ThermalConduction::defaultDynamicOptions();
+  options.T_lin_options = IterativeSolverOptions{.rel_tol     = 1.0e-12,
+                                                 .abs_tol     = 1.0e-14,
+                                                 .print_level = 0,
+                                                 .max_iter    = 500,
+                                                 .lin_solver  = LinearSolver::CG,
+                                                 .prec        = HypreSmootherPrec{mfem::HypreSmoother::Jacobi}};
+
+  // Steps the problem to t = 1, recording snapshots or using a reduced basis
+  auto solve = [&](std::shared_ptr<mfem_ext::ReducedBasis>                       record,
+                   std::shared_ptr<const mfem_ext::ReducedBasis>                 basis,
+                   const std::optional<ThermalConduction::ReducedOrderOptions>& rom_options, int* fallbacks) {
+    ThermalConduction therm_solver(2, pmesh, options);
+    f->SetTime(0.0);
+    therm_solver.setTemperature(*f);
+    therm_solver.setTemperatureBCs({1, 2, 3, 4}, f);
+    therm_solver.setConductivity(std::make_unique<mfem::ConstantCoefficient>(1.0));
+    therm_solver.completeSetup();
+
+    if (record) {
+      therm_solver.recordSnapshots(record);
+    }
+    if (basis) {
+      therm_solver.enableReducedOrder(basis, *rom_options);
+    }
+
+    for (int i = 0; i < 10; i++) {
+      double dt = 0.1;
+      therm_solver.advanceTimestep(dt);
+    }
+    if (fallbacks) {
+      *fallbacks = therm_solver.fullOrderFallbacks();
+    }
+    return mfem::Vector(therm_solver.temperature().trueVec());
+  };
+
+  auto snapshots = std::make_shared<mfem_ext::ReducedBasis>(MPI_COMM_WORLD);
+  auto full      = solve(snapshots, nullptr, std::nullopt, nullptr);
+  EXPECT_EQ(snapshots->numSnapshots(), 11);
+
+  snapshots->compute(0.0);
+  ASSERT_GT(snapshots->size(), 0);
+
+  // The modes are orthonormal across the ranks
+  mfem::DenseMatrix gram(snapshots->size());
+  mfem::MultAtB(snapshots->modes(), snapshots->modes(), gram);
+  MPI_Allreduce(MPI_IN_PLACE, gram.GetData(), gram.Height() * gram.Width(), MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD);
+  for (int i = 0; i < gram.Height(); i++) {
+    gram(i, i) -= 1.0;
+  }
+  EXPECT_LT(gram.MaxMaxNorm(), 1.0e-10);
+
+  const double full_norm = mfem::ParNormlp(full, 2, MPI_COMM_WORLD);
+
+  // The full trajectory lies in the span of the modes, so the reduced model reproduces it
+  int  fallbacks = 0;
+  auto reduced   = solve(nullptr, snapshots, ThermalConduction::ReducedOrderOptions{1.0e-6, 1}, &fallbacks);
+  EXPECT_EQ(fallbacks, 0);
+  reduced -= full;
+  EXPECT_LT(mfem::ParNormlp(reduced, 2, MPI_COMM_WORLD), 1.0e-8 * full_norm);
+
+  // A single mode cannot, so the error indicator repeats the steps with the full model
+  snapshots->compute(0.5, 1);
+  auto fallback = solve(nullptr, snapshots, ThermalConduction::ReducedOrderOptions{1.0e-10, 1}, &fallbacks);
+  EXPECT_GT(fallbacks, 0);
+  fallback -= full;
+  EXPECT_LT(mfem::ParNormlp(fallback, 2, MPI_COMM_WORLD), 1.0e-8 * full_norm);
+
+  MPI_Barrier(MPI_COMM_WORLD);
+}
+
 #ifdef MFEM_USE_AMGX
 TEST(thermal_solver, static_amgx_solve)
 {